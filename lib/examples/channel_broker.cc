@@ -0,0 +1,266 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Channel emulator between RF endpoints (e.g. the shm or zmq devices). It receives the signals of up to
+ * SRSLTE_MAX_PORTS transmitters from the input device, applies the channel of every link, adds the links of every
+ * receiver and sends them through the output device with the input timestamps. One instance handles one direction,
+ * for example the DL of two cells towards two UEs (with shm):
+ *
+ *   channel_broker -I 2 -i rx_port=enb1_dl,rx_port2=enb2_dl,id=brk_dl_in -O 2 -o tx_port=ue1_dl,tx_port2=ue2_dl,id=brk_dl
+ *                  -l 0,0,0,epa5 -l 1,0,-10,epa5 -l 0,1,-10,eva70 -l 1,1,0,eva70 -n -30
+ *
+ * and a second instance for the UL in the opposite direction.
+ */
+
+#include <signal.h>
+#include <srslte/phy/channel/channel_broker.h>
+#include <srslte/phy/rf/rf.h>
+#include <srslte/srslte.h>
+#include <unistd.h>
+
+static char*    devname     = (char*)"shm";
+static char*    input_args  = (char*)"";
+static char*    output_args = (char*)"";
+static uint32_t nof_prb     = 25;
+static uint32_t duration_s  = 0;
+
+static srslte::channel_broker::args_t broker_args = {};
+
+static bool go_exit = false;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [dIiOolnwpstv]\n", prog);
+  printf("\t-d RF device name [Default %s]\n", devname);
+  printf("\t-I Number of transmitters (input channels) [Default %d]\n", broker_args.nof_tx);
+  printf("\t-i Input RF device args [Default %s]\n", input_args);
+  printf("\t-O Number of receivers (output channels) [Default %d]\n", broker_args.nof_rx);
+  printf("\t-o Output RF device args [Default %s]\n", output_args);
+  printf("\t-l Link tx,rx,gain_dB[,fading_model[,delay_us]], can be repeated\n");
+  printf("\t-n AWGN power in dBfs at every receiver [Default disabled]\n");
+  printf("\t-w Number of worker threads [Default %d]\n", broker_args.nof_workers);
+  printf("\t-p Number of PRB [Default %d]\n", nof_prb);
+  printf("\t-s Random seed [Default %d]\n", broker_args.seed);
+  printf("\t-t Duration in seconds, 0 runs until Ctrl+C [Default %d]\n", duration_s);
+  printf("\t-v srslte_verbose\n");
+}
+
+static int parse_link(char* str)
+{
+  srslte::channel_broker::link_args_t link = {};
+  char*                               save = NULL;
+  char*                               tok  = strtok_r(str, ",", &save);
+
+  for (uint32_t i = 0; tok != NULL; i++, tok = strtok_r(NULL, ",", &save)) {
+    switch (i) {
+      case 0:
+        link.tx = (uint32_t)strtol(tok, NULL, 10);
+        break;
+      case 1:
+        link.rx = (uint32_t)strtol(tok, NULL, 10);
+        break;
+      case 2:
+        link.gain_dB = strtof(tok, NULL);
+        break;
+      case 3:
+        link.channel_args.enable        = true;
+        link.channel_args.fading_enable = true;
+        link.channel_args.fading_model  = tok;
+        break;
+      case 4:
+        link.channel_args.enable       = true;
+        link.channel_args.delay_enable = true;
+        link.channel_args.delay_min_us = strtof(tok, NULL);
+        link.channel_args.delay_max_us = link.channel_args.delay_min_us;
+        break;
+      default:
+        return SRSLTE_ERROR;
+    }
+  }
+
+  broker_args.links.push_back(link);
+
+  return SRSLTE_SUCCESS;
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "dIiOolnwpstv")) != -1) {
+    switch (opt) {
+      case 'd':
+        devname = argv[optind];
+        break;
+      case 'I':
+        broker_args.nof_tx = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'i':
+        input_args = argv[optind];
+        break;
+      case 'O':
+        broker_args.nof_rx = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'o':
+        output_args = argv[optind];
+        break;
+      case 'l':
+        if (parse_link(argv[optind])) {
+          ERROR("Invalid link %s\n", argv[optind]);
+          exit(-1);
+        }
+        break;
+      case 'n':
+        broker_args.awgn_enable  = true;
+        broker_args.awgn_n0_dBfs = strtof(argv[optind], NULL);
+        break;
+      case 'w':
+        broker_args.nof_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'p':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        broker_args.seed = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        duration_s = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        srslte_verbose++;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+
+  if (broker_args.nof_tx > SRSLTE_MAX_PORTS || broker_args.nof_rx > SRSLTE_MAX_PORTS ||
+      !srslte_nofprb_isvalid(nof_prb)) {
+    usage(argv[0]);
+    exit(-1);
+  }
+
+  // Independent fading for every link, derived once the seed is known regardless of the option order
+  for (uint32_t i = 0; i < broker_args.links.size(); i++) {
+    broker_args.links[i].channel_args.fading_seed = broker_args.seed + i + 1;
+  }
+}
+
+static void sig_int_handler(int signo)
+{
+  if (signo == SIGINT) {
+    go_exit = true;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int                ret                   = SRSLTE_ERROR;
+  srslte_rf_t        rf_in                 = {};
+  srslte_rf_t        rf_out                = {};
+  cf_t*              in[SRSLTE_MAX_PORTS]  = {};
+  cf_t*              out[SRSLTE_MAX_PORTS] = {};
+  srslte_timestamp_t ts                    = {};
+  uint32_t           nof_sf                = 0;
+
+  parse_args(argc, argv);
+
+  int      srate  = srslte_sampling_freq_hz(nof_prb);
+  uint32_t sf_len = (uint32_t)srate / 1000;
+
+  for (uint32_t i = 0; i < SRSLTE_MAX_PORTS; i++) {
+    in[i]  = (cf_t*)srslte_vec_malloc(sizeof(cf_t) * sf_len);
+    out[i] = (cf_t*)srslte_vec_malloc(sizeof(cf_t) * sf_len);
+    if (!in[i] || !out[i]) {
+      perror("malloc");
+      goto clean_exit;
+    }
+  }
+
+  // Inputs and outputs use separate devices so the output timestamps are not constrained by the reception
+  printf("Opening input RF device...\n");
+  if (srslte_rf_open_devname(&rf_in, devname, input_args, broker_args.nof_tx)) {
+    ERROR("Error opening input rf\n");
+    goto clean_exit;
+  }
+
+  printf("Opening output RF device...\n");
+  if (srslte_rf_open_devname(&rf_out, devname, output_args, broker_args.nof_rx)) {
+    ERROR("Error opening output rf\n");
+    srslte_rf_close(&rf_in);
+    goto clean_exit;
+  }
+
+  srslte_rf_set_rx_srate(&rf_in, (double)srate);
+  srslte_rf_set_tx_srate(&rf_out, (double)srate);
+  srslte_rf_start_rx_stream(&rf_in, false);
+
+  {
+    srslte::channel_broker broker(broker_args);
+    broker.set_srate((uint32_t)srate);
+
+    printf("Running %d links between %d transmitters and %d receivers at %.2f MHz\n",
+           (int)broker_args.links.size(),
+           broker_args.nof_tx,
+           broker_args.nof_rx,
+           srate / 1e6);
+
+    signal(SIGINT, sig_int_handler);
+
+    while (!go_exit && (duration_s == 0 || nof_sf < duration_s * 1000)) {
+      if (srslte_rf_recv_with_time_multi(&rf_in, (void**)in, sf_len, true, &ts.full_secs, &ts.frac_secs) < 0) {
+        ERROR("Error receiving samples\n");
+        break;
+      }
+
+      broker.run(in, out, sf_len, ts);
+
+      // Same timestamps as the input, the broker adds no latency
+      if (srslte_rf_send_timed_multi(
+              &rf_out, (void**)out, sf_len, ts.full_secs, ts.frac_secs, true, nof_sf == 0, false) < 0) {
+        ERROR("Error sending samples\n");
+        break;
+      }
+
+      nof_sf++;
+    }
+  }
+
+  printf("Processed %d subframes\n", nof_sf);
+
+  srslte_rf_close(&rf_in);
+  srslte_rf_close(&rf_out);
+
+  ret = SRSLTE_SUCCESS;
+
+clean_exit:
+  for (uint32_t i = 0; i < SRSLTE_MAX_PORTS; i++) {
+    if (in[i]) {
+      free(in[i]);
+    }
+    if (out[i]) {
+      free(out[i]);
+    }
+  }
+
+  return ret;
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Measures the FFT plans used by the OFDM modulator/demodulator and the SC-FDMA transform precoder for all the LTE
+ * bandwidths and stores them in the FFTW wisdom file. Run it once per host (or bake the file into the container image
+ * and point SRSLTE_FFTW_WISDOM to it) so eNB/UE start-up and cell reconfiguration do not need to measure plans.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srslte/srslte.h"
+
+static char*    output_file_name = NULL;
+static uint32_t max_prb          = SRSLTE_MAX_PRB;
+static bool     standard_sz      = false;
+
+static const uint32_t nof_prb_list[] = {6, 15, 25, 50, 75, 100};
+
+void usage(char* prog)
+{
+  char default_file[256] = "none";
+  srslte_dft_wisdom_filename(default_file, sizeof(default_file));
+
+  printf("Usage: %s [ops]\n", prog);
+  printf("\t-o output wisdom file [Default %s]\n", default_file);
+  printf("\t-p maximum number of PRB [Default %d]\n", max_prb);
+  printf("\t-s use standard symbol sizes [Default %s]\n", standard_sz ? "enabled" : "disabled");
+  printf("\t-v srslte_verbose\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "opsv")) != -1) {
+    switch (opt) {
+      case 'o':
+        output_file_name = argv[optind];
+        break;
+      case 'p':
+        max_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        standard_sz = true;
+        break;
+      case 'v':
+        srslte_verbose++;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static int plan_ofdm(uint32_t nof_prb, srslte_cp_t cp)
+{
+  int           ret = SRSLTE_ERROR;
+  srslte_ofdm_t ofdm_rx, ofdm_tx;
+
+  bzero(&ofdm_rx, sizeof(srslte_ofdm_t));
+  bzero(&ofdm_tx, sizeof(srslte_ofdm_t));
+
+  uint32_t sf_len    = SRSLTE_SF_LEN_PRB(nof_prb);
+  uint32_t sf_len_re = SRSLTE_SF_LEN_RE(nof_prb, cp);
+
+  cf_t* time_buffer = srslte_vec_malloc(sizeof(cf_t) * sf_len);
+  cf_t* re_buffer   = srslte_vec_malloc(sizeof(cf_t) * sf_len_re);
+  if (!time_buffer || !re_buffer) {
+    perror("malloc");
+    goto clean_exit;
+  }
+
+  if (srslte_ofdm_rx_init(&ofdm_rx, cp, time_buffer, re_buffer, nof_prb)) {
+    ERROR("Error initialising OFDM demodulator for %d PRB\n", nof_prb);
+    goto clean_exit;
+  }
+
+  if (srslte_ofdm_tx_init(&ofdm_tx, cp, re_buffer, time_buffer, nof_prb)) {
+    ERROR("Error initialising OFDM modulator for %d PRB\n", nof_prb);
+    goto clean_exit;
+  }
+
+  ret = SRSLTE_SUCCESS;
+
+clean_exit:
+  srslte_ofdm_rx_free(&ofdm_rx);
+  srslte_ofdm_tx_free(&ofdm_tx);
+  if (time_buffer) {
+    free(time_buffer);
+  }
+  if (re_buffer) {
+    free(re_buffer);
+  }
+  return ret;
+}
+
+static int plan_dft_precoding(uint32_t nof_prb)
+{
+  srslte_dft_precoding_t precoding;
+
+  if (srslte_dft_precoding_init_tx(&precoding, nof_prb)) {
+    ERROR("Error initialising DFT precoding\n");
+    return SRSLTE_ERROR;
+  }
+  srslte_dft_precoding_free(&precoding);
+
+  if (srslte_dft_precoding_init_rx(&precoding, nof_prb)) {
+    ERROR("Error initialising DFT precoding\n");
+    return SRSLTE_ERROR;
+  }
+  srslte_dft_precoding_free(&precoding);
+
+  return SRSLTE_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  struct timeval t[3];
+
+  parse_args(argc, argv);
+
+  if (max_prb > SRSLTE_MAX_PRB) {
+    ERROR("Invalid number of PRB %d\n", max_prb);
+    exit(-1);
+  }
+
+  srslte_use_standard_symbol_size(standard_sz);
+
+  // Plans already in the wisdom are kept, the rest are measured
+  srslte_dft_set_measure(true);
+
+  gettimeofday(&t[1], NULL);
+
+  for (uint32_t i = 0; i < sizeof(nof_prb_list) / sizeof(uint32_t) && nof_prb_list[i] <= max_prb; i++) {
+    for (srslte_cp_t cp = SRSLTE_CP_NORM; cp <= SRSLTE_CP_EXT; cp++) {
+      printf("Planning OFDM %3d PRB, %s CP...\n", nof_prb_list[i], SRSLTE_CP_ISNORM(cp) ? "normal" : "extended");
+      if (plan_ofdm(nof_prb_list[i], cp)) {
+        exit(-1);
+      }
+    }
+  }
+
+  printf("Planning SC-FDMA transform precoding up to %d PRB...\n", max_prb);
+  if (plan_dft_precoding(max_prb)) {
+    exit(-1);
+  }
+
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  if (srslte_dft_save_wisdom(output_file_name)) {
+    ERROR("Error saving wisdom\n");
+    exit(-1);
+  }
+
+  printf("Done in %.1f s\n", t[0].tv_sec + t[0].tv_usec * 1e-6);
+
+  exit(0);
+}
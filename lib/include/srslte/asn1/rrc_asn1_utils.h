@@ -40,6 +40,7 @@ struct sched_request_cfg_c;
 struct mac_main_cfg_s;
 struct rach_cfg_common_s;
 struct time_align_timer_opts;
+struct sps_cfg_s;
 struct phys_cfg_ded_s;
 struct prach_cfg_info_s;
 struct pdsch_cfg_common_s;
@@ -97,6 +98,7 @@ void set_mac_cfg_t_sched_request_cfg(mac_cfg_t* cfg, const asn1::rrc::sched_requ
 void set_mac_cfg_t_main_cfg(mac_cfg_t* cfg, const asn1::rrc::mac_main_cfg_s& asn1_type);
 void set_mac_cfg_t_rach_cfg_common(mac_cfg_t* cfg, const asn1::rrc::rach_cfg_common_s& asn1_type);
 void set_mac_cfg_t_time_alignment(mac_cfg_t* cfg, const asn1::rrc::time_align_timer_opts asn1_type);
+sps_cfg_t make_sps_cfg_t(const asn1::rrc::sps_cfg_s& asn1_type);
 
 /***************************
  *      PHY Config
@@ -110,6 +112,7 @@ void set_phy_cfg_t_common_srs(phy_cfg_t* cfg, const asn1::rrc::srs_ul_cfg_common
 void set_phy_cfg_t_common_pwr_ctrl(phy_cfg_t* cfg, const asn1::rrc::ul_pwr_ctrl_common_s& asn1_type);
 void set_phy_cfg_t_scell_config(phy_cfg_t* cfg, const asn1::rrc::scell_to_add_mod_r10_s& asn1_type);
 void set_phy_cfg_t_enable_64qam(phy_cfg_t* cfg, const bool enabled);
+void set_phy_cfg_t_sps_cfg(phy_cfg_t* cfg, const asn1::rrc::sps_cfg_s& asn1_type);
 
 // mbms
 mbms_notif_cfg_t  make_mbms_notif_cfg(const asn1::rrc::mbms_notif_cfg_r9_s& asn1_type);
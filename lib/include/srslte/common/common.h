@@ -26,6 +26,7 @@
                               INCLUDES
 *******************************************************************************/
 
+#include "srslte/phy/common/phy_common.h"
 #include <memory>
 #include <stdint.h>
 #include <string.h>
@@ -45,18 +46,20 @@
 
 #define SRSLTE_N_MCH_LCIDS 32
 
+// Legacy n+4 timing. Also the maximum delays, use them only for sizing buffers. The actual delays are given by
+// srslte_fdd_harq_delay() (phy_common.h), which can be reduced to n+3 or n+2 (short processing time)
 #define TX_DELAY 4
 #define MSG3_DELAY_MS 2 // Delay added to TX_DELAY
 
 #define TTI_SUB(a, b) ((((a) + 10240) - (b)) % 10240)
 #define TTI_ADD(a, b) (((a) + (b)) % 10240)
 
-#define TTI_TX(tti) TTI_ADD(tti, TX_DELAY)
+#define TTI_TX(tti) TTI_ADD(tti, srslte_fdd_harq_delay())
 
 // Use only in FDD mode!!
 #define FDD_HARQ_DELAY_MS 4
-#define TTI_RX(tti) (TTI_SUB(tti, FDD_HARQ_DELAY_MS))
-#define TTI_RX_ACK(tti) (TTI_ADD(tti, FDD_HARQ_DELAY_MS + TX_DELAY))
+#define TTI_RX(tti) (TTI_SUB(tti, srslte_fdd_harq_delay()))
+#define TTI_RX_ACK(tti) (TTI_ADD(tti, 2 * srslte_fdd_harq_delay()))
 
 #define TTIMOD_SZ 20
 #define TTIMOD(tti) (tti % TTIMOD_SZ)
@@ -47,6 +47,8 @@ public:
     srslte_dci_cfg_t        dci_cfg;
     uint8_t*                data[SRSLTE_MAX_TB];
     srslte_softbuffer_tx_t* softbuffer_tx[SRSLTE_MAX_TB];
+    bool                    needs_pdcch;
+    uint16_t                sps_rnti; ///< SPS C-RNTI of the DCI and PDSCH, 0 if addressed to dci.rnti
   } dl_sched_grant_t;
 
   typedef struct {
@@ -68,6 +70,7 @@ public:
     uint32_t                current_tx_nb;
     uint8_t*                data;
     bool                    needs_pdcch;
+    uint16_t                sps_rnti; ///< SPS C-RNTI of the DCI and PUSCH, 0 if addressed to dci.rnti
     srslte_softbuffer_rx_t* softbuffer_rx;
   } ul_sched_grant_t;
 
@@ -145,6 +148,7 @@ public:
   virtual int  bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, sched_interface::ue_bearer_cfg_t* cfg) = 0;
   virtual int  bearer_ue_rem(uint16_t rnti, uint32_t lc_id)                                        = 0;
   virtual int  set_dl_ant_info(uint16_t rnti, asn1::rrc::phys_cfg_ded_s::ant_info_c_* dl_ant_info) = 0;
+  virtual int  set_sps_cfg(uint16_t rnti, const srslte::sps_cfg_t& sps_cfg)                        = 0;
   virtual void phy_config_enabled(uint16_t rnti, bool enabled)                                     = 0;
   virtual void
   write_mcch(asn1::rrc::sib_type2_s* sib2, asn1::rrc::sib_type13_r9_s* sib13, asn1::rrc::mcch_msg_s* mcch) = 0;
@@ -350,6 +354,7 @@ typedef struct {
 typedef struct {
   sched_interface::sched_args_t sched;
   int                           link_failure_nof_err;
+  bool                          pusch_softbuffer_pool;
 } mac_args_t;
 
 class stack_interface_s1ap_lte
@@ -473,6 +473,29 @@ struct rach_cfg_t {
   }
 };
 
+struct sps_cfg_t {
+  uint16_t sps_rnti;
+  bool     dl_enabled;
+  uint32_t dl_interval;    ///< semiPersistSchedIntervalDL, in subframes
+  uint32_t dl_nof_harq;    ///< numberOfConfSPS-Processes
+  uint32_t dl_n1_pucch_an; ///< first entry of n1PUCCH-AN-PersistentList, HARQ-ACK resource of the PDSCH without PDCCH
+  bool     ul_enabled;
+  uint32_t ul_interval;         ///< semiPersistSchedIntervalUL, in subframes
+  uint32_t ul_implicit_release; ///< empty UL transmissions after which the UL grant is released
+  sps_cfg_t() { reset(); }
+  void reset()
+  {
+    sps_rnti            = 0;
+    dl_enabled          = false;
+    dl_interval         = 0;
+    dl_nof_harq         = 0;
+    dl_n1_pucch_an      = 0;
+    ul_enabled          = false;
+    ul_interval         = 0;
+    ul_implicit_release = 0;
+  }
+};
+
 struct mac_cfg_t {
   // Default constructor with default values as in 36.331 9.2.2
   mac_cfg_t() { set_defaults(); }
@@ -481,6 +504,7 @@ struct mac_cfg_t {
   {
     rach_cfg.reset();
     sr_cfg.reset();
+    sps_cfg.reset();
     set_mac_main_cfg_default();
   }
 
@@ -497,6 +521,7 @@ struct mac_cfg_t {
   sr_cfg_t      sr_cfg;
   rach_cfg_t    rach_cfg;
   ul_harq_cfg_t harq_cfg;
+  sps_cfg_t     sps_cfg;
   int           time_alignment_timer = -1;
 };
 
@@ -20,6 +20,7 @@
  */
 
 #include "srslte/common/common.h"
+#include "srslte/interfaces/rrc_interface_types.h"
 #include "srslte/srslte.h"
 
 #ifndef SRSLTE_SCHED_INTERFACE_H
@@ -57,6 +58,10 @@ public:
     int pusch_max_mcs;
     int nof_ctrl_symbols;
     int max_aggr_level;
+    enum { METRIC_RR = 0, METRIC_EDF } metric;
+    uint32_t tti_lookahead;       ///< TTIs the decisions are computed ahead of the PHY (0 runs them in the PHY worker)
+    uint32_t nof_carrier_workers; ///< Threads running the SCell scheduling passes concurrently (0 runs them in series)
+                                  ///< Not exposed in the eNB config yet, the MAC only configures the PCell
   } sched_args_t;
 
   typedef struct {
@@ -95,10 +100,12 @@ public:
   } cell_cfg_t;
 
   typedef struct {
-    int priority;
-    int bsd;
-    int pbr;
-    int group;
+    int      priority;
+    int      bsd;
+    int      pbr;
+    int      group;
+    int      delay_budget_ms;        ///< Packet delay budget used by the EDF metric. 0 selects the default budget
+    uint32_t proactive_ul_period_ms; ///< Period of the UL grants given without waiting for SR/BSR. 0 disables them
     enum { IDLE = 0, UL, DL, BOTH } direction;
   } ue_bearer_cfg_t;
 
@@ -111,6 +118,9 @@ public:
     uint32_t                aperiodic_cqi_period; // if 0 is periodic CQI
     srslte_dl_cfg_t         dl_cfg;
     ue_bearer_cfg_t         ue_bearers[MAX_LC];
+    uint32_t                nof_supported_cc;                       ///< 0 configures the PCell (eNB carrier 0) only
+    uint32_t                supported_cc_idxs[SRSLTE_MAX_CARRIERS]; ///< eNB carrier of each UE cell index, PCell first
+    srslte::sps_cfg_t       sps_cfg;
   };
 
   typedef struct {
@@ -134,6 +144,8 @@ public:
   } dl_pdu_mch_t;
 
   typedef struct {
+    bool            needs_pdcch; ///< false for the transmissions in a configured SPS grant
+    uint16_t        sps_rnti;    ///< SPS C-RNTI the DCI and PDSCH are addressed to, 0 if addressed to the C-RNTI
     srslte_dci_dl_t dci;
     uint32_t        tbs[SRSLTE_MAX_TB];
     bool            mac_ce_ta;
@@ -144,6 +156,7 @@ public:
 
   typedef struct {
     bool            needs_pdcch;
+    uint16_t        sps_rnti; ///< SPS C-RNTI the DCI and PUSCH are addressed to, 0 if addressed to the C-RNTI
     uint32_t        current_tx_nb;
     uint32_t        tbs;
     srslte_dci_ul_t dci;
@@ -220,6 +233,13 @@ public:
   virtual uint32_t get_ul_buffer(uint16_t rnti) = 0;
   virtual uint32_t get_dl_buffer(uint16_t rnti) = 0;
 
+  /* PRBs of the proactive UL grants since the last call, split into the ones the UE sent UL data in and the unused */
+  virtual void get_ul_proactive_prb(uint16_t rnti, uint32_t* used_prb, uint32_t* wasted_prb) = 0;
+
+  /* Returns false once the UL HARQ process of the PUSCH received in tti is done, including a TB discarded after the
+   * maximum number of retransmissions */
+  virtual bool ul_harq_active(uint32_t tti, uint16_t rnti, uint32_t cc_idx) = 0;
+
   /******************* Scheduling Interface ***********************/
   /* DL buffer status report */
   virtual int dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t retx_queue) = 0;
@@ -234,6 +254,7 @@ public:
 
   /* UL information */
   virtual int ul_crc_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, bool crc)                          = 0;
+  virtual int ul_sdu_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_sdus)                 = 0;
   virtual int ul_sr_info(uint32_t tti, uint16_t rnti)                                                      = 0;
   virtual int ul_bsr(uint16_t rnti, uint32_t lcid, uint32_t bsr, bool set_value = true)                    = 0;
   virtual int ul_recv_len(uint16_t rnti, uint32_t lcid, uint32_t len)                                      = 0;
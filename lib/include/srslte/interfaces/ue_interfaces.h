@@ -343,6 +343,7 @@ public:
     mac_tb_t tb;
     uint32_t pid;
     uint16_t rnti;
+    bool     is_sps_release;
     bool     phich_available;
     bool     hi_value;
     uint32_t tti_tx;
@@ -385,6 +386,10 @@ public:
   /* Indicate successful decoding of PDSCH AND PCH TB. */
   virtual void tb_decoded(uint32_t cc_idx, mac_grant_dl_t grant, bool ack[SRSLTE_MAX_CODEWORDS]) = 0;
 
+  /* Obtain the configured SPS assignment/grant if one occurs in this TTI, received without PDCCH */
+  virtual bool get_dl_sps_grant(uint32_t tti, mac_grant_dl_t* grant)    = 0;
+  virtual bool get_ul_sps_grant(uint32_t tti_tx, mac_grant_ul_t* grant) = 0;
+
   /* Indicate successful decoding of BCH TB through PBCH */
   virtual void bch_decoded_ok(uint8_t* payload, uint32_t len) = 0;
 
@@ -475,10 +480,11 @@ typedef struct {
   float dl_freq = -1.0f;
   float ul_freq = -1.0f;
 
-  bool  ul_pwr_ctrl_en  = false;
-  float prach_gain      = -1;
-  int   pdsch_max_its   = 8;
-  int   nof_phy_threads = 3;
+  bool     ul_pwr_ctrl_en  = false;
+  float    prach_gain      = -1;
+  int      pdsch_max_its   = 8;
+  int      nof_phy_threads = 3;
+  uint32_t harq_delay_ms   = 4;
 
   int worker_cpu_mask   = -1;
   int sync_cpu_affinity = -1;
@@ -496,6 +502,7 @@ typedef struct {
   bool          agc_enable                       = true;
   bool          cfo_is_doppler                   = false;
   bool          cfo_integer_enabled              = false;
+  bool          cfo_fused_ofdm                   = true;
   float         cfo_correct_tol_hz               = 1.0f;
   float         cfo_pss_ema                      = DEFAULT_CFO_EMA_TRACK;
   float         cfo_loop_bw_pss                  = DEFAULT_CFO_BW_PSS;
@@ -33,6 +33,12 @@ typedef enum SRSLTE_API {
   SRSLTE_CHEST_FILTER_NONE
 } srslte_chest_filter_t;
 
+/* Specialised smoothing (frequency averaging) kernel, equivalent to srslte_conv_same_cf() */
+typedef void (*srslte_chest_smooth_fn)(const cf_t* input, const float* filter, cf_t* output, uint32_t nof_ref);
+
+/* Specialised frequency interpolation kernel, equivalent to srslte_interp_linear_offset() */
+typedef void (*srslte_chest_interp_fn)(const cf_t* input, cf_t* output, uint32_t nof_ref, uint32_t off_st, uint32_t off_end);
+
 SRSLTE_API void srslte_chest_average_pilots(cf_t*    input,
                                             cf_t*    output,
                                             float*   filter,
@@ -48,4 +54,8 @@ SRSLTE_API uint32_t srslte_chest_set_triangle_filter(float* fil, int filter_len)
 
 SRSLTE_API uint32_t srslte_chest_set_smooth_filter_gauss(float* filter, uint32_t order, float std_dev);
 
+SRSLTE_API srslte_chest_smooth_fn srslte_chest_smooth_kernel(uint32_t nof_ref, uint32_t filter_len);
+
+SRSLTE_API srslte_chest_interp_fn srslte_chest_interp_kernel(uint32_t nof_ref, uint32_t M);
+
 #endif // SRSLTE_CHEST_COMMON_H
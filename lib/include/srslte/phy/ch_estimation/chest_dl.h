@@ -72,6 +72,8 @@ typedef enum SRSLTE_API {
   SRSLTE_NOISE_ALG_EMPTY,
 } srslte_chest_dl_noise_alg_t;
 
+#define SRSLTE_CHEST_DL_NOF_SMOOTH_FN 4 // Filter lengths 1, 3, 5 and 7
+
 typedef struct SRSLTE_API {
   srslte_cell_t cell;
   uint32_t      nof_rx_antennas;
@@ -95,6 +97,10 @@ typedef struct SRSLTE_API {
   srslte_interp_lin_t           srslte_interp_lin_3;
   srslte_interp_lin_t           srslte_interp_lin_mbsfn;
 
+  // Kernels specialised for the cell bandwidth, for one and two pilot symbols per reference, selected at set_cell
+  srslte_chest_smooth_fn smooth_fn[2][SRSLTE_CHEST_DL_NOF_SMOOTH_FN];
+  srslte_chest_interp_fn interp_fn[2];
+
   float rssi[SRSLTE_MAX_PORTS][SRSLTE_MAX_PORTS];
   float rsrp[SRSLTE_MAX_PORTS][SRSLTE_MAX_PORTS];
   float rsrp_corr[SRSLTE_MAX_PORTS][SRSLTE_MAX_PORTS];
@@ -72,8 +72,9 @@ typedef struct {
   float snr_vector[12000];
   float pilot_power[12000];
 #endif
-  uint32_t smooth_filter_len;
-  float    smooth_filter[SRSLTE_CHEST_MAX_SMOOTH_FIL_LEN];
+  uint32_t               smooth_filter_len;
+  float                  smooth_filter[SRSLTE_CHEST_MAX_SMOOTH_FIL_LEN];
+  srslte_chest_smooth_fn smooth_fn; // Kernel specialised for the filter length, NULL if not available
 
   srslte_interp_linsrslte_vec_t srslte_interp_linvec;
 
@@ -26,9 +26,13 @@
 #include "fading.h"
 #include "hst.h"
 #include "rlf.h"
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <srslte/common/log_filter.h>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace srslte {
 
@@ -40,8 +44,10 @@ public:
     bool enable = false;
 
     // Fading options
-    bool        fading_enable = false;
-    std::string fading_model  = "none";
+    bool        fading_enable      = false;
+    std::string fading_model       = "none";
+    uint32_t    fading_seed        = 0; // Added to the seed of every port, independent links need different values
+    uint32_t    fading_nof_threads = 1; // Ports are faded in parallel by up to this number of threads
 
     // High Speed Train options
     bool  hst_enable      = false;
@@ -69,6 +75,10 @@ public:
   void run(cf_t* in[SRSLTE_MAX_PORTS], cf_t* out[SRSLTE_MAX_PORTS], uint32_t len, const srslte_timestamp_t& t);
 
 private:
+  bool ports_alias(cf_t* in[SRSLTE_MAX_PORTS], cf_t* out[SRSLTE_MAX_PORTS]) const;
+  void run_fading(uint32_t id);
+  void fading_thread(uint32_t id);
+
   srslte_channel_fading_t* fading[SRSLTE_MAX_PORTS] = {};
   srslte_channel_delay_t*  delay[SRSLTE_MAX_PORTS]  = {};
   srslte_channel_hst_t*    hst                      = nullptr; // HST has no buffers / no multiple instance is required
@@ -79,6 +89,19 @@ private:
   uint32_t                 nof_ports                = 0;
   uint32_t                 current_srate            = 0;
   args_t                   args                     = {};
+
+  // Fading workers, the caller thread takes the first share of ports
+  std::vector<std::thread> fading_workers = {};
+  std::mutex               fading_mutex;
+  std::condition_variable  fading_cvar_start;
+  std::condition_variable  fading_cvar_done;
+  uint64_t                 fading_generation = 0;
+  uint32_t                 fading_pending    = 0;
+  bool                     fading_running    = true;
+  cf_t**                   fading_in         = nullptr;
+  cf_t**                   fading_out        = nullptr;
+  uint32_t                 fading_len        = 0;
+  double                   fading_time       = 0.0;
 };
 
 typedef std::unique_ptr<channel> channel_ptr;
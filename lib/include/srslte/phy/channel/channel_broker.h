@@ -0,0 +1,101 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLTE_CHANNEL_BROKER_H
+#define SRSLTE_CHANNEL_BROKER_H
+
+#include "channel.h"
+#include <condition_variable>
+#include <mutex>
+#include <srslte/phy/utils/random.h>
+#include <thread>
+#include <vector>
+
+namespace srslte {
+
+/*
+ * Connects several transmitters (e.g. the DL of the cells) to several receivers (e.g. the UEs). Every transmitter and
+ * receiver pair with a link goes through its own channel and gain, and every receiver gets the sum of its links plus
+ * AWGN. The sample timing is not altered, so the output can be sent with the input timestamps. Receivers are
+ * processed in parallel by a fixed set of worker threads.
+ */
+class channel_broker
+{
+public:
+  typedef struct {
+    uint32_t        tx           = 0;    // Transmitter index
+    uint32_t        rx           = 0;    // Receiver index
+    float           gain_dB      = 0.0f; // Path gain
+    channel::args_t channel_args = {};   // Fading, delay, HST and RLF of the link
+  } link_args_t;
+
+  typedef struct {
+    uint32_t                 nof_tx       = 1;
+    uint32_t                 nof_rx       = 1;
+    bool                     awgn_enable  = false;
+    float                    awgn_n0_dBfs = -30.0f; // Noise power at every receiver
+    uint32_t                 nof_workers  = 1;      // Less than 2 processes all the receivers in the caller thread
+    uint32_t                 seed         = 0;
+    std::vector<link_args_t> links;
+  } args_t;
+
+  explicit channel_broker(const args_t& channel_broker_args);
+  ~channel_broker();
+  void set_logger(log_filter* _log_h);
+  void set_srate(uint32_t srate);
+  void run(cf_t* in[], cf_t* out[], uint32_t len, const srslte_timestamp_t& t);
+
+private:
+  typedef struct {
+    uint32_t    tx   = 0;
+    float       gain = 1.0f;
+    channel_ptr ch   = nullptr;
+  } link_t;
+
+  typedef struct {
+    std::vector<link_t> links;
+    srslte_random_t     random = nullptr;
+    cf_t*               buffer = nullptr;
+  } receiver_t;
+
+  void run_receiver(uint32_t rx);
+  void worker_thread(uint32_t id);
+
+  args_t                   args      = {};
+  std::vector<receiver_t>  receivers = {};
+  std::vector<std::thread> workers   = {};
+
+  // Current run, shared with the workers
+  std::mutex              mutex;
+  std::condition_variable cvar_start;
+  std::condition_variable cvar_done;
+  uint64_t                generation = 0;
+  uint32_t                pending    = 0;
+  bool                    running    = true;
+  cf_t**                  run_in     = nullptr;
+  cf_t**                  run_out    = nullptr;
+  uint32_t                run_len    = 0;
+  srslte_timestamp_t      run_t      = {};
+};
+
+} // namespace srslte
+
+#endif // SRSLTE_CHANNEL_BROKER_H
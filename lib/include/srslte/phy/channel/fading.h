@@ -48,11 +48,12 @@ typedef struct {
   double   coeff_p[SRSLTE_CHANNEL_FADING_MAXTAPS]; // Initial phase, random
 
   // Utils
-  srslte_dft_plan_t fft;    // DFT to frequency domain
-  srslte_dft_plan_t ifft;   // DFT to time domain
-  cf_t*             temp;   // Temporal buffer, length fft_size
-  cf_t*             h_freq; // Channel frequency response, length fft_size
-  cf_t*             y_freq; // Intermediate frequency domain buffer
+  srslte_dft_plan_t fft;       // DFT to frequency domain
+  srslte_dft_plan_t ifft;      // DFT to time domain
+  cf_t*             temp;      // Temporal buffer, length fft_size
+  cf_t*             h_freq;    // Channel frequency response, length fft_size
+  cf_t*             y_freq;    // Intermediate frequency domain buffer
+  cf_t*             tap_table; // Unit frequency response of every tap, nof_taps x fft_size
 
   // State variables
   cf_t* state; // Length fft_size/2
@@ -37,6 +37,10 @@
 
 #include "srslte/config.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #define SRSLTE_NOF_SF_X_FRAME 10
 #define SRSLTE_NOF_SLOTS_PER_SF 2
 #define SRSLTE_NSLOTS_X_FRAME (SRSLTE_NOF_SLOTS_PER_SF * SRSLTE_NOF_SF_X_FRAME)
@@ -152,6 +156,8 @@ typedef enum { SRSLTE_SF_NORM = 0, SRSLTE_SF_MBSFN } srslte_sf_t;
        : (2 * SRSLTE_CP_LEN_EXT(symbol_sz) - SRSLTE_CP_LEN_NORM(0, symbol_sz) - SRSLTE_CP_LEN_NORM(1, symbol_sz)))
 
 #define SRSLTE_FDD_NOF_HARQ (TX_DELAY + FDD_HARQ_DELAY_MS)
+#define SRSLTE_FDD_HARQ_DELAY_MIN_MS 2
+#define SRSLTE_FDD_HARQ_DELAY_MAX_MS 4
 #define SRSLTE_MAX_HARQ_PROC 15
 
 #define SRSLTE_NOF_LTE_BANDS 58
@@ -411,6 +417,12 @@ SRSLTE_API int srslte_sampling_freq_hz(uint32_t nof_prb);
 
 SRSLTE_API void srslte_use_standard_symbol_size(bool enabled);
 
+SRSLTE_API int srslte_set_fdd_harq_delay(uint32_t delay_ms);
+
+SRSLTE_API uint32_t srslte_fdd_harq_delay();
+
+SRSLTE_API uint32_t srslte_fdd_nof_harq();
+
 SRSLTE_API uint32_t srslte_re_x_prb(uint32_t ns, uint32_t symbol, uint32_t nof_ports, uint32_t nof_symbols);
 
 SRSLTE_API uint32_t srslte_voffset(uint32_t symbol_id, uint32_t cell_id, uint32_t nof_ports);
@@ -466,4 +478,8 @@ SRSLTE_API char* srslte_nbiot_mode_string(srslte_nbiot_mode_t mode);
 
 bool srslte_psbch_is_symbol(srslte_sl_symbol_t type, srslte_sl_tm_t tm, uint32_t i);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif // SRSLTE_PHY_COMMON_H
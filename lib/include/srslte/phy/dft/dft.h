@@ -24,6 +24,7 @@
 
 #include "srslte/config.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 /**********************************************************************************************
  *  File:         dft.h
@@ -120,4 +121,15 @@ SRSLTE_API void srslte_dft_run_guru_c(srslte_dft_plan_t* plan);
 
 SRSLTE_API void srslte_dft_run_r(srslte_dft_plan_t* plan, const float* in, float* out);
 
+/* Plan cache (FFTW wisdom) management. The default wisdom file is $SRSLTE_FFTW_WISDOM or ~/.srslte_fftwisdom and it
+ * is loaded/saved automatically. Plans not found in the wisdom are estimated unless measuring is enabled. */
+
+SRSLTE_API int srslte_dft_wisdom_filename(char* full_path, uint32_t n);
+
+SRSLTE_API int srslte_dft_load_wisdom(const char* filename);
+
+SRSLTE_API int srslte_dft_save_wisdom(const char* filename);
+
+SRSLTE_API void srslte_dft_set_measure(bool measure);
+
 #endif // SRSLTE_DFT_H
@@ -62,6 +62,10 @@ typedef struct SRSLTE_API {
   bool  freq_shift;
   float freq_shift_f;
   cf_t* shift_buffer;
+
+  float    cfo;            // Rx CFO correction, normalised to the sampling rate
+  uint32_t window_prb;     // First PRB extracted in Rx
+  uint32_t window_nof_prb; // Number of PRB extracted in Rx, 0 for all
 } srslte_ofdm_t;
 
 SRSLTE_API int srslte_ofdm_init_(srslte_ofdm_t*   q,
@@ -121,4 +125,8 @@ SRSLTE_API void srslte_ofdm_set_normalize(srslte_ofdm_t* q, bool normalize_enabl
 
 SRSLTE_API void srslte_ofdm_set_non_mbsfn_region(srslte_ofdm_t* q, uint8_t non_mbsfn_region);
 
+SRSLTE_API void srslte_ofdm_set_cfo(srslte_ofdm_t* q, float cfo);
+
+SRSLTE_API void srslte_ofdm_rx_set_prb_window(srslte_ofdm_t* q, uint32_t first_prb, uint32_t nof_prb);
+
 #endif // SRSLTE_OFDM_H
@@ -86,4 +86,18 @@ SRSLTE_API int srslte_rm_turbo_rx_lut_(int16_t* input,
 SRSLTE_API int
 srslte_rm_turbo_rx_lut_8bit(int8_t* input, int8_t* output, uint32_t in_len, uint32_t cb_idx, uint32_t rv_idx);
 
+SRSLTE_API int srslte_rm_turbo_rx_lut_offset(int16_t* input,
+                                             int16_t* output,
+                                             uint32_t in_len,
+                                             uint32_t in_offset,
+                                             uint32_t cb_idx,
+                                             uint32_t rv_idx);
+
+SRSLTE_API int srslte_rm_turbo_rx_lut_8bit_offset(int8_t*  input,
+                                                  int8_t*  output,
+                                                  uint32_t in_len,
+                                                  uint32_t in_offset,
+                                                  uint32_t cb_idx,
+                                                  uint32_t rv_idx);
+
 #endif // SRSLTE_RM_TURBO_H
@@ -33,13 +33,28 @@
 
 #include "srslte/config.h"
 #include "srslte/phy/common/phy_common.h"
+#include <pthread.h>
 
+/* Pool of code block soft-buffers shared by the RX soft-buffers of many HARQ processes. Code blocks are taken when
+ * they are first decoded and given back as soon as their CRC passes, so memory follows the actual transport blocks
+ * in flight instead of the largest possible one per HARQ process. */
 typedef struct SRSLTE_API {
-  uint32_t  max_cb;
-  int16_t** buffer_f;
-  uint8_t** data;
-  bool*     cb_crc;
-  bool      tb_crc;
+  uint32_t        nof_cb;   // Number of code block buffers in the pool
+  uint32_t        cb_size;  // Size in bytes of each code block buffer
+  bool            is_8bit;  // Soft bits are stored as 8-bit saturated LLRs
+  uint8_t*        mem;
+  void**          free_cb;  // Stack of free code block buffers
+  uint32_t        nof_free;
+  pthread_mutex_t mutex;
+} srslte_softbuffer_rx_pool_t;
+
+typedef struct SRSLTE_API {
+  uint32_t                     max_cb;
+  int16_t**                    buffer_f;
+  uint8_t**                    data;
+  bool*                        cb_crc;
+  bool                         tb_crc;
+  srslte_softbuffer_rx_pool_t* pool; // NULL if the code block buffers are owned by the soft-buffer
 } srslte_softbuffer_rx_t;
 
 typedef struct SRSLTE_API {
@@ -49,8 +64,21 @@ typedef struct SRSLTE_API {
 
 #define SOFTBUFFER_SIZE 18600
 
+SRSLTE_API int srslte_softbuffer_rx_pool_init(srslte_softbuffer_rx_pool_t* pool, uint32_t nof_cb, bool is_8bit);
+
+SRSLTE_API void srslte_softbuffer_rx_pool_free(srslte_softbuffer_rx_pool_t* pool);
+
+SRSLTE_API uint32_t srslte_softbuffer_rx_pool_nof_free(srslte_softbuffer_rx_pool_t* pool);
+
 SRSLTE_API int srslte_softbuffer_rx_init(srslte_softbuffer_rx_t* q, uint32_t nof_prb);
 
+SRSLTE_API int
+srslte_softbuffer_rx_init_pool(srslte_softbuffer_rx_t* q, uint32_t nof_prb, srslte_softbuffer_rx_pool_t* pool);
+
+SRSLTE_API int srslte_softbuffer_rx_alloc_cb(srslte_softbuffer_rx_t* q, uint32_t cb_idx);
+
+SRSLTE_API void srslte_softbuffer_rx_release_cb(srslte_softbuffer_rx_t* q, uint32_t cb_idx);
+
 SRSLTE_API void srslte_softbuffer_rx_reset(srslte_softbuffer_rx_t* p);
 
 SRSLTE_API void srslte_softbuffer_rx_reset_tbs(srslte_softbuffer_rx_t* q, uint32_t tbs);
@@ -47,6 +47,8 @@
 
 typedef enum SRSLTE_API { SEARCH_UE, SEARCH_COMMON } srslte_pdcch_search_mode_t;
 
+#define SRSLTE_PDCCH_MAX_DECODED 64 // Maximum number of decoded candidates kept per subframe
+
 /* PDCCH object */
 typedef struct SRSLTE_API {
   srslte_cell_t cell;
@@ -66,6 +68,11 @@ typedef struct SRSLTE_API {
   uint8_t* e;
   float    rm_f[3 * (SRSLTE_DCI_MAX_BITS + 16)];
   float*   llr;
+  float*   cce_llr_mean; // Mean LLR magnitude of each CCE, used as candidate reliability metric
+
+  /* Candidates decoded in the current subframe, a location is not decoded twice for the same DCI size */
+  srslte_dci_msg_t decoded[SRSLTE_PDCCH_MAX_DECODED];
+  uint32_t         nof_decoded;
 
   /* tx & rx objects */
   srslte_modem_table_t mod;
@@ -101,6 +108,8 @@ SRSLTE_API int srslte_pdcch_extract_llr(srslte_pdcch_t*        q,
                                         cf_t*                  sf_symbols[SRSLTE_MAX_PORTS]);
 
 /* Decoding functions: Try to decode a DCI message after calling srslte_pdcch_extract_llr */
+SRSLTE_API float srslte_pdcch_location_metric(srslte_pdcch_t* q, srslte_dl_sf_cfg_t* sf, srslte_dci_location_t* location);
+
 SRSLTE_API int
 srslte_pdcch_decode_msg(srslte_pdcch_t* q, srslte_dl_sf_cfg_t* sf, srslte_dci_cfg_t* dci_cfg, srslte_dci_msg_t* msg);
 
@@ -60,6 +60,8 @@ typedef struct SRSLTE_API {
   bool     is_ue;
 
   bool llr_is_8bit;
+  bool fused_rx;   /* Demodulate, descramble and rate dematch in a single pass, without storing the codeword LLRs */
+  bool output_llr; /* Store the descrambled codeword LLRs in e[] for inspection. Disables the fused Rx */
 
   /* buffers */
   // void buffers are shared for tx and rx
@@ -78,6 +78,8 @@ typedef struct SRSLTE_API {
   cf_t*  prach_bins;
   cf_t*  corr_spec;
   float* corr;
+  cf_t*  corr_spec_roots; // Correlation spectrum of every root, N_roots x N_zc
+  float* corr_roots;      // Correlation power of every root combined across antennas, N_roots x N_zc
 
   // PRACH IFFT
   srslte_dft_plan_t fft;
@@ -86,6 +88,7 @@ typedef struct SRSLTE_API {
   // ZC-sequence FFT and IFFT
   srslte_dft_plan_t zc_fft;
   srslte_dft_plan_t zc_ifft;
+  srslte_dft_plan_t zc_ifft_roots; // Batched ZC IFFT, one transform per root
 
   cf_t* signal_fft;
   float detect_factor;
@@ -194,6 +197,18 @@ SRSLTE_API int srslte_prach_detect_offset(srslte_prach_t* p,
                                           float*          peak_to_avg,
                                           uint32_t*       ind_len);
 
+/* Detects the preambles in the signals of several receive antennas. The correlations of all the roots are computed in
+ * one batched transform per antenna and combined non-coherently across the antennas */
+SRSLTE_API int srslte_prach_detect_offset_multi(srslte_prach_t* p,
+                                                uint32_t        freq_offset,
+                                                cf_t*           signal[SRSLTE_MAX_PORTS],
+                                                uint32_t        nof_rx_ant,
+                                                uint32_t        sig_len,
+                                                uint32_t*       indices,
+                                                float*          t_offsets,
+                                                float*          peak_to_avg,
+                                                uint32_t*       ind_len);
+
 SRSLTE_API void srslte_prach_set_detect_factor(srslte_prach_t* p, float factor);
 
 SRSLTE_API int srslte_prach_free(srslte_prach_t* p);
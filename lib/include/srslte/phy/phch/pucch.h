@@ -44,11 +44,28 @@
 #define SRSLTE_PUCCH3_NOF_BITS (4 * SRSLTE_NRE)
 #define SRSLTE_PUCCH_MAX_BITS SRSLTE_CQI_MAX_BITS
 #define SRSLTE_PUCCH_MAX_SYMBOLS 128
+#define SRSLTE_PUCCH_USER_NOF_REF 2
 
+/* Reference signal (unit modulation symbols) of a Format 1/1a/1b or 2/2a/2b resource. The entry is valid for the
+ * subframe it was generated for and as long as the resource parameters do not change. */
 typedef struct {
-  srslte_sequence_t seq_f2[SRSLTE_NOF_SF_X_FRAME];
-  uint32_t          cell_id;
-  bool              sequence_generated;
+  bool                  valid;
+  srslte_pucch_format_t format;
+  uint32_t              n_pucch;
+  uint32_t              N_cs;
+  uint32_t              delta_pucch_shift;
+  uint32_t              n_rb_2;
+  bool                  group_hopping_en;
+  bool                  shortened;
+  cf_t                  z[SRSLTE_PUCCH_MAX_SYMBOLS];
+} srslte_pucch_user_ref_t;
+
+typedef struct {
+  srslte_sequence_t       seq_f2[SRSLTE_NOF_SF_X_FRAME];
+  srslte_pucch_user_ref_t ref[SRSLTE_NOF_SF_X_FRAME][SRSLTE_PUCCH_USER_NOF_REF]; // e.g. SR and HARQ-ACK resources
+  uint32_t                ref_next[SRSLTE_NOF_SF_X_FRAME];                     // Entry replaced in the next miss
+  uint32_t                cell_id;
+  bool                    sequence_generated;
 } srslte_pucch_user_t;
 
 /* PUCCH object */
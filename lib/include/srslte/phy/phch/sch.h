@@ -32,6 +32,7 @@
 
 #include "srslte/config.h"
 #include "srslte/phy/common/phy_common.h"
+#include "srslte/phy/common/sequence.h"
 #include "srslte/phy/fec/crc.h"
 #include "srslte/phy/fec/rm_turbo.h"
 #include "srslte/phy/fec/turbocoder.h"
@@ -48,6 +49,10 @@
 #define SRSLTE_TX_NULL 100
 #endif
 
+/* Number of LLRs generated per step by the fused receive path. It is a multiple of Qm*Nl for every modulation and
+ * number of layers, so tiles never split a symbol, and is small enough to stay in L1 cache */
+#define SRSLTE_SCH_LLR_TILE_LEN 1536
+
 /* DL-SCH AND UL-SCH common functions */
 typedef struct SRSLTE_API {
 
@@ -61,6 +66,7 @@ typedef struct SRSLTE_API {
   uint8_t*         parity_bits;
   void*            e;
   uint8_t*         temp_g_bits;
+  void*            llr_tile;
   uint32_t*        ul_interleaver;
   srslte_uci_bit_t ack_ri_bits[57600]; // 4*M_sc*Qm_max for RI and ACK
 
@@ -99,6 +105,14 @@ SRSLTE_API int srslte_dlsch_decode2(srslte_sch_t*       q,
                                     int                 codeword_idx,
                                     uint32_t            nof_layers);
 
+SRSLTE_API int srslte_dlsch_decode_fused(srslte_sch_t*       q,
+                                         srslte_pdsch_cfg_t* cfg,
+                                         const cf_t*         symbols,
+                                         srslte_sequence_t*  seq,
+                                         uint8_t*            data,
+                                         int                 codeword_idx,
+                                         uint32_t            nof_layers);
+
 SRSLTE_API int srslte_ulsch_encode(srslte_sch_t*       q,
                                    srslte_pusch_cfg_t* cfg,
                                    uint8_t*            data,
@@ -113,6 +113,7 @@ typedef struct SRSLTE_API {
   srslte_pdsch_cfg_t      pdsch;
   srslte_dci_cfg_t        dci;
   srslte_tm_t             tm;
+  uint16_t                sps_rnti; ///< SPS C-RNTI searched along the C-RNTI, 0 if not configured
 } srslte_dl_cfg_t;
 
 typedef struct SRSLTE_API {
@@ -166,6 +167,8 @@ SRSLTE_API int srslte_ue_dl_set_mbsfn_area_id(srslte_ue_dl_t* q, uint16_t mbsfn_
 
 SRSLTE_API void srslte_ue_dl_set_non_mbsfn_region(srslte_ue_dl_t* q, uint8_t non_mbsfn_region_length);
 
+SRSLTE_API void srslte_ue_dl_set_cfo(srslte_ue_dl_t* q, float cfo);
+
 SRSLTE_API void srslte_ue_dl_set_mi_manual(srslte_ue_dl_t* q, uint32_t mi_idx);
 
 SRSLTE_API void srslte_ue_dl_set_mi_auto(srslte_ue_dl_t* q);
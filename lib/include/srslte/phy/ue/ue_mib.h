@@ -53,6 +53,9 @@
 
 #define SRSLTE_UE_MIB_NOF_PRB              6
 
+// PRB demodulated at each side of the PBCH, so that the channel estimate smoothing only uses extracted pilots
+#define SRSLTE_UE_MIB_WINDOW_MARGIN_PRB    2
+
 #define SRSLTE_UE_MIB_FOUND                1
 #define SRSLTE_UE_MIB_NOTFOUND             0
 
@@ -128,6 +128,8 @@ typedef struct SRSLTE_API {
   float cfo_pss_min;
   float cfo_ref_min;
   float cfo_ref_max;
+  bool  cfo_correct_defer;
+  float cfo_deferred;
 
   uint32_t pss_stable_cnt;
   uint32_t pss_stable_timeout;
@@ -241,6 +243,10 @@ SRSLTE_API uint32_t srslte_ue_sync_get_sfidx(srslte_ue_sync_t *q);
 
 SRSLTE_API float srslte_ue_sync_get_cfo(srslte_ue_sync_t *q);
 
+SRSLTE_API void srslte_ue_sync_set_cfo_defer(srslte_ue_sync_t* q, bool enable);
+
+SRSLTE_API float srslte_ue_sync_get_cfo_deferred(srslte_ue_sync_t* q);
+
 SRSLTE_API float srslte_ue_sync_get_sfo(srslte_ue_sync_t *q);
 
 SRSLTE_API int srslte_ue_sync_get_last_sample_offset(srslte_ue_sync_t *q); 
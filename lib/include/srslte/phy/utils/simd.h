@@ -856,8 +856,8 @@ static inline simd_cf_t srslte_simd_cf_prod(simd_cf_t a, simd_cf_t b)
 {
   simd_cf_t ret;
 #ifdef LV_HAVE_AVX512
-  ret.re = _mm512_sub_ps(_mm512_mul_ps(a.re, b.re), _mm512_mul_ps(a.im, b.im));
-  ret.im = _mm512_add_ps(_mm512_mul_ps(a.re, b.im), _mm512_mul_ps(a.im, b.re));
+  ret.re = _mm512_fmsub_ps(a.re, b.re, _mm512_mul_ps(a.im, b.im));
+  ret.im = _mm512_fmadd_ps(a.re, b.im, _mm512_mul_ps(a.im, b.re));
 #else /* LV_HAVE_AVX512 */
 #ifdef LV_HAVE_AVX2
 #ifdef LV_HAVE_FMA
@@ -886,12 +886,17 @@ static inline simd_cf_t srslte_simd_cf_conjprod(simd_cf_t a, simd_cf_t b)
 {
   simd_cf_t ret;
 #ifdef LV_HAVE_AVX512
-  ret.re = _mm512_add_ps(_mm512_mul_ps(a.re, b.re), _mm512_mul_ps(a.im, b.im));
-  ret.im = _mm512_sub_ps(_mm512_mul_ps(a.im, b.re), _mm512_mul_ps(a.re, b.im));
+  ret.re = _mm512_fmadd_ps(a.re, b.re, _mm512_mul_ps(a.im, b.im));
+  ret.im = _mm512_fmsub_ps(a.im, b.re, _mm512_mul_ps(a.re, b.im));
 #else /* LV_HAVE_AVX512 */
 #ifdef LV_HAVE_AVX2
+#ifdef LV_HAVE_FMA
+  ret.re            = _mm256_fmadd_ps(a.re, b.re, _mm256_mul_ps(a.im, b.im));
+  ret.im            = _mm256_fmsub_ps(a.im, b.re, _mm256_mul_ps(a.re, b.im));
+#else  /* LV_HAVE_FMA */
   ret.re            = _mm256_add_ps(_mm256_mul_ps(a.re, b.re), _mm256_mul_ps(a.im, b.im));
   ret.im            = _mm256_sub_ps(_mm256_mul_ps(a.im, b.re), _mm256_mul_ps(a.re, b.im));
+#endif /* LV_HAVE_FMA */
 #else /* LV_HAVE_AVX2 */
 #ifdef LV_HAVE_SSE
   ret.re            = _mm_add_ps(_mm_mul_ps(a.re, b.re), _mm_mul_ps(a.im, b.im));
@@ -119,6 +119,12 @@ SRSLTE_API void srslte_vec_sc_prod_fff(const float* x, const float h, float* z,
 SRSLTE_API void srslte_vec_convert_fi(const float* x, const float scale, int16_t* z, const uint32_t len);
 SRSLTE_API void srslte_vec_convert_if(const int16_t* x, const float scale, float* z, const uint32_t len);
 SRSLTE_API void srslte_vec_convert_fb(const float* x, const float scale, int8_t* z, const uint32_t len);
+SRSLTE_API void srslte_vec_convert_bf(const int8_t* x, const float scale, float* z, const uint32_t len);
+SRSLTE_API void srslte_vec_convert_sb(const int16_t* x, const float scale, int8_t* z, const uint32_t len);
+
+/* pack pairs of int16 (saturated to 12 bit) in 3 bytes and unpack them, len is the number of int16 and must be even */
+SRSLTE_API void srslte_vec_pack_s12(const int16_t* x, uint8_t* z, const uint32_t len);
+SRSLTE_API void srslte_vec_unpack_s12(const uint8_t* x, int16_t* z, const uint32_t len);
 
 SRSLTE_API void srslte_vec_lut_sss(const short* x, const unsigned short* lut, short* y, const uint32_t len);
 SRSLTE_API void srslte_vec_lut_bbb(const int8_t* x, const unsigned short* lut, int8_t* y, const uint32_t len);
@@ -138,6 +138,14 @@ SRSLTE_API void srslte_vec_convert_fi_simd(const float* x, int16_t* z, const flo
 
 SRSLTE_API void srslte_vec_convert_fb_simd(const float* x, int8_t* z, const float scale, const int len);
 
+SRSLTE_API void srslte_vec_convert_bf_simd(const int8_t* x, float* z, const float scale, const int len);
+
+SRSLTE_API void srslte_vec_convert_sb_simd(const int16_t* x, int8_t* z, const float scale, const int len);
+
+SRSLTE_API void srslte_vec_pack_s12_simd(const int16_t* x, uint8_t* z, const int len);
+
+SRSLTE_API void srslte_vec_unpack_s12_simd(const uint8_t* x, int16_t* z, const int len);
+
 SRSLTE_API void srslte_vec_cp_simd(const cf_t* src, cf_t* dst, int len);
 
 SRSLTE_API void srslte_vec_interleave_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len);
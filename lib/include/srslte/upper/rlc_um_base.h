@@ -74,7 +74,7 @@ protected:
     rlc_um_base_tx(rlc_um_base* parent_);
     virtual ~rlc_um_base_tx();
     virtual bool     configure(rlc_config_t cfg, std::string rb_name) = 0;
-    int              build_data_pdu(uint8_t* payload, uint32_t nof_bytes);
+    int              read_pdu(uint8_t* payload, uint32_t nof_bytes);
     void             stop();
     void             reestablish();
     void             empty_queue();
@@ -99,7 +99,8 @@ protected:
     // Mutexes
     std::mutex mutex;
 
-    virtual int build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes) = 0;
+    // Writes the next PDU to the MAC payload, which has room for nof_bytes
+    virtual int build_data_pdu(uint8_t* payload, uint32_t nof_bytes) = 0;
 
     // helper functions
     virtual void debug_state() = 0;
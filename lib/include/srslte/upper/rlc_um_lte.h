@@ -32,6 +32,7 @@
 #include <mutex>
 #include <pthread.h>
 #include <queue>
+#include <vector>
 
 namespace srslte {
 
@@ -59,10 +60,13 @@ private:
     rlc_um_lte_tx(rlc_um_base* parent_);
 
     bool     configure(rlc_config_t cfg, std::string rb_name);
-    int      build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes);
+    int      build_data_pdu(uint8_t* payload, uint32_t nof_bytes);
     uint32_t get_buffer_state();
 
   private:
+    // SDUs and number of their bytes that go in the PDU being built. Kept to reuse its capacity
+    std::vector<std::pair<unique_byte_buffer_t, uint32_t> > pdu_segments;
+
     /****************************************************************************
      * State variables and counters
      * Ref: 3GPP TS 36.322 v10.0.0 Section 7
@@ -125,6 +129,7 @@ void rlc_um_read_data_pdu_header(uint8_t*              payload,
                                  rlc_umd_sn_size_t     sn_size,
                                  rlc_umd_pdu_header_t* header);
 void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu);
+void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, uint8_t** payload);
 
 uint32_t rlc_um_packed_length(rlc_umd_pdu_header_t* header);
 bool     rlc_um_start_aligned(uint8_t fi);
@@ -59,6 +59,7 @@ private:
     rlc_um_nr_tx(rlc_um_base* parent_);
 
     bool     configure(rlc_config_t cfg, std::string rb_name);
+    int      build_data_pdu(uint8_t* payload, uint32_t nof_bytes);
     int      build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes);
     uint32_t get_buffer_state();
 
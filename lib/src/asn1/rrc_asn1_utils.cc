@@ -317,6 +317,33 @@ void set_mac_cfg_t_time_alignment(mac_cfg_t* cfg, const asn1::rrc::time_align_ti
   cfg->time_alignment_timer = asn1_type.to_number();
 }
 
+sps_cfg_t make_sps_cfg_t(const asn1::rrc::sps_cfg_s& asn1_type)
+{
+  sps_cfg_t cfg;
+  if (asn1_type.semi_persist_sched_c_rnti_present) {
+    cfg.sps_rnti = (uint16_t)asn1_type.semi_persist_sched_c_rnti.to_number();
+  }
+  if (asn1_type.sps_cfg_dl_present and asn1_type.sps_cfg_dl.type() == asn1::rrc::setup_e::setup) {
+    cfg.dl_enabled  = true;
+    cfg.dl_interval = asn1_type.sps_cfg_dl.setup().semi_persist_sched_interv_dl.to_number();
+    cfg.dl_nof_harq = asn1_type.sps_cfg_dl.setup().nof_conf_sps_processes;
+    if (asn1_type.sps_cfg_dl.setup().n1_pucch_an_persistent_list.size() > 0) {
+      cfg.dl_n1_pucch_an = asn1_type.sps_cfg_dl.setup().n1_pucch_an_persistent_list[0];
+    }
+  }
+  if (asn1_type.sps_cfg_ul_present and asn1_type.sps_cfg_ul.type() == asn1::rrc::setup_e::setup) {
+    cfg.ul_enabled          = true;
+    cfg.ul_interval         = asn1_type.sps_cfg_ul.setup().semi_persist_sched_interv_ul.to_number();
+    cfg.ul_implicit_release = asn1_type.sps_cfg_ul.setup().implicit_release_after.to_number();
+  }
+  // Without SPS C-RNTI, SPS can not be activated
+  if (cfg.sps_rnti == 0) {
+    cfg.dl_enabled = false;
+    cfg.ul_enabled = false;
+  }
+  return cfg;
+}
+
 void set_phy_cfg_t_dedicated_cfg(phy_cfg_t* cfg, const asn1::rrc::phys_cfg_ded_s& asn1_type)
 {
   if (asn1_type.pucch_cfg_ded_present) {
@@ -539,6 +566,20 @@ void set_phy_cfg_t_enable_64qam(phy_cfg_t* cfg, const bool enabled)
   cfg->ul_cfg.pusch.enable_64qam = enabled;
 }
 
+// The PHY searches the SPS C-RNTI and acknowledges the configured assignments in n1PUCCH-AN-Persistent
+void set_phy_cfg_t_sps_cfg(phy_cfg_t* cfg, const asn1::rrc::sps_cfg_s& asn1_type)
+{
+  sps_cfg_t sps_cfg = make_sps_cfg_t(asn1_type);
+
+  cfg->dl_cfg.sps_rnti = (sps_cfg.dl_enabled or sps_cfg.ul_enabled) ? sps_cfg.sps_rnti : 0;
+  if (sps_cfg.dl_enabled) {
+    const asn1::rrc::n1_pucch_an_persistent_list_l& n1_list = asn1_type.sps_cfg_dl.setup().n1_pucch_an_persistent_list;
+    for (uint32_t i = 0; i < n1_list.size() and i < 4; i++) {
+      cfg->ul_cfg.pucch.n_pucch_1[i] = n1_list[i];
+    }
+  }
+}
+
 void set_phy_cfg_t_common_pusch(phy_cfg_t* cfg, const asn1::rrc::pusch_cfg_common_s& asn1_type)
 {
   /* PUSCH DMRS signal configuration */
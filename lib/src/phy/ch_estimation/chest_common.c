@@ -98,3 +98,184 @@ void srslte_chest_average_pilots(cf_t*    input,
     srslte_conv_same_cf(&input[l * nof_ref], filter, &output[l * nof_ref], nof_ref, filter_len);
   }
 }
+
+/* Smoothing kernel body. It is always inlined with constant filter length (and, if possible, constant number of
+ * references) so the compiler generates fixed-length fully vectorised loops for each specialisation.
+ */
+static inline __attribute__((always_inline)) void
+chest_smooth_body(const cf_t* input, const float* filter, cf_t* output, const uint32_t N, const uint32_t M)
+{
+  const uint32_t H = M / 2;
+  cf_t           first[M + H];
+  cf_t           last[M + H];
+
+  // Same extrapolation of the extremes as srslte_conv_same_cf()
+  for (uint32_t i = 0; i < M + H; i++) {
+    first[i] = (i < H) ? (2 + H - i) * input[1] - (1 + H - i) * input[0] : input[i - H];
+    last[i]  = (i >= M - 1) ? (2 + i - H) * input[N - 1] - (1 + i - H) * input[N - 2] : input[N - M + i + 1];
+  }
+
+  for (uint32_t i = 0; i < H; i++) {
+    cf_t acc = 0;
+    for (uint32_t k = 0; k < M; k++) {
+      acc += first[i + k] * filter[k];
+    }
+    output[i] = acc;
+  }
+
+  // Real and imaginary parts are filtered as interleaved real sequences
+  const float* x = (const float*)input;
+  float*       y = (float*)output;
+  for (uint32_t j = 2 * H; j < 2 * (N - H); j++) {
+    float acc = 0;
+    for (uint32_t k = 0; k < M; k++) {
+      acc += filter[k] * x[j + 2 * k - 2 * H];
+    }
+    y[j] = acc;
+  }
+
+  for (uint32_t i = 0; i < H; i++) {
+    cf_t acc = 0;
+    for (uint32_t k = 0; k < M; k++) {
+      acc += last[i + k] * filter[k];
+    }
+    output[N - H + i] = acc;
+  }
+}
+
+/* Interpolation kernel body, single pass version of srslte_interp_linear_offset() for constant M and, if possible,
+ * constant number of references N.
+ */
+static inline __attribute__((always_inline)) void
+chest_interp_body(const cf_t* input, cf_t* output, uint32_t off_st, uint32_t off_end, const uint32_t N, const uint32_t M)
+{
+  for (uint32_t j = 0; j < off_st; j++) {
+    output[off_st - j - 1] = input[0] - (j + 1) * (input[1] - input[0]) / M;
+  }
+
+  output += off_st;
+  for (uint32_t i = 0; i < N - 1; i++) {
+    cf_t diff = (input[i + 1] - input[i]) / M;
+    for (uint32_t j = 0; j < M; j++) {
+      output[i * M + j] = input[i] + j * diff;
+    }
+  }
+
+  if (N > 1) {
+    cf_t diff = input[N - 1] - input[N - 2];
+    for (uint32_t j = 0; j < off_end; j++) {
+      output[(N - 1) * M + j] = input[N - 1] + j * diff / M;
+    }
+  }
+}
+
+#define CHEST_SMOOTH_KERNEL(N, M)                                                                                      \
+  static void chest_smooth_##N##_##M(const cf_t* input, const float* filter, cf_t* output, uint32_t nof_ref)           \
+  {                                                                                                                    \
+    chest_smooth_body(input, filter, output, N, M);                                                                    \
+  }
+
+#define CHEST_SMOOTH_KERNEL_ANY(M)                                                                                     \
+  static void chest_smooth_any_##M(const cf_t* input, const float* filter, cf_t* output, uint32_t nof_ref)             \
+  {                                                                                                                    \
+    chest_smooth_body(input, filter, output, nof_ref, M);                                                              \
+  }
+
+#define CHEST_INTERP_KERNEL(N, M)                                                                                      \
+  static void chest_interp_##N##_##M(                                                                                  \
+      const cf_t* input, cf_t* output, uint32_t nof_ref, uint32_t off_st, uint32_t off_end)                            \
+  {                                                                                                                    \
+    chest_interp_body(input, output, off_st, off_end, N, M);                                                           \
+  }
+
+#define CHEST_INTERP_KERNEL_ANY(M)                                                                                     \
+  static void chest_interp_any_##M(                                                                                    \
+      const cf_t* input, cf_t* output, uint32_t nof_ref, uint32_t off_st, uint32_t off_end)                            \
+  {                                                                                                                    \
+    chest_interp_body(input, output, off_st, off_end, nof_ref, M);                                                     \
+  }
+
+/* Number of references in the standard bandwidths (6, 15, 25, 50, 75 and 100 PRB) for 2 (one OFDM symbol) and 4 (time
+ * averaged) CRS per PRB */
+#define CHEST_FOREACH_NOF_REF(F, M)                                                                                    \
+  F(12, M) F(30, M) F(50, M) F(100, M) F(150, M) F(200, M) F(24, M) F(60, M) F(300, M) F(400, M)
+
+CHEST_FOREACH_NOF_REF(CHEST_SMOOTH_KERNEL, 3)
+CHEST_FOREACH_NOF_REF(CHEST_SMOOTH_KERNEL, 5)
+CHEST_SMOOTH_KERNEL_ANY(3)
+CHEST_SMOOTH_KERNEL_ANY(5)
+CHEST_SMOOTH_KERNEL_ANY(7)
+
+CHEST_FOREACH_NOF_REF(CHEST_INTERP_KERNEL, 3)
+CHEST_FOREACH_NOF_REF(CHEST_INTERP_KERNEL, 6)
+CHEST_INTERP_KERNEL_ANY(2)
+CHEST_INTERP_KERNEL_ANY(3)
+CHEST_INTERP_KERNEL_ANY(6)
+
+#define CHEST_KERNEL_ENTRY(N, M) {N, M, chest_smooth_##N##_##M},
+#define CHEST_INTERP_ENTRY(N, M) {N, M, chest_interp_##N##_##M},
+
+// clang-format off
+static const struct {
+  uint32_t               nof_ref; // 0 for any number of references
+  uint32_t               filter_len;
+  srslte_chest_smooth_fn fn;
+} smooth_kernels[] = {
+    CHEST_FOREACH_NOF_REF(CHEST_KERNEL_ENTRY, 3)
+    CHEST_FOREACH_NOF_REF(CHEST_KERNEL_ENTRY, 5)
+    {0, 3, chest_smooth_any_3},
+    {0, 5, chest_smooth_any_5},
+    {0, 7, chest_smooth_any_7},
+};
+
+static const struct {
+  uint32_t               nof_ref; // 0 for any number of references
+  uint32_t               M;
+  srslte_chest_interp_fn fn;
+} interp_kernels[] = {
+    CHEST_FOREACH_NOF_REF(CHEST_INTERP_ENTRY, 3)
+    CHEST_FOREACH_NOF_REF(CHEST_INTERP_ENTRY, 6)
+    {0, 2, chest_interp_any_2},
+    {0, 3, chest_interp_any_3},
+    {0, 6, chest_interp_any_6},
+};
+// clang-format on
+
+/* Selects the smoothing kernel for nof_ref references and the given filter length. The kernel specialised for the
+ * number of references is preferred, then the one specialised for the filter length only. Returns NULL if there is no
+ * specialised kernel, srslte_conv_same_cf() shall be used instead.
+ */
+srslte_chest_smooth_fn srslte_chest_smooth_kernel(uint32_t nof_ref, uint32_t filter_len)
+{
+  srslte_chest_smooth_fn fn = NULL;
+  for (uint32_t i = 0; i < sizeof(smooth_kernels) / sizeof(smooth_kernels[0]) && !fn; i++) {
+    if (smooth_kernels[i].filter_len == filter_len && smooth_kernels[i].nof_ref == nof_ref) {
+      fn = smooth_kernels[i].fn;
+    }
+  }
+  for (uint32_t i = 0; i < sizeof(smooth_kernels) / sizeof(smooth_kernels[0]) && !fn; i++) {
+    if (smooth_kernels[i].filter_len == filter_len && smooth_kernels[i].nof_ref == 0) {
+      fn = smooth_kernels[i].fn;
+    }
+  }
+  return (nof_ref == 0 || nof_ref >= filter_len) ? fn : NULL;
+}
+
+/* Selects the interpolation kernel for nof_ref references spaced M subcarriers. Returns NULL if there is no specialised
+ * kernel, srslte_interp_linear_offset() shall be used instead.
+ */
+srslte_chest_interp_fn srslte_chest_interp_kernel(uint32_t nof_ref, uint32_t M)
+{
+  srslte_chest_interp_fn fn = NULL;
+  for (uint32_t i = 0; i < sizeof(interp_kernels) / sizeof(interp_kernels[0]) && !fn; i++) {
+    if (interp_kernels[i].M == M && interp_kernels[i].nof_ref == nof_ref) {
+      fn = interp_kernels[i].fn;
+    }
+  }
+  for (uint32_t i = 0; i < sizeof(interp_kernels) / sizeof(interp_kernels[0]) && !fn; i++) {
+    if (interp_kernels[i].M == M && interp_kernels[i].nof_ref == 0) {
+      fn = interp_kernels[i].fn;
+    }
+  }
+  return fn;
+}
@@ -291,6 +291,15 @@ int srslte_chest_dl_set_cell(srslte_chest_dl_t* q, srslte_cell_t cell)
         fprintf(stderr, "Error initializing interpolator\n");
         return SRSLTE_ERROR;
       }
+
+      // Select the kernels for 2 references per PRB (one symbol) and 4 references per PRB (averaged in time)
+      for (uint32_t i = 0; i < 2; i++) {
+        uint32_t nref = 2 * (i + 1) * q->cell.nof_prb;
+        for (uint32_t j = 0; j < SRSLTE_CHEST_DL_NOF_SMOOTH_FN; j++) {
+          q->smooth_fn[i][j] = srslte_chest_smooth_kernel(nref, 2 * j + 1);
+        }
+        q->interp_fn[i] = srslte_chest_interp_kernel(nref, SRSLTE_NRE / (2 * (i + 1)));
+      }
     }
     ret = SRSLTE_SUCCESS;
   }
@@ -452,16 +461,21 @@ static void interpolate_pilots(srslte_chest_dl_t*     q,
     } else {
       if (!cfg->interpolate_subframe && nsymbols > 1) {
         fidx_offset = q->cell.id % 3;
-        srslte_interp_linear_offset(
-            &q->srslte_interp_lin_3, pilot_estimates, ce, fidx_offset, SRSLTE_NRE / 4 - fidx_offset);
+        if (q->interp_fn[1]) {
+          q->interp_fn[1](pilot_estimates, ce, 4 * q->cell.nof_prb, fidx_offset, SRSLTE_NRE / 4 - fidx_offset);
+        } else {
+          srslte_interp_linear_offset(
+              &q->srslte_interp_lin_3, pilot_estimates, ce, fidx_offset, SRSLTE_NRE / 4 - fidx_offset);
+        }
       } else {
-        fidx_offset = srslte_refsignal_cs_fidx(q->cell, l, port_id, 0);
-        srslte_interp_linear_offset(
-            &q->srslte_interp_lin,
-            &pilot_estimates[2 * q->cell.nof_prb * l],
-            &ce[srslte_refsignal_cs_nsymbol(l, q->cell.cp, port_id) * q->cell.nof_prb * SRSLTE_NRE],
-            fidx_offset,
-            SRSLTE_NRE / 2 - fidx_offset);
+        fidx_offset  = srslte_refsignal_cs_fidx(q->cell, l, port_id, 0);
+        cf_t* input  = &pilot_estimates[2 * q->cell.nof_prb * l];
+        cf_t* output = &ce[srslte_refsignal_cs_nsymbol(l, q->cell.cp, port_id) * q->cell.nof_prb * SRSLTE_NRE];
+        if (q->interp_fn[0]) {
+          q->interp_fn[0](input, output, 2 * q->cell.nof_prb, fidx_offset, SRSLTE_NRE / 2 - fidx_offset);
+        } else {
+          srslte_interp_linear_offset(&q->srslte_interp_lin, input, output, fidx_offset, SRSLTE_NRE / 2 - fidx_offset);
+        }
       }
     }
   }
@@ -552,9 +566,19 @@ static void average_pilots(srslte_chest_dl_t*     q,
     memcpy(&output[0], &input[0], skip * sizeof(cf_t));
   }
 
+  // Use the kernel specialised for the bandwidth and filter length if available
+  srslte_chest_smooth_fn smooth_fn = NULL;
+  if (sf->sf_type != SRSLTE_SF_MBSFN && filter_len % 2 && filter_len / 2 < SRSLTE_CHEST_DL_NOF_SMOOTH_FN) {
+    smooth_fn = q->smooth_fn[nref == 4 * q->cell.nof_prb ? 1 : 0][filter_len / 2];
+  }
+
   // Average in the frequency domain
   for (int l = 0; l < nsymbols; l++) {
-    srslte_conv_same_cf(&input[l * nref + skip], filter, &output[l * nref + skip], nref, filter_len);
+    if (smooth_fn) {
+      smooth_fn(&input[l * nref + skip], filter, &output[l * nref + skip], nref);
+    } else {
+      srslte_conv_same_cf(&input[l * nref + skip], filter, &output[l * nref + skip], nref, filter_len);
+    }
   }
 }
 
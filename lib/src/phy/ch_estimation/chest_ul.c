@@ -96,6 +96,7 @@ int srslte_chest_ul_init(srslte_chest_ul_t* q, uint32_t max_prb)
 
     q->smooth_filter_len = 3;
     srslte_chest_set_smooth_filter3_coeff(q->smooth_filter, 0.3333);
+    q->smooth_fn = srslte_chest_smooth_kernel(0, q->smooth_filter_len);
 
     q->dmrs_signal_configured = false;
 
@@ -264,13 +265,12 @@ static void interpolate_pilots(srslte_chest_ul_t* q, cf_t* ce, uint32_t nrefs, u
 static void average_pilots(srslte_chest_ul_t* q, cf_t* input, cf_t* ce, uint32_t nrefs, uint32_t n_prb[2])
 {
   for (int i = 0; i < 2; i++) {
-    srslte_chest_average_pilots(
-        &input[i * nrefs],
-        &ce[SRSLTE_REFSIGNAL_UL_L(i, q->cell.cp) * q->cell.nof_prb * SRSLTE_NRE + n_prb[i] * SRSLTE_NRE],
-        q->smooth_filter,
-        nrefs,
-        1,
-        q->smooth_filter_len);
+    cf_t* output = &ce[SRSLTE_REFSIGNAL_UL_L(i, q->cell.cp) * q->cell.nof_prb * SRSLTE_NRE + n_prb[i] * SRSLTE_NRE];
+    if (q->smooth_fn && nrefs >= q->smooth_filter_len) {
+      q->smooth_fn(&input[i * nrefs], q->smooth_filter, output, nrefs);
+    } else {
+      srslte_chest_average_pilots(&input[i * nrefs], output, q->smooth_filter, nrefs, 1, q->smooth_filter_len);
+    }
   }
 }
 
@@ -408,12 +408,19 @@ int srslte_chest_ul_estimate_pucch(srslte_chest_ul_t*     q,
                              SRSLTE_NRE);
 
       // Average in freq domain
-      srslte_chest_average_pilots(&q->pilot_estimates[ns * n_rs * SRSLTE_NRE],
-                                  &q->pilot_recv_signal[ns * n_rs * SRSLTE_NRE],
-                                  q->smooth_filter,
-                                  SRSLTE_NRE,
-                                  1,
-                                  q->smooth_filter_len);
+      if (q->smooth_fn) {
+        q->smooth_fn(&q->pilot_estimates[ns * n_rs * SRSLTE_NRE],
+                     q->smooth_filter,
+                     &q->pilot_recv_signal[ns * n_rs * SRSLTE_NRE],
+                     SRSLTE_NRE);
+      } else {
+        srslte_chest_average_pilots(&q->pilot_estimates[ns * n_rs * SRSLTE_NRE],
+                                    &q->pilot_recv_signal[ns * n_rs * SRSLTE_NRE],
+                                    q->smooth_filter,
+                                    SRSLTE_NRE,
+                                    1,
+                                    q->smooth_filter_len);
+      }
 
       // Determine n_prb
       uint32_t n_prb = srslte_pucch_n_prb(&q->cell, cfg, ns);
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <unistd.h>
+
+#include "srslte/phy/ch_estimation/chest_common.h"
+#include "srslte/phy/resampling/interp.h"
+#include "srslte/phy/utils/convolution.h"
+#include "srslte/phy/utils/debug.h"
+#include "srslte/phy/utils/random.h"
+#include "srslte/phy/utils/vector.h"
+
+#define MAX_NOF_REF 400
+#define MAX_ERROR 1e-4f
+
+static const uint32_t nof_ref_list[] = {12, 30, 50, 100, 150, 200, 24, 60, 300, 400, 36, 72, 600};
+
+void usage(char* prog)
+{
+  printf("Usage: %s [v]\n", prog);
+  printf("\t-v increase verbosity\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "v")) != -1) {
+    switch (opt) {
+      case 'v':
+        srslte_verbose++;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static float max_error(cf_t* a, cf_t* b, uint32_t len)
+{
+  float err = 0;
+  for (uint32_t i = 0; i < len; i++) {
+    err = SRSLTE_MAX(err, cabsf(a[i] - b[i]));
+  }
+  return err;
+}
+
+static int test_smooth(srslte_random_t random, cf_t* input, cf_t* gold, cf_t* output, uint32_t nof_ref, uint32_t len)
+{
+  float filter[SRSLTE_CHEST_MAX_SMOOTH_FIL_LEN];
+  float sum = 0;
+  for (uint32_t i = 0; i < len; i++) {
+    filter[i] = srslte_random_uniform_real_dist(random, 0.1f, 1.0f);
+    sum += filter[i];
+  }
+  srslte_vec_sc_prod_fff(filter, 1.0f / sum, filter, len);
+
+  srslte_chest_smooth_fn fn = srslte_chest_smooth_kernel(nof_ref, len);
+  if (!fn) {
+    INFO("No smoothing kernel for nof_ref=%d, len=%d\n", nof_ref, len);
+    return SRSLTE_SUCCESS;
+  }
+
+  srslte_random_uniform_complex_dist_vector(random, input, nof_ref, -1.0f, 1.0f);
+  srslte_conv_same_cf(input, filter, gold, nof_ref, len);
+  bzero(output, sizeof(cf_t) * nof_ref);
+  fn(input, filter, output, nof_ref);
+
+  float err = max_error(gold, output, nof_ref);
+  INFO("Smooth nof_ref=%3d, len=%d, error=%e\n", nof_ref, len, err);
+  if (err > MAX_ERROR) {
+    ERROR("Smoothing kernel nof_ref=%d, len=%d error %e exceeds %e\n", nof_ref, len, err, MAX_ERROR);
+    return SRSLTE_ERROR;
+  }
+  return SRSLTE_SUCCESS;
+}
+
+static int test_interp(srslte_random_t     random,
+                       srslte_interp_lin_t* interp,
+                       cf_t*               input,
+                       cf_t*               gold,
+                       cf_t*               output,
+                       uint32_t            nof_ref,
+                       uint32_t            M)
+{
+  srslte_chest_interp_fn fn = srslte_chest_interp_kernel(nof_ref, M);
+  if (!fn) {
+    INFO("No interpolation kernel for nof_ref=%d, M=%d\n", nof_ref, M);
+    return SRSLTE_SUCCESS;
+  }
+
+  if (srslte_interp_linear_resize(interp, nof_ref, M)) {
+    ERROR("Error resizing interpolator\n");
+    return SRSLTE_ERROR;
+  }
+
+  srslte_random_uniform_complex_dist_vector(random, input, nof_ref, -1.0f, 1.0f);
+
+  for (uint32_t off_st = 0; off_st < M; off_st++) {
+    uint32_t off_end = M - off_st;
+    uint32_t len     = nof_ref * M;
+    srslte_interp_linear_offset(interp, input, gold, off_st, off_end);
+    bzero(output, sizeof(cf_t) * len);
+    fn(input, output, nof_ref, off_st, off_end);
+
+    float err = max_error(gold, output, len);
+    INFO("Interp nof_ref=%3d, M=%d, off_st=%d, error=%e\n", nof_ref, M, off_st, err);
+    if (err > MAX_ERROR) {
+      ERROR("Interpolation kernel nof_ref=%d, M=%d, off_st=%d error %e exceeds %e\n", nof_ref, M, off_st, err, MAX_ERROR);
+      return SRSLTE_ERROR;
+    }
+  }
+  return SRSLTE_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int                 ret    = SRSLTE_ERROR;
+  srslte_random_t     random = srslte_random_init(0x1234);
+  srslte_interp_lin_t interp = {};
+
+  parse_args(argc, argv);
+
+  uint32_t max_len = 6 * 600;
+  cf_t*    input   = srslte_vec_cf_malloc(max_len);
+  cf_t*    gold    = srslte_vec_cf_malloc(max_len);
+  cf_t*    output  = srslte_vec_cf_malloc(max_len);
+  if (!input || !gold || !output) {
+    perror("malloc");
+    goto clean_exit;
+  }
+
+  if (srslte_interp_linear_init(&interp, 600, 6)) {
+    ERROR("Error initializing interpolator\n");
+    goto clean_exit;
+  }
+
+  for (uint32_t i = 0; i < sizeof(nof_ref_list) / sizeof(uint32_t); i++) {
+    for (uint32_t len = 3; len <= 7; len += 2) {
+      if (test_smooth(random, input, gold, output, nof_ref_list[i], len)) {
+        goto clean_exit;
+      }
+    }
+    for (uint32_t M = 2; M <= 6; M++) {
+      if (test_interp(random, &interp, input, gold, output, nof_ref_list[i], M)) {
+        goto clean_exit;
+      }
+    }
+  }
+
+  ret = SRSLTE_SUCCESS;
+
+clean_exit:
+  srslte_random_free(random);
+  srslte_interp_linear_free(&interp);
+  if (input) {
+    free(input);
+  }
+  if (gold) {
+    free(gold);
+  }
+  if (output) {
+    free(output);
+  }
+
+  printf("%s\n", ret ? "Failed" : "Ok");
+  return ret;
+}
@@ -47,7 +47,8 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_ports)
     if (channel_args.fading_enable && !channel_args.fading_model.empty() && channel_args.fading_model != "none" &&
         ret == SRSLTE_SUCCESS) {
       fading[i] = (srslte_channel_fading_t*)calloc(sizeof(srslte_channel_fading_t), 1);
-      ret       = srslte_channel_fading_init(fading[i], srate_max, channel_args.fading_model.c_str(), 0x1234 * i);
+      ret       = srslte_channel_fading_init(
+          fading[i], srate_max, channel_args.fading_model.c_str(), channel_args.fading_seed + 0x1234 * i);
     } else {
       fading[i] = nullptr;
     }
@@ -81,10 +82,28 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_ports)
   if (ret != SRSLTE_SUCCESS) {
     fprintf(stderr, "Error: Creating channel\n\n");
   }
+
+  // Start fading workers, the caller thread is one of them
+  if (fading[0] != nullptr) {
+    uint32_t nof_threads = SRSLTE_MIN(channel_args.fading_nof_threads, nof_ports);
+    for (uint32_t i = 1; i < nof_threads; i++) {
+      fading_workers.emplace_back(&channel::fading_thread, this, i);
+    }
+  }
 }
 
 channel::~channel()
 {
+  {
+    std::unique_lock<std::mutex> lock(fading_mutex);
+    fading_running = false;
+    fading_cvar_start.notify_all();
+  }
+
+  for (std::thread& w : fading_workers) {
+    w.join();
+  }
+
   if (buffer_in) {
     free(buffer_in);
   }
@@ -121,18 +140,92 @@ void channel::set_logger(log_filter* _log_h)
   log_h = _log_h;
 }
 
+void channel::run_fading(uint32_t id)
+{
+  // Every port has its own fading state, so the ports can be processed in any thread
+  for (uint32_t i = id; i < nof_ports; i += (uint32_t)fading_workers.size() + 1) {
+    if (fading[i] && fading_in[i] != nullptr && fading_out[i] != nullptr) {
+      srslte_channel_fading_execute(fading[i], fading_in[i], fading_out[i], fading_len, fading_time);
+    }
+  }
+}
+
+void channel::fading_thread(uint32_t id)
+{
+  uint64_t                     last_generation = 0;
+  std::unique_lock<std::mutex> lock(fading_mutex);
+
+  while (fading_running) {
+    // Wait for a new run
+    while (fading_running && fading_generation == last_generation) {
+      fading_cvar_start.wait(lock);
+    }
+    if (!fading_running) {
+      break;
+    }
+    last_generation = fading_generation;
+
+    lock.unlock();
+    run_fading(id);
+    lock.lock();
+
+    fading_pending--;
+    if (fading_pending == 0) {
+      fading_cvar_done.notify_one();
+    }
+  }
+}
+
+bool channel::ports_alias(cf_t* in[SRSLTE_MAX_PORTS], cf_t* out[SRSLTE_MAX_PORTS]) const
+{
+  for (uint32_t i = 0; i < nof_ports; i++) {
+    for (uint32_t j = i + 1; j < nof_ports && in[i] != nullptr && out[i] != nullptr; j++) {
+      if (in[j] == nullptr || out[j] == nullptr) {
+        continue;
+      }
+      if (in[i] == in[j] || in[i] == out[j] || out[i] == in[j] || out[i] == out[j]) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 void channel::run(cf_t* in[SRSLTE_MAX_PORTS], cf_t* out[SRSLTE_MAX_PORTS], uint32_t len, const srslte_timestamp_t& t)
 {
   // check input pointers
   if (in != nullptr && out != nullptr) {
     if (current_srate) {
+      // Ports sharing buffers (e.g. the same zeros for all of them) are processed one after the other
+      bool parallel_fading = fading[0] != nullptr && !fading_workers.empty() && !ports_alias(in, out);
+
+      // Fading goes first, in place in the output buffers so the ports can be processed in parallel
+      if (parallel_fading) {
+        std::unique_lock<std::mutex> lock(fading_mutex);
+        fading_in      = in;
+        fading_out     = out;
+        fading_len     = len;
+        fading_time    = t.full_secs + t.frac_secs;
+        fading_pending = (uint32_t)fading_workers.size();
+        fading_generation++;
+        fading_cvar_start.notify_all();
+
+        lock.unlock();
+        run_fading(0);
+        lock.lock();
+
+        while (fading_pending > 0) {
+          fading_cvar_done.wait(lock);
+        }
+      }
+
       for (uint32_t i = 0; i < nof_ports; i++) {
         // Check buffers are not null
         if (in[i] != nullptr && out[i] != nullptr) {
           // Copy input buffer
-          memcpy(buffer_in, in[i], sizeof(cf_t) * len);
+          memcpy(buffer_in, (fading[i] && parallel_fading) ? out[i] : in[i], sizeof(cf_t) * len);
 
-          if (fading[i]) {
+          if (fading[i] && !parallel_fading) {
             srslte_channel_fading_execute(fading[i], buffer_in, buffer_out, len, t.full_secs + t.frac_secs);
             memcpy(buffer_in, buffer_out, sizeof(cf_t) * len);
           }
@@ -192,7 +285,7 @@ void channel::set_srate(uint32_t srate)
       if (fading[i]) {
         srslte_channel_fading_free(fading[i]);
 
-        srslte_channel_fading_init(fading[i], srate, args.fading_model.c_str(), 0x1234 * i);
+        srslte_channel_fading_init(fading[i], srate, args.fading_model.c_str(), args.fading_seed + 0x1234 * i);
       }
 
       if (delay[i]) {
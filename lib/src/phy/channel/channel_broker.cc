@@ -0,0 +1,194 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <srslte/phy/channel/channel_broker.h>
+#include <srslte/srslte.h>
+
+using namespace srslte;
+
+channel_broker::channel_broker(const channel_broker::args_t& channel_broker_args)
+{
+  uint32_t buffer_size = (uint32_t)SRSLTE_SF_LEN_PRB(SRSLTE_MAX_PRB) * 5; // Same as the channel
+
+  // Copy args
+  args = channel_broker_args;
+
+  // Create receivers and their links
+  receivers.resize(args.nof_rx);
+  for (uint32_t i = 0; i < args.nof_rx; i++) {
+    receivers[i].random = srslte_random_init(args.seed + i);
+    receivers[i].buffer = (cf_t*)srslte_vec_malloc(sizeof(cf_t) * buffer_size);
+    if (!receivers[i].buffer) {
+      fprintf(stderr, "Error: Creating channel broker\n\n");
+    }
+  }
+
+  for (const link_args_t& l : args.links) {
+    if (l.tx >= args.nof_tx || l.rx >= args.nof_rx) {
+      fprintf(stderr, "Error: Invalid channel broker link %d-%d, ignoring\n", l.tx, l.rx);
+      continue;
+    }
+
+    link_t link = {};
+    link.tx     = l.tx;
+    link.gain   = srslte_convert_dB_to_amplitude(l.gain_dB);
+    link.ch     = channel_ptr(new channel(l.channel_args, 1));
+    receivers[l.rx].links.push_back(std::move(link));
+  }
+
+  // Start workers, each of them takes every nof_workers-th receiver
+  if (args.nof_workers > 1) {
+    for (uint32_t i = 0; i < args.nof_workers; i++) {
+      workers.emplace_back(&channel_broker::worker_thread, this, i);
+    }
+  }
+}
+
+channel_broker::~channel_broker()
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    running = false;
+    cvar_start.notify_all();
+  }
+
+  for (std::thread& w : workers) {
+    w.join();
+  }
+
+  for (receiver_t& r : receivers) {
+    if (r.buffer) {
+      free(r.buffer);
+    }
+    if (r.random) {
+      srslte_random_free(r.random);
+    }
+  }
+}
+
+void channel_broker::set_logger(log_filter* _log_h)
+{
+  for (receiver_t& r : receivers) {
+    for (link_t& link : r.links) {
+      link.ch->set_logger(_log_h);
+    }
+  }
+}
+
+void channel_broker::set_srate(uint32_t srate)
+{
+  for (receiver_t& r : receivers) {
+    for (link_t& link : r.links) {
+      link.ch->set_srate(srate);
+    }
+  }
+}
+
+void channel_broker::run_receiver(uint32_t rx)
+{
+  receiver_t& r   = receivers[rx];
+  cf_t*       out = run_out[rx];
+
+  if (out == nullptr) {
+    return;
+  }
+
+  bzero(out, sizeof(cf_t) * run_len);
+
+  for (link_t& link : r.links) {
+    cf_t* ch_in[SRSLTE_MAX_PORTS]  = {run_in[link.tx]};
+    cf_t* ch_out[SRSLTE_MAX_PORTS] = {r.buffer};
+
+    if (ch_in[0] == nullptr) {
+      continue;
+    }
+
+    link.ch->run(ch_in, ch_out, run_len, run_t);
+    srslte_vec_sc_prod_cfc(r.buffer, link.gain, r.buffer, run_len);
+    srslte_vec_sum_ccc(out, r.buffer, out, run_len);
+  }
+
+  if (args.awgn_enable) {
+    float std_dev = sqrtf(srslte_convert_dB_to_power(args.awgn_n0_dBfs) / 2.0f);
+    for (uint32_t i = 0; i < run_len; i++) {
+      cf_t noise;
+      __real__ noise = srslte_random_gauss_dist(r.random, std_dev);
+      __imag__ noise = srslte_random_gauss_dist(r.random, std_dev);
+      out[i] += noise;
+    }
+  }
+}
+
+void channel_broker::worker_thread(uint32_t id)
+{
+  uint64_t                     last_generation = 0;
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while (running) {
+    // Wait for a new run
+    while (running && generation == last_generation) {
+      cvar_start.wait(lock);
+    }
+    if (!running) {
+      break;
+    }
+    last_generation = generation;
+
+    lock.unlock();
+    for (uint32_t rx = id; rx < args.nof_rx; rx += args.nof_workers) {
+      run_receiver(rx);
+    }
+    lock.lock();
+
+    pending--;
+    if (pending == 0) {
+      cvar_done.notify_one();
+    }
+  }
+}
+
+void channel_broker::run(cf_t* in[], cf_t* out[], uint32_t len, const srslte_timestamp_t& t)
+{
+  if (in == nullptr || out == nullptr) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  run_in  = in;
+  run_out = out;
+  run_len = len;
+  run_t   = t;
+
+  if (workers.empty()) {
+    for (uint32_t rx = 0; rx < args.nof_rx; rx++) {
+      run_receiver(rx);
+    }
+    return;
+  }
+
+  pending = (uint32_t)workers.size();
+  generation++;
+  cvar_start.notify_all();
+
+  while (pending > 0) {
+    cvar_done.wait(lock);
+  }
+}
@@ -21,6 +21,7 @@
 
 #include "srslte/phy/channel/fading.h"
 #include "srslte/phy/utils/random.h"
+#include "srslte/phy/utils/simd.h"
 #include "srslte/phy/utils/vector.h"
 
 #include <complex.h>
@@ -87,14 +88,30 @@ static inline float get_doppler_dispersion(double t, double a, double w, double
   return (float)(a * sin(w * t + p));
 }
 
-static inline void
-generate_tap(float delay_ns, float power_db, float srate, float phase, cf_t* buf, uint32_t N, uint32_t path_delay)
+static inline void generate_tap(float delay_ns, float srate, cf_t* buf, uint32_t N, uint32_t path_delay)
 {
-  float amplitude = srslte_convert_dB_to_power(power_db);
-  float O         = (delay_ns * 1e-9f * srate + path_delay) / (float)N;
-  cf_t  a0        = amplitude * cexpf(-_Complex_I * phase) / N;
+  float O = (delay_ns * 1e-9f * srate + path_delay) / (float)N;
 
-  srslte_vec_gen_sine(a0, -O, buf, N);
+  srslte_vec_gen_sine(1.0f, -O, buf, N);
+}
+
+// h += a * tap, with the same operations as scaling the tap sine and adding it, so the response is bit exact
+static inline void accumulate_tap(const cf_t* tap, cf_t a, cf_t* h, uint32_t N)
+{
+  uint32_t i = 0;
+
+#if SRSLTE_SIMD_CF_SIZE
+  simd_cf_t _a = srslte_simd_cf_set1(a);
+  for (; i + SRSLTE_SIMD_CF_SIZE <= N; i += SRSLTE_SIMD_CF_SIZE) {
+    simd_cf_t r = srslte_simd_cf_prod(_a, srslte_simd_cfi_load(&tap[i]));
+    srslte_simd_cfi_store(&h[i], srslte_simd_cf_add(srslte_simd_cfi_load(&h[i]), r));
+  }
+#endif /* SRSLTE_SIMD_CF_SIZE */
+
+  for (; i < N; i++) {
+    cf_t r = a * tap[i];
+    h[i] += r;
+  }
 }
 
 static inline void generate_taps(srslte_channel_fading_t* q, double time)
@@ -102,22 +119,15 @@ static inline void generate_taps(srslte_channel_fading_t* q, double time)
   // Initialise freq response
   bzero(q->h_freq, sizeof(cf_t) * q->N);
 
-  // Generate taps
+  // The tap sines are tabulated, only their amplitude and doppler phase are applied every segment
   for (int i = 0; i < nof_taps[q->model]; i++) {
-    // Compute phase for thee doppler dispersion
-    float phase = get_doppler_dispersion(time, q->coeff_a[i], q->coeff_w[i], q->coeff_p[i]);
-
-    // Generate tab
-    generate_tap(excess_tap_delay_ns[q->model][i],
-                 relative_power_db[q->model][i],
-                 q->srate,
-                 phase,
-                 q->temp,
-                 q->N,
-                 q->path_delay);
+    // Compute phase for the doppler dispersion
+    float phase     = get_doppler_dispersion(time, q->coeff_a[i], q->coeff_w[i], q->coeff_p[i]);
+    float amplitude = srslte_convert_dB_to_power(relative_power_db[q->model][i]);
+    cf_t  a0        = amplitude * cexpf(-_Complex_I * phase) / q->N;
 
     // Add to frequency response
-    srslte_vec_sum_ccc(q->h_freq, q->temp, q->h_freq, q->N);
+    accumulate_tap(&q->tap_table[i * q->N], a0, q->h_freq, q->N);
   }
 
   // at this stage, q->h_freq should contain the frequency response
@@ -219,6 +229,17 @@ int srslte_channel_fading_init(srslte_channel_fading_t* q, double srate, const c
       goto clean_exit;
     }
     bzero(q->state, sizeof(cf_t) * q->N);
+
+    // Tabulate the frequency response of every tap, it only depends on the model, srate and FFT size
+    q->tap_table = srslte_vec_malloc(sizeof(cf_t) * q->N * nof_taps[q->model]);
+    if (!q->tap_table) {
+      fprintf(stderr, "Error: allocating tap_table\n");
+      goto clean_exit;
+    }
+
+    for (int i = 0; i < nof_taps[q->model]; i++) {
+      generate_tap(excess_tap_delay_ns[q->model][i], q->srate, &q->tap_table[i * q->N], q->N, q->path_delay);
+    }
   }
 
   ret = SRSLTE_SUCCESS;
@@ -248,6 +269,10 @@ void srslte_channel_fading_free(srslte_channel_fading_t* q)
     if (q->state) {
       free(q->state);
     }
+
+    if (q->tap_table) {
+      free(q->tap_table);
+    }
   }
 }
 
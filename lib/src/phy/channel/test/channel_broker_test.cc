@@ -0,0 +1,220 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <srslte/phy/channel/channel_broker.h>
+#include <srslte/phy/utils/debug.h>
+#include <srslte/phy/utils/vector.h>
+#include <unistd.h>
+
+static uint32_t srate_hz    = 1920000;
+static uint32_t nof_workers = 2;
+static uint32_t nof_sf      = 100;
+
+#define NOF_TX 2
+#define NOF_RX 3
+#define MAX_ERROR (1e-5f)
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [swn]\n", prog);
+  printf("\t-s Sampling rate in Hz: [Default %d]\n", srate_hz);
+  printf("\t-w Number of worker threads: [Default %d]\n", nof_workers);
+  printf("\t-n Number of subframes: [Default %d]\n", nof_sf);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "swn")) != -1) {
+    switch (opt) {
+      case 's':
+        srate_hz = (uint32_t)strtof(argv[optind], NULL);
+        break;
+      case 'w':
+        nof_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_sf = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static srslte::channel_broker::args_t make_args(uint32_t workers, bool fading, bool awgn)
+{
+  srslte::channel_broker::args_t args = {};
+  args.nof_tx                         = NOF_TX;
+  args.nof_rx                         = NOF_RX;
+  args.nof_workers                    = workers;
+  args.awgn_enable                    = awgn;
+  args.awgn_n0_dBfs                   = -20.0f;
+
+  // Receiver 0 gets both transmitters, receiver 1 only the second and receiver 2 nothing
+  srslte::channel_broker::link_args_t link = {};
+  link.channel_args.enable                 = fading;
+  link.channel_args.fading_enable          = fading;
+  link.channel_args.fading_model           = "epa5";
+
+  link.tx                       = 0;
+  link.rx                       = 0;
+  link.gain_dB                  = 0.0f;
+  link.channel_args.fading_seed = 1;
+  args.links.push_back(link);
+
+  link.tx                       = 1;
+  link.rx                       = 0;
+  link.gain_dB                  = -6.0f;
+  link.channel_args.fading_seed = 2;
+  args.links.push_back(link);
+
+  link.tx                       = 1;
+  link.rx                       = 1;
+  link.gain_dB                  = 0.0f;
+  link.channel_args.fading_seed = 3;
+  args.links.push_back(link);
+
+  return args;
+}
+
+// Runs nof_sf subframes through the broker and stores the output
+static void run_broker(const srslte::channel_broker::args_t& args, cf_t* in[NOF_TX], cf_t* out[NOF_RX], uint32_t sf_len)
+{
+  srslte::channel_broker broker(args);
+  broker.set_srate(srate_hz);
+
+  srslte_timestamp_t t = {};
+  for (uint32_t sf = 0; sf < nof_sf; sf++) {
+    cf_t* sf_in[NOF_TX];
+    cf_t* sf_out[NOF_RX];
+    for (uint32_t i = 0; i < NOF_TX; i++) {
+      sf_in[i] = &in[i][sf * sf_len];
+    }
+    for (uint32_t i = 0; i < NOF_RX; i++) {
+      sf_out[i] = &out[i][sf * sf_len];
+    }
+    broker.run(sf_in, sf_out, sf_len, t);
+    srslte_timestamp_add(&t, 0, 1e-3);
+  }
+}
+
+static float max_error(const cf_t* a, const cf_t* b, uint32_t len)
+{
+  float err = 0.0f;
+  for (uint32_t i = 0; i < len; i++) {
+    cf_t d = a[i] - b[i];
+    err    = SRSLTE_MAX(err, sqrtf(__real__ d * __real__ d + __imag__ d * __imag__ d));
+  }
+  return err;
+}
+
+int main(int argc, char** argv)
+{
+  int             ret          = SRSLTE_ERROR;
+  uint32_t        sf_len       = 0;
+  uint32_t        len          = 0;
+  cf_t*           in[NOF_TX]   = {};
+  cf_t*           out[NOF_RX]  = {};
+  cf_t*           gold[NOF_RX] = {};
+  srslte_random_t random       = srslte_random_init(0x1234);
+  struct timeval  t[3]         = {};
+
+  parse_args(argc, argv);
+  sf_len = srate_hz / 1000;
+  len    = sf_len * nof_sf;
+
+  for (uint32_t i = 0; i < NOF_TX; i++) {
+    in[i] = (cf_t*)srslte_vec_malloc(sizeof(cf_t) * len);
+    if (!in[i]) {
+      goto clean_exit;
+    }
+    srslte_random_uniform_complex_dist_vector(random, in[i], len, -1.0f, 1.0f);
+  }
+  for (uint32_t i = 0; i < NOF_RX; i++) {
+    out[i]  = (cf_t*)srslte_vec_malloc(sizeof(cf_t) * len);
+    gold[i] = (cf_t*)srslte_vec_malloc(sizeof(cf_t) * len);
+    if (!out[i] || !gold[i]) {
+      goto clean_exit;
+    }
+  }
+
+  // Without fading the receivers get the scaled sum of their links
+  run_broker(make_args(nof_workers, false, false), in, out, sf_len);
+  for (uint32_t i = 0; i < len; i++) {
+    gold[0][i] = in[0][i] + srslte_convert_dB_to_amplitude(-6.0f) * in[1][i];
+    gold[1][i] = in[1][i];
+    gold[2][i] = 0.0f;
+  }
+  for (uint32_t i = 0; i < NOF_RX; i++) {
+    if (max_error(out[i], gold[i], len) > MAX_ERROR) {
+      ERROR("Receiver %d does not match the sum of its links\n", i);
+      goto clean_exit;
+    }
+  }
+
+  // With fading, the parallel broker must give the same result as the serial one
+  run_broker(make_args(1, true, false), in, gold, sf_len);
+  gettimeofday(&t[1], NULL);
+  run_broker(make_args(nof_workers, true, false), in, out, sf_len);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  for (uint32_t i = 0; i < NOF_RX; i++) {
+    if (max_error(out[i], gold[i], len) > MAX_ERROR) {
+      ERROR("Receiver %d differs between serial and parallel execution\n", i);
+      goto clean_exit;
+    }
+  }
+  printf("%d subframes with %d workers in %.1f ms\n", nof_sf, nof_workers, t[0].tv_sec * 1e3 + t[0].tv_usec * 1e-3);
+
+  // Receiver without links only gets noise
+  run_broker(make_args(nof_workers, false, true), in, out, sf_len);
+  {
+    float n0_dBfs = srslte_convert_power_to_dB(srslte_vec_avg_power_cf(out[2], len));
+    printf("Noise power %.2f dBfs\n", n0_dBfs);
+    if (fabsf(n0_dBfs + 20.0f) > 0.5f) {
+      ERROR("Wrong noise power %.2f dBfs\n", n0_dBfs);
+      goto clean_exit;
+    }
+  }
+
+  ret = SRSLTE_SUCCESS;
+
+clean_exit:
+  for (uint32_t i = 0; i < NOF_TX; i++) {
+    if (in[i]) {
+      free(in[i]);
+    }
+  }
+  for (uint32_t i = 0; i < NOF_RX; i++) {
+    if (out[i]) {
+      free(out[i]);
+    }
+    if (gold[i]) {
+      free(gold[i]);
+    }
+  }
+  srslte_random_free(random);
+
+  printf("%s!\n", (ret == SRSLTE_SUCCESS) ? "Ok" : "Failed");
+  return ret;
+}
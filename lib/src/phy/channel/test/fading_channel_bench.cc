@@ -0,0 +1,179 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <srslte/phy/channel/channel.h>
+#include <srslte/phy/utils/debug.h>
+#include <srslte/phy/utils/random.h>
+#include <srslte/phy/utils/vector.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+static char     default_model[] = "etu70";
+static char*    model           = default_model;
+static uint32_t srate_hz        = 23040000;
+static uint32_t nof_ports       = 2;
+static uint32_t nof_threads     = 2;
+static uint32_t duration_ms     = 100;
+static uint32_t random_seed     = 0x1234;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [mspTtr]\n", prog);
+  printf("\t-m Channel model: epa5, eva70, etu300 [Default %s]\n", model);
+  printf("\t-s Sampling rate in Hz: [Default %d]\n", srate_hz);
+  printf("\t-p Number of ports: [Default %d]\n", nof_ports);
+  printf("\t-T Number of fading threads: [Default %d]\n", nof_threads);
+  printf("\t-t Simulation time in ms: [Default %d]\n", duration_ms);
+  printf("\t-r Random generator seed: [Default %d]\n", random_seed);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "mspTtr")) != -1) {
+    switch (opt) {
+      case 'm':
+        model = argv[optind];
+        break;
+      case 's':
+        srate_hz = (uint32_t)strtof(argv[optind], NULL);
+        break;
+      case 'p':
+        nof_ports = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'T':
+        nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        duration_ms = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        random_seed = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+
+  if (nof_ports == 0 || nof_ports > SRSLTE_MAX_PORTS) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+// Runs the whole input through a channel with the given number of threads and returns the throughput in MSps
+static double run_channel(uint32_t threads, cf_t* in[SRSLTE_MAX_PORTS], cf_t* out[SRSLTE_MAX_PORTS], uint32_t sf_len)
+{
+  srslte::channel::args_t args = {};
+  args.enable                  = true;
+  args.fading_enable           = true;
+  args.fading_model            = model;
+  args.fading_seed             = random_seed;
+  args.fading_nof_threads      = threads;
+
+  srslte::channel channel(args, nof_ports);
+  channel.set_srate(srate_hz);
+
+  struct timeval     t[3]   = {};
+  uint64_t           t_usec = 0;
+  srslte_timestamp_t ts     = {};
+  for (uint32_t sf = 0; sf < duration_ms; sf++) {
+    cf_t* sf_in[SRSLTE_MAX_PORTS]  = {};
+    cf_t* sf_out[SRSLTE_MAX_PORTS] = {};
+    for (uint32_t i = 0; i < nof_ports; i++) {
+      sf_in[i]  = &in[i][sf * sf_len];
+      sf_out[i] = &out[i][sf * sf_len];
+    }
+
+    gettimeofday(&t[1], NULL);
+    channel.run(sf_in, sf_out, sf_len, ts);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    t_usec += (uint64_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+
+    srslte_timestamp_add(&ts, 0, 1e-3);
+  }
+
+  return (double)duration_ms * sf_len * nof_ports / (double)SRSLTE_MAX(t_usec, 1);
+}
+
+int main(int argc, char** argv)
+{
+  int             ret                      = SRSLTE_ERROR;
+  cf_t*           in[SRSLTE_MAX_PORTS]     = {};
+  cf_t*           out[SRSLTE_MAX_PORTS]    = {};
+  cf_t*           serial[SRSLTE_MAX_PORTS] = {};
+  srslte_random_t random                   = NULL;
+
+  parse_args(argc, argv);
+
+  random          = srslte_random_init(random_seed);
+  uint32_t sf_len = srate_hz / 1000;
+  uint32_t len    = sf_len * duration_ms;
+
+  for (uint32_t i = 0; i < nof_ports; i++) {
+    in[i]     = (cf_t*)srslte_vec_malloc(sizeof(cf_t) * len);
+    out[i]    = (cf_t*)srslte_vec_malloc(sizeof(cf_t) * len);
+    serial[i] = (cf_t*)srslte_vec_malloc(sizeof(cf_t) * len);
+    if (!in[i] || !out[i] || !serial[i]) {
+      ERROR("Error allocating buffers\n");
+      goto clean_exit;
+    }
+    srslte_random_uniform_complex_dist_vector(random, in[i], len, -1.0f, 1.0f);
+  }
+
+  printf("-- Fading channel benchmark. srate=%.2fMHz; model=%s; ports=%d; duration=%dms\n",
+         srate_hz / 1e6,
+         model,
+         nof_ports,
+         duration_ms);
+
+  printf("  1 thread(s): %.1f MSps\n", run_channel(1, in, serial, sf_len));
+  printf("%3d thread(s): %.1f MSps\n", nof_threads, run_channel(nof_threads, in, out, sf_len));
+
+  // The seeded output must not depend on the threading
+  for (uint32_t i = 0; i < nof_ports; i++) {
+    if (memcmp(out[i], serial[i], sizeof(cf_t) * len) != 0) {
+      ERROR("Port %d output depends on the number of threads\n", i);
+      goto clean_exit;
+    }
+  }
+
+  ret = SRSLTE_SUCCESS;
+
+clean_exit:
+  for (uint32_t i = 0; i < nof_ports; i++) {
+    if (in[i]) {
+      free(in[i]);
+    }
+    if (out[i]) {
+      free(out[i]);
+    }
+    if (serial[i]) {
+      free(serial[i]);
+    }
+  }
+  srslte_random_free(random);
+
+  printf("%s!\n", (ret == SRSLTE_SUCCESS) ? "Ok" : "Failed");
+  return ret;
+}
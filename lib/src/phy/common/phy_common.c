@@ -34,6 +34,9 @@ static bool use_standard_rates = true;
 static bool use_standard_rates = false;
 #endif
 
+// FDD processing time k: PDSCH/PUSCH in n+k after the grant or data and HARQ feedback in n+k after the data
+static uint32_t fdd_harq_delay_ms = SRSLTE_FDD_HARQ_DELAY_MAX_MS;
+
 /* Returns true if the structure pointed by cell has valid parameters
  */
 
@@ -310,6 +313,34 @@ void srslte_use_standard_symbol_size(bool enabled)
   use_standard_rates = enabled;
 }
 
+/* Sets the FDD processing time (4 for legacy timing, 3 or 2 for reduced processing time). It must be set before any
+ * eNB/UE thread is started as it is not protected.
+ */
+int srslte_set_fdd_harq_delay(uint32_t delay_ms)
+{
+  if (delay_ms < SRSLTE_FDD_HARQ_DELAY_MIN_MS || delay_ms > SRSLTE_FDD_HARQ_DELAY_MAX_MS) {
+    ERROR("Invalid FDD HARQ delay %d ms, it must be between %d and %d\n",
+          delay_ms,
+          SRSLTE_FDD_HARQ_DELAY_MIN_MS,
+          SRSLTE_FDD_HARQ_DELAY_MAX_MS);
+    return SRSLTE_ERROR;
+  }
+  fdd_harq_delay_ms = delay_ms;
+  return SRSLTE_SUCCESS;
+}
+
+uint32_t srslte_fdd_harq_delay()
+{
+  return fdd_harq_delay_ms;
+}
+
+/* Number of synchronous UL HARQ processes (and DL round trip time), 8 for the legacy n+4 timing
+ */
+uint32_t srslte_fdd_nof_harq()
+{
+  return 2 * fdd_harq_delay_ms;
+}
+
 int srslte_sampling_freq_hz(uint32_t nof_prb)
 {
   int n = srslte_symbol_sz(nof_prb);
@@ -34,45 +34,97 @@
 #define dft_floor(a, b) (a / b)
 
 #define FFTW_WISDOM_FILE "%s/.srslte_fftwisdom"
+#define FFTW_WISDOM_ENV "SRSLTE_FFTW_WISDOM"
 
-static int get_fftw_wisdom_file(char* full_path, uint32_t n)
+int srslte_dft_wisdom_filename(char* full_path, uint32_t n)
 {
-  const char* homedir = NULL;
-  if ((homedir = getenv("HOME")) == NULL) {
-    homedir = getpwuid(getuid())->pw_dir;
+  const char* path = getenv(FFTW_WISDOM_ENV);
+  if (path != NULL) {
+    return snprintf(full_path, n, "%s", path);
+  }
+
+  const char* homedir = getenv("HOME");
+  if (homedir == NULL) {
+    struct passwd* pw = getpwuid(getuid());
+    if (pw == NULL) {
+      // No home directory (e.g. containers), run without wisdom
+      return SRSLTE_ERROR;
+    }
+    homedir = pw->pw_dir;
   }
 
   return snprintf(full_path, n, FFTW_WISDOM_FILE, homedir);
 }
 
-#ifdef FFTW_WISDOM_FILE
-#define FFTW_TYPE FFTW_MEASURE
-#else
-#define FFTW_TYPE 0
-#endif
+static pthread_mutex_t fft_mutex   = PTHREAD_MUTEX_INITIALIZER;
+static bool            dft_measure = false;
+
+/* Creates plan p calling the FFTW planner fn. Unless measuring is forced, plans are only taken from the wisdom and
+ * fall back to an estimated plan, which takes microseconds instead of the seconds FFTW_MEASURE needs.
+ * Must be called with fft_mutex locked. */
+#define DFT_PLAN(p, fn, ...)                                                                                           \
+  do {                                                                                                                 \
+    if (dft_measure) {                                                                                                 \
+      p = fn(__VA_ARGS__, FFTW_MEASURE);                                                                               \
+    } else {                                                                                                           \
+      p = fn(__VA_ARGS__, FFTW_MEASURE | FFTW_WISDOM_ONLY);                                                            \
+      if (!p) {                                                                                                        \
+        p = fn(__VA_ARGS__, FFTW_ESTIMATE);                                                                            \
+      }                                                                                                                \
+    }                                                                                                                  \
+  } while (0)
+
+void srslte_dft_set_measure(bool measure)
+{
+  pthread_mutex_lock(&fft_mutex);
+  dft_measure = measure;
+  pthread_mutex_unlock(&fft_mutex);
+}
+
+int srslte_dft_load_wisdom(const char* filename)
+{
+  char full_path[256];
+  if (filename == NULL) {
+    if (srslte_dft_wisdom_filename(full_path, sizeof(full_path)) < 0) {
+      return SRSLTE_ERROR;
+    }
+    filename = full_path;
+  }
+
+  pthread_mutex_lock(&fft_mutex);
+  int ret = fftwf_import_wisdom_from_filename(filename) ? SRSLTE_SUCCESS : SRSLTE_ERROR;
+  pthread_mutex_unlock(&fft_mutex);
+
+  return ret;
+}
+
+int srslte_dft_save_wisdom(const char* filename)
+{
+  char full_path[256];
+  if (filename == NULL) {
+    if (srslte_dft_wisdom_filename(full_path, sizeof(full_path)) < 0) {
+      return SRSLTE_ERROR;
+    }
+    filename = full_path;
+  }
+
+  pthread_mutex_lock(&fft_mutex);
+  int ret = fftwf_export_wisdom_to_filename(filename) ? SRSLTE_SUCCESS : SRSLTE_ERROR;
+  pthread_mutex_unlock(&fft_mutex);
 
-static pthread_mutex_t fft_mutex = PTHREAD_MUTEX_INITIALIZER;
+  return ret;
+}
 
 // This function is called in the beggining of any executable where it is linked
 __attribute__((constructor)) static void srslte_dft_load()
 {
-#ifdef FFTW_WISDOM_FILE
-  char full_path[256];
-  get_fftw_wisdom_file(full_path, sizeof(full_path));
-  fftwf_import_wisdom_from_filename(full_path);
-#else
-  printf("Warning: FFTW Wisdom file not defined\n");
-#endif
+  srslte_dft_load_wisdom(NULL);
 }
 
 // This function is called in the ending of any executable where it is linked
 __attribute__((destructor)) static void srslte_dft_exit()
 {
-#ifdef FFTW_WISDOM_FILE
-  char full_path[256];
-  get_fftw_wisdom_file(full_path, sizeof(full_path));
-  fftwf_export_wisdom_to_filename(full_path);
-#endif
+  srslte_dft_save_wisdom(NULL);
   fftwf_cleanup();
 }
 
@@ -130,7 +182,7 @@ int srslte_dft_replan_guru_c(srslte_dft_plan_t* plan,
   /* Destroy current plan */
   fftwf_destroy_plan(plan->p);
 
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  DFT_PLAN(plan->p, fftwf_plan_guru_dft, 1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign);
 
   pthread_mutex_unlock(&fft_mutex);
 
@@ -152,7 +204,7 @@ int srslte_dft_replan_c(srslte_dft_plan_t* plan, const int new_dft_points)
     fftwf_destroy_plan(plan->p);
     plan->p = NULL;
   }
-  plan->p = fftwf_plan_dft_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  DFT_PLAN(plan->p, fftwf_plan_dft_1d, new_dft_points, plan->in, plan->out, sign);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -180,11 +232,13 @@ int srslte_dft_plan_guru_c(srslte_dft_plan_t* plan,
 
   pthread_mutex_lock(&fft_mutex);
 
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  DFT_PLAN(plan->p, fftwf_plan_guru_dft, 1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign);
+
+  pthread_mutex_unlock(&fft_mutex);
+
   if (!plan->p) {
     return -1;
   }
-  pthread_mutex_unlock(&fft_mutex);
 
   plan->size      = dft_points;
   plan->init_size = plan->size;
@@ -207,7 +261,7 @@ int srslte_dft_plan_c(srslte_dft_plan_t* plan, const int dft_points, srslte_dft_
   pthread_mutex_lock(&fft_mutex);
 
   int sign = (dir == SRSLTE_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
-  plan->p  = fftwf_plan_dft_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  DFT_PLAN(plan->p, fftwf_plan_dft_1d, dft_points, plan->in, plan->out, sign);
 
   pthread_mutex_unlock(&fft_mutex);
 
@@ -237,7 +291,7 @@ int srslte_dft_replan_r(srslte_dft_plan_t* plan, const int new_dft_points)
     fftwf_destroy_plan(plan->p);
     plan->p = NULL;
   }
-  plan->p = fftwf_plan_r2r_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  DFT_PLAN(plan->p, fftwf_plan_r2r_1d, new_dft_points, plan->in, plan->out, sign);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -253,7 +307,7 @@ int srslte_dft_plan_r(srslte_dft_plan_t* plan, const int dft_points, srslte_dft_
   int sign = (dir == SRSLTE_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
 
   pthread_mutex_lock(&fft_mutex);
-  plan->p = fftwf_plan_r2r_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  DFT_PLAN(plan->p, fftwf_plan_r2r_1d, dft_points, plan->in, plan->out, sign);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -62,6 +62,9 @@ int srslte_ofdm_init_mbsfn_(srslte_ofdm_t*   q,
   q->nof_symbols_mbsfn = SRSLTE_CP_NSYMB(SRSLTE_CP_EXT);
   q->cp                = cp;
   q->freq_shift        = false;
+  q->cfo               = 0.0f;
+  q->window_prb        = 0;
+  q->window_nof_prb    = 0;
   q->nof_re            = (uint32_t)nof_prb * SRSLTE_NRE;
   q->nof_guards        = ((symbol_sz - q->nof_re) / 2);
   q->slot_sz           = (uint32_t)SRSLTE_SLOT_LEN(symbol_sz);
@@ -167,8 +170,40 @@ void srslte_ofdm_set_non_mbsfn_region(srslte_ofdm_t* q, uint8_t non_mbsfn_region
   q->non_mbsfn_region = non_mbsfn_region;
 }
 
+/* Sets the CFO corrected by srslte_ofdm_rx_sf(), normalised to the sampling rate. The correction phase starts at the
+ * first sample of the subframe, as srslte_cfo_correct() does over a whole subframe.
+ */
+void srslte_ofdm_set_cfo(srslte_ofdm_t* q, float cfo)
+{
+  q->cfo = cfo;
+}
+
+/* Restricts the resource grid Rx extraction to nof_prb PRB starting at first_prb, the rest of the grid is not written.
+ * Setting nof_prb to 0 extracts all the PRB.
+ */
+void srslte_ofdm_rx_set_prb_window(srslte_ofdm_t* q, uint32_t first_prb, uint32_t nof_prb)
+{
+  q->window_prb     = first_prb;
+  q->window_nof_prb = nof_prb;
+}
+
 int srslte_ofdm_replan_(srslte_ofdm_t* q, srslte_cp_t cp, int symbol_sz, int nof_prb)
 {
+  // Plans only depend on the symbol size and CP, several bandwidths share them (e.g. 75 and 100 PRB)
+  if (q->tmp && q->symbol_sz == (uint32_t)symbol_sz && q->cp == cp && q->fft_plan.size == symbol_sz) {
+    q->nof_re     = (uint32_t)nof_prb * SRSLTE_NRE;
+    q->nof_guards = ((symbol_sz - q->nof_re) / 2);
+
+#ifndef AVOID_GURU
+    bzero(q->tmp, sizeof(cf_t) * q->sf_sz);
+    if (q->fft_plan.dir == SRSLTE_DFT_BACKWARD) {
+      bzero(q->in_buffer, sizeof(cf_t) * SRSLTE_SF_LEN_RE(nof_prb, cp));
+    }
+#endif /* AVOID_GURU */
+
+    DEBUG("Replan skipped symbol_sz=%d, nof_re=%d, nof_guards=%d\n", q->symbol_sz, q->nof_re, q->nof_guards);
+    return SRSLTE_SUCCESS;
+  }
 
   if (srslte_dft_replan_c(&q->fft_plan, symbol_sz)) {
     ERROR("Error: Creating DFT plan\n");
@@ -445,6 +480,35 @@ void srslte_ofdm_rx_slot_ng(srslte_ofdm_t* q, cf_t* input, cf_t* output)
   }
 }
 
+/* Copies the subcarriers of the Rx PRB window from the FFT output into the resource grid, scaling them by h */
+static void ofdm_rx_extract(srslte_ofdm_t* q, const cf_t* tmp, cf_t* output, cf_t h)
+{
+  uint32_t half  = q->nof_re / 2;
+  uint32_t dc    = (q->fft_plan.dc) ? 1 : 0;
+  uint32_t start = SRSLTE_MIN(q->window_prb * SRSLTE_NRE, q->nof_re);
+  uint32_t end   = (q->window_nof_prb) ? SRSLTE_MIN(start + q->window_nof_prb * SRSLTE_NRE, q->nof_re) : q->nof_re;
+
+  // Negative frequencies are at the end of the FFT output
+  if (start < half) {
+    uint32_t n = SRSLTE_MIN(end, half) - start;
+    if (h == 1.0f) {
+      memcpy(&output[start], &tmp[q->symbol_sz - half + start], sizeof(cf_t) * n);
+    } else {
+      srslte_vec_sc_prod_ccc(&tmp[q->symbol_sz - half + start], h, &output[start], n);
+    }
+  }
+
+  // Positive frequencies follow the DC subcarrier
+  if (end > half) {
+    uint32_t k = SRSLTE_MAX(start, half);
+    if (h == 1.0f) {
+      memcpy(&output[k], &tmp[dc + k - half], sizeof(cf_t) * (end - k));
+    } else {
+      srslte_vec_sc_prod_ccc(&tmp[dc + k - half], h, &output[k], end - k);
+    }
+  }
+}
+
 /* Transforms input samples into output OFDM symbols.
  * Performs FFT on a each symbol and removes CP.
  */
@@ -456,19 +520,13 @@ void srslte_ofdm_rx_slot(srslte_ofdm_t* q, int slot_in_sf)
   srslte_ofdm_rx_slot_ng(
       q, q->in_buffer + slot_in_sf * q->slot_sz, q->out_buffer + slot_in_sf * q->nof_re * q->nof_symbols);
 #else
-  float    norm = 1.0f / sqrtf(q->fft_plan.size);
-  cf_t*    tmp  = q->tmp + slot_in_sf * q->symbol_sz * q->nof_symbols;
-  uint32_t dc   = (q->fft_plan.dc) ? 1 : 0;
+  float norm = (q->fft_plan.norm) ? 1.0f / sqrtf(q->fft_plan.size) : 1.0f;
+  cf_t* tmp  = q->tmp + slot_in_sf * q->symbol_sz * q->nof_symbols;
 
   srslte_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
 
   for (int i = 0; i < q->nof_symbols; i++) {
-    memcpy(output, tmp + q->symbol_sz - q->nof_re / 2, sizeof(cf_t) * q->nof_re / 2);
-    memcpy(output + q->nof_re / 2, &tmp[dc], sizeof(cf_t) * q->nof_re / 2);
-
-    if (q->fft_plan.norm) {
-      srslte_vec_sc_prod_cfc(output, norm, output, q->nof_re);
-    }
+    ofdm_rx_extract(q, tmp, output, norm);
 
     tmp += q->symbol_sz;
     output += q->nof_re;
@@ -476,17 +534,55 @@ void srslte_ofdm_rx_slot(srslte_ofdm_t* q, int slot_in_sf)
 #endif
 }
 
+/* Fused front-end for one symbol starting at input[offset], offset being relative to the subframe start: applies the
+ * CFO correction and the frequency shift while staging the samples into the FFT input, runs the FFT and extracts the
+ * PRB window. The input buffer is not modified.
+ */
+static void ofdm_rx_symbol_fused(srslte_ofdm_t* q, const cf_t* input, uint32_t offset, float freq_shift, cf_t* output)
+{
+  float norm = (q->fft_plan.norm) ? 1.0f / sqrtf(q->fft_plan.size) : 1.0f;
+
+  // The frequency shift restarts its phase at the beginning of every symbol
+  srslte_vec_apply_cfo(&input[offset], q->cfo + freq_shift / q->symbol_sz, q->fft_plan.in, q->symbol_sz);
+  srslte_dft_run_c_zerocopy(&q->fft_plan, q->fft_plan.in, q->fft_plan.out);
+
+  // The CFO phase at the symbol start is constant over the symbol, apply it after the FFT with the normalisation
+  cf_t h = norm;
+  if (q->cfo != 0.0f) {
+    h *= cexpf(_Complex_I * 2.0f * (float)M_PI * q->cfo * (float)offset);
+  }
+  ofdm_rx_extract(q, q->fft_plan.out, output, h);
+}
+
+static void ofdm_rx_slot_fused(srslte_ofdm_t* q, int slot_in_sf, float freq_shift)
+{
+  cf_t*    output = q->out_buffer + slot_in_sf * q->nof_re * q->nof_symbols;
+  uint32_t offset = slot_in_sf * q->slot_sz;
+
+  for (uint32_t i = 0; i < q->nof_symbols; i++) {
+    offset += SRSLTE_CP_ISNORM(q->cp) ? SRSLTE_CP_LEN_NORM(i, q->symbol_sz) : SRSLTE_CP_LEN_EXT(q->symbol_sz);
+    ofdm_rx_symbol_fused(q, q->in_buffer, offset, freq_shift, output);
+    offset += q->symbol_sz;
+    output += q->nof_re;
+  }
+}
+
 void srslte_ofdm_rx_slot_mbsfn(srslte_ofdm_t* q, cf_t* input, cf_t* output)
 {
   uint32_t i;
+  uint32_t offset = 0;
   for (i = 0; i < q->nof_symbols_mbsfn; i++) {
     if (i == q->non_mbsfn_region) {
-      input += SRSLTE_NON_MBSFN_REGION_GUARD_LENGTH(q->non_mbsfn_region, q->symbol_sz);
+      offset += SRSLTE_NON_MBSFN_REGION_GUARD_LENGTH(q->non_mbsfn_region, q->symbol_sz);
     }
-    input += (i >= q->non_mbsfn_region) ? SRSLTE_CP_LEN_EXT(q->symbol_sz) : SRSLTE_CP_LEN_NORM(i, q->symbol_sz);
-    srslte_dft_run_c(&q->fft_plan, input, q->tmp);
-    memcpy(output, &q->tmp[q->nof_guards], q->nof_re * sizeof(cf_t));
-    input += q->symbol_sz;
+    offset += (i >= q->non_mbsfn_region) ? SRSLTE_CP_LEN_EXT(q->symbol_sz) : SRSLTE_CP_LEN_NORM(i, q->symbol_sz);
+    if (q->cfo != 0.0f) {
+      ofdm_rx_symbol_fused(q, input, offset, 0.0f, output);
+    } else {
+      srslte_dft_run_c(&q->fft_plan, &input[offset], q->tmp);
+      memcpy(output, &q->tmp[q->nof_guards], q->nof_re * sizeof(cf_t));
+    }
+    offset += q->symbol_sz;
     output += q->nof_re;
   }
 }
@@ -507,6 +603,12 @@ void srslte_ofdm_rx_slot_zerocopy(srslte_ofdm_t* q, cf_t* input, cf_t* output)
 void srslte_ofdm_rx_sf(srslte_ofdm_t* q)
 {
   uint32_t n;
+  if (!q->mbsfn_subframe && (q->cfo != 0.0f || q->freq_shift)) {
+    for (n = 0; n < 2; n++) {
+      ofdm_rx_slot_fused(q, n, q->freq_shift ? q->freq_shift_f : 0.0f);
+    }
+    return;
+  }
   if (q->freq_shift) {
     srslte_vec_prod_ccc(q->in_buffer, q->shift_buffer, q->in_buffer, 2 * q->slot_sz);
   }
@@ -516,7 +618,11 @@ void srslte_ofdm_rx_sf(srslte_ofdm_t* q)
     }
   } else {
     srslte_ofdm_rx_slot_mbsfn(q, &q->in_buffer[0 * q->slot_sz], &q->out_buffer[0 * q->nof_re * q->nof_symbols]);
-    srslte_ofdm_rx_slot(q, 1);
+    if (q->cfo != 0.0f) {
+      ofdm_rx_slot_fused(q, 1, 0.0f);
+    } else {
+      srslte_ofdm_rx_slot(q, 1);
+    }
   }
 }
 
@@ -31,6 +31,8 @@
 int         nof_prb         = -1;
 srslte_cp_t cp              = SRSLTE_CP_NORM;
 int         nof_repetitions = 128;
+float       cfo             = 0.0f;
+bool        prb_window      = false;
 
 static double elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
 {
@@ -49,12 +51,14 @@ void usage(char* prog)
   printf("\t-n nof_prb [Default All]\n");
   printf("\t-e extended cyclic prefix [Default Normal]\n");
   printf("\t-r nof_repetitions [Default %d]\n", nof_repetitions);
+  printf("\t-c CFO in subcarriers, runs whole subframes [Default %.2f]\n", cfo);
+  printf("\t-w extract only half of the PRB [Default %s]\n", prb_window ? "enabled" : "disabled");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "ner")) != -1) {
+  while ((opt = getopt(argc, argv, "nercw")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (int)strtol(argv[optind], NULL, 10);
@@ -65,6 +69,12 @@ void parse_args(int argc, char** argv)
       case 'r':
         nof_repetitions = (int)strtol(argv[optind], NULL, 10);
         break;
+      case 'c':
+        cfo = strtof(argv[optind], NULL);
+        break;
+      case 'w':
+        prb_window = true;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -125,30 +135,62 @@ int main(int argc, char** argv)
     }
     srslte_ofdm_set_normalize(&ifft, true);
 
-    for (i = 0; i < n_re; i++) {
+    // A CFO is corrected at subframe level, run both slots
+    uint32_t nof_slots  = (cfo != 0.0f) ? 2 : 1;
+    uint32_t slot_len   = SRSLTE_SLOT_LEN(srslte_symbol_sz(n_prb));
+    uint32_t window_prb = 0, window_nof_prb = n_prb;
+    if (prb_window) {
+      window_prb     = n_prb / 4;
+      window_nof_prb = SRSLTE_MAX(n_prb / 2, 1);
+      srslte_ofdm_rx_set_prb_window(&fft, window_prb, window_nof_prb);
+    }
+    bzero(outfft, sizeof(cf_t) * n_re * 2);
+
+    for (i = 0; i < n_re * nof_slots; i++) {
       input[i] = 100 * ((float)rand() / (float)RAND_MAX + I * ((float)rand() / (float)RAND_MAX));
       // input[i] = 100;
     }
 
     gettimeofday(&start, NULL);
     for (int i = 0; i < nof_repetitions; i++) {
-      srslte_ofdm_tx_slot(&ifft, 0);
+      if (nof_slots == 2) {
+        srslte_ofdm_tx_sf(&ifft);
+      } else {
+        srslte_ofdm_tx_slot(&ifft, 0);
+      }
     }
     gettimeofday(&end, NULL);
-    printf(" Tx@%.1fMsps",
-           (float)(SRSLTE_SLOT_LEN(srslte_symbol_sz(n_prb)) * nof_repetitions) / elapsed_us(&start, &end));
+    printf(" Tx@%.1fMsps", (float)(slot_len * nof_slots * nof_repetitions) / elapsed_us(&start, &end));
+
+    if (nof_slots == 2) {
+      // Add the CFO to the transmitted subframe and let the demodulator correct it
+      srslte_vec_apply_cfo(outifft, cfo / srslte_symbol_sz(n_prb), outifft, slot_len * 2);
+      srslte_ofdm_set_cfo(&fft, -cfo / srslte_symbol_sz(n_prb));
+    }
 
     gettimeofday(&start, NULL);
     for (int i = 0; i < nof_repetitions; i++) {
-      srslte_ofdm_rx_slot(&fft, 0);
+      if (nof_slots == 2) {
+        srslte_ofdm_rx_sf(&fft);
+      } else {
+        srslte_ofdm_rx_slot(&fft, 0);
+      }
     }
     gettimeofday(&end, NULL);
-    printf(" Rx@%.1fMsps",
-           (float)(SRSLTE_SLOT_LEN(srslte_symbol_sz(n_prb)) * nof_repetitions) / elapsed_us(&start, &end));
+    printf(" Rx@%.1fMsps", (float)(slot_len * nof_slots * nof_repetitions) / elapsed_us(&start, &end));
 
     /* compute MSE */
     mse = 0.0f;
-    for (i = 0; i < n_re; i++) {
+    for (i = 0; i < n_re * nof_slots; i++) {
+      uint32_t prb = (i % (n_prb * SRSLTE_NRE)) / SRSLTE_NRE;
+      if (prb < window_prb || prb >= window_prb + window_nof_prb) {
+        // Outside of the window nothing shall be written
+        if (outfft[i] != 0.0f) {
+          printf("RE %d outside of the PRB window was written\n", i);
+          exit(-1);
+        }
+        continue;
+      }
       cf_t error = input[i] - outfft[i];
       mse += (__real__ error * __real__ error + __imag__ error * __imag__ error) / cabsf(input[i]);
       if (mse > 1.0f)
@@ -332,6 +332,173 @@ void srslte_rm_turbo_free_tables()
   rm_turbo_tables_generated = false;
 }
 
+/* Small code blocks (up to NROWS_MAX rows per sub-block) are sub-block interleaved with a bit matrix transpose instead
+ * of a bit by bit table lookup. The rows of the matrix are 32-bit words and, once transposed, every column is a word
+ * already in the output order. The two parity streams are interlaced by transposing a matrix with their rows
+ * alternated. */
+typedef struct {
+  uint8_t* output;
+  uint64_t acc;
+  uint32_t nof_bits;
+} rm_turbo_bit_writer_t;
+
+/* Appends the nof_bits (up to 32) least significant bits of value. The accumulator is MSB aligned and flushed in 32-bit
+ * words */
+static inline void rm_turbo_bit_writer_put(rm_turbo_bit_writer_t* w, uint32_t value, uint32_t nof_bits)
+{
+  if (nof_bits) {
+    w->acc |= ((uint64_t)value << (64 - nof_bits)) >> w->nof_bits;
+    w->nof_bits += nof_bits;
+    if (w->nof_bits >= 32) {
+      uint32_t word = (uint32_t)(w->acc >> 32);
+      w->output[0]  = (uint8_t)(word >> 24);
+      w->output[1]  = (uint8_t)(word >> 16);
+      w->output[2]  = (uint8_t)(word >> 8);
+      w->output[3]  = (uint8_t)word;
+      w->output += 4;
+      w->acc <<= 32;
+      w->nof_bits -= 32;
+    }
+  }
+}
+
+static inline void rm_turbo_bit_writer_put64(rm_turbo_bit_writer_t* w, uint64_t value, uint32_t nof_bits)
+{
+  if (nof_bits > 32) {
+    rm_turbo_bit_writer_put(w, (uint32_t)(value >> 32), nof_bits - 32);
+    nof_bits = 32;
+  }
+  rm_turbo_bit_writer_put(w, (uint32_t)value, nof_bits);
+}
+
+static inline void rm_turbo_bit_writer_flush(rm_turbo_bit_writer_t* w)
+{
+  for (uint32_t i = 0; i < (w->nof_bits + 7) / 8; i++) {
+    w->output[i] = (uint8_t)(w->acc >> (56 - 8 * i));
+  }
+}
+
+/* Reads 32 bits, MSB first, starting at any bit of the input */
+static inline uint32_t rm_turbo_read_word(const uint8_t* input, uint32_t bit_idx)
+{
+  const uint8_t* p = &input[bit_idx / 8];
+  uint64_t       w =
+      ((uint64_t)p[0] << 32) | ((uint64_t)p[1] << 24) | ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 8) | p[4];
+  return (uint32_t)(w >> (8 - bit_idx % 8));
+}
+
+/* Rows of the sub-block matrix of a stream of nrows * NCOLS - ndummy bits, preceded by ndummy dummy bits */
+static void
+rm_turbo_subblock_rows(const uint8_t* input, uint32_t offset, uint32_t nrows, uint32_t ndummy, uint32_t* rows)
+{
+  rows[0] = rm_turbo_read_word(input, offset) >> ndummy;
+  for (uint32_t r = 1; r < nrows; r++) {
+    rows[r] = rm_turbo_read_word(input, offset + r * NCOLS - ndummy);
+  }
+}
+
+/* Transposes a matrix of nof_rows (16, 32, 48 or 64) rows of NCOLS bits. Column c is returned in cols[c] with the
+ * first row in the MSB */
+static void rm_turbo_transpose(const uint32_t* rows, uint32_t nof_rows, uint64_t cols[NCOLS])
+{
+  for (uint32_t c = 0; c < NCOLS; c++) {
+    cols[c] = 0;
+  }
+
+#ifdef LV_HAVE_SSE
+  /* Split 16 rows in byte planes, last row first, so that every movemask returns 16 bits of one column */
+  const __m128i shuffle = _mm_setr_epi8(15, 11, 7, 3, 14, 10, 6, 2, 13, 9, 5, 1, 12, 8, 4, 0);
+  for (uint32_t h = 0; h < nof_rows / 16; h++) {
+    const __m128i* ptr = (const __m128i*)&rows[16 * h];
+    __m128i        a   = _mm_shuffle_epi8(_mm_loadu_si128(ptr + 3), shuffle);
+    __m128i        b   = _mm_shuffle_epi8(_mm_loadu_si128(ptr + 2), shuffle);
+    __m128i        c   = _mm_shuffle_epi8(_mm_loadu_si128(ptr + 1), shuffle);
+    __m128i        d   = _mm_shuffle_epi8(_mm_loadu_si128(ptr + 0), shuffle);
+    __m128i        t0  = _mm_unpacklo_epi32(a, b);
+    __m128i        t1  = _mm_unpacklo_epi32(c, d);
+    __m128i        t2  = _mm_unpackhi_epi32(a, b);
+    __m128i        t3  = _mm_unpackhi_epi32(c, d);
+    __m128i        planes[4];
+    planes[0] = _mm_unpacklo_epi64(t0, t1);
+    planes[1] = _mm_unpackhi_epi64(t0, t1);
+    planes[2] = _mm_unpacklo_epi64(t2, t3);
+    planes[3] = _mm_unpackhi_epi64(t2, t3);
+
+    uint32_t shift = 48 - 16 * h;
+    for (uint32_t k = 0; k < 4; k++) {
+      for (uint32_t t = 0; t < 8; t++) {
+        cols[8 * k + t] |= (uint64_t)_mm_movemask_epi8(planes[k]) << shift;
+        planes[k] = _mm_add_epi8(planes[k], planes[k]);
+      }
+    }
+  }
+#else  /* LV_HAVE_SSE */
+  for (uint32_t r = 0; r < nof_rows; r++) {
+    for (uint32_t c = 0; c < NCOLS; c++) {
+      cols[c] |= (uint64_t)((rows[r] >> (NCOLS - 1 - c)) & 1) << (63 - r);
+    }
+  }
+#endif /* LV_HAVE_SSE */
+}
+
+/* Sub-block interleaver and bit collection (5.1.4.1.1 and 5.1.4.1.2) for code blocks up to NROWS_MAX rows */
+static void rm_turbo_tx_subblock(uint8_t* systematic, uint8_t* parity, uint8_t* w_buff, uint32_t cb_len)
+{
+  uint32_t d_len  = cb_len + 4;
+  uint32_t nrows  = (d_len - 1) / NCOLS + 1;
+  uint32_t ndummy = nrows * NCOLS - d_len;
+
+  uint32_t rows[2 * NROWS_MAX], rows2[NROWS_MAX];
+  uint64_t cols[NCOLS];
+
+  rm_turbo_bit_writer_t w = {w_buff, 0, 0};
+
+  // Systematic bits, only the first row can have a dummy bit
+  uint32_t nof_rows = ((nrows - 1) / 16 + 1) * 16;
+  memset(rows, 0, sizeof(uint32_t) * nof_rows);
+  rm_turbo_subblock_rows(systematic, 0, nrows, ndummy, rows);
+  rm_turbo_transpose(rows, nof_rows, cols);
+  for (uint32_t j = 0; j < NCOLS; j++) {
+    uint32_t c = RM_PERM_TC[j];
+    if (c < ndummy) {
+      rm_turbo_bit_writer_put(&w, (uint32_t)(cols[c] >> (64 - nrows)), nrows - 1);
+    } else {
+      rm_turbo_bit_writer_put(&w, (uint32_t)(cols[c] >> (64 - nrows)), nrows);
+    }
+  }
+
+  // Parity bits. Rows of both streams are alternated, the second one read one position ahead, so its last column
+  // takes the first column of the next row and wraps to the first (dummy) bit
+  nof_rows = ((2 * nrows - 1) / 16 + 1) * 16;
+  memset(rows, 0, sizeof(uint32_t) * nof_rows);
+  rm_turbo_subblock_rows(parity, 0, nrows, ndummy, rows2);
+  for (uint32_t r = 0; r < nrows; r++) {
+    rows[2 * r] = rows2[r];
+  }
+  rm_turbo_subblock_rows(parity, d_len, nrows, ndummy, rows2);
+  for (uint32_t r = 0; r < nrows; r++) {
+    rows[2 * r + 1] = (rows2[r] << 1) | (rows2[(r + 1) % nrows] >> (NCOLS - 1));
+  }
+  rm_turbo_transpose(rows, nof_rows, cols);
+  for (uint32_t j = 0; j < NCOLS; j++) {
+    uint32_t c     = RM_PERM_TC[j];
+    uint64_t y     = cols[c] >> (64 - 2 * nrows);
+    uint32_t y_len = 2 * nrows;
+    if (c == NCOLS - 1) {
+      y >>= 1;
+      y_len--;
+    }
+    if (c + 1 < ndummy) {
+      y_len -= 2;
+    } else if (c < ndummy) {
+      y_len -= 1;
+    }
+    rm_turbo_bit_writer_put64(&w, y, y_len);
+  }
+
+  rm_turbo_bit_writer_flush(&w);
+}
+
 /**
  * Rate matching for LTE Turbo Coder
  *
@@ -361,7 +528,11 @@ int srslte_rm_turbo_tx_lut(uint8_t* w_buff,
     int in_len = 3 * srslte_cbsegm_cbsize(cb_idx) + 12;
 
     /* Sub-block interleaver (5.1.4.1.1) and bit collection */
-    if (rv_idx == 0) {
+    if (rv_idx == 0 && in_len / 3 <= NCOLS * NROWS_MAX) {
+
+      rm_turbo_tx_subblock(systematic, parity, w_buff, in_len / 3 - 4);
+
+    } else if (rv_idx == 0) {
 
       // Systematic bits
       // srslte_bit_interleave(systematic, w_buff, interleaver_systematic_bits[cb_idx], in_len/3);
@@ -375,8 +546,8 @@ int srslte_rm_turbo_tx_lut(uint8_t* w_buff,
     /* Bit selection and transmission 5.1.4.1.2 */
     int w_len = 0;
     int r_ptr = k0_vec[cb_idx][rv_idx][1];
-    while (w_len < out_len) {
-      int cp_len = out_len - w_len;
+    while (w_len < out_len && w_len < in_len) {
+      int cp_len = SRSLTE_MIN(out_len, in_len) - w_len;
       if (cp_len + r_ptr >= in_len) {
         cp_len = in_len - r_ptr;
       }
@@ -388,12 +559,52 @@ int srslte_rm_turbo_tx_lut(uint8_t* w_buff,
       w_len += cp_len;
     }
 
+    /* Once the whole circular buffer has been sent the output repeats itself. Copying the output already written
+     * doubles the copy length every time and, as two circular buffers are a whole number of bytes, keeps the copies
+     * byte aligned after the first one */
+    while (w_len < out_len) {
+      int cp_len = SRSLTE_MIN(out_len - w_len, w_len);
+      srslte_bit_copy(output, w_len + w_offset, output, w_offset, cp_len);
+      w_len += cp_len;
+    }
+
     return 0;
   } else {
     return SRSLTE_ERROR_INVALID_INPUTS;
   }
 }
 
+/* Selects the deinterleaver table for the given code block size and redundancy version. If the turbo decoder
+ * expects its input arranged in sub-blocks (nof_subblocks != 0) the sub-block version of the table is returned. */
+static uint16_t* rm_turbo_rx_deinter_table(uint32_t cb_idx, uint32_t rv_idx, uint32_t nof_subblocks)
+{
+#if SRSLTE_TDEC_EXPECT_INPUT_SB == 1
+  int idx = deinter_table_idx_from_sb_len(nof_subblocks);
+  if (idx < 0) {
+    return deinterleaver[cb_idx][rv_idx];
+  } else if (idx < NOF_DEINTER_TABLE_SB_IDX) {
+    return deinterleaver_sb[idx][cb_idx][rv_idx];
+  } else {
+    ERROR("Sub-block size index %d not supported in srslte_rm_turbo_rx_lut()\n", idx);
+    return NULL;
+  }
+#else
+  return deinterleaver[cb_idx][rv_idx];
+#endif
+}
+
+/* 8-bit soft-buffers are combined with saturation, so repetitions and retransmissions can not wrap the stored LLRs
+ * around. Half of the 8-bit range is kept as headroom for the 8-bit turbo decoder metrics. */
+#define RM_TURBO_RX_8BIT_MAX (INT8_MAX / 2)
+
+static inline int8_t rm_turbo_sadd_8bit(int8_t a, int8_t b)
+{
+  int16_t s = (int16_t)a + (int16_t)b;
+  s         = s > RM_TURBO_RX_8BIT_MAX ? RM_TURBO_RX_8BIT_MAX : s;
+  s         = s < -RM_TURBO_RX_8BIT_MAX ? -RM_TURBO_RX_8BIT_MAX : s;
+  return (int8_t)s;
+}
+
 int srslte_rm_turbo_rx_lut(int16_t* input, int16_t* output, uint32_t in_len, uint32_t cb_idx, uint32_t rv_idx)
 {
   return srslte_rm_turbo_rx_lut_(input, output, in_len, cb_idx, rv_idx, true);
@@ -417,21 +628,11 @@ int srslte_rm_turbo_rx_lut_(int16_t* input,
 
   if (rv_idx < 4 && cb_idx < SRSLTE_NOF_TC_CB_SIZES) {
 
-#if SRSLTE_TDEC_EXPECT_INPUT_SB == 1
-    int       cb_len  = srslte_cbsegm_cbsize(cb_idx);
-    int       idx     = deinter_table_idx_from_sb_len(srslte_tdec_autoimp_get_subblocks(cb_len));
-    uint16_t* deinter = NULL;
-    if (idx < 0 || !enable_input_tdec) {
-      deinter = deinterleaver[cb_idx][rv_idx];
-    } else if (idx < NOF_DEINTER_TABLE_SB_IDX) {
-      deinter = deinterleaver_sb[idx][cb_idx][rv_idx];
-    } else {
-      ERROR("Sub-block size index %d not supported in srslte_rm_turbo_rx_lut()\n", idx);
+    uint32_t  nof_sb  = enable_input_tdec ? srslte_tdec_autoimp_get_subblocks(srslte_cbsegm_cbsize(cb_idx)) : 0;
+    uint16_t* deinter = rm_turbo_rx_deinter_table(cb_idx, rv_idx, nof_sb);
+    if (!deinter) {
       return -1;
     }
-#else
-    uint16_t* deinter = deinterleaver[cb_idx][rv_idx];
-#endif
 
 #ifdef LV_HAVE_AVX
     return srslte_rm_turbo_rx_lut_avx(input, output, deinter, in_len, cb_idx, rv_idx);
@@ -457,21 +658,11 @@ int srslte_rm_turbo_rx_lut_8bit(int8_t* input, int8_t* output, uint32_t in_len,
 {
   if (rv_idx < 4 && cb_idx < SRSLTE_NOF_TC_CB_SIZES) {
 
-#if SRSLTE_TDEC_EXPECT_INPUT_SB == 1
-    int       cb_len  = srslte_cbsegm_cbsize(cb_idx);
-    int       idx     = deinter_table_idx_from_sb_len(srslte_tdec_autoimp_get_subblocks_8bit(cb_len));
-    uint16_t* deinter = NULL;
-    if (idx < 0) {
-      deinter = deinterleaver[cb_idx][rv_idx];
-    } else if (idx < NOF_DEINTER_TABLE_SB_IDX) {
-      deinter = deinterleaver_sb[idx][cb_idx][rv_idx];
-    } else {
-      ERROR("Sub-block size index %d not supported in srslte_rm_turbo_rx_lut()\n", idx);
+    uint16_t* deinter =
+        rm_turbo_rx_deinter_table(cb_idx, rv_idx, srslte_tdec_autoimp_get_subblocks_8bit(srslte_cbsegm_cbsize(cb_idx)));
+    if (!deinter) {
       return -1;
     }
-#else
-    uint16_t* deinter = deinterleaver[cb_idx][rv_idx];
-#endif
 
     // TODO: AVX version of rm_turbo_rx_lut not working
     // Warning: Need to check if 8-bit sse version is correct
@@ -482,7 +673,7 @@ int srslte_rm_turbo_rx_lut_8bit(int8_t* input, int8_t* output, uint32_t in_len,
     uint32_t  out_len = 3 * srslte_cbsegm_cbsize(cb_idx) + 12;
 
     for (int i = 0; i < in_len; i++) {
-      output[deinter[i % out_len]] += input[i];
+      output[deinter[i % out_len]] = rm_turbo_sadd_8bit(output[deinter[i % out_len]], input[i]);
     }
     return 0;
 #endif
@@ -492,6 +683,94 @@ int srslte_rm_turbo_rx_lut_8bit(int8_t* input, int8_t* output, uint32_t in_len,
   }
 }
 
+/**
+ * Undoes rate matching for a segment of the received code block, starting at LLR in_offset of the rate matched
+ * sequence. Used to accumulate the soft-buffer tile by tile while the LLRs are being generated, so the complete rate
+ * matched sequence never needs to be stored.
+ *
+ * @param[in] input Input buffer of size in_len
+ * @param[out] output Output buffer of size 3*srslte_cbsegm_cbsize(cb_idx)+12
+ * @param[in] in_len Number of LLRs in the segment
+ * @param[in] in_offset Position of the first input LLR in the rate matched sequence of the code block
+ * @param[in] cb_idx Code block table index
+ * @param[in] rv_idx Redundancy Version from DCI control message
+ * @return Error code
+ */
+int srslte_rm_turbo_rx_lut_offset(int16_t* input,
+                                  int16_t* output,
+                                  uint32_t in_len,
+                                  uint32_t in_offset,
+                                  uint32_t cb_idx,
+                                  uint32_t rv_idx)
+{
+  if (rv_idx < 4 && cb_idx < SRSLTE_NOF_TC_CB_SIZES) {
+    uint32_t  out_len = 3 * srslte_cbsegm_cbsize(cb_idx) + 12;
+    uint16_t* deinter =
+        rm_turbo_rx_deinter_table(cb_idx, rv_idx, srslte_tdec_autoimp_get_subblocks(srslte_cbsegm_cbsize(cb_idx)));
+    if (!deinter) {
+      return -1;
+    }
+
+    // Split the segment where the circular buffer wraps, so that every call runs the no-wrap kernel
+    uint32_t k = in_offset % out_len;
+    for (uint32_t i = 0; i < in_len;) {
+      uint32_t n = SRSLTE_MIN(in_len - i, out_len - k);
+#ifdef LV_HAVE_AVX
+      srslte_rm_turbo_rx_lut_avx(&input[i], output, &deinter[k], n, cb_idx, rv_idx);
+#else
+#ifdef LV_HAVE_SSE
+      srslte_rm_turbo_rx_lut_sse(&input[i], output, &deinter[k], n, cb_idx, rv_idx);
+#else
+      for (uint32_t j = 0; j < n; j++) {
+        output[deinter[k + j]] += input[i + j];
+      }
+#endif
+#endif
+      i += n;
+      k = 0;
+    }
+    return 0;
+  } else {
+    printf("Invalid inputs rv_idx=%d, cb_idx=%d\n", rv_idx, cb_idx);
+    return SRSLTE_ERROR_INVALID_INPUTS;
+  }
+}
+
+int srslte_rm_turbo_rx_lut_8bit_offset(int8_t*  input,
+                                       int8_t*  output,
+                                       uint32_t in_len,
+                                       uint32_t in_offset,
+                                       uint32_t cb_idx,
+                                       uint32_t rv_idx)
+{
+  if (rv_idx < 4 && cb_idx < SRSLTE_NOF_TC_CB_SIZES) {
+    uint32_t  out_len = 3 * srslte_cbsegm_cbsize(cb_idx) + 12;
+    uint16_t* deinter =
+        rm_turbo_rx_deinter_table(cb_idx, rv_idx, srslte_tdec_autoimp_get_subblocks_8bit(srslte_cbsegm_cbsize(cb_idx)));
+    if (!deinter) {
+      return -1;
+    }
+
+    uint32_t k = in_offset % out_len;
+    for (uint32_t i = 0; i < in_len;) {
+      uint32_t n = SRSLTE_MIN(in_len - i, out_len - k);
+#ifdef LV_HAVE_SSE
+      srslte_rm_turbo_rx_lut_sse_8bit(&input[i], output, &deinter[k], n, cb_idx, rv_idx);
+#else
+      for (uint32_t j = 0; j < n; j++) {
+        output[deinter[k + j]] = rm_turbo_sadd_8bit(output[deinter[k + j]], input[i + j]);
+      }
+#endif
+      i += n;
+      k = 0;
+    }
+    return 0;
+  } else {
+    printf("Invalid inputs rv_idx=%d, cb_idx=%d\n", rv_idx, cb_idx);
+    return SRSLTE_ERROR_INVALID_INPUTS;
+  }
+}
+
 #ifdef LV_HAVE_SSE
 
 #define SAVE_OUTPUT_16_SSE(j)                                                                                          \
@@ -586,12 +865,12 @@ int srslte_rm_turbo_rx_lut_sse(int16_t*  input,
 #define SAVE_OUTPUT_SSE_8(j)                                                                                           \
   x = (int8_t)_mm_extract_epi8(xVal, j);                                                                               \
   l = (uint16_t)_mm_extract_epi16(lutVal1, j);                                                                         \
-  output[l] += x;
+  output[l] = rm_turbo_sadd_8bit(output[l], x);
 
 #define SAVE_OUTPUT_SSE_8_2(j)                                                                                         \
   x = (int8_t)_mm_extract_epi8(xVal, j + 8);                                                                           \
   l = (uint16_t)_mm_extract_epi16(lutVal2, j);                                                                         \
-  output[l] += x;
+  output[l] = rm_turbo_sadd_8bit(output[l], x);
 
 int srslte_rm_turbo_rx_lut_sse_8bit(int8_t*   input,
                                     int8_t*   output,
@@ -639,7 +918,7 @@ int srslte_rm_turbo_rx_lut_sse_8bit(int8_t*   input,
         SAVE_OUTPUT_SSE_8_2(7);
       }
       for (int i = 16 * (in_len / 16); i < in_len; i++) {
-        output[deinter[i % out_len]] += input[i];
+        output[deinter[i % out_len]] = rm_turbo_sadd_8bit(output[deinter[i % out_len]], input[i]);
       }
     } else {
       int intCnt   = 16;
@@ -677,12 +956,12 @@ int srslte_rm_turbo_rx_lut_sse_8bit(int8_t*   input,
           /* Copy last elements */
           if ((out_len % 16) == 12) {
             for (int j = (nwrapps + 1) * out_len - 12; j < (nwrapps + 1) * out_len; j++) {
-              output[deinter[j % out_len]] += input[j];
+              output[deinter[j % out_len]] = rm_turbo_sadd_8bit(output[deinter[j % out_len]], input[j]);
               inputCnt++;
             }
           } else {
             for (int j = (nwrapps + 1) * out_len - 4; j < (nwrapps + 1) * out_len; j++) {
-              output[deinter[j % out_len]] += input[j];
+              output[deinter[j % out_len]] = rm_turbo_sadd_8bit(output[deinter[j % out_len]], input[j]);
               inputCnt++;
             }
           }
@@ -694,7 +973,7 @@ int srslte_rm_turbo_rx_lut_sse_8bit(int8_t*   input,
         }
       }
       for (int i = inputCnt; i < in_len; i++) {
-        output[deinter[i % out_len]] += input[i];
+        output[deinter[i % out_len]] = rm_turbo_sadd_8bit(output[deinter[i % out_len]], input[i]);
       }
     }
 
@@ -823,12 +1102,12 @@ int srslte_rm_turbo_rx_lut_avx(int16_t*  input,
 #define SAVE_OUTPUT8(j)                                                                                                \
   x = (int8_t)_mm256_extract_epi8(xVal, j);                                                                            \
   l = (uint16_t)_mm256_extract_epi16(lutVal1, j);                                                                      \
-  output[l] += x;
+  output[l] = rm_turbo_sadd_8bit(output[l], x);
 
 #define SAVE_OUTPUT8_2(j)                                                                                              \
   x = (int8_t)_mm256_extract_epi8(xVal, j + 8);                                                                        \
   l = (uint16_t)_mm256_extract_epi16(lutVal2, j);                                                                      \
-  output[l] += x;
+  output[l] = rm_turbo_sadd_8bit(output[l], x);
 
 int srslte_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
                                     int8_t*   output,
@@ -894,7 +1173,7 @@ int srslte_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
         SAVE_OUTPUT8_2(15);
       }
       for (int i = 32 * (in_len / 32); i < in_len; i++) {
-        output[deinter[i % out_len]] += input[i];
+        output[deinter[i % out_len]] = rm_turbo_sadd_8bit(output[deinter[i % out_len]], input[i]);
       }
     } else {
       printf("wraps not implemented!\n");
@@ -952,7 +1231,7 @@ int srslte_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
           printf("warning rate matching wrapping remainder %d\n", out_len % 32);
           /* Copy last elements */
           for (int j = (nwrapps + 1) * out_len - (out_len % 32); j < (nwrapps + 1) * out_len; j++) {
-            output[deinter[j % out_len]] += input[j];
+            output[deinter[j % out_len]] = rm_turbo_sadd_8bit(output[deinter[j % out_len]], input[j]);
             inputCnt++;
           }
           /* And wrap pointers */
@@ -963,7 +1242,7 @@ int srslte_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
         }
       }
       for (int i = inputCnt; i < in_len; i++) {
-        output[deinter[i % out_len]] += input[i];
+        output[deinter[i % out_len]] = rm_turbo_sadd_8bit(output[deinter[i % out_len]], input[i]);
       }
 #endif
     }
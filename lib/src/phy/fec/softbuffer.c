@@ -38,7 +38,79 @@
 
 #define MAX_PDSCH_RE(cp) (2 * SRSLTE_CP_NSYMB(cp) * 12)
 
-int srslte_softbuffer_rx_init(srslte_softbuffer_rx_t* q, uint32_t nof_prb)
+/* Code block buffers taken from a pool are kept 64-byte aligned for the SIMD rate dematching */
+#define SOFTBUFFER_POOL_ALIGN 64
+
+int srslte_softbuffer_rx_pool_init(srslte_softbuffer_rx_pool_t* pool, uint32_t nof_cb, bool is_8bit)
+{
+  if (pool == NULL || nof_cb == 0) {
+    return SRSLTE_ERROR_INVALID_INPUTS;
+  }
+
+  bzero(pool, sizeof(srslte_softbuffer_rx_pool_t));
+
+  uint32_t cb_size = SOFTBUFFER_SIZE * (is_8bit ? sizeof(int8_t) : sizeof(int16_t));
+  pool->cb_size    = SOFTBUFFER_POOL_ALIGN * ((cb_size + SOFTBUFFER_POOL_ALIGN - 1) / SOFTBUFFER_POOL_ALIGN);
+  pool->nof_cb     = nof_cb;
+  pool->is_8bit    = is_8bit;
+
+  pool->mem = srslte_vec_malloc(pool->cb_size * nof_cb);
+  if (!pool->mem) {
+    perror("malloc");
+    goto clean_exit;
+  }
+
+  pool->free_cb = srslte_vec_malloc(sizeof(void*) * nof_cb);
+  if (!pool->free_cb) {
+    perror("malloc");
+    goto clean_exit;
+  }
+
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    pool->free_cb[i] = &pool->mem[(nof_cb - i - 1) * pool->cb_size];
+  }
+  pool->nof_free = nof_cb;
+
+  pthread_mutex_init(&pool->mutex, NULL);
+
+  return SRSLTE_SUCCESS;
+
+clean_exit:
+  if (pool->mem) {
+    free(pool->mem);
+  }
+  if (pool->free_cb) {
+    free(pool->free_cb);
+  }
+  bzero(pool, sizeof(srslte_softbuffer_rx_pool_t));
+  return SRSLTE_ERROR;
+}
+
+void srslte_softbuffer_rx_pool_free(srslte_softbuffer_rx_pool_t* pool)
+{
+  if (pool && pool->mem) {
+    if (pool->nof_free != pool->nof_cb) {
+      ERROR("Freeing soft-buffer pool with %d code blocks in use\n", pool->nof_cb - pool->nof_free);
+    }
+    free(pool->mem);
+    free(pool->free_cb);
+    pthread_mutex_destroy(&pool->mutex);
+    bzero(pool, sizeof(srslte_softbuffer_rx_pool_t));
+  }
+}
+
+uint32_t srslte_softbuffer_rx_pool_nof_free(srslte_softbuffer_rx_pool_t* pool)
+{
+  uint32_t nof_free = 0;
+  if (pool && pool->mem) {
+    pthread_mutex_lock(&pool->mutex);
+    nof_free = pool->nof_free;
+    pthread_mutex_unlock(&pool->mutex);
+  }
+  return nof_free;
+}
+
+static int softbuffer_rx_init(srslte_softbuffer_rx_t* q, uint32_t nof_prb, srslte_softbuffer_rx_pool_t* pool)
 {
   int ret = SRSLTE_ERROR_INVALID_INPUTS;
 
@@ -55,12 +127,14 @@ int srslte_softbuffer_rx_init(srslte_softbuffer_rx_t* q, uint32_t nof_prb)
         perror("malloc");
         goto clean_exit;
       }
+      bzero(q->buffer_f, sizeof(int16_t*) * q->max_cb);
 
       q->data = srslte_vec_malloc(sizeof(uint8_t*) * q->max_cb);
       if (!q->data) {
         perror("malloc");
         goto clean_exit;
       }
+      bzero(q->data, sizeof(uint8_t*) * q->max_cb);
 
       q->cb_crc = srslte_vec_malloc(sizeof(bool) * q->max_cb);
       if (!q->cb_crc) {
@@ -69,12 +143,17 @@ int srslte_softbuffer_rx_init(srslte_softbuffer_rx_t* q, uint32_t nof_prb)
       }
       bzero(q->cb_crc, sizeof(bool) * q->max_cb);
 
+      // Pooled soft-buffers take the code block buffers on demand
+      q->pool = pool;
+
       // TODO: Use HARQ buffer limitation based on UE category
       for (uint32_t i = 0; i < q->max_cb; i++) {
-        q->buffer_f[i] = srslte_vec_malloc(sizeof(int16_t) * SOFTBUFFER_SIZE);
-        if (!q->buffer_f[i]) {
-          perror("malloc");
-          goto clean_exit;
+        if (!q->pool) {
+          q->buffer_f[i] = srslte_vec_malloc(sizeof(int16_t) * SOFTBUFFER_SIZE);
+          if (!q->buffer_f[i]) {
+            perror("malloc");
+            goto clean_exit;
+          }
         }
 
         q->data[i] = srslte_vec_malloc(sizeof(uint8_t) * 6144 / 8);
@@ -96,12 +175,69 @@ clean_exit:
   return ret;
 }
 
+int srslte_softbuffer_rx_init(srslte_softbuffer_rx_t* q, uint32_t nof_prb)
+{
+  return softbuffer_rx_init(q, nof_prb, NULL);
+}
+
+int srslte_softbuffer_rx_init_pool(srslte_softbuffer_rx_t* q, uint32_t nof_prb, srslte_softbuffer_rx_pool_t* pool)
+{
+  if (pool == NULL || pool->mem == NULL) {
+    return SRSLTE_ERROR_INVALID_INPUTS;
+  }
+  return softbuffer_rx_init(q, nof_prb, pool);
+}
+
+int srslte_softbuffer_rx_alloc_cb(srslte_softbuffer_rx_t* q, uint32_t cb_idx)
+{
+  if (q == NULL || cb_idx >= q->max_cb) {
+    return SRSLTE_ERROR_INVALID_INPUTS;
+  }
+
+  if (q->buffer_f[cb_idx]) {
+    return SRSLTE_SUCCESS;
+  }
+
+  if (!q->pool) {
+    return SRSLTE_ERROR;
+  }
+
+  void* cb = NULL;
+  pthread_mutex_lock(&q->pool->mutex);
+  if (q->pool->nof_free) {
+    cb = q->pool->free_cb[--q->pool->nof_free];
+  }
+  pthread_mutex_unlock(&q->pool->mutex);
+
+  if (!cb) {
+    return SRSLTE_ERROR;
+  }
+
+  // A new code block starts from zero soft bits
+  bzero(cb, q->pool->cb_size);
+  q->buffer_f[cb_idx] = cb;
+
+  return SRSLTE_SUCCESS;
+}
+
+void srslte_softbuffer_rx_release_cb(srslte_softbuffer_rx_t* q, uint32_t cb_idx)
+{
+  if (q && q->pool && q->buffer_f && cb_idx < q->max_cb && q->buffer_f[cb_idx]) {
+    pthread_mutex_lock(&q->pool->mutex);
+    q->pool->free_cb[q->pool->nof_free++] = q->buffer_f[cb_idx];
+    pthread_mutex_unlock(&q->pool->mutex);
+    q->buffer_f[cb_idx] = NULL;
+  }
+}
+
 void srslte_softbuffer_rx_free(srslte_softbuffer_rx_t* q)
 {
   if (q) {
     if (q->buffer_f) {
       for (uint32_t i = 0; i < q->max_cb; i++) {
-        if (q->buffer_f[i]) {
+        if (q->pool) {
+          srslte_softbuffer_rx_release_cb(q, i);
+        } else if (q->buffer_f[i]) {
           free(q->buffer_f[i]);
         }
       }
@@ -139,6 +275,12 @@ void srslte_softbuffer_rx_reset_cb(srslte_softbuffer_rx_t* q, uint32_t nof_cb)
     if (nof_cb > q->max_cb) {
       nof_cb = q->max_cb;
     }
+    if (q->pool) {
+      // Give back every code block, they are taken again (zeroed) when the new transport block is decoded
+      for (uint32_t i = 0; i < q->max_cb; i++) {
+        srslte_softbuffer_rx_release_cb(q, i);
+      }
+    }
     for (uint32_t i = 0; i < nof_cb; i++) {
       if (q->buffer_f[i]) {
         bzero(q->buffer_f[i], SOFTBUFFER_SIZE * sizeof(int16_t));
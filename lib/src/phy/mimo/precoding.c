@@ -62,6 +62,100 @@ int srslte_predecoding_single_avx(cf_t* y[SRSLTE_MAX_PORTS],
 
 static srslte_mimo_decoder_t mimo_decoder = SRSLTE_MIMO_DECODER_MMSE;
 
+/* 36.211 Table 6.3.4.2.3-2: Householder vectors u_n of the codebook for transmission on antenna ports {0,1,2,3} */
+static const cf_t codebook_4p_u[16][4] = {
+    {1, -1, -1, -1},
+    {1, -_Complex_I, 1, _Complex_I},
+    {1, 1, -1, 1},
+    {1, _Complex_I, 1, -_Complex_I},
+    {1, (-1 - _Complex_I) * M_SQRT1_2, -_Complex_I, (1 - _Complex_I) * M_SQRT1_2},
+    {1, (1 - _Complex_I) * M_SQRT1_2, _Complex_I, (-1 - _Complex_I) * M_SQRT1_2},
+    {1, (1 + _Complex_I) * M_SQRT1_2, -_Complex_I, (-1 + _Complex_I) * M_SQRT1_2},
+    {1, (-1 + _Complex_I) * M_SQRT1_2, _Complex_I, (1 + _Complex_I) * M_SQRT1_2},
+    {1, -1, 1, 1},
+    {1, -_Complex_I, -1, -_Complex_I},
+    {1, 1, 1, -1},
+    {1, _Complex_I, -1, _Complex_I},
+    {1, -1, -1, 1},
+    {1, -1, 1, -1},
+    {1, 1, -1, -1},
+    {1, 1, 1, 1}};
+
+/* 36.211 Table 6.3.4.2.3-2: Columns of W_n selected for each number of layers (zero based) */
+static const uint8_t codebook_4p_columns[4][16][4] = {
+    {{0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}},
+    {{0, 3},
+     {0, 1},
+     {0, 1},
+     {0, 1},
+     {0, 3},
+     {0, 3},
+     {0, 2},
+     {0, 2},
+     {0, 1},
+     {0, 3},
+     {0, 2},
+     {0, 2},
+     {0, 1},
+     {0, 2},
+     {0, 2},
+     {0, 1}},
+    {{0, 1, 3},
+     {0, 1, 2},
+     {0, 1, 2},
+     {0, 1, 2},
+     {0, 1, 3},
+     {0, 1, 3},
+     {0, 2, 3},
+     {0, 2, 3},
+     {0, 1, 3},
+     {0, 2, 3},
+     {0, 1, 2},
+     {0, 2, 3},
+     {0, 1, 2},
+     {0, 1, 2},
+     {0, 1, 2},
+     {0, 1, 2}},
+    {{0, 1, 2, 3},
+     {0, 1, 2, 3},
+     {2, 1, 0, 3},
+     {2, 1, 0, 3},
+     {0, 1, 2, 3},
+     {0, 1, 2, 3},
+     {0, 2, 1, 3},
+     {0, 2, 1, 3},
+     {0, 1, 2, 3},
+     {0, 1, 2, 3},
+     {0, 2, 1, 3},
+     {0, 2, 1, 3},
+     {0, 1, 2, 3},
+     {0, 2, 1, 3},
+     {2, 1, 0, 3},
+     {0, 1, 2, 3}}};
+
+/* Computes the precoding matrix W (ports x layers) for 4 antenna ports, W_n = I - 2 u_n u_n' / (u_n' u_n) with the
+ * selected columns and normalised by the square root of the number of layers */
+static int codebook_4p_matrix(uint32_t codebook_idx, uint32_t nof_layers, cf_t W[SRSLTE_MAX_PORTS][SRSLTE_MAX_LAYERS])
+{
+  if (codebook_idx > 15 || nof_layers == 0 || nof_layers > 4) {
+    ERROR("Invalid 4 port codebook_idx=%d for %d layers\n", codebook_idx, nof_layers);
+    return SRSLTE_ERROR;
+  }
+
+  const cf_t* u    = codebook_4p_u[codebook_idx];
+  float       norm = 1.0f / sqrtf((float)nof_layers);
+
+  for (uint32_t p = 0; p < 4; p++) {
+    for (uint32_t l = 0; l < nof_layers; l++) {
+      uint32_t c = codebook_4p_columns[nof_layers - 1][codebook_idx][l];
+      W[p][l]    = ((p == c) ? 1.0f : 0.0f) - u[p] * conjf(u[c]) * 0.5f; // u_n' u_n = 4 for all the codebook
+      W[p][l] *= norm;
+    }
+  }
+
+  return SRSLTE_SUCCESS;
+}
+
 /************************************************
  *
  * RECEIVER SIDE FUNCTIONS
@@ -1821,6 +1915,267 @@ static int srslte_predecoding_multiplex_2x1_mrc_csi(cf_t*  y[SRSLTE_MAX_PORTS],
   return SRSLTE_SUCCESS;
 }
 
+#if SRSLTE_SIMD_CF_SIZE != 0
+
+/* Reciprocal refined with one Newton-Raphson iteration, the estimate alone is not accurate enough for inverting
+ * matrices larger than 2x2 */
+static inline simd_cf_t srslte_simd_cf_rcp_nr(simd_cf_t a)
+{
+  simd_cf_t r = srslte_simd_cf_rcp(a);
+  return srslte_simd_cf_prod(r, srslte_simd_cf_sub(srslte_simd_cf_set1(2.0f), srslte_simd_cf_prod(a, r)));
+}
+
+#endif /* SRSLTE_SIMD_CF_SIZE != 0 */
+
+/* Stores the CSI of a layer in the codeword it belongs to, according to 36.211 Table 6.3.3.2-1 */
+static inline void multiplex_4p_set_csi(float* csi[SRSLTE_MAX_CODEWORDS], int nof_layers, int l, int i, float value)
+{
+  int nof_layers_cw0 = (nof_layers == 1) ? 1 : nof_layers / 2;
+
+  if (l < nof_layers_cw0) {
+    if (csi[0]) {
+      csi[0][nof_layers_cw0 * i + l] = value;
+    }
+  } else {
+    if (csi[1]) {
+      csi[1][(nof_layers - nof_layers_cw0) * i + l - nof_layers_cw0] = value;
+    }
+  }
+}
+
+#if SRSLTE_SIMD_CF_SIZE != 0
+
+/* SIMD kernel of srslte_predecoding_multiplex_4p(), returns the number of processed symbols. It is inlined with constant
+ * number of layers so the loops are unrolled and the matrices kept in registers. */
+static inline int predecoding_multiplex_4p_simd(cf_t*  y[SRSLTE_MAX_PORTS],
+                                                cf_t*  h[SRSLTE_MAX_PORTS][SRSLTE_MAX_PORTS],
+                                                cf_t*  x[SRSLTE_MAX_LAYERS],
+                                                float* csi[SRSLTE_MAX_CODEWORDS],
+                                                bool   csi_en,
+                                                cf_t   W[SRSLTE_MAX_PORTS][SRSLTE_MAX_LAYERS],
+                                                int    nof_rxant,
+                                                int    nof_layers,
+                                                int    nof_symbols,
+                                                float  noise_estimate,
+                                                float  norm)
+{
+  int i = 0;
+
+  simd_cf_t _W[SRSLTE_MAX_PORTS][SRSLTE_MAX_LAYERS];
+  for (int p = 0; p < 4; p++) {
+    for (int l = 0; l < nof_layers; l++) {
+      _W[p][l] = srslte_simd_cf_set1(W[p][l]);
+    }
+  }
+  simd_cf_t _noise_estimate = srslte_simd_cf_set1(noise_estimate);
+  simd_f_t  _norm           = srslte_simd_f_set1(norm);
+
+  for (; i < nof_symbols - SRSLTE_SIMD_CF_SIZE + 1; i += SRSLTE_SIMD_CF_SIZE) {
+    simd_cf_t g[SRSLTE_MAX_PORTS][SRSLTE_MAX_LAYERS];
+    simd_cf_t a[SRSLTE_MAX_LAYERS][SRSLTE_MAX_LAYERS];
+    simd_cf_t b[SRSLTE_MAX_LAYERS][SRSLTE_MAX_LAYERS];
+    simd_cf_t z[SRSLTE_MAX_LAYERS];
+
+    /* 1. G = H x W */
+    for (int r = 0; r < nof_rxant; r++) {
+      for (int l = 0; l < nof_layers; l++) {
+        g[r][l] = srslte_simd_cf_zero();
+      }
+      for (int p = 0; p < 4; p++) {
+        simd_cf_t hpr = srslte_simd_cfi_load(&h[p][r][i]);
+        for (int l = 0; l < nof_layers; l++) {
+          g[r][l] = srslte_simd_cf_add(g[r][l], srslte_simd_cf_prod(hpr, _W[p][l]));
+        }
+      }
+    }
+
+    /* 2. A = G' x G + No, Z = G' x Y and B = I */
+    for (int l = 0; l < nof_layers; l++) {
+      z[l] = srslte_simd_cf_zero();
+      for (int m = 0; m < nof_layers; m++) {
+        a[l][m] = (l == m) ? _noise_estimate : srslte_simd_cf_zero();
+        b[l][m] = srslte_simd_cf_set1((l == m) ? 1.0f : 0.0f);
+      }
+    }
+    for (int r = 0; r < nof_rxant; r++) {
+      simd_cf_t yr = srslte_simd_cfi_load(&y[r][i]);
+      for (int l = 0; l < nof_layers; l++) {
+        for (int m = l; m < nof_layers; m++) {
+          a[l][m] = srslte_simd_cf_add(a[l][m], srslte_simd_cf_conjprod(g[r][m], g[r][l]));
+        }
+        z[l] = srslte_simd_cf_add(z[l], srslte_simd_cf_conjprod(yr, g[r][l]));
+      }
+    }
+    for (int l = 1; l < nof_layers; l++) {
+      for (int m = 0; m < l; m++) {
+        a[l][m] = srslte_simd_cf_conj(a[m][l]);
+      }
+    }
+
+    /* 3. Gauss-Jordan elimination, [A | Z | B] -> [I | inv(A) x Z | inv(A)] */
+    for (int k = 0; k < nof_layers; k++) {
+      simd_cf_t pivot = srslte_simd_cf_rcp_nr(a[k][k]);
+      for (int m = k + 1; m < nof_layers; m++) {
+        a[k][m] = srslte_simd_cf_prod(a[k][m], pivot);
+      }
+      z[k] = srslte_simd_cf_prod(z[k], pivot);
+      if (csi_en) {
+        for (int m = 0; m < nof_layers; m++) {
+          b[k][m] = srslte_simd_cf_prod(b[k][m], pivot);
+        }
+      }
+
+      for (int l = 0; l < nof_layers; l++) {
+        if (l != k) {
+          simd_cf_t f = a[l][k];
+          for (int m = k + 1; m < nof_layers; m++) {
+            a[l][m] = srslte_simd_cf_sub(a[l][m], srslte_simd_cf_prod(f, a[k][m]));
+          }
+          z[l] = srslte_simd_cf_sub(z[l], srslte_simd_cf_prod(f, z[k]));
+          if (csi_en) {
+            for (int m = 0; m < nof_layers; m++) {
+              b[l][m] = srslte_simd_cf_sub(b[l][m], srslte_simd_cf_prod(f, b[k][m]));
+            }
+          }
+        }
+      }
+    }
+
+    /* 4. Store layers and CSI */
+    for (int l = 0; l < nof_layers; l++) {
+      srslte_simd_cfi_store(&x[l][i], srslte_simd_cf_mul(z[l], _norm));
+    }
+
+    if (csi_en) {
+      for (int l = 0; l < nof_layers; l++) {
+        cf_t b_ll[SRSLTE_SIMD_CF_SIZE];
+        srslte_simd_cfi_storeu(b_ll, b[l][l]);
+        for (int k = 0; k < SRSLTE_SIMD_CF_SIZE; k++) {
+          multiplex_4p_set_csi(csi, nof_layers, l, i + k, 1.0f / (crealf(b_ll[k]) * norm));
+        }
+      }
+    }
+  }
+
+  return i;
+}
+
+#endif /* SRSLTE_SIMD_CF_SIZE != 0 */
+
+/* Spatial multiplexing equalizer for 4 antenna ports and up to 4 layers and receive antennas. The precoding matrix is
+ * merged into the channel, G = H x W, and the layers are given by X = inv(G' x G + No) x G' x Y, which is MRC for a
+ * single layer and ZF when No is 0. The inverse is computed with Gauss-Jordan elimination without pivoting, G' x G
+ * is Hermitian and positive definite. */
+static int srslte_predecoding_multiplex_4p(cf_t*  y[SRSLTE_MAX_PORTS],
+                                           cf_t*  h[SRSLTE_MAX_PORTS][SRSLTE_MAX_PORTS],
+                                           cf_t*  x[SRSLTE_MAX_LAYERS],
+                                           float* csi[SRSLTE_MAX_CODEWORDS],
+                                           int    nof_rxant,
+                                           int    nof_layers,
+                                           int    codebook_idx,
+                                           int    nof_symbols,
+                                           float  scaling,
+                                           float  noise_estimate)
+{
+  cf_t  W[SRSLTE_MAX_PORTS][SRSLTE_MAX_LAYERS];
+  float norm   = 1.0f / scaling;
+  bool  csi_en = csi && (csi[0] || csi[1]);
+  int   i      = 0;
+
+  if (nof_rxant < nof_layers) {
+    ERROR("Error predecoding multiplex: %d layers can not be received with %d antennas\n", nof_layers, nof_rxant);
+    return SRSLTE_ERROR;
+  }
+
+  if (codebook_4p_matrix(codebook_idx, nof_layers, W)) {
+    return SRSLTE_ERROR;
+  }
+
+  if (mimo_decoder == SRSLTE_MIMO_DECODER_ZF) {
+    noise_estimate = 0.0f;
+  }
+
+#if SRSLTE_SIMD_CF_SIZE != 0
+  switch (nof_layers) {
+    case 1:
+      i = predecoding_multiplex_4p_simd(y, h, x, csi, csi_en, W, nof_rxant, 1, nof_symbols, noise_estimate, norm);
+      break;
+    case 2:
+      i = predecoding_multiplex_4p_simd(y, h, x, csi, csi_en, W, nof_rxant, 2, nof_symbols, noise_estimate, norm);
+      break;
+    case 3:
+      i = predecoding_multiplex_4p_simd(y, h, x, csi, csi_en, W, nof_rxant, 3, nof_symbols, noise_estimate, norm);
+      break;
+    default:
+      i = predecoding_multiplex_4p_simd(y, h, x, csi, csi_en, W, nof_rxant, 4, nof_symbols, noise_estimate, norm);
+      break;
+  }
+#endif /* SRSLTE_SIMD_CF_SIZE != 0 */
+
+  for (; i < nof_symbols; i++) {
+    cf_t g[SRSLTE_MAX_PORTS][SRSLTE_MAX_LAYERS];
+    cf_t a[SRSLTE_MAX_LAYERS][SRSLTE_MAX_LAYERS];
+    cf_t b[SRSLTE_MAX_LAYERS][SRSLTE_MAX_LAYERS];
+    cf_t z[SRSLTE_MAX_LAYERS];
+
+    for (int r = 0; r < nof_rxant; r++) {
+      for (int l = 0; l < nof_layers; l++) {
+        g[r][l] = 0;
+        for (int p = 0; p < 4; p++) {
+          g[r][l] += h[p][r][i] * W[p][l];
+        }
+      }
+    }
+
+    for (int l = 0; l < nof_layers; l++) {
+      z[l] = 0;
+      for (int m = 0; m < nof_layers; m++) {
+        a[l][m] = (l == m) ? noise_estimate : 0;
+        b[l][m] = (l == m) ? 1 : 0;
+        for (int r = 0; r < nof_rxant; r++) {
+          a[l][m] += conjf(g[r][l]) * g[r][m];
+        }
+      }
+      for (int r = 0; r < nof_rxant; r++) {
+        z[l] += conjf(g[r][l]) * y[r][i];
+      }
+    }
+
+    for (int k = 0; k < nof_layers; k++) {
+      cf_t pivot = 1.0f / a[k][k];
+      for (int m = k + 1; m < nof_layers; m++) {
+        a[k][m] *= pivot;
+      }
+      z[k] *= pivot;
+      for (int m = 0; m < nof_layers; m++) {
+        b[k][m] *= pivot;
+      }
+
+      for (int l = 0; l < nof_layers; l++) {
+        if (l != k) {
+          cf_t f = a[l][k];
+          for (int m = k + 1; m < nof_layers; m++) {
+            a[l][m] -= f * a[k][m];
+          }
+          z[l] -= f * z[k];
+          for (int m = 0; m < nof_layers; m++) {
+            b[l][m] -= f * b[k][m];
+          }
+        }
+      }
+    }
+
+    for (int l = 0; l < nof_layers; l++) {
+      x[l][i] = z[l] * norm;
+      if (csi_en) {
+        multiplex_4p_set_csi(csi, nof_layers, l, i, 1.0f / (crealf(b[l][l]) * norm));
+      }
+    }
+  }
+
+  return SRSLTE_SUCCESS;
+}
+
 static int srslte_predecoding_multiplex(cf_t*  y[SRSLTE_MAX_PORTS],
                                         cf_t*  h[SRSLTE_MAX_PORTS][SRSLTE_MAX_PORTS],
                                         cf_t*  x[SRSLTE_MAX_LAYERS],
@@ -1860,7 +2215,8 @@ static int srslte_predecoding_multiplex(cf_t*  y[SRSLTE_MAX_PORTS],
       }
     }
   } else if (nof_ports == 4) {
-    ERROR("Error predecoding multiplex: not implemented for %d Tx ports", nof_ports);
+    return srslte_predecoding_multiplex_4p(
+        y, h, x, csi, nof_rxant, nof_layers, codebook_idx, nof_symbols, scaling, noise_estimate);
   } else {
     ERROR("Error predecoding multiplex: Invalid combination of ports %d and rx antennas %d\n", nof_ports, nof_rxant);
   }
@@ -2095,6 +2451,63 @@ int srslte_precoding_cdd(cf_t* x[SRSLTE_MAX_LAYERS],
   }
 }
 
+/* Spatial multiplexing precoder for 4 antenna ports, Y = W x X */
+static int srslte_precoding_multiplex_4p(cf_t*    x[SRSLTE_MAX_LAYERS],
+                                         cf_t*    y[SRSLTE_MAX_PORTS],
+                                         int      nof_layers,
+                                         int      codebook_idx,
+                                         uint32_t nof_symbols,
+                                         float    scaling)
+{
+  cf_t W[SRSLTE_MAX_PORTS][SRSLTE_MAX_LAYERS];
+  int  i = 0;
+
+  if (codebook_4p_matrix(codebook_idx, nof_layers, W)) {
+    return SRSLTE_ERROR;
+  }
+
+  for (int p = 0; p < 4; p++) {
+    for (int l = 0; l < nof_layers; l++) {
+      W[p][l] *= scaling;
+    }
+  }
+
+#if SRSLTE_SIMD_CF_SIZE != 0
+  simd_cf_t _W[SRSLTE_MAX_PORTS][SRSLTE_MAX_LAYERS];
+  for (int p = 0; p < 4; p++) {
+    for (int l = 0; l < nof_layers; l++) {
+      _W[p][l] = srslte_simd_cf_set1(W[p][l]);
+    }
+  }
+
+  for (; i < (int)nof_symbols - SRSLTE_SIMD_CF_SIZE + 1; i += SRSLTE_SIMD_CF_SIZE) {
+    simd_cf_t _x[SRSLTE_MAX_LAYERS];
+    for (int l = 0; l < nof_layers; l++) {
+      _x[l] = srslte_simd_cfi_load(&x[l][i]);
+    }
+
+    for (int p = 0; p < 4; p++) {
+      simd_cf_t _y = srslte_simd_cf_prod(_x[0], _W[p][0]);
+      for (int l = 1; l < nof_layers; l++) {
+        _y = srslte_simd_cf_add(_y, srslte_simd_cf_prod(_x[l], _W[p][l]));
+      }
+      srslte_simd_cfi_store(&y[p][i], _y);
+    }
+  }
+#endif /* SRSLTE_SIMD_CF_SIZE != 0 */
+
+  for (; i < nof_symbols; i++) {
+    for (int p = 0; p < 4; p++) {
+      y[p][i] = x[0][i] * W[p][0];
+      for (int l = 1; l < nof_layers; l++) {
+        y[p][i] += x[l][i] * W[p][l];
+      }
+    }
+  }
+
+  return SRSLTE_SUCCESS;
+}
+
 int srslte_precoding_multiplex(cf_t*    x[SRSLTE_MAX_LAYERS],
                                cf_t*    y[SRSLTE_MAX_PORTS],
                                int      nof_layers,
@@ -2215,6 +2628,8 @@ int srslte_precoding_multiplex(cf_t*    x[SRSLTE_MAX_LAYERS],
     } else {
       ERROR("Not implemented");
     }
+  } else if (nof_ports == 4) {
+    return srslte_precoding_multiplex_4p(x, y, nof_layers, codebook_idx, nof_symbols, scaling);
   } else {
     ERROR("Not implemented");
   }
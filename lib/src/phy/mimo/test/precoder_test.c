@@ -330,9 +330,10 @@ int main(int argc, char** argv)
       }
     }
   }
-  printf("SNR: %5.1fdB;\tExecution time: %5ldus;\tMSE: %.6f;\tBER: %.6f\n",
+  printf("SNR: %5.1fdB;\tExecution time: %5ldus (%.3f us/PRB);\tMSE: %.6f;\tBER: %.6f\n",
          snr_db,
          t[0].tv_usec,
+         (float)t[0].tv_usec * SRSLTE_NRE * SRSLTE_CP_NORM_SF_NSYMB / nof_re,
          mse / nof_layers / nof_symbols,
          (float)nof_errors / (4.0f * nof_re));
   if (mse / nof_layers / nof_symbols > MSE_THRESHOLD) {
@@ -287,9 +287,9 @@ void demod_16qam_lte_s_sse(const cf_t* symbols, short* llr, int nsymbols)
   __m128i shuffle_abs_2 = _mm_set_epi8(15, 14, 13, 12, 0xff, 0xff, 0xff, 0xff, 11, 10, 9, 8, 0xff, 0xff, 0xff, 0xff);
 
   for (int i = 0; i < nsymbols / 4; i++) {
-    symbol1 = _mm_load_ps(symbolsPtr);
+    symbol1 = _mm_loadu_ps(symbolsPtr);
     symbolsPtr += 4;
-    symbol2 = _mm_load_ps(symbolsPtr);
+    symbol2 = _mm_loadu_ps(symbolsPtr);
     symbolsPtr += 4;
     symbol_i1 = _mm_cvtps_epi32(_mm_mul_ps(symbol1, scale_v));
     symbol_i2 = _mm_cvtps_epi32(_mm_mul_ps(symbol2, scale_v));
@@ -339,13 +339,13 @@ void demod_16qam_lte_b_sse(const cf_t* symbols, int8_t* llr, int nsymbols)
   __m128i shuffle_abs_2 = _mm_set_epi8(15, 14, 0xff, 0xff, 13, 12, 0xff, 0xff, 11, 10, 0xff, 0xff, 9, 8, 0xff, 0xff);
 
   for (int i = 0; i < nsymbols / 8; i++) {
-    symbol1 = _mm_load_ps(symbolsPtr);
+    symbol1 = _mm_loadu_ps(symbolsPtr);
     symbolsPtr += 4;
-    symbol2 = _mm_load_ps(symbolsPtr);
+    symbol2 = _mm_loadu_ps(symbolsPtr);
     symbolsPtr += 4;
-    symbol3 = _mm_load_ps(symbolsPtr);
+    symbol3 = _mm_loadu_ps(symbolsPtr);
     symbolsPtr += 4;
-    symbol4 = _mm_load_ps(symbolsPtr);
+    symbol4 = _mm_loadu_ps(symbolsPtr);
     symbolsPtr += 4;
     symbol_i1 = _mm_cvtps_epi32(_mm_mul_ps(symbol1, scale_v));
     symbol_i2 = _mm_cvtps_epi32(_mm_mul_ps(symbol2, scale_v));
@@ -621,9 +621,9 @@ void demod_64qam_lte_s_sse(const cf_t* symbols, short* llr, int nsymbols)
   __m128i shuffle_abs2_3 = _mm_set_epi8(15, 14, 13, 12, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 11, 10, 9, 8);
 
   for (int i = 0; i < nsymbols / 4; i++) {
-    symbol1 = _mm_load_ps(symbolsPtr);
+    symbol1 = _mm_loadu_ps(symbolsPtr);
     symbolsPtr += 4;
-    symbol2 = _mm_load_ps(symbolsPtr);
+    symbol2 = _mm_loadu_ps(symbolsPtr);
     symbolsPtr += 4;
     symbol_i1 = _mm_cvtps_epi32(_mm_mul_ps(symbol1, scale_v));
     symbol_i2 = _mm_cvtps_epi32(_mm_mul_ps(symbol2, scale_v));
@@ -696,13 +696,13 @@ void demod_64qam_lte_b_sse(const cf_t* symbols, int8_t* llr, int nsymbols)
       _mm_set_epi8(15, 14, 0xff, 0xff, 0xff, 0xff, 13, 12, 0xff, 0xff, 0xff, 0xff, 11, 10, 0xff, 0xff);
 
   for (int i = 0; i < nsymbols / 8; i++) {
-    symbol1 = _mm_load_ps(symbolsPtr);
+    symbol1 = _mm_loadu_ps(symbolsPtr);
     symbolsPtr += 4;
-    symbol2 = _mm_load_ps(symbolsPtr);
+    symbol2 = _mm_loadu_ps(symbolsPtr);
     symbolsPtr += 4;
-    symbol3 = _mm_load_ps(symbolsPtr);
+    symbol3 = _mm_loadu_ps(symbolsPtr);
     symbolsPtr += 4;
-    symbol4 = _mm_load_ps(symbolsPtr);
+    symbol4 = _mm_loadu_ps(symbolsPtr);
     symbolsPtr += 4;
     symbol_i1 = _mm_cvtps_epi32(_mm_mul_ps(symbol1, scale_v));
     symbol_i2 = _mm_cvtps_epi32(_mm_mul_ps(symbol2, scale_v));
@@ -40,6 +40,8 @@
 #define PDCCH_FORMAT_NOF_REGS(i) ((1 << i) * 9)
 #define PDCCH_FORMAT_NOF_BITS(i) ((1 << i) * 72)
 
+#define PDCCH_MIN_LLR_MEAN 0.3f // Candidates with lower mean LLR magnitude are not decoded
+
 #define NOF_CCE(cfi) ((cfi > 0 && cfi < 4) ? q->nof_cce[cfi - 1] : 0)
 #define NOF_REGS(cfi) ((cfi > 0 && cfi < 4) ? q->nof_regs[cfi - 1] : 0)
 
@@ -87,6 +89,13 @@ static int pdcch_init(srslte_pdcch_t* q, uint32_t max_prb, uint32_t nof_rx_anten
 
     bzero(q->llr, sizeof(float) * q->max_bits);
 
+    q->cce_llr_mean = srslte_vec_malloc(sizeof(float) * q->max_bits / 72);
+    if (!q->cce_llr_mean) {
+      goto clean;
+    }
+
+    bzero(q->cce_llr_mean, sizeof(float) * q->max_bits / 72);
+
     q->d = srslte_vec_malloc(sizeof(cf_t) * q->max_bits / 2);
     if (!q->d) {
       goto clean;
@@ -139,6 +148,9 @@ void srslte_pdcch_free(srslte_pdcch_t* q)
   if (q->llr) {
     free(q->llr);
   }
+  if (q->cce_llr_mean) {
+    free(q->cce_llr_mean);
+  }
   if (q->d) {
     free(q->d);
   }
@@ -359,11 +371,52 @@ int srslte_pdcch_dci_decode(srslte_pdcch_t* q, float* e, uint8_t* data, uint32_t
   }
 }
 
+/** Returns the mean LLR magnitude of a candidate location in the LLRs stored by srslte_pdcch_extract_llr(). It is a
+ * cheap reliability metric to rank the candidates before decoding them. Returns 0 for invalid locations.
+ */
+float srslte_pdcch_location_metric(srslte_pdcch_t* q, srslte_dl_sf_cfg_t* sf, srslte_dci_location_t* location)
+{
+  float metric = 0.0f;
+  if (q != NULL && location != NULL && srslte_dci_location_isvalid(location) &&
+      location->ncce + PDCCH_FORMAT_NOF_CCE(location->L) <= NOF_CCE(sf->cfi)) {
+    for (uint32_t i = 0; i < PDCCH_FORMAT_NOF_CCE(location->L); i++) {
+      metric += q->cce_llr_mean[location->ncce + i];
+    }
+    metric /= PDCCH_FORMAT_NOF_CCE(location->L);
+  }
+  return metric;
+}
+
+/* Looks for a candidate already decoded in this subframe with the same location and size */
+static srslte_dci_msg_t* pdcch_find_decoded(srslte_pdcch_t* q, srslte_dci_location_t* location, uint32_t nof_bits)
+{
+  for (uint32_t i = 0; i < q->nof_decoded; i++) {
+    if (q->decoded[i].nof_bits == nof_bits && q->decoded[i].location.ncce == location->ncce &&
+        q->decoded[i].location.L == location->L) {
+      return &q->decoded[i];
+    }
+  }
+  return NULL;
+}
+
+static void pdcch_save_decoded(srslte_pdcch_t* q, srslte_dci_msg_t* msg)
+{
+  if (q->nof_decoded < SRSLTE_PDCCH_MAX_DECODED) {
+    srslte_dci_msg_t* decoded = &q->decoded[q->nof_decoded++];
+    decoded->location         = msg->location;
+    decoded->nof_bits         = msg->nof_bits;
+    decoded->rnti             = msg->rnti;
+    memcpy(decoded->payload, msg->payload, msg->nof_bits);
+  }
+}
+
 /** Tries to decode a DCI message from the LLRs stored in the srslte_pdcch_t structure by the function
  * srslte_pdcch_extract_llr(). This function can be called multiple times.
  * The location to search for is obtained from msg.
  * The decoded message is stored in msg and the CRC remainder in msg->rnti
  *
+ * A location is decoded only once per subframe for each DCI size, successive calls (e.g. Format 0 and Format 1A or
+ * searches for different RNTI) reuse the decoded message.
  */
 int srslte_pdcch_decode_msg(srslte_pdcch_t* q, srslte_dl_sf_cfg_t* sf, srslte_dci_cfg_t* dci_cfg, srslte_dci_msg_t* msg)
 {
@@ -377,15 +430,20 @@ int srslte_pdcch_decode_msg(srslte_pdcch_t* q, srslte_dl_sf_cfg_t* sf, srslte_dc
       uint32_t nof_bits = srslte_dci_format_sizeof(&q->cell, sf, dci_cfg, msg->format);
       uint32_t e_bits   = PDCCH_FORMAT_NOF_BITS(msg->location.L);
 
-      double mean = 0;
-      for (int i = 0; i < e_bits; i++) {
-        mean += fabsf(q->llr[msg->location.ncce * 72 + i]);
-      }
-      mean /= e_bits;
-      if (mean > 0.3) {
-        ret = srslte_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
+      float             mean    = srslte_pdcch_location_metric(q, sf, &msg->location);
+      srslte_dci_msg_t* decoded = pdcch_find_decoded(q, &msg->location, nof_bits);
+      if (decoded || mean > PDCCH_MIN_LLR_MEAN) {
+        if (decoded) {
+          msg->rnti = decoded->rnti;
+          memcpy(msg->payload, decoded->payload, nof_bits);
+        } else {
+          ret = srslte_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
+        }
         if (ret == SRSLTE_SUCCESS) {
           msg->nof_bits = nof_bits;
+          if (!decoded) {
+            pdcch_save_decoded(q, msg);
+          }
           // Check format differentiation
           if (msg->format == SRSLTE_DCI_FORMAT0 || msg->format == SRSLTE_DCI_FORMAT1A) {
             msg->format = (msg->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSLTE_DCI_FORMAT0 : SRSLTE_DCI_FORMAT1A;
@@ -478,6 +536,18 @@ int srslte_pdcch_extract_llr(srslte_pdcch_t*        q,
     /* descramble */
     srslte_scrambling_f_offset(&q->seq[sf->tti % 10], q->llr, 0, e_bits);
 
+    /* reliability metric of each CCE, candidates are ranked by the average of their CCEs */
+    for (i = 0; i < NOF_CCE(sf->cfi); i++) {
+      float acc = 0.0f;
+      for (uint32_t k = 0; k < 72; k++) {
+        acc += fabsf(q->llr[i * 72 + k]);
+      }
+      q->cce_llr_mean[i] = acc / 72;
+    }
+
+    /* new LLRs, previously decoded candidates are no longer valid */
+    q->nof_decoded = 0;
+
     ret = SRSLTE_SUCCESS;
   }
   return ret;
@@ -251,6 +251,7 @@ static int pdsch_init(srslte_pdsch_t* q, uint32_t max_prb, bool is_ue, uint32_t
     q->max_re          = max_prb * MAX_PDSCH_RE(q->cell.cp);
     q->is_ue           = is_ue;
     q->nof_rx_antennas = nof_antennas;
+    q->fused_rx        = true;
 
     INFO("Init PDSCH: %d PRBs, max_symbols: %d\n", max_prb, q->max_re);
 
@@ -763,16 +764,6 @@ static int srslte_pdsch_codeword_decode(srslte_pdsch_t*     q,
          cfg->grant.tb[tb_idx].nof_bits,
          rv);
 
-    /* demodulate symbols
-     * The MAX-log-MAP algorithm used in turbo decoding is unsensitive to SNR estimation,
-     * thus we don't need tot set it in the LLRs normalization
-     */
-    if (q->llr_is_8bit) {
-      srslte_demod_soft_demodulate_b(mcs->mod, q->d[codeword_idx], q->e[codeword_idx], cfg->grant.nof_re);
-    } else {
-      srslte_demod_soft_demodulate_s(mcs->mod, q->d[codeword_idx], q->e[codeword_idx], cfg->grant.nof_re);
-    }
-
     /* Select scrambling sequence */
     srslte_sequence_t* seq =
         get_user_sequence(q, cfg->rnti, codeword_idx, sf->tti % 10, cfg->grant.tb[tb_idx].nof_bits);
@@ -781,19 +772,35 @@ static int srslte_pdsch_codeword_decode(srslte_pdsch_t*     q,
       return -1;
     }
 
-    /* Bit scrambling */
-    if (q->llr_is_8bit) {
-      srslte_scrambling_sb_offset(seq, q->e[codeword_idx], 0, cfg->grant.tb[tb_idx].nof_bits);
+    /* The CSI correction, the debug traces and the callers inspecting e[] need the LLRs of the whole codeword, use
+     * the fused path otherwise */
+    if (q->fused_rx && !q->output_llr && !cfg->csi_enable && !SRSLTE_VERBOSE_ISDEBUG()) {
+      ret = srslte_dlsch_decode_fused(dl_sch, cfg, q->d[codeword_idx], seq, data, tb_idx, nof_layers);
     } else {
-      srslte_scrambling_s_offset(seq, q->e[codeword_idx], 0, cfg->grant.tb[tb_idx].nof_bits);
-    }
+      /* demodulate symbols
+       * The MAX-log-MAP algorithm used in turbo decoding is unsensitive to SNR estimation,
+       * thus we don't need tot set it in the LLRs normalization
+       */
+      if (q->llr_is_8bit) {
+        srslte_demod_soft_demodulate_b(mcs->mod, q->d[codeword_idx], q->e[codeword_idx], cfg->grant.nof_re);
+      } else {
+        srslte_demod_soft_demodulate_s(mcs->mod, q->d[codeword_idx], q->e[codeword_idx], cfg->grant.nof_re);
+      }
 
-    if (cfg->csi_enable) {
-      csi_correction(q, cfg, codeword_idx, tb_idx, q->e[codeword_idx]);
-    }
+      /* Bit scrambling */
+      if (q->llr_is_8bit) {
+        srslte_scrambling_sb_offset(seq, q->e[codeword_idx], 0, cfg->grant.tb[tb_idx].nof_bits);
+      } else {
+        srslte_scrambling_s_offset(seq, q->e[codeword_idx], 0, cfg->grant.tb[tb_idx].nof_bits);
+      }
 
-    /* Return  */
-    ret = srslte_dlsch_decode2(dl_sch, cfg, q->e[codeword_idx], data, tb_idx, nof_layers);
+      if (cfg->csi_enable) {
+        csi_correction(q, cfg, codeword_idx, tb_idx, q->e[codeword_idx]);
+      }
+
+      /* Return  */
+      ret = srslte_dlsch_decode2(dl_sch, cfg, q->e[codeword_idx], data, tb_idx, nof_layers);
+    }
 
     if (ret == SRSLTE_SUCCESS) {
       *ack = true;
@@ -350,6 +350,14 @@ int srslte_prach_init(srslte_prach_t* p, uint32_t max_N_ifft_ul)
     p->corr_spec  = srslte_vec_malloc(sizeof(cf_t) * MAX_N_zc);
     p->corr       = srslte_vec_malloc(sizeof(float) * MAX_N_zc);
 
+    // Batched correlation containers, for the maximum number of roots
+    p->corr_spec_roots = srslte_vec_malloc(sizeof(cf_t) * MAX_N_zc * N_SEQS);
+    p->corr_roots      = srslte_vec_malloc(sizeof(float) * MAX_N_zc * N_SEQS);
+    if (!p->prach_bins || !p->corr_spec || !p->corr || !p->corr_spec_roots || !p->corr_roots) {
+      ERROR("Error allocating memory\n");
+      return SRSLTE_ERROR;
+    }
+
     // Set up ZC FFTS
     if (srslte_dft_plan(&p->zc_fft, MAX_N_zc, SRSLTE_DFT_FORWARD, SRSLTE_DFT_COMPLEX)) {
       return SRSLTE_ERROR;
@@ -469,6 +477,28 @@ int srslte_prach_set_cell_(srslte_prach_t*      p,
       srslte_dft_run(&p->zc_fft, p->seqs[i], p->dft_seqs[i]);
     }
 
+    // Plan the IFFT of all the root correlations at once
+    int err;
+    if (p->zc_ifft_roots.size) {
+      err = srslte_dft_replan_guru_c(
+          &p->zc_ifft_roots, p->N_zc, p->corr_spec_roots, p->corr_spec_roots, 1, 1, p->N_roots, p->N_zc, p->N_zc);
+    } else {
+      err = srslte_dft_plan_guru_c(&p->zc_ifft_roots,
+                                   p->N_zc,
+                                   SRSLTE_DFT_BACKWARD,
+                                   p->corr_spec_roots,
+                                   p->corr_spec_roots,
+                                   1,
+                                   1,
+                                   p->N_roots,
+                                   p->N_zc,
+                                   p->N_zc);
+    }
+    if (err) {
+      ERROR("Error creating DFT plan\n");
+      return SRSLTE_ERROR;
+    }
+
     // Create our FFT objects and buffers
     p->N_ifft_ul = N_ifft_ul;
     if (4 == preamble_format) {
@@ -575,18 +605,31 @@ int srslte_prach_detect_offset(srslte_prach_t* p,
                                float*          t_offsets,
                                float*          peak_to_avg,
                                uint32_t*       n_indices)
+{
+  cf_t* signal_ant[SRSLTE_MAX_PORTS] = {signal};
+  return srslte_prach_detect_offset_multi(
+      p, freq_offset, signal_ant, 1, sig_len, indices, t_offsets, peak_to_avg, n_indices);
+}
+
+int srslte_prach_detect_offset_multi(srslte_prach_t* p,
+                                     uint32_t        freq_offset,
+                                     cf_t*           signal[SRSLTE_MAX_PORTS],
+                                     uint32_t        nof_rx_ant,
+                                     uint32_t        sig_len,
+                                     uint32_t*       indices,
+                                     float*          t_offsets,
+                                     float*          peak_to_avg,
+                                     uint32_t*       n_indices)
 {
   int ret = SRSLTE_ERROR;
-  if (p != NULL && signal != NULL && sig_len > 0 && indices != NULL) {
+  if (p != NULL && signal != NULL && sig_len > 0 && indices != NULL && nof_rx_ant > 0 &&
+      nof_rx_ant <= SRSLTE_MAX_PORTS) {
 
     if (sig_len < p->N_ifft_prach) {
       ERROR("srslte_prach_detect: Signal length is %d and should be %d\n", sig_len, p->N_ifft_prach);
       return SRSLTE_ERROR_INVALID_INPUTS;
     }
 
-    // FFT incoming signal
-    srslte_dft_run(&p->fft, signal, p->signal_fft);
-
     *n_indices = 0;
 
     // Extract bins of interest
@@ -594,27 +637,48 @@ int srslte_prach_detect_offset(srslte_prach_t* p,
     uint32_t k_0     = freq_offset * N_RB_SC - N_rb_ul * N_RB_SC / 2 + p->N_ifft_ul / 2;
     uint32_t K       = DELTA_F / DELTA_F_RA;
     uint32_t begin   = PHI + (K * k_0) + (K / 2);
+    uint32_t len     = p->N_roots * p->N_zc;
 
-    memcpy(p->prach_bins, &p->signal_fft[begin], p->N_zc * sizeof(cf_t));
-
-    for (int i = 0; i < p->N_roots; i++) {
-      cf_t* root_spec = p->dft_seqs[p->root_seqs_idx[i]];
+    for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+      if (signal[ant] == NULL) {
+        return SRSLTE_ERROR_INVALID_INPUTS;
+      }
 
-      srslte_vec_prod_conj_ccc(p->prach_bins, root_spec, p->corr_spec, p->N_zc);
+      // FFT incoming signal
+      srslte_dft_run(&p->fft, signal[ant], p->signal_fft);
 
-      srslte_dft_run(&p->zc_ifft, p->corr_spec, p->corr_spec);
+      memcpy(p->prach_bins, &p->signal_fft[begin], p->N_zc * sizeof(cf_t));
 
-      srslte_vec_abs_square_cf(p->corr_spec, p->corr, p->N_zc);
+      // Correlate with all the roots in a single batched IFFT
+      for (int i = 0; i < p->N_roots; i++) {
+        cf_t* root_spec = p->dft_seqs[p->root_seqs_idx[i]];
+        srslte_vec_prod_conj_ccc(p->prach_bins, root_spec, &p->corr_spec_roots[i * p->N_zc], p->N_zc);
+      }
 
-      float corr_ave = srslte_vec_acc_ff(p->corr, p->N_zc) / p->N_zc;
+      srslte_dft_run_guru_c(&p->zc_ifft_roots);
 
-      uint32_t winsize = 0;
-      if (p->N_cs != 0) {
-        winsize = p->N_cs;
+      // Combine the antennas non-coherently
+      if (ant == 0) {
+        srslte_vec_abs_square_cf(p->corr_spec_roots, p->corr_roots, len);
       } else {
-        winsize = p->N_zc;
+        for (int i = 0; i < p->N_roots; i++) {
+          srslte_vec_abs_square_cf(&p->corr_spec_roots[i * p->N_zc], p->corr, p->N_zc);
+          srslte_vec_sum_fff(&p->corr_roots[i * p->N_zc], p->corr, &p->corr_roots[i * p->N_zc], p->N_zc);
+        }
       }
-      uint32_t n_wins = p->N_zc / winsize;
+    }
+
+    uint32_t winsize = 0;
+    if (p->N_cs != 0) {
+      winsize = p->N_cs;
+    } else {
+      winsize = p->N_zc;
+    }
+    uint32_t n_wins = p->N_zc / winsize;
+
+    for (int i = 0; i < p->N_roots; i++) {
+      float* corr     = &p->corr_roots[i * p->N_zc];
+      float  corr_ave = srslte_vec_acc_ff(corr, p->N_zc) / p->N_zc;
 
       float max_peak = 0;
       for (int j = 0; j < n_wins; j++) {
@@ -625,21 +689,17 @@ int srslte_prach_detect_offset(srslte_prach_t* p,
         }
         start += p->deadzone;
         p->peak_values[j] = 0;
-        for (int k = start; k < end; k++) {
-          if (p->corr[k] > p->peak_values[j]) {
-            p->peak_values[j]  = p->corr[k];
-            p->peak_offsets[j] = k - start;
-            if (p->peak_values[j] > max_peak) {
-              max_peak = p->peak_values[j];
-            }
+        if (end > start) {
+          p->peak_offsets[j] = srslte_vec_max_fi(&corr[start], end - start);
+          p->peak_values[j]  = corr[start + p->peak_offsets[j]];
+          if (p->peak_values[j] > max_peak) {
+            max_peak = p->peak_values[j];
           }
         }
       }
       if (max_peak > p->detect_factor * corr_ave) {
         for (int j = 0; j < n_wins; j++) {
           if (p->peak_values[j] > p->detect_factor * corr_ave) {
-            // printf("saving prach correlation\n");
-            // memcpy(save_corr, p->corr, p->N_zc*sizeof(float));
             if (indices) {
               indices[*n_indices] = (i * n_wins) + j;
             }
@@ -673,6 +733,13 @@ int srslte_prach_free(srslte_prach_t* p)
   free(p->prach_bins);
   free(p->corr_spec);
   free(p->corr);
+  if (p->corr_spec_roots) {
+    free(p->corr_spec_roots);
+  }
+  if (p->corr_roots) {
+    free(p->corr_roots);
+  }
+  srslte_dft_plan_free(&p->zc_ifft_roots);
   srslte_dft_plan_free(&p->ifft);
   free(p->ifft_in);
   free(p->ifft_out);
@@ -174,6 +174,8 @@ int srslte_pucch_set_rnti(srslte_pucch_t* q, uint16_t rnti)
       }
     }
     q->users[rnti_idx]->sequence_generated = false;
+    bzero(q->users[rnti_idx]->ref, sizeof(q->users[rnti_idx]->ref));
+    bzero(q->users[rnti_idx]->ref_next, sizeof(q->users[rnti_idx]->ref_next));
     for (uint32_t sf_idx = 0; sf_idx < SRSLTE_NOF_SF_X_FRAME; sf_idx++) {
       // Precompute scrambling sequence for pucch format 2
       if (srslte_sequence_pucch(&q->users[rnti_idx]->seq_f2[sf_idx], rnti, 2 * sf_idx, q->cell.id)) {
@@ -644,6 +646,68 @@ static int encode_bits(srslte_pucch_cfg_t*   cfg,
   return SRSLTE_SUCCESS;
 }
 
+static bool user_ref_match(srslte_pucch_user_ref_t* ref, srslte_ul_sf_cfg_t* sf, srslte_pucch_cfg_t* cfg)
+{
+  srslte_pucch_format_t format = (cfg->format < SRSLTE_PUCCH_FORMAT_2) ? SRSLTE_PUCCH_FORMAT_1 : SRSLTE_PUCCH_FORMAT_2;
+
+  return ref->valid && ref->format == format && ref->n_pucch == cfg->n_pucch && ref->N_cs == cfg->N_cs &&
+         ref->delta_pucch_shift == cfg->delta_pucch_shift && ref->n_rb_2 == cfg->n_rb_2 &&
+         ref->group_hopping_en == cfg->group_hopping_en && ref->shortened == sf->shortened;
+}
+
+/* Returns the reference signal of the PUCCH resource. The signal only depends on the resource parameters and the
+ * subframe, so it is cached per RNTI and generated again only when the UE is given a different resource. If the
+ * RNTI has no state, the signal is generated in tmp. */
+static cf_t* get_user_ref(srslte_pucch_t*     q,
+                          srslte_ul_sf_cfg_t* sf,
+                          srslte_pucch_cfg_t* cfg,
+                          cf_t                tmp[SRSLTE_PUCCH_MAX_SYMBOLS])
+{
+  uint32_t             rnti_idx = q->is_ue ? 0 : cfg->rnti;
+  uint32_t             sf_idx   = sf->tti % SRSLTE_NOF_SF_X_FRAME;
+  srslte_pucch_user_t* user     = NULL;
+
+  if (cfg->rnti >= SRSLTE_CRNTI_START && cfg->rnti < SRSLTE_CRNTI_END && q->users[rnti_idx] &&
+      q->users[rnti_idx]->sequence_generated && q->users[rnti_idx]->cell_id == q->cell.id &&
+      (!q->is_ue || q->ue_rnti == cfg->rnti)) {
+    user = q->users[rnti_idx];
+  }
+
+  if (!user) {
+    encode_signal_format12(q, sf, cfg, NULL, tmp, true);
+    return tmp;
+  }
+
+  for (uint32_t i = 0; i < SRSLTE_PUCCH_USER_NOF_REF; i++) {
+    if (user_ref_match(&user->ref[sf_idx][i], sf, cfg)) {
+      return user->ref[sf_idx][i].z;
+    }
+  }
+
+  // Miss, replace the oldest entry of this subframe
+  srslte_pucch_user_ref_t* ref = &user->ref[sf_idx][user->ref_next[sf_idx]];
+  user->ref_next[sf_idx]       = (user->ref_next[sf_idx] + 1) % SRSLTE_PUCCH_USER_NOF_REF;
+
+  encode_signal_format12(q, sf, cfg, NULL, ref->z, true);
+  ref->format            = (cfg->format < SRSLTE_PUCCH_FORMAT_2) ? SRSLTE_PUCCH_FORMAT_1 : SRSLTE_PUCCH_FORMAT_2;
+  ref->n_pucch           = cfg->n_pucch;
+  ref->N_cs              = cfg->N_cs;
+  ref->delta_pucch_shift = cfg->delta_pucch_shift;
+  ref->n_rb_2            = cfg->n_rb_2;
+  ref->group_hopping_en  = cfg->group_hopping_en;
+  ref->shortened         = sf->shortened;
+  ref->valid             = true;
+
+  return ref->z;
+}
+
+/* Normalised correlation of the received symbols with d_0 times the reference signal, given their correlation with
+ * the reference signal (dot) and the norm of both signals. It equals srslte_vec_corr_ccc() of the encoded hypothesis */
+static inline float format1_corr(cf_t dot, cf_t d_0, float norm)
+{
+  return (norm > 0) ? crealf(conjf(d_0) * dot) / norm : 0;
+}
+
 static bool decode_signal(srslte_pucch_t*     q,
                           srslte_ul_sf_cfg_t* sf,
                           srslte_pucch_cfg_t* cfg,
@@ -656,14 +720,25 @@ static bool decode_signal(srslte_pucch_t*     q,
   bool    detected = false;
   float   corr = 0, corr_max = -1e9;
   uint8_t b_max = 0, b2_max = 0; // default bit value, eg. HI is NACK
+  uint8_t tmp[2];
 
   srslte_sequence_t* seq;
   cf_t               ref[SRSLTE_PUCCH_MAX_SYMBOLS];
+  cf_t*              z_ref;
+  cf_t               dot  = 0;
+  float              norm = 0;
+
+  if (cfg->format < SRSLTE_PUCCH_FORMAT_2) {
+    // The hypotheses only differ in the modulation symbol d_0 multiplying the reference signal, a single correlation
+    // with the reference gives the correlation of all of them
+    z_ref = get_user_ref(q, sf, cfg, ref);
+    dot   = srslte_vec_dot_prod_conj_ccc(q->z, z_ref, nof_re);
+    norm  = sqrtf(crealf(srslte_vec_dot_prod_conj_ccc(q->z, q->z, nof_re)) * (float)nof_re);
+  }
 
   switch (cfg->format) {
     case SRSLTE_PUCCH_FORMAT_1:
-      encode_signal(q, sf, cfg, pucch_bits, q->z_tmp);
-      corr = srslte_vec_corr_ccc(q->z, q->z_tmp, nof_re);
+      corr = format1_corr(dot, uci_encode_format1(), norm);
       if (corr >= cfg->threshold_format1) {
         detected = true;
       }
@@ -672,9 +747,7 @@ static bool decode_signal(srslte_pucch_t*     q,
     case SRSLTE_PUCCH_FORMAT_1A:
       detected = 0;
       for (uint8_t b = 0; b < 2; b++) {
-        pucch_bits[0] = b;
-        encode_signal(q, sf, cfg, pucch_bits, q->z_tmp);
-        corr = srslte_vec_corr_ccc(q->z, q->z_tmp, nof_re);
+        corr = format1_corr(dot, uci_encode_format1a(b), norm);
         if (corr > corr_max) {
           corr_max = corr;
           b_max    = b;
@@ -691,10 +764,9 @@ static bool decode_signal(srslte_pucch_t*     q,
       detected = 0;
       for (uint8_t b = 0; b < 2; b++) {
         for (uint8_t b2 = 0; b2 < 2; b2++) {
-          pucch_bits[0] = b;
-          pucch_bits[1] = b2;
-          encode_signal(q, sf, cfg, pucch_bits, q->z_tmp);
-          corr = srslte_vec_corr_ccc(q->z, q->z_tmp, nof_re);
+          tmp[0] = b;
+          tmp[1] = b2;
+          corr   = format1_corr(dot, uci_encode_format1b(tmp), norm);
           if (corr > corr_max) {
             corr_max = corr;
             b_max    = b;
@@ -715,13 +787,10 @@ static bool decode_signal(srslte_pucch_t*     q,
     case SRSLTE_PUCCH_FORMAT_2B:
       seq = get_user_sequence(q, cfg->rnti, sf->tti % 10);
       if (seq) {
-        encode_signal_format12(q, sf, cfg, NULL, ref, true);
-        srslte_vec_prod_conj_ccc(q->z, ref, q->z_tmp, SRSLTE_PUCCH_MAX_SYMBOLS);
+        z_ref = get_user_ref(q, sf, cfg, ref);
+        srslte_vec_prod_conj_ccc(q->z, z_ref, q->z_tmp, SRSLTE_PUCCH2_NOF_BITS / 2 * SRSLTE_NRE);
         for (int i = 0; i < SRSLTE_PUCCH2_NOF_BITS / 2; i++) {
-          q->z[i] = 0;
-          for (int j = 0; j < SRSLTE_NRE; j++) {
-            q->z[i] += q->z_tmp[i * SRSLTE_NRE + j] / SRSLTE_NRE;
-          }
+          q->z[i] = srslte_vec_acc_cc(&q->z_tmp[i * SRSLTE_NRE], SRSLTE_NRE) / SRSLTE_NRE;
         }
         srslte_demod_soft_demodulate_s(SRSLTE_MOD_QPSK, q->z, llr_pucch2, SRSLTE_PUCCH2_NOF_BITS / 2);
         srslte_scrambling_s_offset(seq, llr_pucch2, 0, SRSLTE_PUCCH2_NOF_BITS);
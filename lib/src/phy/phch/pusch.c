@@ -491,12 +491,9 @@ int srslte_pusch_decode(srslte_pusch_t*        q,
     // DFT predecoding
     srslte_dft_precoding(&q->dft_precoding, q->z, q->d, cfg->grant.L_prb, cfg->grant.nof_symb);
 
-    // Soft demodulation
-    if (q->llr_is_8bit) {
-      srslte_demod_soft_demodulate_b(cfg->grant.tb.mod, q->d, q->q, cfg->grant.nof_re);
-    } else {
-      srslte_demod_soft_demodulate_s(cfg->grant.tb.mod, q->d, q->q, cfg->grant.nof_re);
-    }
+    // Soft demodulation. The UCI and the UL-SCH deinterleaver take 16-bit LLRs, with llr_is_8bit the UL-SCH code blocks
+    // are converted to 8-bit by the decoder
+    srslte_demod_soft_demodulate_s(cfg->grant.tb.mod, q->d, q->q, cfg->grant.nof_re);
 
     // Generate scrambling sequence if not pre-generated
     srslte_sequence_t* seq = get_user_sequence(q, cfg->rnti, sf->tti % 10, cfg->grant.tb.nof_bits);
@@ -506,11 +503,7 @@ int srslte_pusch_decode(srslte_pusch_t*        q,
     }
 
     // Descrambling
-    if (q->llr_is_8bit) {
-      srslte_scrambling_sb_offset(seq, q->q, 0, cfg->grant.tb.nof_bits);
-    } else {
-      srslte_scrambling_s_offset(seq, q->q, 0, cfg->grant.tb.nof_bits);
-    }
+    srslte_scrambling_s_offset(seq, q->q, 0, cfg->grant.tb.nof_bits);
 
     // Decode
     ret      = srslte_ulsch_decode(&q->ul_sch, cfg, q->q, q->g, seq->c, out->data, &out->uci);
@@ -133,6 +133,10 @@ int srslte_sch_init(srslte_sch_t* q)
       goto clean;
     }
     bzero(q->temp_g_bits, SRSLTE_MAX_PRB * 12 * 12 * 12);
+    q->llr_tile = srslte_vec_malloc(sizeof(int16_t) * SRSLTE_SCH_LLR_TILE_LEN);
+    if (!q->llr_tile) {
+      goto clean;
+    }
     q->ul_interleaver = srslte_vec_malloc(sizeof(uint32_t) * SRSLTE_MAX_PRB * 12 * 12 * 12);
     if (!q->ul_interleaver) {
       goto clean;
@@ -163,6 +167,9 @@ void srslte_sch_free(srslte_sch_t* q)
   if (q->temp_g_bits) {
     free(q->temp_g_bits);
   }
+  if (q->llr_tile) {
+    free(q->llr_tile);
+  }
   if (q->ul_interleaver) {
     free(q->ul_interleaver);
   }
@@ -313,19 +320,82 @@ static int encode_tb(srslte_sch_t*           q,
   return encode_tb_off(q, soft_buffer, cb_segm, Qm, rv, nof_e_bits, data, e_bits, 0);
 }
 
-bool decode_tb_cb(srslte_sch_t*           q,
-                  srslte_softbuffer_rx_t* softbuffer,
-                  srslte_cbsegm_t*        cb_segm,
-                  uint32_t                Qm,
-                  uint32_t                rv,
-                  uint32_t                nof_e_bits,
-                  void*                   e_bits,
-                  uint8_t*                data)
+/* Source of the LLRs of a transport block. Either the demodulated and descrambled LLRs (e_bits, 8-bit if e_bits_8bit)
+ * or, in the fused receive path, the equalized symbols and the scrambling sequence the LLRs are generated from. The
+ * modulation is always set. */
+typedef struct {
+  void*              e_bits;
+  bool               e_bits_8bit;
+  const cf_t*        symbols;
+  srslte_mod_t       mod;
+  srslte_sequence_t* seq;
+} sch_llr_src_t;
+
+/* Half the ratio between the 8-bit and the 16-bit soft demodulator scales (see demod_soft.c), indexed by Qm/2-1. Used
+ * to store 16-bit LLRs in an 8-bit soft-buffer, the extra bit of headroom is for HARQ combining and repetitions. */
+static const float llr_s_to_b_scale[4] = {10.0f / 100.0f, 15.0f / 400.0f, 20.0f / 700.0f, 25.0f / 1000.0f};
+
+/* Accumulates the n_e LLRs starting at rp into the code block soft-buffer w_buff. In the fused path the LLRs are
+ * demodulated and descrambled in tiles of SRSLTE_SCH_LLR_TILE_LEN and rate dematched while still in cache. If the
+ * soft-buffer is 8-bit (cb_8bit) and the LLRs are not, they are saturated to 8 bits tile by tile. */
+static int rate_dematch_cb(srslte_sch_t*        q,
+                           const sch_llr_src_t* src,
+                           uint32_t             rp,
+                           uint32_t             n_e,
+                           void*                w_buff,
+                           uint32_t             cb_len_idx,
+                           uint32_t             rv,
+                           bool                 cb_8bit)
 {
+  uint32_t Qm = srslte_mod_bits_x_symbol(src->mod);
+
+  if (src->symbols == NULL) {
+    if (src->e_bits_8bit) {
+      return srslte_rm_turbo_rx_lut_8bit(&((int8_t*)src->e_bits)[rp], (int8_t*)w_buff, n_e, cb_len_idx, rv);
+    } else if (!cb_8bit) {
+      return srslte_rm_turbo_rx_lut(&((int16_t*)src->e_bits)[rp], (int16_t*)w_buff, n_e, cb_len_idx, rv);
+    }
+
+    float scale = llr_s_to_b_scale[(SRSLTE_MIN(SRSLTE_MAX(Qm, 2), 8) / 2) - 1];
+    for (uint32_t k = 0; k < n_e; k += SRSLTE_SCH_LLR_TILE_LEN) {
+      uint32_t len = SRSLTE_MIN(n_e - k, SRSLTE_SCH_LLR_TILE_LEN);
+      srslte_vec_convert_sb(&((int16_t*)src->e_bits)[rp + k], scale, q->llr_tile, len);
+      if (srslte_rm_turbo_rx_lut_8bit_offset(q->llr_tile, (int8_t*)w_buff, len, k, cb_len_idx, rv)) {
+        return SRSLTE_ERROR;
+      }
+    }
+    return SRSLTE_SUCCESS;
+  }
 
-  int8_t*  e_bits_b = e_bits;
-  int16_t* e_bits_s = e_bits;
+  for (uint32_t k = 0; k < n_e; k += SRSLTE_SCH_LLR_TILE_LEN) {
+    uint32_t    len     = SRSLTE_MIN(n_e - k, SRSLTE_SCH_LLR_TILE_LEN);
+    const cf_t* symbols = &src->symbols[(rp + k) / Qm];
+    if (cb_8bit) {
+      srslte_demod_soft_demodulate_b(src->mod, symbols, q->llr_tile, len / Qm);
+      srslte_scrambling_sb_offset(src->seq, q->llr_tile, rp + k, len);
+      if (srslte_rm_turbo_rx_lut_8bit_offset(q->llr_tile, (int8_t*)w_buff, len, k, cb_len_idx, rv)) {
+        return SRSLTE_ERROR;
+      }
+    } else {
+      srslte_demod_soft_demodulate_s(src->mod, symbols, q->llr_tile, len / Qm);
+      srslte_scrambling_s_offset(src->seq, q->llr_tile, rp + k, len);
+      if (srslte_rm_turbo_rx_lut_offset(q->llr_tile, (int16_t*)w_buff, len, k, cb_len_idx, rv)) {
+        return SRSLTE_ERROR;
+      }
+    }
+  }
+  return SRSLTE_SUCCESS;
+}
 
+static bool decode_tb_cb(srslte_sch_t*           q,
+                         srslte_softbuffer_rx_t* softbuffer,
+                         srslte_cbsegm_t*        cb_segm,
+                         uint32_t                Qm,
+                         uint32_t                rv,
+                         uint32_t                nof_e_bits,
+                         const sch_llr_src_t*    src,
+                         uint8_t*                data)
+{
   if (cb_segm->C > SRSLTE_MAX_CODEBLOCKS) {
     ERROR("Error SRSLTE_MAX_CODEBLOCKS=%d\n", SRSLTE_MAX_CODEBLOCKS);
     return false;
@@ -333,6 +403,9 @@ bool decode_tb_cb(srslte_sch_t*           q,
 
   q->avg_iterations = 0;
 
+  // Code blocks are decoded with 8-bit LLRs if either the LLRs or the soft-buffer storage are 8-bit
+  bool cb_8bit = q->llr_is_8bit || (softbuffer->pool && softbuffer->pool->is_8bit);
+
   for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
     /* Do not process blocks with CRC Ok */
     if (softbuffer->cb_crc[cb_idx] == false) {
@@ -353,16 +426,15 @@ bool decode_tb_cb(srslte_sch_t*           q,
         rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
       }
 
-      if (q->llr_is_8bit) {
-        if (srslte_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching\n");
-          return SRSLTE_ERROR;
-        }
-      } else {
-        if (srslte_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching\n");
-          return SRSLTE_ERROR;
-        }
+      // Pooled soft-buffers take the code block storage on its first transmission
+      if (srslte_softbuffer_rx_alloc_cb(softbuffer, cb_idx)) {
+        ERROR("Error no soft-buffer memory for CB %d\n", cb_idx);
+        return false;
+      }
+
+      if (rate_dematch_cb(q, src, rp, n_e2, softbuffer->buffer_f[cb_idx], cb_len_idx, rv, cb_8bit)) {
+        ERROR("Error in rate matching\n");
+        return SRSLTE_ERROR;
       }
 
       srslte_tdec_new_cb(&q->decoder, cb_len);
@@ -371,7 +443,7 @@ bool decode_tb_cb(srslte_sch_t*           q,
       bool     early_stop = false;
       uint32_t cb_noi     = 0;
       do {
-        if (q->llr_is_8bit) {
+        if (cb_8bit) {
           srslte_tdec_iteration_8bit(&q->decoder, (int8_t*)softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
         } else {
           srslte_tdec_iteration(&q->decoder, softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
@@ -402,6 +474,11 @@ bool decode_tb_cb(srslte_sch_t*           q,
 
       } while (cb_noi < q->max_iterations && !early_stop);
 
+      // The soft bits of a decoded code block are not needed anymore
+      if (early_stop) {
+        srslte_softbuffer_rx_release_cb(softbuffer, cb_idx);
+      }
+
       INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d\n",
            cb_idx,
            rp,
@@ -446,7 +523,7 @@ bool decode_tb_cb(srslte_sch_t*           q,
  * @param[in] q
  * @param[inout] softbuffer Initialized softbuffer
  * @param[in] cb_segm Code block segmentation parameters
- * @param[in] e_bits Input transport block
+ * @param[in] src Input transport block LLRs, or symbols and scrambling sequence in the fused receive path
  * @param[in] Qm Modulation type
  * @param[in] rv Redundancy Version. Indicates which part of FEC bits is in input buffer
  * @param[out] softbuffer Initialized output softbuffer
@@ -459,11 +536,12 @@ static int decode_tb(srslte_sch_t*           q,
                      uint32_t                Qm,
                      uint32_t                rv,
                      uint32_t                nof_e_bits,
-                     int16_t*                e_bits,
+                     const sch_llr_src_t*    src,
                      uint8_t*                data)
 {
 
-  if (q != NULL && data != NULL && softbuffer != NULL && e_bits != NULL && cb_segm != NULL) {
+  if (q != NULL && data != NULL && softbuffer != NULL && (src->e_bits != NULL || src->symbols != NULL) &&
+      cb_segm != NULL) {
 
     if (cb_segm->tbs == 0 || cb_segm->C == 0) {
       return SRSLTE_SUCCESS;
@@ -489,7 +567,7 @@ static int decode_tb(srslte_sch_t*           q,
     data[cb_segm->tbs / 8 + 2] = 0;
 
     // Process Codeblocks
-    crc_ok = decode_tb_cb(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data);
+    crc_ok = decode_tb_cb(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, src, data);
 
     if (crc_ok) {
 
@@ -516,7 +594,7 @@ static int decode_tb(srslte_sch_t*           q,
     ERROR("Missing inputs: data=%d, softbuffer=%d, e_bits=%d, cb_segm=%d\n",
           data != 0,
           softbuffer != 0,
-          e_bits != 0,
+          src->e_bits != 0 || src->symbols != 0,
           cb_segm != 0);
     return SRSLTE_ERROR_INVALID_INPUTS;
   }
@@ -527,12 +605,12 @@ int srslte_dlsch_decode(srslte_sch_t* q, srslte_pdsch_cfg_t* cfg, int16_t* e_bit
   return srslte_dlsch_decode2(q, cfg, e_bits, data, 0, 1);
 }
 
-int srslte_dlsch_decode2(srslte_sch_t*       q,
-                         srslte_pdsch_cfg_t* cfg,
-                         int16_t*            e_bits,
-                         uint8_t*            data,
-                         int                 tb_idx,
-                         uint32_t            nof_layers)
+static int dlsch_decode(srslte_sch_t*        q,
+                        srslte_pdsch_cfg_t*  cfg,
+                        const sch_llr_src_t* src,
+                        uint8_t*             data,
+                        int                  tb_idx,
+                        uint32_t             nof_layers)
 {
   uint32_t Nl = 1;
 
@@ -554,10 +632,41 @@ int srslte_dlsch_decode2(srslte_sch_t*       q,
                    Qm * Nl,
                    cfg->grant.tb[tb_idx].rv,
                    cfg->grant.tb[tb_idx].nof_bits,
-                   e_bits,
+                   src,
                    data);
 }
 
+int srslte_dlsch_decode2(srslte_sch_t*       q,
+                         srslte_pdsch_cfg_t* cfg,
+                         int16_t*            e_bits,
+                         uint8_t*            data,
+                         int                 tb_idx,
+                         uint32_t            nof_layers)
+{
+  sch_llr_src_t src = {.e_bits = e_bits, .e_bits_8bit = q->llr_is_8bit, .mod = cfg->grant.tb[tb_idx].mod};
+  return dlsch_decode(q, cfg, &src, data, tb_idx, nof_layers);
+}
+
+/**
+ * Decodes a DL-SCH transport block straight from the equalized codeword symbols. Demodulation, descrambling and rate
+ * dematching run as a single pass per code block, so the LLRs of the whole codeword are never written to memory.
+ * Code blocks whose CRC was already correct in a previous transmission are not demodulated.
+ *
+ * @param[in] symbols Equalized codeword symbols
+ * @param[in] seq Scrambling sequence of the codeword
+ */
+int srslte_dlsch_decode_fused(srslte_sch_t*       q,
+                              srslte_pdsch_cfg_t* cfg,
+                              const cf_t*         symbols,
+                              srslte_sequence_t*  seq,
+                              uint8_t*            data,
+                              int                 tb_idx,
+                              uint32_t            nof_layers)
+{
+  sch_llr_src_t src = {.symbols = symbols, .mod = cfg->grant.tb[tb_idx].mod, .seq = seq};
+  return dlsch_decode(q, cfg, &src, data, tb_idx, nof_layers);
+}
+
 /**
  * Encode transport block. Segments into code blocks, adds channel coding, and does rate matching.
  *
@@ -1108,8 +1217,9 @@ int srslte_ulsch_decode(srslte_sch_t*       q,
 
   // Decode ULSCH
   if (cb_segm.tbs > 0) {
-    uint32_t G = nb_q / Qm - Q_prime_ri - Q_prime_cqi;
-    ret        = decode_tb(q, cfg->softbuffers.rx, &cb_segm, Qm, cfg->grant.tb.rv, G * Qm, &g_bits[e_offset], data);
+    uint32_t      G   = nb_q / Qm - Q_prime_ri - Q_prime_cqi;
+    sch_llr_src_t src = {.e_bits = &g_bits[e_offset], .mod = cfg->grant.tb.mod};
+    ret               = decode_tb(q, cfg->softbuffers.rx, &cb_segm, Qm, cfg->grant.tb.rv, G * Qm, &src, data);
   }
   return ret;
 }
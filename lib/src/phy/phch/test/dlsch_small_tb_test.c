@@ -0,0 +1,221 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Per transport block latency of the DL-SCH transmit chain (turbo coding, rate matching, scrambling and modulation)
+ * for small, single code block, transport blocks. Every transport block is also demodulated and decoded to check it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srslte/srslte.h"
+
+static uint32_t nof_prb        = 4;
+static uint32_t max_tbs        = 1000;
+static uint32_t nof_iterations = 10000;
+static uint16_t rnti           = 1234;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [ptNv]\n", prog);
+  printf("\t-p number of PRB of the grant [Default %d]\n", nof_prb);
+  printf("\t-t maximum TBS in bits [Default %d]\n", max_tbs);
+  printf("\t-N number of transport blocks encoded per TBS [Default %d]\n", nof_iterations);
+  printf("\t-v [set srslte_verbose to debug, default none]\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "ptNv")) != -1) {
+    switch (opt) {
+      case 'p':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        max_tbs = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'N':
+        nof_iterations = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        srslte_verbose++;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static srslte_mod_t mod_from_tbs_idx(uint32_t tbs_idx)
+{
+  if (tbs_idx < 10) {
+    return SRSLTE_MOD_QPSK;
+  } else if (tbs_idx < 16) {
+    return SRSLTE_MOD_16QAM;
+  }
+  return SRSLTE_MOD_64QAM;
+}
+
+int main(int argc, char** argv)
+{
+  srslte_sch_t           sch;
+  srslte_softbuffer_tx_t softbuffer_tx;
+  srslte_softbuffer_rx_t softbuffer_rx;
+  srslte_modem_table_t   modem[SRSLTE_MOD_64QAM + 1];
+  srslte_sequence_t      seq;
+  srslte_pdsch_cfg_t     cfg;
+  struct timeval         t[3];
+  int                    ret = SRSLTE_ERROR;
+
+  parse_args(argc, argv);
+
+  // Data REs of a subframe with 2 control symbols, 2 CRS ports
+  uint32_t nof_re = nof_prb * SRSLTE_NRE * 10;
+
+  uint8_t* data_tx = srslte_vec_malloc(max_tbs / 8 + 1);
+  uint8_t* data_rx = srslte_vec_malloc(max_tbs / 8 + 1);
+  uint8_t* e_bits  = srslte_vec_malloc(nof_re * 6 / 8 + 1);
+  int16_t* llr     = srslte_vec_malloc(sizeof(int16_t) * nof_re * 6);
+  cf_t*    symbols = srslte_vec_malloc(sizeof(cf_t) * nof_re);
+  if (!data_tx || !data_rx || !e_bits || !llr || !symbols) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  if (srslte_sch_init(&sch)) {
+    ERROR("Error initiating SCH\n");
+    exit(-1);
+  }
+  if (srslte_softbuffer_tx_init(&softbuffer_tx, nof_prb) || srslte_softbuffer_rx_init(&softbuffer_rx, nof_prb)) {
+    ERROR("Error initiating soft buffers\n");
+    exit(-1);
+  }
+  for (srslte_mod_t mod = SRSLTE_MOD_QPSK; mod <= SRSLTE_MOD_64QAM; mod++) {
+    srslte_modem_table_lte(&modem[mod], mod);
+    srslte_modem_table_bytes(&modem[mod]);
+  }
+  if (srslte_sequence_pdsch(&seq, rnti, 0, 0, 1, nof_re * 6)) {
+    ERROR("Error initiating scrambling sequence\n");
+    exit(-1);
+  }
+
+  bzero(&cfg, sizeof(srslte_pdsch_cfg_t));
+  cfg.grant.nof_tb        = 1;
+  cfg.grant.nof_layers    = 1;
+  cfg.grant.nof_re        = nof_re;
+  cfg.grant.tb[0].enabled = true;
+  cfg.softbuffers.tx[0]   = &softbuffer_tx;
+  cfg.softbuffers.rx[0]   = &softbuffer_rx;
+
+  printf("  TBS    K     E    Mod   encode (us)  scrambling+modulation (us)\n");
+
+  for (uint32_t tbs_idx = 0; tbs_idx < 27; tbs_idx++) {
+    int tbs = srslte_ra_tbs_from_idx(tbs_idx, nof_prb);
+    if (tbs <= 0 || tbs > max_tbs) {
+      continue;
+    }
+
+    srslte_mod_t mod      = mod_from_tbs_idx(tbs_idx);
+    uint32_t     nof_bits = nof_re * srslte_mod_bits_x_symbol(mod);
+
+    cfg.grant.tb[0].tbs      = tbs;
+    cfg.grant.tb[0].mod      = mod;
+    cfg.grant.tb[0].rv       = 0;
+    cfg.grant.tb[0].nof_bits = nof_bits;
+
+    // Only single code block transport blocks with a code rate below 0.9
+    srslte_cbsegm_t cb_segm;
+    if (srslte_cbsegm(&cb_segm, (uint32_t)tbs) || cb_segm.C != 1 || 10 * cb_segm.K1 > 9 * nof_bits) {
+      continue;
+    }
+
+    for (uint32_t i = 0; i < tbs / 8; i++) {
+      data_tx[i] = (uint8_t)(rand() & 0xff);
+    }
+
+    // Coding only
+    gettimeofday(&t[1], NULL);
+    for (uint32_t n = 0; n < nof_iterations; n++) {
+      srslte_dlsch_encode(&sch, &cfg, data_tx, e_bits);
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    double encode_us = (t[0].tv_sec * 1e6 + t[0].tv_usec) / nof_iterations;
+
+    // Scrambling and modulation of the coded bits
+    gettimeofday(&t[1], NULL);
+    for (uint32_t n = 0; n < nof_iterations; n++) {
+      srslte_scrambling_bytes(&seq, e_bits, nof_bits);
+      srslte_mod_modulate_bytes(&modem[mod], e_bits, symbols, nof_bits);
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    double modulate_us = (t[0].tv_sec * 1e6 + t[0].tv_usec) / nof_iterations;
+
+    printf("%5d %4d %5d %6s %10.2f %16.2f\n",
+           tbs,
+           cb_segm.K1,
+           nof_bits,
+           srslte_mod_string(mod),
+           encode_us,
+           modulate_us);
+
+    // Check the last transport block goes through the receive chain
+    srslte_dlsch_encode(&sch, &cfg, data_tx, e_bits);
+    srslte_scrambling_bytes(&seq, e_bits, nof_bits);
+    srslte_mod_modulate_bytes(&modem[mod], e_bits, symbols, nof_bits);
+
+    srslte_demod_soft_demodulate_s(mod, symbols, llr, nof_re);
+    srslte_scrambling_s_offset(&seq, llr, 0, nof_bits);
+    srslte_softbuffer_rx_reset(&softbuffer_rx);
+    if (srslte_dlsch_decode(&sch, &cfg, llr, data_rx) || memcmp(data_tx, data_rx, tbs / 8)) {
+      ERROR("Error decoding TBS=%d\n", tbs);
+      goto quit;
+    }
+  }
+
+  ret = SRSLTE_SUCCESS;
+
+quit:
+  srslte_sequence_free(&seq);
+  for (srslte_mod_t mod = SRSLTE_MOD_QPSK; mod <= SRSLTE_MOD_64QAM; mod++) {
+    srslte_modem_table_free(&modem[mod]);
+  }
+  srslte_softbuffer_tx_free(&softbuffer_tx);
+  srslte_softbuffer_rx_free(&softbuffer_rx);
+  srslte_sch_free(&sch);
+  free(data_tx);
+  free(data_rx);
+  free(e_bits);
+  free(llr);
+  free(symbols);
+
+  if (ret == SRSLTE_SUCCESS) {
+    printf("Ok\n");
+  }
+  exit(ret);
+}
@@ -340,6 +340,20 @@ int main(int argc, char** argv)
         printf("Received invalid DCI CRC %d\n", testcases[i].dci_rx.rnti);
         goto quit;
       }
+
+      /* Decoding the same location again must return the same message */
+      srslte_dci_msg_t dci_rx2 = {};
+      dci_rx2.format           = testcases[i].dci_format;
+      dci_rx2.location         = testcases[i].dci_location;
+      if (srslte_pdcch_decode_msg(&pdcch_rx, &dl_sf, &dci_cfg, &dci_rx2)) {
+        ERROR("Error decoding DCI message\n");
+        goto quit;
+      }
+      if (dci_rx2.rnti != testcases[i].dci_rx.rnti + 1234 || dci_rx2.nof_bits != testcases[i].dci_rx.nof_bits ||
+          memcmp(dci_rx2.payload, testcases[i].dci_rx.payload, dci_rx2.nof_bits)) {
+        printf("Error in DCI %d: Second decoding does not match\n", i);
+        goto quit;
+      }
     }
 
     /* Compare Tx and Rx */
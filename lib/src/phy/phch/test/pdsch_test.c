@@ -55,15 +55,17 @@ static char*       input_file                   = NULL;
 static int         M                            = 1;
 static bool        enable_256qam                = false;
 static bool        use_8_bit                    = false;
+static bool        use_fused_rx                 = true;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [fmMbcsrtRFpnwav] \n", prog);
+  printf("Usage: %s [fmMbecsrtRFpnwav] \n", prog);
   printf("\t-f read signal from file [Default generate it with pdsch_encode()]\n");
   printf("\t-m MCS [Default %d]\n", mcs[0]);
   printf("\t-M MCS2 [Default %d]\n", mcs[1]);
   printf("\t-c cell id [Default %d]\n", cell.id);
   printf("\t-b Use 8-bit LLR [Default 16-bit]\n");
+  printf("\t-e Store the codeword LLRs instead of using the fused receive path\n");
   printf("\t-s subframe [Default %d]\n", subframe);
   printf("\t-r rv_idx [Default %d]\n", rv_idx[0]);
   printf("\t-t rv_idx2 [Default %d]\n", rv_idx[1]);
@@ -83,7 +85,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "fmMcsbrtRFpnqawvXxj")) != -1) {
+  while ((opt = getopt(argc, argv, "fmMcsbertRFpnqawvXxj")) != -1) {
     switch (opt) {
       case 'f':
         input_file = argv[optind];
@@ -94,6 +96,9 @@ void parse_args(int argc, char** argv)
       case 'b':
         use_8_bit = true;
         break;
+      case 'e':
+        use_fused_rx = false;
+        break;
       case 'M':
         mcs[1] = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
@@ -157,7 +162,7 @@ static int check_softbits(srslte_pdsch_t*     pdsch_enb,
 {
   int ret = SRSLTE_SUCCESS;
 
-  if (!pdsch_ue->llr_is_8bit && !tb_cw_swap) {
+  if (!pdsch_ue->llr_is_8bit && !pdsch_ue->fused_rx && !tb_cw_swap) {
 
     // Generate sequence
     srslte_sequence_pdsch(&pdsch_ue->tmp_seq,
@@ -337,6 +342,7 @@ int main(int argc, char** argv)
 
   pdsch_rx.llr_is_8bit        = use_8_bit;
   pdsch_rx.dl_sch.llr_is_8bit = use_8_bit;
+  pdsch_rx.fused_rx           = use_fused_rx;
 
   srslte_pdsch_set_rnti(&pdsch_rx, rnti);
 
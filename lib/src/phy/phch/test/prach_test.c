@@ -36,6 +36,9 @@ uint32_t nof_prb        = 50;
 uint32_t config_idx     = 3;
 uint32_t root_seq_idx   = 0;
 uint32_t zero_corr_zone = 15;
+uint32_t nof_rx_ant     = 1;
+
+static cf_t preamble_ant[SRSLTE_MAX_PORTS][MAX_LEN];
 
 void usage(char* prog)
 {
@@ -44,12 +47,13 @@ void usage(char* prog)
   printf("\t-f Preamble format [Default 0]\n");
   printf("\t-r Root sequence index [Default 0]\n");
   printf("\t-z Zero correlation zone config [Default 1]\n");
+  printf("\t-a Number of receive antennas [Default %d]\n", nof_rx_ant);
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "nfrz")) != -1) {
+  while ((opt = getopt(argc, argv, "nfrza")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -63,6 +67,9 @@ void parse_args(int argc, char** argv)
       case 'z':
         zero_corr_zone = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'a':
+        nof_rx_ant = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -107,9 +114,20 @@ int main(int argc, char** argv)
 
     uint32_t prach_len = prach.N_seq;
 
+    // Every antenna sees the preamble with a different phase
+    cf_t* signal[SRSLTE_MAX_PORTS] = {};
+    for (uint32_t a = 0; a < nof_rx_ant; a++) {
+      srslte_vec_sc_prod_ccc(preamble, cexpf(_Complex_I * 0.7f * a), preamble_ant[a], prach.N_cp + prach.N_seq);
+      signal[a] = &preamble_ant[a][prach.N_cp];
+    }
+
     struct timeval t[3];
     gettimeofday(&t[1], NULL);
-    srslte_prach_detect(&prach, 0, &preamble[prach.N_cp], prach_len, indices, &n_indices);
+    if (nof_rx_ant > 1) {
+      srslte_prach_detect_offset_multi(&prach, 0, signal, nof_rx_ant, prach_len, indices, NULL, NULL, &n_indices);
+    } else {
+      srslte_prach_detect(&prach, 0, &preamble[prach.N_cp], prach_len, indices, &n_indices);
+    }
     gettimeofday(&t[2], NULL);
     get_time_interval(t);
     printf("texec=%ld us\n", t[0].tv_usec);
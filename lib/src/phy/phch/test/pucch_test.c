@@ -133,11 +133,58 @@ int test_uci_cqi_pucch(void)
   return ret;
 }
 
+/* Decodes with an ideal channel twice, the second time the reference signal is taken from the RNTI cache, and
+ * compares the result with a receiver that has no RNTI state */
+int test_decode(srslte_pucch_t*        pucch_enb,
+                srslte_pucch_t*        pucch_enb_nornti,
+                srslte_ul_sf_cfg_t*    ul_sf,
+                srslte_pucch_cfg_t*    cfg,
+                srslte_chest_ul_res_t* chest_res,
+                cf_t*                  sf_symbols,
+                srslte_uci_value_t*    uci_value)
+{
+  srslte_pucch_res_t res[3];
+  bzero(res, sizeof(res));
+
+  if (srslte_pucch_decode(pucch_enb, ul_sf, cfg, chest_res, sf_symbols, &res[0]) ||
+      srslte_pucch_decode(pucch_enb, ul_sf, cfg, chest_res, sf_symbols, &res[1]) ||
+      srslte_pucch_decode(pucch_enb_nornti, ul_sf, cfg, chest_res, sf_symbols, &res[2])) {
+    ERROR("Error decoding PUCCH\n");
+    return SRSLTE_ERROR;
+  }
+
+  for (uint32_t i = 1; i < 3; i++) {
+    if (res[i].correlation != res[0].correlation || res[i].detected != res[0].detected) {
+      ERROR("Decoding %d mismatch: corr=%f/%f\n", i, res[i].correlation, res[0].correlation);
+      return SRSLTE_ERROR;
+    }
+  }
+
+  if (!res[0].detected) {
+    ERROR("PUCCH %s not detected, corr=%f\n", srslte_pucch_format_text(cfg->format), res[0].correlation);
+    return SRSLTE_ERROR;
+  }
+
+  if (cfg->format < SRSLTE_PUCCH_FORMAT_2) {
+    for (uint32_t a = 0; a < srslte_uci_cfg_total_ack(&cfg->uci_cfg); a++) {
+      if (res[0].uci_data.ack.ack_value[a] != uci_value->ack.ack_value[a]) {
+        ERROR("PUCCH %s wrong ACK %d\n", srslte_pucch_format_text(cfg->format), a);
+        return SRSLTE_ERROR;
+      }
+    }
+  }
+
+  return SRSLTE_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   srslte_pucch_t        pucch;
+  srslte_pucch_t        pucch_enb;
+  srslte_pucch_t        pucch_enb_nornti;
   srslte_pucch_cfg_t    pucch_cfg;
   srslte_refsignal_ul_t dmrs;
+  srslte_chest_ul_res_t chest_res;
   cf_t*                 sf_symbols = NULL;
   cf_t                  pucch_dmrs[2 * SRSLTE_NRE * 3];
   int                   ret = -1;
@@ -156,6 +203,19 @@ int main(int argc, char** argv)
     ERROR("Error creating PDSCH object\n");
     exit(-1);
   }
+  if (srslte_pucch_init_enb(&pucch_enb) || srslte_pucch_init_enb(&pucch_enb_nornti)) {
+    ERROR("Error creating PUCCH object\n");
+    exit(-1);
+  }
+  if (srslte_pucch_set_cell(&pucch_enb, cell) || srslte_pucch_set_cell(&pucch_enb_nornti, cell)) {
+    ERROR("Error setting PUCCH cell\n");
+    exit(-1);
+  }
+  if (srslte_chest_ul_res_init(&chest_res, cell.nof_prb)) {
+    ERROR("Error initiating channel estimation result\n");
+    exit(-1);
+  }
+  srslte_chest_ul_res_set_identity(&chest_res);
   if (srslte_refsignal_ul_init(&dmrs, cell.nof_prb)) {
     ERROR("Error creating PDSCH object\n");
     exit(-1);
@@ -167,7 +227,7 @@ int main(int argc, char** argv)
 
   bzero(&pucch_cfg, sizeof(srslte_pucch_cfg_t));
 
-  if (srslte_pucch_set_rnti(&pucch, 11)) {
+  if (srslte_pucch_set_rnti(&pucch, 11) || srslte_pucch_set_rnti(&pucch_enb, 11)) {
     ERROR("Error setting C-RNTI\n");
     goto quit;
   }
@@ -223,6 +283,8 @@ int main(int argc, char** argv)
           if (format >= SRSLTE_PUCCH_FORMAT_2) {
             uci_data.cfg.cqi.data_enable = true;
           }
+          pucch_cfg.uci_cfg           = uci_data.cfg;
+          pucch_cfg.threshold_format1 = 0.8f;
 
           gettimeofday(&t[1], NULL);
           if (srslte_pucch_encode(&pucch, &ul_sf, &pucch_cfg, &uci_data.value, sf_symbols)) {
@@ -241,6 +303,17 @@ int main(int argc, char** argv)
           gettimeofday(&t[2], NULL);
           get_time_interval(t);
           INFO("format %d, n_pucch: %d, ncs: %d, d: %d, t_exec=%ld us\n", format, n_pucch, ncs, d, t[0].tv_usec);
+
+          // There is no receiver for Format 3
+          if (format < SRSLTE_PUCCH_FORMAT_3 && test_decode(&pucch_enb,
+                                                            &pucch_enb_nornti,
+                                                            &ul_sf,
+                                                            &pucch_cfg,
+                                                            &chest_res,
+                                                            sf_symbols,
+                                                            &uci_data.value)) {
+            goto quit;
+          }
         }
       }
     }
@@ -249,6 +322,9 @@ int main(int argc, char** argv)
   ret = 0;
 quit:
   srslte_pucch_free(&pucch);
+  srslte_pucch_free(&pucch_enb);
+  srslte_pucch_free(&pucch_enb_nornti);
+  srslte_chest_ul_res_free(&chest_res);
   srslte_refsignal_ul_free(&dmrs);
 
   if (sf_symbols) {
@@ -56,6 +56,8 @@ int          freq_hop      = -1;
 int          riv           = -1;
 uint32_t     mcs_idx       = 0;
 bool         enable_64_qam = false;
+bool         rx_pool_8bit  = false;
+bool         use_8_bit     = false;
 
 void usage(char* prog)
 {
@@ -84,6 +86,9 @@ void usage(char* prog)
   printf("\n\tOther parameters:\n");
   printf("\t\t-p enable_64qam [Default %s]\n", enable_64_qam ? "enabled" : "disabled");
   printf("\t\t-s number of subframes [Default %d]\n", subframe);
+  printf("\t\t-P store the soft bits as 8-bit in a soft-buffer pool [Default %s]\n",
+         rx_pool_8bit ? "enabled" : "disabled");
+  printf("\t\t-b use 8-bit LLR in the receiver [Default %s]\n", use_8_bit ? "enabled" : "disabled");
   printf("\t-v [set srslte_verbose to debug, default none]\n");
 }
 
@@ -139,7 +144,7 @@ void parse_extensive_param(char* param, char* arg)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "msLFrncpvf")) != -1) {
+  while ((opt = getopt(argc, argv, "msLFrncpPbvf")) != -1) {
     switch (opt) {
       case 'm':
         mcs_idx = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -169,6 +174,12 @@ void parse_args(int argc, char** argv)
         parse_extensive_param(argv[optind], argv[optind + 1]);
         optind++;
         break;
+      case 'P':
+        rx_pool_8bit = true;
+        break;
+      case 'b':
+        use_8_bit = true;
+        break;
       case 'v':
         srslte_verbose++;
         break;
@@ -181,20 +192,22 @@ void parse_args(int argc, char** argv)
 
 int main(int argc, char** argv)
 {
-  srslte_random_t        random_h = srslte_random_init(0);
-  srslte_chest_ul_res_t  chest_res;
-  srslte_pusch_t         pusch_tx;
-  srslte_pusch_t         pusch_rx;
-  uint8_t*               data       = NULL;
-  uint8_t*               data_rx    = NULL;
-  cf_t*                  sf_symbols = NULL;
-  int                    ret        = -1;
-  struct timeval         t[3];
-  srslte_pusch_cfg_t     cfg;
-  srslte_softbuffer_tx_t softbuffer_tx;
-  srslte_softbuffer_rx_t softbuffer_rx;
+  srslte_random_t             random_h   = srslte_random_init(0);
+  srslte_chest_ul_res_t       chest_res;
+  srslte_pusch_t              pusch_tx;
+  srslte_pusch_t              pusch_rx;
+  uint8_t*                    data       = NULL;
+  uint8_t*                    data_rx    = NULL;
+  cf_t*                       sf_symbols = NULL;
+  int                         ret        = -1;
+  struct timeval              t[3];
+  srslte_pusch_cfg_t          cfg;
+  srslte_softbuffer_tx_t      softbuffer_tx;
+  srslte_softbuffer_rx_t      softbuffer_rx;
+  srslte_softbuffer_rx_pool_t rx_pool;
 
   ZERO_OBJECT(uci_data_tx);
+  ZERO_OBJECT(rx_pool);
 
   bzero(&cfg, sizeof(srslte_pusch_cfg_t));
 
@@ -241,6 +254,8 @@ int main(int argc, char** argv)
     ERROR("Error creating PUSCH object\n");
     goto quit;
   }
+  pusch_rx.llr_is_8bit        = use_8_bit;
+  pusch_rx.ul_sch.llr_is_8bit = use_8_bit;
 
   uint16_t rnti = 62;
   dci.rnti      = rnti;
@@ -272,7 +287,16 @@ int main(int argc, char** argv)
     goto quit;
   }
 
-  if (srslte_softbuffer_rx_init(&softbuffer_rx, 100)) {
+  if (rx_pool_8bit) {
+    if (srslte_softbuffer_rx_pool_init(&rx_pool, SRSLTE_MAX_CODEBLOCKS, true)) {
+      ERROR("Error initiating soft buffer pool\n");
+      goto quit;
+    }
+    if (srslte_softbuffer_rx_init_pool(&softbuffer_rx, 100, &rx_pool)) {
+      ERROR("Error initiating soft buffer\n");
+      goto quit;
+    }
+  } else if (srslte_softbuffer_rx_init(&softbuffer_rx, 100)) {
     ERROR("Error initiating soft buffer\n");
     goto quit;
   }
@@ -339,6 +363,14 @@ int main(int argc, char** argv)
       INFO("Rx Data is Ok\n");
     }
 
+    // Every code block goes back to the pool once the transport block is decoded
+    if (rx_pool_8bit && srslte_softbuffer_rx_pool_nof_free(&rx_pool) != rx_pool.nof_cb) {
+      printf("Soft-buffer pool not reclaimed (%d/%d free)\n",
+             srslte_softbuffer_rx_pool_nof_free(&rx_pool),
+             rx_pool.nof_cb);
+      ret = SRSLTE_ERROR;
+    }
+
     if (uci_data_tx.cfg.ack[0].nof_acks) {
       if (memcmp(uci_data_tx.value.ack.ack_value, pusch_res.uci.ack.ack_value, uci_data_tx.cfg.ack[0].nof_acks) != 0) {
         printf("UCI ACK bit error:\n");
@@ -393,6 +425,7 @@ quit:
   srslte_pusch_free(&pusch_rx);
   srslte_softbuffer_tx_free(&softbuffer_tx);
   srslte_softbuffer_rx_free(&softbuffer_rx);
+  srslte_softbuffer_rx_pool_free(&rx_pool);
   srslte_random_free(random_h);
   if (sf_symbols) {
     free(sf_symbols);
@@ -0,0 +1,703 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Shared memory RF device. Each transmit channel writes a timestamped ring in POSIX shared memory and each receive
+ * channel reads one or more of them (see rf_shm_imp_trx.h), so eNB and UE processes on the same host exchange
+ * samples with a single copy and no system calls. Example with two UE attached to one eNB:
+ *
+ *   eNB: tx_port=enb_dl,rx_port=ue1_ul:ue2_ul,id=enb,base_srate=23.04e6
+ *   UE1: tx_port=ue1_ul,rx_port=enb_dl,id=ue1,base_srate=23.04e6
+ *   UE2: tx_port=ue2_ul,rx_port=enb_dl,id=ue2,base_srate=23.04e6
+ *
+ * Additional channels use tx_port2=, rx_port2=, ... Time is given by the sample count: a device which has not
+ * transmitted yet (e.g. a UE) aligns its time to the first stream it receives.
+ */
+
+#include "rf_shm_imp.h"
+#include "rf_helper.h"
+#include "rf_shm_imp_trx.h"
+#include <math.h>
+#include <srslte/phy/common/phy_common.h>
+#include <srslte/phy/common/timestamp.h>
+#include <srslte/phy/utils/vector.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+  // Common attributes
+  srslte_rf_info_t info;
+  uint32_t         nof_channels;
+
+  // RF State
+  uint32_t srate; // radio rate configured by upper layers
+  uint32_t base_srate;
+  uint32_t decim_factor; // decimation factor between base_srate used on transport on radio's rate
+  uint32_t max_samples;  // maximum number of samples per transfer at the base rate
+  double   rx_gain;
+  bool     tx_used;
+
+  // Rings
+  rf_shm_tx_t transmitter[SRSLTE_MAX_PORTS];
+  rf_shm_rx_t receiver[SRSLTE_MAX_PORTS];
+
+  char id[PARAM_LEN_SHORT];
+
+  // Various sample buffers
+  cf_t* buffer_decimation[SRSLTE_MAX_PORTS];
+  cf_t* buffer_tx;
+
+  // Rx timestamp
+  uint64_t next_rx_ts;
+  bool     rx_synced;
+
+  // Real-time pacing
+  bool            realtime;
+  bool            pace_init;
+  struct timespec pace_t0;
+  uint64_t        pace_ts0;
+
+  srslte_rf_error_handler_t error_handler;
+} rf_shm_handler_t;
+
+static void update_rates(rf_shm_handler_t* handler, double srate);
+
+/*
+ * Static Atributes
+ */
+const char shm_devname[4] = DEVNAME_SHM;
+
+/*
+ * Static methods
+ */
+
+void rf_shm_info(char* id, const char* format, ...)
+{
+#if VERBOSE
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  va_list args;
+  va_start(args, format);
+  printf("[%s@%02ld.%06ld] ", id ? id : "shm", t.tv_sec % 10, t.tv_usec);
+  vprintf(format, args);
+  va_end(args);
+#else  /* VERBOSE */
+  // Do nothing
+#endif /* VERBOSE */
+}
+
+void rf_shm_error(char* id, const char* format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  fprintf(stderr, "[shm] %s: ", id ? id : "shm");
+  vfprintf(stderr, format, args);
+  va_end(args);
+}
+
+static void log_error(rf_shm_handler_t* handler, int type, bool is_rx)
+{
+  if (handler->error_handler) {
+    srslte_rf_error_t error;
+    bzero(&error, sizeof(srslte_rf_error_t));
+    error.opt  = is_rx ? 1 : 0;
+    error.type = type;
+    handler->error_handler(error);
+  }
+}
+
+/* Sleeps until the wall clock reaches the next rx timestamp, so the emulation does not run faster than real time */
+static void pace(rf_shm_handler_t* handler)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  if (!handler->pace_init) {
+    handler->pace_t0   = now;
+    handler->pace_ts0  = handler->next_rx_ts;
+    handler->pace_init = true;
+    return;
+  }
+
+  uint64_t elapsed_ns = ((handler->next_rx_ts - handler->pace_ts0) * 1000000000ULL) / handler->base_srate;
+
+  struct timespec deadline = handler->pace_t0;
+  deadline.tv_sec += elapsed_ns / 1000000000ULL;
+  deadline.tv_nsec += elapsed_ns % 1000000000ULL;
+  if (deadline.tv_nsec >= 1000000000L) {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+
+  if (deadline.tv_sec > now.tv_sec || (deadline.tv_sec == now.tv_sec && deadline.tv_nsec > now.tv_nsec)) {
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+  }
+}
+
+/*
+ * Public methods
+ */
+
+void rf_shm_suppress_stdout(void* h)
+{
+  // do nothing
+}
+
+void rf_shm_register_error_handler(void* h, srslte_rf_error_handler_t new_handler)
+{
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    handler->error_handler    = new_handler;
+  }
+}
+
+const char* rf_shm_devname(void* h)
+{
+  return shm_devname;
+}
+
+int rf_shm_start_rx_stream(void* h, bool now)
+{
+  return SRSLTE_SUCCESS;
+}
+
+int rf_shm_stop_rx_stream(void* h)
+{
+  return SRSLTE_SUCCESS;
+}
+
+void rf_shm_flush_buffer(void* h)
+{
+  // do nothing
+}
+
+bool rf_shm_has_rssi(void* h)
+{
+  return false;
+}
+
+float rf_shm_get_rssi(void* h)
+{
+  return 0.0;
+}
+
+int rf_shm_open(char* args, void** h)
+{
+  return rf_shm_open_multi(args, h, 1);
+}
+
+static inline int parse_string(char* args, const char* config_arg, char* value, uint32_t len)
+{
+  int   ret        = SRSLTE_ERROR;
+  char* config_ptr = strstr(args, config_arg);
+  if (config_ptr) {
+    char config_str[PARAM_LEN] = {0};
+    copy_subdev_string(config_str, config_ptr + strlen(config_arg));
+    strncpy(value, config_str, len - 1);
+    value[len - 1] = 0;
+    remove_substring(args, config_arg);
+    remove_substring(args, config_str);
+    ret = SRSLTE_SUCCESS;
+  }
+  return ret;
+}
+
+int rf_shm_open_multi(char* args, void** h, uint32_t nof_channels)
+{
+  int ret = SRSLTE_ERROR;
+  if (h && nof_channels <= SRSLTE_MAX_PORTS) {
+    *h = NULL;
+
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)malloc(sizeof(rf_shm_handler_t));
+    if (!handler) {
+      perror("malloc");
+      return SRSLTE_ERROR;
+    }
+    bzero(handler, sizeof(rf_shm_handler_t));
+    *h                        = handler;
+    handler->base_srate       = SHM_BASERATE_DEFAULT_HZ; // Sample rate for 100 PRB cell
+    handler->rx_gain          = 0.0;
+    handler->info.max_rx_gain = SHM_MAX_GAIN_DB;
+    handler->info.min_rx_gain = SHM_MIN_GAIN_DB;
+    handler->info.max_tx_gain = SHM_MAX_GAIN_DB;
+    handler->info.min_tx_gain = SHM_MIN_GAIN_DB;
+    handler->nof_channels     = nof_channels;
+    handler->realtime         = true;
+    strcpy(handler->id, "shm\0");
+
+    rf_shm_opts_t opts = {};
+    opts.ring_ms       = SHM_RING_DEFAULT_MS;
+
+    char tx_port[SRSLTE_MAX_PORTS][PARAM_LEN] = {};
+    char rx_port[SRSLTE_MAX_PORTS][PARAM_LEN] = {};
+
+    // parse args
+    if (args && strlen(args)) {
+      char config_str[PARAM_LEN] = {0};
+
+      // base_srate
+      if (!parse_string(args, "base_srate=", config_str, PARAM_LEN)) {
+        printf("Using base rate=%s\n", config_str);
+        handler->base_srate = (uint32_t)strtod(config_str, NULL);
+      }
+
+      // id
+      if (!parse_string(args, "id=", handler->id, PARAM_LEN_SHORT)) {
+        printf("Using ID=%s\n", handler->id);
+      }
+
+      // ring_ms
+      if (!parse_string(args, "ring_ms=", config_str, PARAM_LEN)) {
+        opts.ring_ms = (uint32_t)strtol(config_str, NULL, 10);
+        printf("Using %d ms rings\n", opts.ring_ms);
+      }
+
+      // realtime
+      if (!parse_string(args, "realtime=", config_str, PARAM_LEN)) {
+        handler->realtime = (strtol(config_str, NULL, 10) != 0);
+        printf("Real-time pacing %s\n", handler->realtime ? "enabled" : "disabled");
+      }
+
+      // tx_port and rx_port for each channel
+      for (uint32_t i = 0; i < handler->nof_channels; i++) {
+        char config_arg[PARAM_LEN] = "tx_port=";
+        if (i > 0) {
+          snprintf(config_arg, PARAM_LEN, "tx_port%d=", i + 1);
+        }
+        if (!parse_string(args, config_arg, tx_port[i], PARAM_LEN)) {
+          printf("Channel %d. Using tx_port=%s\n", i, tx_port[i]);
+        }
+
+        snprintf(config_arg, PARAM_LEN, "rx_port=");
+        if (i > 0) {
+          snprintf(config_arg, PARAM_LEN, "rx_port%d=", i + 1);
+        }
+        if (!parse_string(args, config_arg, rx_port[i], PARAM_LEN)) {
+          printf("Channel %d. Using rx_port=%s\n", i, rx_port[i]);
+        }
+      }
+    } else {
+      fprintf(stderr, "[shm] Error: RF device args are required for shared memory no-RF module\n");
+      goto clean_exit;
+    }
+
+    update_rates(handler, 1.92e6);
+
+    // Transfers up to 10 ms at the base rate
+    handler->max_samples = handler->base_srate / 100;
+    opts.id              = handler->id;
+    opts.base_srate      = handler->base_srate;
+    opts.max_samples     = handler->max_samples;
+
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      // initialize transmitter
+      if (strlen(tx_port[i]) != 0) {
+        if (rf_shm_tx_open(&handler->transmitter[i], opts, tx_port[i]) != SRSLTE_SUCCESS) {
+          fprintf(stderr, "[shm] Error: opening transmitter\n");
+          goto clean_exit;
+        }
+      } else {
+        fprintf(stdout, "[shm] %s Tx port not specified. Disabling transmitter.\n", handler->id);
+      }
+
+      // initialize receiver
+      if (strlen(rx_port[i]) != 0) {
+        if (rf_shm_rx_open(&handler->receiver[i], opts, rx_port[i]) != SRSLTE_SUCCESS) {
+          fprintf(stderr, "[shm] Error: opening receiver\n");
+          goto clean_exit;
+        }
+      } else {
+        fprintf(stdout, "[shm] %s Rx port not specified. Disabling receiver.\n", handler->id);
+      }
+
+      if (!handler->transmitter[i].running && !handler->receiver[i].running) {
+        fprintf(stderr, "[shm] Error: Neither Tx port nor Rx port specified.\n");
+        goto clean_exit;
+      }
+    }
+
+    // Create decimation and interpolation buffers
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      handler->buffer_decimation[i] = srslte_vec_malloc(sizeof(cf_t) * handler->max_samples);
+      if (!handler->buffer_decimation[i]) {
+        fprintf(stderr, "Error: allocating decimation buffer\n");
+        goto clean_exit;
+      }
+    }
+
+    handler->buffer_tx = srslte_vec_malloc(sizeof(cf_t) * handler->max_samples);
+    if (!handler->buffer_tx) {
+      fprintf(stderr, "Error: allocating tx buffer\n");
+      goto clean_exit;
+    }
+
+    ret = SRSLTE_SUCCESS;
+
+  clean_exit:
+    if (ret) {
+      rf_shm_close(handler);
+      *h = NULL;
+    }
+  }
+  return ret;
+}
+
+int rf_shm_close(void* h)
+{
+  rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+
+  if (handler) {
+    rf_shm_info(handler->id, "Closing ...\n");
+
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      rf_shm_tx_close(&handler->transmitter[i]);
+      rf_shm_rx_close(&handler->receiver[i]);
+      if (handler->buffer_decimation[i]) {
+        free(handler->buffer_decimation[i]);
+      }
+    }
+
+    if (handler->buffer_tx) {
+      free(handler->buffer_tx);
+    }
+
+    free(handler);
+  }
+
+  return SRSLTE_SUCCESS;
+}
+
+static void update_rates(rf_shm_handler_t* handler, double srate)
+{
+  if (handler) {
+    // Decimation must be full integer
+    if (((uint64_t)handler->base_srate % (uint64_t)srate) == 0) {
+      handler->srate        = (uint32_t)srate;
+      handler->decim_factor = handler->base_srate / handler->srate;
+    } else {
+      fprintf(stderr,
+              "Error: couldn't update sample rate. %.2f is not divisible by %.2f\n",
+              srate / 1e6,
+              handler->base_srate / 1e6);
+    }
+    printf("Current sample rate is %.2f MHz with a base rate of %.2f MHz (x%d decimation)\n",
+           handler->srate / 1e6,
+           handler->base_srate / 1e6,
+           handler->decim_factor);
+  }
+}
+
+double rf_shm_set_rx_srate(void* h, double srate)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    update_rates(handler, srate);
+    ret = handler->srate;
+  }
+  return ret;
+}
+
+double rf_shm_set_tx_srate(void* h, double srate)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    update_rates(handler, srate);
+    ret = handler->srate;
+  }
+  return ret;
+}
+
+double rf_shm_set_rx_gain(void* h, double gain)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    handler->rx_gain          = gain;
+    ret                       = gain;
+  }
+  return ret;
+}
+
+double rf_shm_set_tx_gain(void* h, double gain)
+{
+  return 0.0;
+}
+
+double rf_shm_get_rx_gain(void* h)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    ret                       = handler->rx_gain;
+  }
+  return ret;
+}
+
+double rf_shm_get_tx_gain(void* h)
+{
+  return 0.0;
+}
+
+srslte_rf_info_t* rf_shm_get_info(void* h)
+{
+  srslte_rf_info_t* info = NULL;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    info                      = &handler->info;
+  }
+  return info;
+}
+
+double rf_shm_set_rx_freq(void* h, uint32_t ch, double freq)
+{
+  // Channels are mapped to rings by the device arguments
+  return freq;
+}
+
+double rf_shm_set_tx_freq(void* h, uint32_t ch, double freq)
+{
+  return freq;
+}
+
+void rf_shm_get_time(void* h, time_t* secs, double* frac_secs)
+{
+  if (h) {
+    rf_shm_handler_t*  handler = (rf_shm_handler_t*)h;
+    srslte_timestamp_t ts      = {};
+    srslte_timestamp_init_uint64(&ts, handler->next_rx_ts, handler->base_srate);
+    if (secs) {
+      *secs = ts.full_secs;
+    }
+    if (frac_secs) {
+      *frac_secs = ts.frac_secs;
+    }
+  }
+}
+
+int rf_shm_recv_with_time(void* h, void* data, uint32_t nsamples, bool blocking, time_t* secs, double* frac_secs)
+{
+  return rf_shm_recv_with_time_multi(h, &data, nsamples, blocking, secs, frac_secs);
+}
+
+int rf_shm_recv_with_time_multi(void*    h,
+                                void*    data[4],
+                                uint32_t nsamples,
+                                bool     blocking,
+                                time_t*  secs,
+                                double*  frac_secs)
+{
+  int ret = SRSLTE_ERROR;
+
+  if (h) {
+    rf_shm_handler_t* handler           = (rf_shm_handler_t*)h;
+    uint32_t          nsamples_baserate = nsamples * handler->decim_factor;
+
+    rf_shm_info(handler->id, "Rx %d samples\n", nsamples);
+
+    if (nsamples_baserate > handler->max_samples) {
+      fprintf(stderr,
+              "[shm] Error: Trying to receive %d samples but buffer is only %d samples.\n",
+              nsamples_baserate,
+              handler->max_samples);
+      goto clean_exit;
+    }
+
+    // A device which has not transmitted yet takes the time of the first stream it receives
+    if (!handler->rx_synced && !handler->tx_used && handler->receiver[0].running) {
+      uint64_t ts = 0;
+      while (!rf_shm_rx_sync_ts(&handler->receiver[0], &ts)) {
+        usleep(1000);
+      }
+      rf_shm_info(handler->id, "Synchronised rx time to %" PRIu64 "\n", ts);
+      handler->next_rx_ts = ts;
+      handler->pace_init  = false;
+    }
+    handler->rx_synced = true;
+
+    // set timestamp for this reception
+    if (secs != NULL && frac_secs != NULL) {
+      srslte_timestamp_t ts = {};
+      srslte_timestamp_init_uint64(&ts, handler->next_rx_ts, handler->base_srate);
+      *secs      = ts.full_secs;
+      *frac_secs = ts.frac_secs;
+    }
+
+    // Keep the transmitted streams up to date so peers waiting for them do not block
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      if (handler->transmitter[i].running) {
+        rf_shm_tx_align(&handler->transmitter[i], handler->next_rx_ts + nsamples_baserate);
+      }
+    }
+
+    // Read straight into the destination buffers unless decimation is required
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      rf_shm_rx_t* rx        = &handler->receiver[i];
+      cf_t*        buffer    = (cf_t*)data[i];
+      uint64_t     overflows = rx->nof_overflows;
+      uint64_t     late      = rx->nof_late;
+      cf_t*        ptr       = (handler->decim_factor != 1 || buffer == NULL) ? handler->buffer_decimation[i] : buffer;
+
+      if (rx->running) {
+        if (rf_shm_rx_baseband(rx, ptr, handler->next_rx_ts, nsamples_baserate) < 0) {
+          goto clean_exit;
+        }
+        if (rx->nof_overflows != overflows) {
+          log_error(handler, SRSLTE_RF_ERROR_OVERFLOW, true);
+        }
+        if (rx->nof_late != late) {
+          log_error(handler, SRSLTE_RF_ERROR_LATE, true);
+        }
+      } else if (buffer) {
+        bzero(buffer, sizeof(cf_t) * nsamples);
+      }
+
+      // Same decimation as the ZMQ device
+      if (rx->running && buffer && handler->decim_factor != 1) {
+        for (uint32_t k = 0, n = 0; k < nsamples; k++) {
+          cf_t avg = 0.0f;
+          for (uint32_t j = 0; j < handler->decim_factor; j++, n++) {
+            avg += ptr[n];
+          }
+          buffer[k] = avg;
+        }
+      }
+    }
+
+    // Set gain
+    float scale = srslte_convert_dB_to_amplitude(handler->rx_gain);
+    for (uint32_t i = 0; i < handler->nof_channels && scale != 1.0f; i++) {
+      if (data[i] && handler->receiver[i].running) {
+        srslte_vec_sc_prod_cfc(data[i], scale, data[i], nsamples);
+      }
+    }
+
+    // update rx time
+    handler->next_rx_ts += nsamples_baserate;
+
+    if (handler->realtime) {
+      pace(handler);
+    }
+
+    ret = nsamples;
+  }
+
+clean_exit:
+  return ret;
+}
+
+int rf_shm_send_timed(void*  h,
+                      void*  data,
+                      int    nsamples,
+                      time_t secs,
+                      double frac_secs,
+                      bool   has_time_spec,
+                      bool   blocking,
+                      bool   is_start_of_burst,
+                      bool   is_end_of_burst)
+{
+  void* _data[4] = {data, NULL, NULL, NULL};
+
+  return rf_shm_send_timed_multi(
+      h, _data, nsamples, secs, frac_secs, has_time_spec, blocking, is_start_of_burst, is_end_of_burst);
+}
+
+int rf_shm_send_timed_multi(void*  h,
+                            void*  data[4],
+                            int    nsamples,
+                            time_t secs,
+                            double frac_secs,
+                            bool   has_time_spec,
+                            bool   blocking,
+                            bool   is_start_of_burst,
+                            bool   is_end_of_burst)
+{
+  int ret = SRSLTE_ERROR;
+
+  if (h && data && nsamples > 0) {
+    rf_shm_handler_t* handler           = (rf_shm_handler_t*)h;
+    uint32_t          nsamples_baseband = nsamples * handler->decim_factor;
+
+    if (nsamples_baseband > handler->max_samples) {
+      fprintf(stderr,
+              "Error: trying to transmit too many samples (%d > %d).\n",
+              nsamples_baseband,
+              handler->max_samples);
+      goto clean_exit;
+    }
+
+    rf_shm_info(handler->id, "Tx %d samples\n", nsamples);
+
+    // check if this is a tx in the future
+    if (has_time_spec) {
+      srslte_timestamp_t ts = {};
+      srslte_timestamp_init(&ts, secs, frac_secs);
+      uint64_t tx_ts = srslte_timestamp_uint64(&ts, handler->base_srate);
+
+      for (uint32_t i = 0; i < handler->nof_channels; i++) {
+        if (handler->transmitter[i].running && rf_shm_tx_align(&handler->transmitter[i], tx_ts) < 0) {
+          fprintf(stderr,
+                  "[shm] Error: tx time is in the past (%" PRIu64 " < %" PRIu64 ")\n",
+                  tx_ts,
+                  handler->transmitter[i].nsamples);
+          log_error(handler, SRSLTE_RF_ERROR_LATE, false);
+          goto clean_exit;
+        }
+      }
+    }
+
+    // Send base-band samples
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      if (!handler->transmitter[i].running) {
+        continue;
+      }
+
+      if (data[i] != NULL) {
+        cf_t* buf = (cf_t*)data[i];
+
+        // Interpolate if required (zero order hold)
+        if (handler->decim_factor != 1) {
+          cf_t* src = buf;
+          buf       = handler->buffer_tx;
+          for (uint32_t k = 0, n = 0; k < nsamples; k++) {
+            for (uint32_t j = 0; j < handler->decim_factor; j++, n++) {
+              buf[n] = src[k];
+            }
+          }
+        }
+
+        rf_shm_tx_baseband(&handler->transmitter[i], buf, nsamples_baseband);
+      } else {
+        rf_shm_tx_zeros(&handler->transmitter[i], nsamples_baseband);
+      }
+    }
+    handler->tx_used = true;
+
+    ret = SRSLTE_SUCCESS;
+  }
+
+clean_exit:
+  return ret;
+}
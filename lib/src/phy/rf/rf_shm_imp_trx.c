@@ -0,0 +1,411 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <srslte/phy/utils/vector.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+static void shm_name(char* dst, const char* name)
+{
+  // POSIX shared memory objects are named /<name>, prefix them to avoid collisions with other applications
+  snprintf(dst, SHM_NAME_STRLEN, "/srslte_%s", name);
+}
+
+static size_t shm_ring_size(uint32_t nof_samples)
+{
+  return sizeof(rf_shm_ring_t) + sizeof(cf_t) * (size_t)nof_samples;
+}
+
+static uint64_t shm_time_ms(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000 + t.tv_nsec / 1000000;
+}
+
+/*
+ * Transmitter
+ */
+int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, const char* name)
+{
+  int ret = SRSLTE_ERROR;
+
+  if (q && name && strlen(name)) {
+    bzero(q, sizeof(rf_shm_tx_t));
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+    shm_name(q->name, name);
+
+    // The ring must hold, at least, two transfers so readers have time to copy before the samples are overwritten
+    uint32_t nof_samples = (uint32_t)(((uint64_t)opts.base_srate * opts.ring_ms) / 1000);
+    nof_samples          = SRSLTE_MAX(nof_samples, 2 * opts.max_samples);
+    q->size              = shm_ring_size(nof_samples);
+
+    int fd = shm_open(q->name, O_CREAT | O_RDWR, 0666);
+    if (fd < 0) {
+      rf_shm_error(q->id, "Error opening shared memory %s: %s\n", q->name, strerror(errno));
+      return ret;
+    }
+    if (ftruncate(fd, q->size) < 0) {
+      rf_shm_error(q->id, "Error resizing shared memory %s: %s\n", q->name, strerror(errno));
+      close(fd);
+      return ret;
+    }
+    q->ring = mmap(NULL, q->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (q->ring == MAP_FAILED) {
+      rf_shm_error(q->id, "Error mapping shared memory %s: %s\n", q->name, strerror(errno));
+      q->ring = NULL;
+      return ret;
+    }
+
+    // (Re)initialise the ring, attached readers see an invalid signature until it is ready
+    __atomic_store_n(&q->ring->magic, 0, __ATOMIC_RELEASE);
+    q->ring->version     = SHM_RING_VERSION;
+    q->ring->nof_samples = nof_samples;
+    q->ring->base_srate  = opts.base_srate;
+    q->ring->start_ts    = 0;
+    __atomic_store_n(&q->ring->write_ts, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&q->ring->writing_ts, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&q->ring->active, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&q->ring->magic, SHM_RING_MAGIC, __ATOMIC_RELEASE);
+
+    rf_shm_info(q->id, "Opened tx ring %s with %d samples\n", q->name, nof_samples);
+
+    q->running = true;
+    ret        = SRSLTE_SUCCESS;
+  }
+
+  return ret;
+}
+
+/* Writes samples (zeros if buffer is NULL) at the current timestamp and publishes them */
+static void rf_shm_tx_write(rf_shm_tx_t* q, const cf_t* buffer, uint32_t nsamples)
+{
+  rf_shm_ring_t* ring = q->ring;
+  uint32_t       N    = ring->nof_samples;
+
+  // The first write sets the start of the stream
+  if (!__atomic_load_n(&ring->active, __ATOMIC_RELAXED)) {
+    ring->start_ts = q->nsamples;
+    __atomic_store_n(&ring->write_ts, q->nsamples, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->writing_ts, q->nsamples, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->active, 1, __ATOMIC_RELEASE);
+  }
+
+  // Announce the range which is going to be overwritten before touching it
+  __atomic_store_n(&ring->writing_ts, q->nsamples + nsamples, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  while (nsamples) {
+    uint32_t idx = (uint32_t)(q->nsamples % N);
+    uint32_t len = SRSLTE_MIN(nsamples, N - idx);
+    if (buffer) {
+      memcpy(&ring->samples[idx], buffer, sizeof(cf_t) * len);
+      buffer += len;
+    } else {
+      bzero(&ring->samples[idx], sizeof(cf_t) * len);
+    }
+    q->nsamples += len;
+    nsamples -= len;
+  }
+
+  __atomic_store_n(&ring->write_ts, q->nsamples, __ATOMIC_RELEASE);
+}
+
+/* Fills with zeros until the timestamp ts. Returns the number of zeros (negative if ts is in the past) */
+int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts)
+{
+  if (!q->running) {
+    return 0;
+  }
+
+  // Nothing written yet, the stream starts at ts
+  if (!__atomic_load_n(&q->ring->active, __ATOMIC_RELAXED)) {
+    q->nsamples = ts;
+    return 0;
+  }
+
+  int64_t gap = (int64_t)(ts - q->nsamples);
+  if (gap > 0) {
+    // Samples older than the ring length would be overwritten anyway
+    if (gap > q->ring->nof_samples) {
+      q->nsamples = ts - q->ring->nof_samples;
+    }
+    rf_shm_tx_write(q, NULL, (uint32_t)(ts - q->nsamples));
+    rf_shm_info(q->id, " - tx_align: inserted %" PRId64 " zeros\n", gap);
+  }
+
+  return (int)SRSLTE_MAX(SRSLTE_MIN(gap, INT32_MAX), INT32_MIN);
+}
+
+int rf_shm_tx_baseband(rf_shm_tx_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  if (q->running) {
+    rf_shm_tx_write(q, buffer, nsamples);
+  }
+  return (int)nsamples;
+}
+
+int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples)
+{
+  return rf_shm_tx_baseband(q, NULL, nsamples);
+}
+
+void rf_shm_tx_close(rf_shm_tx_t* q)
+{
+  if (q->ring) {
+    // Attached readers see the invalid signature, drop their mapping and read zeros until a new writer appears
+    __atomic_store_n(&q->ring->active, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&q->ring->magic, 0, __ATOMIC_RELEASE);
+    munmap(q->ring, q->size);
+    shm_unlink(q->name);
+    q->ring = NULL;
+  }
+  q->running = false;
+}
+
+/*
+ * Receiver
+ */
+int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, const char* names)
+{
+  int ret = SRSLTE_ERROR;
+
+  if (q && names && strlen(names)) {
+    bzero(q, sizeof(rf_shm_rx_t));
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+
+    // Rings are separated by ':', samples of all of them are added (e.g. uplink from several UE)
+    char list[SHM_NAME_STRLEN * SHM_MAX_WRITERS] = {};
+    strncpy(list, names, sizeof(list) - 1);
+    char* saveptr = NULL;
+    for (char* name = strtok_r(list, ":", &saveptr); name && q->nof_rings < SHM_MAX_WRITERS;
+         name       = strtok_r(NULL, ":", &saveptr)) {
+      shm_name(q->rings[q->nof_rings++].name, name);
+    }
+
+    q->max_samples = opts.max_samples;
+    if (q->nof_rings > 1) {
+      q->temp_buffer = srslte_vec_malloc(sizeof(cf_t) * q->max_samples);
+      if (!q->temp_buffer) {
+        rf_shm_error(q->id, "Error allocating rx buffer\n");
+        return ret;
+      }
+    }
+
+    // Readers may start before the writers, rings are attached when they appear
+    rf_shm_rx_attach(q);
+
+    q->running = true;
+    ret        = SRSLTE_SUCCESS;
+  }
+
+  return ret;
+}
+
+static void rf_shm_rx_detach_ring(rf_shm_rx_ring_t* r)
+{
+  if (r->ring) {
+    munmap(r->ring, r->size);
+    r->ring = NULL;
+  }
+}
+
+/* Maps the ring if the writer has created it. Returns true if the ring is mapped and valid */
+static bool rf_shm_rx_attach_ring(rf_shm_rx_ring_t* r)
+{
+  // Drop the mapping if the writer has re-initialised the ring with a different size
+  if (r->ring && (__atomic_load_n(&r->ring->magic, __ATOMIC_ACQUIRE) != SHM_RING_MAGIC ||
+                  shm_ring_size(r->ring->nof_samples) != r->size)) {
+    rf_shm_rx_detach_ring(r);
+  }
+
+  if (!r->ring) {
+    int fd = shm_open(r->name, O_RDONLY, 0);
+    if (fd < 0) {
+      return false;
+    }
+
+    struct stat st = {};
+    if (fstat(fd, &st) < 0 || st.st_size < sizeof(rf_shm_ring_t)) {
+      close(fd);
+      return false;
+    }
+
+    r->size = (size_t)st.st_size;
+    r->ring = mmap(NULL, r->size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (r->ring == MAP_FAILED) {
+      r->ring = NULL;
+      return false;
+    }
+
+    if (__atomic_load_n(&r->ring->magic, __ATOMIC_ACQUIRE) != SHM_RING_MAGIC || r->ring->version != SHM_RING_VERSION ||
+        shm_ring_size(r->ring->nof_samples) != r->size) {
+      rf_shm_rx_detach_ring(r);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool rf_shm_rx_ring_active(rf_shm_rx_ring_t* r)
+{
+  return rf_shm_rx_attach_ring(r) && __atomic_load_n(&r->ring->active, __ATOMIC_ACQUIRE);
+}
+
+bool rf_shm_rx_attach(rf_shm_rx_t* q)
+{
+  bool active = false;
+  for (uint32_t i = 0; i < q->nof_rings; i++) {
+    active |= rf_shm_rx_ring_active(&q->rings[i]);
+  }
+  return active;
+}
+
+/* Returns in ts the oldest timestamp still available in the first active ring, so a reader starting after the writer
+ * does not miss the beginning of the stream. Returns false if no ring is active. */
+bool rf_shm_rx_sync_ts(rf_shm_rx_t* q, uint64_t* ts)
+{
+  for (uint32_t i = 0; i < q->nof_rings; i++) {
+    rf_shm_rx_ring_t* r = &q->rings[i];
+    if (rf_shm_rx_ring_active(r)) {
+      uint64_t w = __atomic_load_n(&r->ring->write_ts, __ATOMIC_ACQUIRE);
+      uint64_t N = r->ring->nof_samples / 2; // Leave margin so the writer does not overwrite them immediately
+      *ts        = SRSLTE_MAX(r->ring->start_ts, (w > N) ? w - N : 0);
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Copies samples [ts, ts + nsamples) from a ring. Samples not written, not yet written after the timeout or
+ * overwritten are set to zero */
+static void rf_shm_rx_read_ring(rf_shm_rx_t* q, rf_shm_rx_ring_t* r, cf_t* buffer, uint64_t ts, uint32_t nsamples)
+{
+  if (!rf_shm_rx_ring_active(r)) {
+    bzero(buffer, sizeof(cf_t) * nsamples);
+    return;
+  }
+
+  rf_shm_ring_t* ring = r->ring;
+  uint64_t       end  = ts + nsamples;
+  uint64_t       N    = ring->nof_samples;
+
+  // Wait for the writer, as long as it makes progress
+  uint64_t w = __atomic_load_n(&ring->write_ts, __ATOMIC_ACQUIRE);
+  if (r->stalled && w != r->stalled_ts) {
+    r->stalled = false;
+  }
+  if (w < end && !r->stalled) {
+    uint64_t last_w    = w;
+    uint64_t last_time = shm_time_ms();
+    while (w < end && __atomic_load_n(&ring->magic, __ATOMIC_RELAXED) == SHM_RING_MAGIC) {
+      usleep(SHM_POLL_US);
+      w = __atomic_load_n(&ring->write_ts, __ATOMIC_ACQUIRE);
+      if (w != last_w) {
+        last_w    = w;
+        last_time = shm_time_ms();
+      } else if (shm_time_ms() - last_time > SHM_TIMEOUT_MS) {
+        rf_shm_error(q->id, "Writer of %s did not progress for %d ms, reading zeros\n", r->name, SHM_TIMEOUT_MS);
+        r->stalled    = true;
+        r->stalled_ts = w;
+        break;
+      }
+    }
+  }
+
+  // Copy what is available
+  uint64_t copy_end = SRSLTE_MIN(end, w);
+  for (uint64_t t = ts; t < copy_end;) {
+    uint32_t idx = (uint32_t)(t % N);
+    uint32_t len = (uint32_t)SRSLTE_MIN(copy_end - t, N - idx);
+    memcpy(&buffer[t - ts], &ring->samples[idx], sizeof(cf_t) * len);
+    t += len;
+  }
+
+  // Samples the writer has (or may have) overwritten during the copy are not valid
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  uint64_t writing    = __atomic_load_n(&ring->writing_ts, __ATOMIC_RELAXED);
+  uint64_t valid_from = SRSLTE_MAX(ring->start_ts, (writing > N) ? writing - N : 0);
+
+  uint64_t nof_invalid = (valid_from > ts) ? SRSLTE_MIN(valid_from - ts, nsamples) : 0;
+  if (nof_invalid) {
+    bzero(buffer, sizeof(cf_t) * nof_invalid);
+    if (writing > N && ts < writing - N) {
+      q->nof_overflows++;
+    }
+  }
+
+  uint64_t nof_late = (end > w) ? SRSLTE_MIN(end - w, nsamples) : 0;
+  if (nof_late) {
+    bzero(&buffer[nsamples - nof_late], sizeof(cf_t) * nof_late);
+    q->nof_late++;
+  }
+}
+
+int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, uint64_t ts, uint32_t nsamples)
+{
+  if (nsamples > q->max_samples) {
+    rf_shm_error(q->id, "Error: trying to receive %d samples, maximum is %d\n", nsamples, q->max_samples);
+    return SRSLTE_ERROR;
+  }
+
+  if (q->nof_rings == 0) {
+    bzero(buffer, sizeof(cf_t) * nsamples);
+  }
+
+  for (uint32_t i = 0; i < q->nof_rings; i++) {
+    if (i == 0) {
+      // The first ring is copied straight into the destination
+      rf_shm_rx_read_ring(q, &q->rings[i], buffer, ts, nsamples);
+    } else {
+      rf_shm_rx_read_ring(q, &q->rings[i], q->temp_buffer, ts, nsamples);
+      srslte_vec_sum_ccc(buffer, q->temp_buffer, buffer, nsamples);
+    }
+  }
+
+  return (int)nsamples;
+}
+
+void rf_shm_rx_close(rf_shm_rx_t* q)
+{
+  for (uint32_t i = 0; i < q->nof_rings; i++) {
+    rf_shm_rx_detach_ring(&q->rings[i]);
+  }
+  if (q->temp_buffer) {
+    free(q->temp_buffer);
+    q->temp_buffer = NULL;
+  }
+  q->nof_rings = 0;
+  q->running   = false;
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLTE_RF_SHM_IMP_TRX_H
+#define SRSLTE_RF_SHM_IMP_TRX_H
+
+#include "srslte/config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Definitions */
+#define VERBOSE (0)
+#define SHM_RING_MAGIC (0x73724c54) // Ring segment signature
+#define SHM_RING_VERSION (1)
+#define SHM_RING_DEFAULT_MS (40) // Ring length in milliseconds at the base rate
+#define SHM_MAX_WRITERS (8)      // Maximum number of rings a receiver combines (e.g. several UE attached to an eNB)
+#define SHM_NAME_STRLEN (64)
+#define SHM_TIMEOUT_MS (1000) // A writer which does not progress for this long is considered detached
+#define SHM_POLL_US (20)      // Polling period while waiting for a writer
+#define SHM_BASERATE_DEFAULT_HZ (23040000)
+#define SHM_ID_STRLEN 16
+#define SHM_MAX_GAIN_DB (30.0f)
+#define SHM_MIN_GAIN_DB (0.0f)
+
+/*
+ * Shared memory ring segment. The ring holds the last nof_samples samples written by its only writer, indexed by
+ * timestamp (sample count at the base rate) modulo nof_samples. The writer announces the range it is about to
+ * overwrite in writing_ts, copies the samples and then publishes write_ts with release semantics. Readers load
+ * write_ts with acquire semantics, copy, and check writing_ts afterwards to discard any sample the writer may have
+ * overwritten meanwhile (as a seqlock). Readers never write into the segment, so any number of them can attach to a
+ * ring without locks.
+ */
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t nof_samples; // Ring capacity
+  uint32_t base_srate;
+  uint64_t start_ts; // Timestamp of the first sample written, earlier samples read as zeros
+  uint64_t write_ts;   // Timestamp of the next sample to be written, accessed atomically
+  uint64_t writing_ts; // End of the samples being written, samples before writing_ts - nof_samples are overwritten
+  uint32_t active;     // Set once start_ts is valid, accessed atomically
+  uint8_t  reserved[20];
+  cf_t     samples[];
+} rf_shm_ring_t;
+
+typedef struct {
+  char           id[SHM_ID_STRLEN];
+  char           name[SHM_NAME_STRLEN];
+  rf_shm_ring_t* ring;
+  size_t         size;
+  uint64_t       nsamples; // Timestamp of the next sample to be written
+  bool           running;
+} rf_shm_tx_t;
+
+typedef struct {
+  char           name[SHM_NAME_STRLEN];
+  rf_shm_ring_t* ring;
+  size_t         size;
+  bool           stalled; // The writer timed out at stalled_ts, do not wait again until it makes progress
+  uint64_t       stalled_ts;
+} rf_shm_rx_ring_t;
+
+typedef struct {
+  char             id[SHM_ID_STRLEN];
+  rf_shm_rx_ring_t rings[SHM_MAX_WRITERS];
+  uint32_t         nof_rings;
+  cf_t*            temp_buffer; // Used for combining several rings
+  uint32_t         max_samples;
+  uint64_t         nof_overflows;
+  uint64_t         nof_late;
+  bool             running;
+} rf_shm_rx_t;
+
+typedef struct {
+  const char* id;
+  uint32_t    base_srate;
+  uint32_t    ring_ms;
+  uint32_t    max_samples; // Maximum number of samples per call
+} rf_shm_opts_t;
+
+/*
+ * Common functions
+ */
+SRSLTE_API void rf_shm_info(char* id, const char* format, ...);
+
+SRSLTE_API void rf_shm_error(char* id, const char* format, ...);
+
+/*
+ * Transmitter functions
+ */
+SRSLTE_API int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, const char* name);
+
+SRSLTE_API int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts);
+
+SRSLTE_API int rf_shm_tx_baseband(rf_shm_tx_t* q, cf_t* buffer, uint32_t nsamples);
+
+SRSLTE_API int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples);
+
+SRSLTE_API void rf_shm_tx_close(rf_shm_tx_t* q);
+
+/*
+ * Receiver functions
+ */
+SRSLTE_API int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, const char* names);
+
+SRSLTE_API bool rf_shm_rx_attach(rf_shm_rx_t* q);
+
+SRSLTE_API bool rf_shm_rx_sync_ts(rf_shm_rx_t* q, uint64_t* ts);
+
+SRSLTE_API int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, uint64_t ts, uint32_t nsamples);
+
+SRSLTE_API void rf_shm_rx_close(rf_shm_rx_t* q);
+
+#endif // SRSLTE_RF_SHM_IMP_TRX_H
@@ -0,0 +1,285 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp.h"
+#include "srslte/srslte.h"
+#include <complex.h>
+#include <pthread.h>
+#include <srslte/phy/common/phy_common.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define NOF_RX_ANT 1
+#define NUM_SF (200)
+#define SF_LEN (1920)
+#define RF_BUFFER_SIZE (SF_LEN * NUM_SF)
+#define TX_OFFSET_MS (4)
+
+static cf_t ue_rx_buffer[RF_BUFFER_SIZE];
+static cf_t enb_tx_buffer[RF_BUFFER_SIZE];
+static cf_t enb_rx_buffer[RF_BUFFER_SIZE];
+static cf_t ue_tx_buffer[2][RF_BUFFER_SIZE];
+
+static srslte_rf_t ue_radio, enb_radio, ue_tx_radio[2];
+pthread_t          rx_thread;
+
+static void random_buffer(cf_t* buffer, uint32_t nsamples)
+{
+  for (int i = 0; i < nsamples; i++) {
+    buffer[i] = ((float)rand() / (float)RAND_MAX) + _Complex_I * ((float)rand() / (float)RAND_MAX);
+  }
+}
+
+static void open_radio(srslte_rf_t* radio, const char* args)
+{
+  char rf_args[PARAM_LEN];
+  strncpy(rf_args, args, PARAM_LEN - 1);
+  rf_args[PARAM_LEN - 1] = 0;
+
+  printf("opening device with args=%s\n", rf_args);
+  if (srslte_rf_open_devname(radio, "shm", rf_args, NOF_RX_ANT)) {
+    fprintf(stderr, "Error opening rf\n");
+    exit(-1);
+  }
+}
+
+void* ue_rx_thread_function(void* args)
+{
+  open_radio(&ue_radio, (char*)args);
+
+  // receive 5 subframes at once (i.e. mimic initial rx that receives one slot)
+  uint32_t num_slots          = NUM_SF / 5;
+  uint32_t num_samps_per_slot = SF_LEN * 5;
+  uint32_t num_rxed_samps     = 0;
+  for (uint32_t i = 0; i < num_slots; ++i) {
+    void* data_ptr[SRSLTE_MAX_PORTS] = {NULL};
+    data_ptr[0]                      = &ue_rx_buffer[i * num_samps_per_slot];
+    num_rxed_samps += srslte_rf_recv_with_time_multi(&ue_radio, data_ptr, num_samps_per_slot, true, NULL, NULL);
+  }
+
+  printf("received %d samples.\n", num_rxed_samps);
+
+  printf("closing ue device\n");
+  srslte_rf_close(&ue_radio);
+
+  return NULL;
+}
+
+void enb_tx_function(const char* tx_args, bool timed_tx)
+{
+  open_radio(&enb_radio, tx_args);
+
+  // generate random tx data
+  random_buffer(enb_tx_buffer, RF_BUFFER_SIZE);
+
+  // send data subframe per subframe
+  uint32_t num_txed_samples = 0;
+
+  // initial transmission without ts
+  void* data_ptr[SRSLTE_MAX_PORTS] = {NULL};
+  data_ptr[0]                      = &enb_tx_buffer[num_txed_samples];
+  int ret                          = srslte_rf_send_multi(&enb_radio, (void**)data_ptr, SF_LEN, true, true, false);
+  num_txed_samples += SF_LEN;
+
+  // from here on, all transmissions are timed relative to the last rx time
+  srslte_timestamp_t rx_time, tx_time;
+
+  for (uint32_t i = 0; i < NUM_SF - ((timed_tx) ? TX_OFFSET_MS : 1); ++i) {
+    // first recv samples
+    data_ptr[0] = enb_rx_buffer;
+    srslte_rf_recv_with_time_multi(&enb_radio, data_ptr, SF_LEN, true, &rx_time.full_secs, &rx_time.frac_secs);
+
+    // prepare data buffer
+    data_ptr[0] = &enb_tx_buffer[num_txed_samples];
+
+    if (timed_tx) {
+      // timed tx relative to receive time (this will cause a gap in the rx'ed samples at the UE resulting in 3 zero
+      // subframes)
+      srslte_timestamp_copy(&tx_time, &rx_time);
+      srslte_timestamp_add(&tx_time, 0, TX_OFFSET_MS * 1e-3);
+      ret = srslte_rf_send_timed_multi(
+          &enb_radio, (void**)data_ptr, SF_LEN, tx_time.full_secs, tx_time.frac_secs, true, true, false);
+    } else {
+      // normal tx
+      ret = srslte_rf_send_multi(&enb_radio, (void**)data_ptr, SF_LEN, true, true, false);
+    }
+    if (ret != SRSLTE_SUCCESS) {
+      fprintf(stderr, "Error sending data\n");
+      exit(-1);
+    }
+
+    num_txed_samples += SF_LEN;
+  }
+
+  printf("transmitted %d samples in %d subframes\n", num_txed_samples, NUM_SF);
+
+  // Let the UE read the last subframes before the ring is removed
+  usleep(100000);
+
+  printf("closing tx device\n");
+  srslte_rf_close(&enb_radio);
+}
+
+int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
+{
+  int ret = SRSLTE_ERROR;
+
+  // start Rx thread
+  if (pthread_create(&rx_thread, NULL, ue_rx_thread_function, (void*)rx_args)) {
+    perror("pthread_create");
+    exit(-1);
+  }
+
+  enb_tx_function(tx_args, timed_tx);
+
+  // wait for rx thread
+  pthread_join(rx_thread, NULL);
+
+  // subframe-wise compare tx'ed and rx'ed data (stop 3 subframes earlier for timed tx)
+  for (uint32_t i = 0; i < NUM_SF - (timed_tx ? 3 : 0); ++i) {
+    uint32_t sf_offet = 0;
+    if (timed_tx && i >= 1) {
+      // for timed transmission, the enb inserts 3 zero subframes after the first untimed tx
+      sf_offet = (TX_OFFSET_MS - 1) * SF_LEN;
+    }
+
+    if (memcmp(&ue_rx_buffer[sf_offet + i * SF_LEN], &enb_tx_buffer[i * SF_LEN], sizeof(cf_t) * SF_LEN) != 0) {
+      fprintf(stderr, "data mismatch in subframe %d\n", i);
+      goto exit;
+    }
+  }
+
+  ret = SRSLTE_SUCCESS;
+
+exit:
+  return ret;
+}
+
+typedef struct {
+  srslte_rf_t* radio;
+  cf_t*        buffer;
+} ue_tx_args_t;
+
+void* ue_tx_thread_function(void* args)
+{
+  ue_tx_args_t* ue = (ue_tx_args_t*)args;
+
+  // The first subframe has already been sent
+  for (uint32_t i = 1; i < NUM_SF; i++) {
+    void* data_ptr[SRSLTE_MAX_PORTS] = {NULL};
+    data_ptr[0]                      = &ue->buffer[i * SF_LEN];
+    if (srslte_rf_send_multi(ue->radio, (void**)data_ptr, SF_LEN, true, true, false)) {
+      fprintf(stderr, "Error sending data\n");
+      exit(-1);
+    }
+    usleep(1000);
+  }
+
+  return NULL;
+}
+
+// Two UE transmitting to the same eNB, the eNB receives the sum of both
+int run_test_combine(const char* rx_args, const char* tx_args[2])
+{
+  int          ret = SRSLTE_ERROR;
+  pthread_t    tx_thread[2];
+  ue_tx_args_t ue[2];
+
+  for (uint32_t u = 0; u < 2; u++) {
+    random_buffer(ue_tx_buffer[u], RF_BUFFER_SIZE);
+    open_radio(&ue_tx_radio[u], tx_args[u]);
+
+    // Both streams start at the same time
+    void* data_ptr[SRSLTE_MAX_PORTS] = {NULL};
+    data_ptr[0]                      = ue_tx_buffer[u];
+    srslte_rf_send_multi(&ue_tx_radio[u], (void**)data_ptr, SF_LEN, true, true, false);
+  }
+
+  open_radio(&enb_radio, rx_args);
+
+  for (uint32_t u = 0; u < 2; u++) {
+    ue[u].radio  = &ue_tx_radio[u];
+    ue[u].buffer = ue_tx_buffer[u];
+    if (pthread_create(&tx_thread[u], NULL, ue_tx_thread_function, &ue[u])) {
+      perror("pthread_create");
+      exit(-1);
+    }
+  }
+
+  for (uint32_t i = 0; i < NUM_SF; i++) {
+    void* data_ptr[SRSLTE_MAX_PORTS] = {NULL};
+    data_ptr[0]                      = &enb_rx_buffer[i * SF_LEN];
+    srslte_rf_recv_with_time_multi(&enb_radio, data_ptr, SF_LEN, true, NULL, NULL);
+  }
+
+  for (uint32_t u = 0; u < 2; u++) {
+    pthread_join(tx_thread[u], NULL);
+    srslte_rf_close(&ue_tx_radio[u]);
+  }
+  srslte_rf_close(&enb_radio);
+
+  for (uint32_t i = 0; i < RF_BUFFER_SIZE; i++) {
+    if (cabsf(enb_rx_buffer[i] - ue_tx_buffer[0][i] - ue_tx_buffer[1][i]) > 1e-5) {
+      fprintf(stderr, "data mismatch in sample %d\n", i);
+      goto exit;
+    }
+  }
+
+  ret = SRSLTE_SUCCESS;
+
+exit:
+  return ret;
+}
+
+int main()
+{
+  char rx_args[PARAM_LEN], tx_args[PARAM_LEN], tx_args2[PARAM_LEN];
+  int  pid = (int)getpid();
+
+  // single tx, single rx with continuous transmissions (no timed tx)
+  snprintf(rx_args, PARAM_LEN, "rx_port=dl%d,id=ue,base_srate=1.92e6", pid);
+  snprintf(tx_args, PARAM_LEN, "tx_port=dl%d,id=enb,base_srate=1.92e6", pid);
+  if (run_test(rx_args, tx_args, false) != SRSLTE_SUCCESS) {
+    fprintf(stderr, "Single tx, single rx test failed!\n");
+    return -1;
+  }
+
+  // two trx radios with timed tx
+  snprintf(rx_args, PARAM_LEN, "tx_port=ul%d,rx_port=dl%d,id=ue,base_srate=1.92e6", pid, pid);
+  snprintf(tx_args, PARAM_LEN, "rx_port=ul%d,tx_port=dl%d,id=enb,base_srate=1.92e6", pid, pid);
+  if (run_test(rx_args, tx_args, true) != SRSLTE_SUCCESS) {
+    fprintf(stderr, "Two TRx radio test with timed tx failed!\n");
+    return -1;
+  }
+
+  // two transmitters combined in one receiver
+  snprintf(rx_args, PARAM_LEN, "rx_port=ul1_%d:ul2_%d,id=enb,base_srate=1.92e6", pid, pid);
+  snprintf(tx_args, PARAM_LEN, "tx_port=ul1_%d,id=ue1,base_srate=1.92e6", pid);
+  snprintf(tx_args2, PARAM_LEN, "tx_port=ul2_%d,id=ue2,base_srate=1.92e6", pid);
+  const char* ue_args[2] = {tx_args, tx_args2};
+  if (run_test_combine(rx_args, ue_args) != SRSLTE_SUCCESS) {
+    fprintf(stderr, "Two tx, one rx combining test failed!\n");
+    return -1;
+  }
+
+  printf("Ok\n");
+  return 0;
+}
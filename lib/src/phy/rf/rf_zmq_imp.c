@@ -144,6 +144,58 @@ int rf_zmq_handle_error(char* id, const char* text)
   return ret;
 }
 
+static const char* rf_zmq_format_names[ZMQ_TYPE_NOF] = {"fc32", "sc16", "sc12", "bfp8"};
+
+const char* rf_zmq_format_string(rf_zmq_format_t format)
+{
+  return (format < ZMQ_TYPE_NOF) ? rf_zmq_format_names[format] : "unknown";
+}
+
+uint32_t rf_zmq_format_nbytes(rf_zmq_format_t format, uint32_t nsamples)
+{
+  switch (format) {
+    case ZMQ_TYPE_SC16:
+      return nsamples * 2 * sizeof(int16_t);
+    case ZMQ_TYPE_SC12:
+      return nsamples * 3;
+    case ZMQ_TYPE_BFP8:
+      return nsamples * 2 + (nsamples + ZMQ_BFP_BLOCK_LEN - 1) / ZMQ_BFP_BLOCK_LEN;
+    case ZMQ_TYPE_FC32:
+    default:
+      return NSAMPLES2NBYTES(nsamples);
+  }
+}
+
+uint32_t rf_zmq_format_nsamples(rf_zmq_format_t format, uint32_t nbytes)
+{
+  switch (format) {
+    case ZMQ_TYPE_SC16:
+      return nbytes / (2 * sizeof(int16_t));
+    case ZMQ_TYPE_SC12:
+      return nbytes / 3;
+    case ZMQ_TYPE_BFP8: {
+      // Every block takes one exponent byte plus two bytes per sample, the last block may be shorter
+      uint32_t nof_blocks = nbytes / (2 * ZMQ_BFP_BLOCK_LEN + 1);
+      uint32_t rem        = nbytes % (2 * ZMQ_BFP_BLOCK_LEN + 1);
+      return nof_blocks * ZMQ_BFP_BLOCK_LEN + ((rem > 0) ? (rem - 1) / 2 : 0);
+    }
+    case ZMQ_TYPE_FC32:
+    default:
+      return NBYTES2NSAMPLES(nbytes);
+  }
+}
+
+static bool rf_zmq_parse_format(const char* str, rf_zmq_format_t* format)
+{
+  for (uint32_t i = 0; i < ZMQ_TYPE_NOF; i++) {
+    if (!strcmp(str, rf_zmq_format_names[i])) {
+      *format = (rf_zmq_format_t)i;
+      return true;
+    }
+  }
+  return false;
+}
+
 /*
  * Public methods
  */
@@ -297,11 +349,10 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
         char*      config_ptr                  = strstr(args, config_arg);
         if (config_ptr) {
           copy_subdev_string(config_str, config_ptr + strlen(config_arg));
-          rx_opts.sample_format = ZMQ_TYPE_FC32;
-          if (!strcmp(config_str, "sc16")) {
-            rx_opts.sample_format = ZMQ_TYPE_SC16;
-            printf("Using sc16 format for rx socket\n");
+          if (rf_zmq_parse_format(config_str, &rx_opts.sample_format)) {
+            printf("Using %s format for rx socket\n", config_str);
           } else {
+            rx_opts.sample_format = ZMQ_TYPE_FC32;
             printf("Unsupported sample format %s. Using fc32 for rx socket\n", config_str);
           }
           remove_substring(args, config_arg);
@@ -332,11 +383,10 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
         char*      config_ptr                  = strstr(args, config_arg);
         if (config_ptr) {
           copy_subdev_string(config_str, config_ptr + strlen(config_arg));
-          tx_opts.sample_format = ZMQ_TYPE_FC32;
-          if (!strcmp(config_str, "sc16")) {
-            tx_opts.sample_format = ZMQ_TYPE_SC16;
-            printf("Using sc16 format for tx socket\n");
+          if (rf_zmq_parse_format(config_str, &tx_opts.sample_format)) {
+            printf("Using %s format for tx socket\n", config_str);
           } else {
+            tx_opts.sample_format = ZMQ_TYPE_FC32;
             printf("Unsupported sample format %s. Using fc32 for tx socket\n", config_str);
           }
           remove_substring(args, config_arg);
@@ -26,19 +26,55 @@
 
 #include "rf_zmq_imp_trx.h"
 #include <inttypes.h>
+#include <math.h>
 #include <srslte/phy/utils/vector.h>
 #include <stdlib.h>
 #include <string.h>
 #include <zmq.h>
 
+static void rf_zmq_rx_decode_bfp8(const uint8_t* wire, cf_t* buffer, uint32_t nsamples)
+{
+  float* z = (float*)buffer;
+
+  for (uint32_t i = 0; i < nsamples; i += ZMQ_BFP_BLOCK_LEN) {
+    uint32_t len      = SRSLTE_MIN(ZMQ_BFP_BLOCK_LEN, nsamples - i) * 2;
+    int      exponent = (int8_t)wire[0];
+
+    srslte_vec_convert_bf((const int8_t*)&wire[1], ldexpf(1.0f, -exponent), z, len);
+
+    z += len;
+    wire += len + 1;
+  }
+}
+
+// Converts the received message from the wire format and returns the buffer holding the complex float samples
+static void* rf_zmq_rx_decode(rf_zmq_rx_t* q, uint32_t nsamples)
+{
+  switch (q->sample_format) {
+    case ZMQ_TYPE_SC16:
+      srslte_vec_convert_if((int16_t*)q->temp_buffer, INT16_MAX, (float*)q->temp_buffer_convert, 2 * nsamples);
+      return q->temp_buffer_convert;
+    case ZMQ_TYPE_SC12:
+      srslte_vec_unpack_s12((uint8_t*)q->temp_buffer, (int16_t*)q->temp_buffer_convert, 2 * nsamples);
+      srslte_vec_convert_if((int16_t*)q->temp_buffer_convert, ZMQ_SC12_SCALE, (float*)q->temp_buffer, 2 * nsamples);
+      return q->temp_buffer;
+    case ZMQ_TYPE_BFP8:
+      rf_zmq_rx_decode_bfp8((uint8_t*)q->temp_buffer, q->temp_buffer_convert, nsamples);
+      return q->temp_buffer_convert;
+    case ZMQ_TYPE_FC32:
+    default:
+      return q->temp_buffer;
+  }
+}
+
 static void* rf_zmq_async_rx_thread(void* h)
 {
   rf_zmq_rx_t* q = (rf_zmq_rx_t*)h;
 
   while (q->sock && q->running) {
-    int     nbytes = 0;
-    int     n      = SRSLTE_ERROR;
-    uint8_t dummy  = 0xFF;
+    int     nbytes  = 0;
+    int     n       = SRSLTE_ERROR;
+    uint8_t request = (uint8_t)q->sample_format; // Asks the transmitter for this format
 
     rf_zmq_info(q->id, "-- ASYNC RX wait...\n");
 
@@ -46,7 +82,7 @@ static void* rf_zmq_async_rx_thread(void* h)
     if (q->socket_type == ZMQ_REQ) {
       while (n < 0 && q->running) {
         rf_zmq_info(q->id, " - tx'ing rx request\n");
-        n = zmq_send(q->sock, &dummy, sizeof(dummy), 0);
+        n = zmq_send(q->sock, &request, sizeof(request), 0);
         if (n < 0) {
           if (rf_zmq_handle_error(q->id, "synchronous rx request send")) {
             return NULL;
@@ -77,13 +113,28 @@ static void* rf_zmq_async_rx_thread(void* h)
       }
     }
 
+    // Convert received samples, the conversion is done here so the reader gets complex float from the ring buffer
+    void* buffer = NULL;
+    if (nbytes > 0) {
+      uint32_t nsamples = rf_zmq_format_nsamples(q->sample_format, (uint32_t)nbytes);
+      if (NSAMPLES2NBYTES(nsamples) > ZMQ_MAX_BUFFER_SIZE) {
+        fprintf(stderr,
+                "[zmq] Error: receiver can not convert %d %s samples.\n",
+                nsamples,
+                rf_zmq_format_string(q->sample_format));
+        return NULL;
+      }
+      buffer = rf_zmq_rx_decode(q, nsamples);
+      nbytes = NSAMPLES2NBYTES(nsamples);
+    }
+
     // Write received data in buffer
     if (nbytes > 0) {
       n = -1;
 
       // Try to write in ring buffer
       while (n < 0 && q->running) {
-        n = srslte_ringbuffer_write_timed(&q->ringbuffer, q->temp_buffer, nbytes, ZMQ_TIMEOUT_MS);
+        n = srslte_ringbuffer_write_timed(&q->ringbuffer, buffer, nbytes, ZMQ_TIMEOUT_MS);
       }
 
       // Check write
@@ -190,23 +241,7 @@ clean_exit:
 
 int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples)
 {
-  void*    dst_buffer = buffer;
-  uint32_t sample_sz  = sizeof(cf_t);
-  if (q->sample_format != ZMQ_TYPE_FC32) {
-    dst_buffer = q->temp_buffer_convert;
-    sample_sz  = 2 * sizeof(short);
-  }
-
-  int n = srslte_ringbuffer_read_timed(&q->ringbuffer, dst_buffer, sample_sz * nsamples, ZMQ_TIMEOUT_MS);
-  if (n < 0) {
-    return n;
-  }
-
-  if (q->sample_format == ZMQ_TYPE_SC16) {
-    srslte_vec_convert_if(dst_buffer, INT16_MAX, (float*)buffer, 2 * nsamples);
-  }
-
-  return n;
+  return srslte_ringbuffer_read_timed(&q->ringbuffer, buffer, NSAMPLES2NBYTES(nsamples), ZMQ_TIMEOUT_MS);
 }
 
 bool rf_zmq_rx_match_freq(rf_zmq_rx_t* q, uint32_t freq_hz)
@@ -41,8 +41,14 @@
 #define ZMQ_ID_STRLEN 16
 #define ZMQ_MAX_GAIN_DB (30.0f)
 #define ZMQ_MIN_GAIN_DB (0.0f)
+#define ZMQ_SC12_SCALE (2047.0f)
+#define ZMQ_BFP_BLOCK_LEN (16) // Samples sharing one exponent in block floating point format
 
-typedef enum { ZMQ_TYPE_FC32 = 0, ZMQ_TYPE_SC16 } rf_zmq_format_t;
+/*
+ * Wire formats: fc32 (complex float), sc16 (complex int16), sc12 (complex 12-bit, packed in 3 bytes) and bfp8
+ * (complex int8 with one int8 power of two exponent every ZMQ_BFP_BLOCK_LEN samples).
+ */
+typedef enum { ZMQ_TYPE_FC32 = 0, ZMQ_TYPE_SC16, ZMQ_TYPE_SC12, ZMQ_TYPE_BFP8, ZMQ_TYPE_NOF } rf_zmq_format_t;
 
 typedef struct {
   char            id[ZMQ_ID_STRLEN];
@@ -88,6 +94,12 @@ SRSLTE_API void rf_zmq_error(char* id, const char* format, ...);
 
 SRSLTE_API int rf_zmq_handle_error(char* id, const char* text);
 
+SRSLTE_API const char* rf_zmq_format_string(rf_zmq_format_t format);
+
+SRSLTE_API uint32_t rf_zmq_format_nbytes(rf_zmq_format_t format, uint32_t nsamples);
+
+SRSLTE_API uint32_t rf_zmq_format_nsamples(rf_zmq_format_t format, uint32_t nbytes);
+
 /*
  * Transmitter functions
  */
@@ -26,6 +26,7 @@
 
 #include "rf_zmq_imp_trx.h"
 #include <inttypes.h>
+#include <math.h>
 #include <srslte/config.h>
 #include <srslte/phy/utils/vector.h>
 #include <stdlib.h>
@@ -108,51 +109,99 @@ clean_exit:
   return ret;
 }
 
+static void rf_zmq_tx_encode_bfp8(const cf_t* buffer, uint8_t* wire, uint32_t nsamples)
+{
+  const float* x = (const float*)buffer;
+
+  for (uint32_t i = 0; i < nsamples; i += ZMQ_BFP_BLOCK_LEN) {
+    uint32_t len = SRSLTE_MIN(ZMQ_BFP_BLOCK_LEN, nsamples - i) * 2;
+
+    // Choose the exponent so that the block peak falls in [64, 128) and truncates to at most 127
+    int   exponent = 0;
+    float peak     = fabsf(x[srslte_vec_max_abs_fi(x, len)]);
+    if (peak > 0.0f) {
+      frexpf(peak, &exponent);
+      exponent = SRSLTE_MIN(SRSLTE_MAX(exponent - 7, INT8_MIN), INT8_MAX);
+    }
+
+    wire[0] = (uint8_t)(int8_t)exponent;
+    srslte_vec_convert_fb(x, ldexpf(1.0f, -exponent), (int8_t*)&wire[1], len);
+
+    x += len;
+    wire += len + 1;
+  }
+}
+
+// Converts the samples to the wire format and returns the buffer to send
+static void* rf_zmq_tx_encode(rf_zmq_tx_t* q, rf_zmq_format_t format, cf_t* buffer, uint32_t nsamples)
+{
+  switch (format) {
+    case ZMQ_TYPE_SC16:
+      srslte_vec_convert_fi((float*)buffer, INT16_MAX, (int16_t*)q->temp_buffer_convert, 2 * nsamples);
+      break;
+    case ZMQ_TYPE_SC12:
+      // Pack in place, the packed samples never overtake the ones not yet read
+      srslte_vec_convert_fi((float*)buffer, ZMQ_SC12_SCALE, (int16_t*)q->temp_buffer_convert, 2 * nsamples);
+      srslte_vec_pack_s12((int16_t*)q->temp_buffer_convert, (uint8_t*)q->temp_buffer_convert, 2 * nsamples);
+      break;
+    case ZMQ_TYPE_BFP8:
+      rf_zmq_tx_encode_bfp8(buffer, (uint8_t*)q->temp_buffer_convert, nsamples);
+      break;
+    case ZMQ_TYPE_FC32:
+    default:
+      return buffer;
+  }
+
+  return q->temp_buffer_convert;
+}
+
 static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
 {
   int n = SRSLTE_ERROR;
 
   while (n < 0 && q->running) {
+    rf_zmq_format_t format = q->sample_format;
+
     // Receive Transmit request is socket type is REPLY
     if (q->socket_type == ZMQ_REP) {
-      uint8_t dummy;
-      n = zmq_recv(q->sock, &dummy, sizeof(dummy), 0);
+      uint8_t request;
+      n = zmq_recv(q->sock, &request, sizeof(request), 0);
       if (n < 0) {
         if (rf_zmq_handle_error(q->id, "tx request receive")) {
           n = SRSLTE_ERROR;
           goto clean_exit;
         }
       } else {
-        // Tx request received successful
+        // Tx request received successful, the request carries the format the receiver wants
+        if (request < ZMQ_TYPE_NOF) {
+          format = (rf_zmq_format_t)request;
+        }
         rf_zmq_info(q->id, " - tx request received\n");
-        rf_zmq_info(q->id, " - sending %d samples (%d B)\n", nsamples, NSAMPLES2NBYTES(nsamples));
+        rf_zmq_info(q->id,
+                    " - sending %d samples (%d B, %s)\n",
+                    nsamples,
+                    rf_zmq_format_nbytes(format, nsamples),
+                    rf_zmq_format_string(format));
       }
     } else {
       n = 1;
     }
 
-    // convert samples if necessary
-    void*    buf       = (buffer) ? buffer : q->zeros;
-    uint32_t sample_sz = sizeof(cf_t);
-
-    if (q->sample_format == ZMQ_TYPE_SC16) {
-      buf       = q->temp_buffer_convert;
-      sample_sz = 2 * sizeof(short);
-      srslte_vec_convert_fi((float*)buffer, INT16_MAX, (short*)q->temp_buffer_convert, 2 * nsamples);
-    }
-
     // Send base-band if request was received
     if (n > 0) {
-      n = zmq_send(q->sock, buf, sample_sz * nsamples, 0);
+      void*    buf    = rf_zmq_tx_encode(q, format, (buffer) ? buffer : q->zeros, nsamples);
+      uint32_t nbytes = rf_zmq_format_nbytes(format, nsamples);
+
+      n = zmq_send(q->sock, buf, nbytes, 0);
       if (n < 0) {
         if (rf_zmq_handle_error(q->id, "tx baseband send")) {
           n = SRSLTE_ERROR;
           goto clean_exit;
         }
-      } else if (n != NSAMPLES2NBYTES(nsamples)) {
+      } else if (n != nbytes) {
         rf_zmq_error(q->id,
                      "[zmq] Error: transmitter expected %d bytes and sent %d. %s.\n",
-                     NSAMPLES2NBYTES(nsamples),
+                     nbytes,
                      n,
                      strerror(zmq_errno()));
         n = SRSLTE_ERROR;
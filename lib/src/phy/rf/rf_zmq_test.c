@@ -21,6 +21,7 @@
 
 #include "rf_zmq_imp.h"
 #include "srslte/srslte.h"
+#include <complex.h>
 #include <pthread.h>
 #include <srslte/phy/common/phy_common.h>
 #include <stdlib.h>
@@ -133,7 +134,7 @@ void enb_tx_function(const char* tx_args, bool timed_tx)
   srslte_rf_close(&enb_radio);
 }
 
-int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
+int run_test(const char* rx_args, const char* tx_args, bool timed_tx, float max_error)
 {
   int ret = SRSLTE_ERROR;
 
@@ -170,9 +171,19 @@ int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
     srslte_vec_fprint_c(stdout, &ue_rx_buffer[sf_offet + i * SF_LEN], 3);
 #endif
 
-    if (memcmp(&ue_rx_buffer[sf_offet + i * SF_LEN], &enb_tx_buffer[i * SF_LEN], SF_LEN) != 0) {
-      fprintf(stderr, "data mismatch in subframe %d\n", i);
-      goto exit;
+    if (max_error == 0.0f) {
+      if (memcmp(&ue_rx_buffer[sf_offet + i * SF_LEN], &enb_tx_buffer[i * SF_LEN], sizeof(cf_t) * SF_LEN) != 0) {
+        fprintf(stderr, "data mismatch in subframe %d\n", i);
+        goto exit;
+      }
+    } else {
+      // Lossy wire formats
+      for (uint32_t j = 0; j < SF_LEN; j++) {
+        if (cabsf(ue_rx_buffer[sf_offet + i * SF_LEN + j] - enb_tx_buffer[i * SF_LEN + j]) > max_error) {
+          fprintf(stderr, "data mismatch in subframe %d sample %d\n", i, j);
+          goto exit;
+        }
+      }
     }
   }
 
@@ -185,7 +196,7 @@ exit:
 int main()
 {
   // single tx, single rx with continuous transmissions (no timed tx) using IPC transport
-  if (run_test("rx_port=ipc://link1,id=ue,base_srate=1.92e6", "tx_port=ipc://link1,id=enb,base_srate=1.92e6", false) !=
+  if (run_test("rx_port=ipc://link1,id=ue,base_srate=1.92e6", "tx_port=ipc://link1,id=enb,base_srate=1.92e6", false, 0.0f) !=
       SRSLTE_SUCCESS) {
     fprintf(stderr, "Single tx, single rx test failed!\n");
     return -1;
@@ -194,7 +205,8 @@ int main()
   // two trx radios with continous tx (no timed tx) using TCP transport for both directions
   if (run_test("tx_port=tcp://*:5554,rx_port=tcp://localhost:5555,id=ue,base_srate=1.92e6",
                "rx_port=tcp://localhost:5554,tx_port=tcp://*:5555,id=enb,base_srate=1.92e6",
-               false) != SRSLTE_SUCCESS) {
+               false,
+               0.0f) != SRSLTE_SUCCESS) {
     fprintf(stderr, "Two TRx radio test failed!\n");
     return -1;
   }
@@ -202,10 +214,36 @@ int main()
   // two trx radios with continous tx (no timed tx) using TCP for UL (UE tx) and IPC for eNB DL (eNB tx)
   if (run_test("tx_port=tcp://*:5554,rx_port=ipc://dl,id=ue,base_srate=1.92e6",
                "rx_port=tcp://localhost:5554,tx_port=ipc://dl,id=enb,base_srate=1.92e6",
-               true) != SRSLTE_SUCCESS) {
+               true,
+               0.0f) != SRSLTE_SUCCESS) {
     fprintf(stderr, "Two TRx radio test with timed tx failed!\n");
     return -1;
   }
 
+  // compressed wire formats, the transmitter uses the format requested by the receiver
+  if (run_test("rx_port=ipc://link2,id=ue,base_srate=1.92e6,rx_format=sc16",
+               "tx_port=ipc://link2,id=enb,base_srate=1.92e6",
+               false,
+               1e-4f) != SRSLTE_SUCCESS) {
+    fprintf(stderr, "Single tx, single rx test with sc16 format failed!\n");
+    return -1;
+  }
+
+  if (run_test("rx_port=ipc://link3,id=ue,base_srate=1.92e6,rx_format=sc12",
+               "tx_port=ipc://link3,id=enb,base_srate=1.92e6,tx_format=sc12",
+               true,
+               1e-3f) != SRSLTE_SUCCESS) {
+    fprintf(stderr, "Single tx, single rx test with sc12 format failed!\n");
+    return -1;
+  }
+
+  if (run_test("rx_port=ipc://link4,id=ue,base_srate=1.92e6,rx_format=bfp8",
+               "tx_port=ipc://link4,id=enb,base_srate=1.92e6",
+               true,
+               2e-2f) != SRSLTE_SUCCESS) {
+    fprintf(stderr, "Single tx, single rx test with bfp8 format failed!\n");
+    return -1;
+  }
+
   return 0;
 }
@@ -250,6 +250,15 @@ void srslte_ue_dl_set_non_mbsfn_region(srslte_ue_dl_t* q, uint8_t non_mbsfn_regi
   srslte_ofdm_set_non_mbsfn_region(&q->fft_mbsfn, non_mbsfn_region_length);
 }
 
+/* Sets the CFO (normalised to the sampling rate) corrected by the OFDM demodulator in the next subframes */
+void srslte_ue_dl_set_cfo(srslte_ue_dl_t* q, float cfo)
+{
+  for (uint32_t i = 0; i < q->nof_rx_antennas; i++) {
+    srslte_ofdm_set_cfo(&q->fft[i], cfo);
+  }
+  srslte_ofdm_set_cfo(&q->fft_mbsfn, cfo);
+}
+
 void srslte_ue_dl_set_mi_auto(srslte_ue_dl_t* q)
 {
   q->mi_auto = true;
@@ -419,25 +428,51 @@ static bool find_dci(srslte_dci_msg_t* dci_msg, uint32_t nof_dci_msg, srslte_dci
   return found;
 }
 
+/* Sorts the candidates by decreasing LLR reliability so the search is more likely to stop at the first decoded one.
+ * Insertion sort keeps the standard order between candidates with the same metric. */
+static void rank_candidates(srslte_ue_dl_t*     q,
+                            srslte_dl_sf_cfg_t* sf,
+                            dci_blind_search_t* search_space,
+                            uint32_t            order[MAX_CANDIDATES])
+{
+  float metric[MAX_CANDIDATES];
+
+  for (uint32_t i = 0; i < search_space->nof_locations && i < MAX_CANDIDATES; i++) {
+    float    m = srslte_pdcch_location_metric(&q->pdcch, sf, &search_space->loc[i]);
+    uint32_t j = i;
+    for (; j > 0 && metric[j - 1] < m; j--) {
+      metric[j] = metric[j - 1];
+      order[j]  = order[j - 1];
+    }
+    metric[j] = m;
+    order[j]  = i;
+  }
+}
+
 static int dci_blind_search(srslte_ue_dl_t*     q,
                             srslte_dl_sf_cfg_t* sf,
                             uint16_t            rnti,
+                            uint16_t            sps_rnti,
                             dci_blind_search_t* search_space,
                             srslte_dci_cfg_t*   dci_cfg,
                             srslte_dci_msg_t    dci_msg[SRSLTE_MAX_DCI_MSG])
 {
   uint32_t nof_dci = 0;
   if (rnti) {
+    uint32_t order[MAX_CANDIDATES];
+    rank_candidates(q, sf, search_space, order);
+
     int i = 0;
     while ((dci_cfg->cif_enabled || !nof_dci) && (i < search_space->nof_locations) && (nof_dci < SRSLTE_MAX_DCI_MSG)) {
+      srslte_dci_location_t* loc = &search_space->loc[order[i]];
       DEBUG("Searching format %s in %d,%d (%d/%d)\n",
             srslte_dci_format_string(search_space->format),
-            search_space->loc[i].ncce,
-            search_space->loc[i].L,
+            loc->ncce,
+            loc->L,
             i,
             search_space->nof_locations);
 
-      dci_msg[nof_dci].location = search_space->loc[i];
+      dci_msg[nof_dci].location = *loc;
       dci_msg[nof_dci].format   = search_space->format;
       dci_msg[nof_dci].rnti     = 0;
       if (srslte_pdcch_decode_msg(&q->pdcch, sf, dci_cfg, &dci_msg[nof_dci])) {
@@ -445,9 +480,10 @@ static int dci_blind_search(srslte_ue_dl_t*     q,
         return SRSLTE_ERROR;
       }
 
-      if ((dci_msg[nof_dci].rnti == rnti) && (dci_msg[nof_dci].nof_bits > 0)) {
+      // The SPS C-RNTI shares the UE-specific search space of the C-RNTI (36.213 Section 9.1.1)
+      bool rnti_match = (dci_msg[nof_dci].rnti == rnti) || (sps_rnti && dci_msg[nof_dci].rnti == sps_rnti);
+      if (rnti_match && (dci_msg[nof_dci].nof_bits > 0)) {
 
-        dci_msg[nof_dci].rnti = rnti;
         // If searching for Format1A but found Format0 save it for later
         if (dci_msg[nof_dci].format == SRSLTE_DCI_FORMAT0 && search_space->format == SRSLTE_DCI_FORMAT1A) {
           /* If there is space for accumulate another UL DCI dci and it was not detected before, then store it */
@@ -512,7 +548,7 @@ int srslte_ue_dl_find_ul_dci(srslte_ue_dl_t*     q,
 
       current_ss->format = SRSLTE_DCI_FORMAT0;
       INFO("Searching UL C-RNTI in %d ue locations\n", search_space.nof_locations);
-      nof_msg = dci_blind_search(q, sf, rnti, current_ss, &dl_cfg->cfg.dci, dci_msg);
+      nof_msg = dci_blind_search(q, sf, rnti, dl_cfg->cfg.sps_rnti, current_ss, &dl_cfg->cfg.dci, dci_msg);
     }
 
     // Unpack DCI messages
@@ -554,7 +590,7 @@ static int find_dl_dci_type_siprarnti(srslte_ue_dl_t*     q,
   if (search_space.nof_locations > 0) {
     for (uint32_t f = 0; f < nof_common_formats; f++) {
       search_space.format = common_formats[f];
-      if ((ret = dci_blind_search(q, sf, rnti, &search_space, dci_cfg, dci_msg))) {
+      if ((ret = dci_blind_search(q, sf, rnti, 0, &search_space, dci_cfg, dci_msg))) {
         return ret;
       }
     }
@@ -595,7 +631,7 @@ static int find_dl_dci_type_crnti(srslte_ue_dl_t*     q,
     INFO("Searching DL C-RNTI %s in %d ue locations\n", srslte_dci_format_string(format), current_ss->nof_locations);
 
     current_ss->format = format;
-    if ((ret = dci_blind_search(q, sf, rnti, current_ss, dci_cfg, dci_msg))) {
+    if ((ret = dci_blind_search(q, sf, rnti, cfg->cfg.sps_rnti, current_ss, dci_cfg, dci_msg))) {
       return ret;
     }
   }
@@ -612,7 +648,7 @@ static int find_dl_dci_type_crnti(srslte_ue_dl_t*     q,
   if (current_ss->nof_locations > 0) {
     current_ss->format = SRSLTE_DCI_FORMAT1A;
     INFO("Searching DL C-RNTI in %d ue locations, format 1A\n", current_ss->nof_locations);
-    return dci_blind_search(q, sf, rnti, current_ss, dci_cfg, dci_msg);
+    return dci_blind_search(q, sf, rnti, cfg->cfg.sps_rnti, current_ss, dci_cfg, dci_msg);
   }
   return SRSLTE_SUCCESS;
 }
@@ -1386,7 +1422,10 @@ void srslte_ue_dl_save_signal(srslte_ue_dl_t* q, srslte_dl_sf_cfg_t* sf, srslte_
   srslte_vec_save_file("pdcch_llr", q->pdcch.llr, q->pdcch.nof_cce[cfi - 1] * 72 * sizeof(float));
 
   srslte_vec_save_file("pdsch_symbols", q->pdsch.d[0], pdsch_cfg->grant.nof_re * sizeof(cf_t));
-  srslte_vec_save_file("llr", q->pdsch.e[0], pdsch_cfg->grant.tb[0].nof_bits * sizeof(cf_t));
+  // The fused PDSCH Rx does not store the codeword LLRs
+  if (q->pdsch.output_llr) {
+    srslte_vec_save_file("llr", q->pdsch.e[0], pdsch_cfg->grant.tb[0].nof_bits * sizeof(cf_t));
+  }
   printf("Saved files for tti=%d, sf=%d, cfi=%d, tbs=%d, rv=%d\n",
          tti,
          tti % 10,
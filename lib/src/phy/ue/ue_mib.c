@@ -103,6 +103,16 @@ int srslte_ue_mib_set_cell(srslte_ue_mib_t* q, srslte_cell_t cell)
       return SRSLTE_ERROR;
     }
 
+    /* The PBCH only spans the central PRB, wider cells only extract these plus a margin from the FFT output. The rest
+     * of the grid is left zero */
+    if (cell.nof_prb > SRSLTE_UE_MIB_NOF_PRB + 2 * SRSLTE_UE_MIB_WINDOW_MARGIN_PRB) {
+      uint32_t first_prb = (cell.nof_prb - SRSLTE_UE_MIB_NOF_PRB) / 2 - SRSLTE_UE_MIB_WINDOW_MARGIN_PRB;
+      srslte_ofdm_rx_set_prb_window(&q->fft, first_prb, cell.nof_prb - 2 * first_prb);
+      bzero(q->sf_symbols[0], SRSLTE_SF_LEN_RE(cell.nof_prb, cell.cp) * sizeof(cf_t));
+    } else {
+      srslte_ofdm_rx_set_prb_window(&q->fft, 0, 0);
+    }
+
     if (cell.nof_ports == 0) {
       cell.nof_ports = SRSLTE_MAX_PORTS;
     }
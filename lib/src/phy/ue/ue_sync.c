@@ -486,6 +486,21 @@ float srslte_ue_sync_get_cfo(srslte_ue_sync_t* q)
   return 15000 * q->cfo_current_value;
 }
 
+/* When enabled, the tracking CFO correction is not applied to the subframes the synchronizer does not use (PSS/SSS and
+ * MIB subframes are still corrected). The caller shall apply the correction returned by
+ * srslte_ue_sync_get_cfo_deferred(), for instance fusing it in the OFDM demodulator with srslte_ofdm_set_cfo().
+ */
+void srslte_ue_sync_set_cfo_defer(srslte_ue_sync_t* q, bool enable)
+{
+  q->cfo_correct_defer = enable;
+}
+
+/* Returns the CFO correction, normalised to the sampling rate, still to be applied to the last received subframe */
+float srslte_ue_sync_get_cfo_deferred(srslte_ue_sync_t* q)
+{
+  return q->cfo_deferred;
+}
+
 void srslte_ue_sync_copy_cfo(srslte_ue_sync_t* q, srslte_ue_sync_t* src_obj)
 {
   // Copy find object internal CFO averages
@@ -700,6 +715,16 @@ static int receive_samples(srslte_ue_sync_t* q, cf_t* input_buffer[SRSLTE_MAX_PO
   return SRSLTE_SUCCESS;
 }
 
+/* Subframes used by the synchronizer itself: PSS/SSS tracking and MIB decoding */
+static bool is_sync_sf(srslte_ue_sync_t* q)
+{
+  if (q->sfind.frame_type == SRSLTE_FDD) {
+    return q->sf_idx == 0 || q->sf_idx == 5;
+  } else {
+    return q->sf_idx == 0 || q->sf_idx == 1 || q->sf_idx == 5 || q->sf_idx == 6;
+  }
+}
+
 /* Returns 1 if the subframe is synchronized in time, 0 otherwise */
 int srslte_ue_sync_zerocopy(srslte_ue_sync_t* q, cf_t* input_buffer[SRSLTE_MAX_PORTS])
 {
@@ -708,6 +733,8 @@ int srslte_ue_sync_zerocopy(srslte_ue_sync_t* q, cf_t* input_buffer[SRSLTE_MAX_P
 
   if (q != NULL && input_buffer != NULL) {
 
+    q->cfo_deferred = 0.0f;
+
     if (q->file_mode) {
       int n = srslte_filesource_read_multi(&q->file_source, (void**)input_buffer, q->sf_len, q->nof_rx_antennas);
       if (n < 0) {
@@ -799,7 +826,9 @@ int srslte_ue_sync_zerocopy(srslte_ue_sync_t* q, cf_t* input_buffer[SRSLTE_MAX_P
           q->sf_idx = (q->sf_idx + q->nof_recv_sf) % 10;
 
           // Correct CFO before PSS/SSS tracking using the sync object corrector (initialized for 1 ms)
-          if (q->cfo_correct_enable_track) {
+          if (q->cfo_correct_enable_track && q->cfo_correct_defer && !is_sync_sf(q)) {
+            q->cfo_deferred = -q->cfo_current_value / q->fft_size;
+          } else if (q->cfo_correct_enable_track) {
             for (int i = 0; i < q->nof_rx_antennas; i++) {
               if (input_buffer[i]) {
                 srslte_cfo_correct(
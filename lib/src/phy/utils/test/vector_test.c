@@ -427,6 +427,46 @@ TEST(srslte_vec_convert_if, MALLOC(int16_t, x); MALLOC(float, z); float scale =
      free(x);
      free(z);)
 
+TEST(srslte_vec_convert_bf, MALLOC(int8_t, x); MALLOC(float, z); float scale = 100.0f;
+
+     float gold;
+     float k = 1.0f / scale;
+     for (int i = 0; i < block_size; i++) { x[i] = (int8_t)RANDOM_B(); }
+
+     TEST_CALL(srslte_vec_convert_bf(x, scale, z, block_size))
+
+         for (int i = 0; i < block_size; i++) {
+           gold       = ((float)x[i]) * k;
+           double err = cabsf((float)gold - (float)z[i]);
+           if (err > mse) {
+             mse = err;
+           }
+         }
+
+     free(x);
+     free(z);)
+
+TEST(srslte_vec_pack_s12, MALLOC(int16_t, x); MALLOC(int16_t, y); uint8_t* z = srslte_vec_malloc(2 * block_size);
+     uint32_t len = block_size & ~1U;
+
+     for (int i = 0; i < len; i++) { x[i] = (int16_t)(RANDOM_S() * 10); }
+
+     TEST_CALL(srslte_vec_pack_s12(x, z, len))
+
+         srslte_vec_unpack_s12(z, y, len);
+
+     for (int i = 0; i < len; i++) {
+       int16_t gold = SRSLTE_MIN(SRSLTE_MAX(x[i], -2048), 2047);
+       double  err  = abs(gold - y[i]);
+       if (err > mse) {
+         mse = err;
+       }
+     }
+
+     free(x);
+     free(y);
+     free(z);)
+
 TEST(
     srslte_vec_prod_fff, MALLOC(float, x); MALLOC(float, y); MALLOC(float, z);
 
@@ -806,6 +846,14 @@ int main(int argc, char** argv)
         test_srslte_vec_convert_if(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srslte_vec_convert_bf(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
+    passed[func_count][size_count] =
+        test_srslte_vec_pack_s12(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srslte_vec_prod_fff(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
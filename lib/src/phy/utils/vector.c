@@ -117,6 +117,26 @@ void srslte_vec_convert_fb(const float* x, const float scale, int8_t* z, const u
   srslte_vec_convert_fb_simd(x, z, scale, len);
 }
 
+void srslte_vec_convert_bf(const int8_t* x, const float scale, float* z, const uint32_t len)
+{
+  srslte_vec_convert_bf_simd(x, z, scale, len);
+}
+
+void srslte_vec_convert_sb(const int16_t* x, const float scale, int8_t* z, const uint32_t len)
+{
+  srslte_vec_convert_sb_simd(x, z, scale, len);
+}
+
+void srslte_vec_pack_s12(const int16_t* x, uint8_t* z, const uint32_t len)
+{
+  srslte_vec_pack_s12_simd(x, z, len);
+}
+
+void srslte_vec_unpack_s12(const uint8_t* x, int16_t* z, const uint32_t len)
+{
+  srslte_vec_unpack_s12_simd(x, z, len);
+}
+
 void srslte_vec_lut_sss(const short* x, const unsigned short* lut, short* y, const uint32_t len)
 {
   srslte_vec_lut_sss_simd(x, lut, y, len);
@@ -516,10 +516,10 @@ void srslte_vec_convert_fb_simd(const float* x, int8_t* z, const float scale, co
     }
   } else {
     for (; i < len - 16 + 1; i += 16) {
-      __m128 a = _mm_load_ps(&x[i]);
-      __m128 b = _mm_load_ps(&x[i + 1 * 4]);
-      __m128 c = _mm_load_ps(&x[i + 2 * 4]);
-      __m128 d = _mm_load_ps(&x[i + 3 * 4]);
+      __m128 a = _mm_loadu_ps(&x[i]);
+      __m128 b = _mm_loadu_ps(&x[i + 1 * 4]);
+      __m128 c = _mm_loadu_ps(&x[i + 2 * 4]);
+      __m128 d = _mm_loadu_ps(&x[i + 3 * 4]);
 
       __m128 sa = _mm_mul_ps(a, s);
       __m128 sb = _mm_mul_ps(b, s);
@@ -549,6 +549,136 @@ void srslte_vec_convert_fb_simd(const float* x, int8_t* z, const float scale, co
   }
 }
 
+void srslte_vec_convert_bf_simd(const int8_t* x, float* z, const float scale, const int len)
+{
+  int         i    = 0;
+  const float gain = 1.0f / scale;
+
+#ifdef LV_HAVE_SSE
+  __m128 s = _mm_set1_ps(gain);
+  for (; i < len - 16 + 1; i += 16) {
+    __m128i i8 = _mm_loadu_si128((__m128i*)&x[i]);
+
+    __m128 a = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi8_epi32(i8)), s);
+    __m128 b = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_srli_si128(i8, 4))), s);
+    __m128 c = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_srli_si128(i8, 8))), s);
+    __m128 d = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_srli_si128(i8, 12))), s);
+
+    _mm_storeu_ps(&z[i], a);
+    _mm_storeu_ps(&z[i + 1 * 4], b);
+    _mm_storeu_ps(&z[i + 2 * 4], c);
+    _mm_storeu_ps(&z[i + 3 * 4], d);
+  }
+#endif /* LV_HAVE_SSE */
+
+  for (; i < len; i++) {
+    z[i] = ((float)x[i]) * gain;
+  }
+}
+
+void srslte_vec_convert_sb_simd(const int16_t* x, int8_t* z, const float scale, const int len)
+{
+  int i = 0;
+
+  // Saturates to [-127, 127] so the result can be negated without overflow
+#ifdef LV_HAVE_SSE
+  __m128  s   = _mm_set1_ps(scale);
+  __m128i min = _mm_set1_epi8(-127);
+  for (; i < len - 16 + 1; i += 16) {
+    __m128i a = _mm_loadu_si128((__m128i*)&x[i]);
+    __m128i b = _mm_loadu_si128((__m128i*)&x[i + 8]);
+
+    __m128i a0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi16_epi32(a)), s));
+    __m128i a1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(a, 8))), s));
+    __m128i b0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi16_epi32(b)), s));
+    __m128i b1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(b, 8))), s));
+
+    __m128i i8 = _mm_packs_epi16(_mm_packs_epi32(a0, a1), _mm_packs_epi32(b0, b1));
+
+    _mm_storeu_si128((__m128i*)&z[i], _mm_max_epi8(i8, min));
+  }
+#endif
+
+#ifdef HAVE_NEON
+#pragma message "srslte_vec_convert_sb_simd not implemented in neon"
+#endif /* HAVE_NEON */
+
+  for (; i < len; i++) {
+    float v = rintf(x[i] * scale);
+    z[i]    = (int8_t)(v > 127.0f ? 127 : (v < -127.0f ? -127 : v));
+  }
+}
+
+void srslte_vec_pack_s12_simd(const int16_t* x, uint8_t* z, const int len)
+{
+  int i = 0;
+
+  // Two 12-bit values are packed in 3 bytes: the first in the low 12 bits, the second in the high 12 bits
+#ifdef LV_HAVE_SSE
+  __m128i max   = _mm_set1_epi16(2047);
+  __m128i min   = _mm_set1_epi16(-2048);
+  __m128i mask0 = _mm_set1_epi32(0x00000FFF);
+  __m128i mask1 = _mm_set1_epi32(0x00FFF000);
+  __m128i shuf  = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  for (; i < len - 16 + 1; i += 16) {
+    __m128i a = _mm_loadu_si128((__m128i*)&x[i]);
+    __m128i b = _mm_loadu_si128((__m128i*)&x[i + 8]);
+
+    a = _mm_min_epi16(_mm_max_epi16(a, min), max);
+    b = _mm_min_epi16(_mm_max_epi16(b, min), max);
+
+    a = _mm_or_si128(_mm_and_si128(a, mask0), _mm_and_si128(_mm_srli_epi32(a, 4), mask1));
+    b = _mm_or_si128(_mm_and_si128(b, mask0), _mm_and_si128(_mm_srli_epi32(b, 4), mask1));
+
+    // 12 bytes in each register
+    a = _mm_shuffle_epi8(a, shuf);
+    b = _mm_shuffle_epi8(b, shuf);
+
+    _mm_storeu_si128((__m128i*)&z[(i / 2) * 3], _mm_or_si128(a, _mm_slli_si128(b, 12)));
+    _mm_storel_epi64((__m128i*)&z[(i / 2) * 3 + 16], _mm_srli_si128(b, 4));
+  }
+#endif /* LV_HAVE_SSE */
+
+  for (; i < len - 1; i += 2) {
+    int16_t a = (x[i] > 2047) ? 2047 : ((x[i] < -2048) ? -2048 : x[i]);
+    int16_t b = (x[i + 1] > 2047) ? 2047 : ((x[i + 1] < -2048) ? -2048 : x[i + 1]);
+
+    z[(i / 2) * 3]     = (uint8_t)(a & 0xFF);
+    z[(i / 2) * 3 + 1] = (uint8_t)(((a >> 8) & 0x0F) | ((b & 0x0F) << 4));
+    z[(i / 2) * 3 + 2] = (uint8_t)((b >> 4) & 0xFF);
+  }
+}
+
+void srslte_vec_unpack_s12_simd(const uint8_t* x, int16_t* z, const int len)
+{
+  int i = 0;
+
+#ifdef LV_HAVE_SSE
+  // Every 16-bit lane gets the two bytes its 12-bit value spans, even lanes have the value in the low 12 bits and odd
+  // lanes in the high 12 bits
+  __m128i shuf0 = _mm_setr_epi8(0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11);
+  __m128i shuf1 = _mm_setr_epi8(4, 5, 5, 6, 7, 8, 8, 9, 10, 11, 11, 12, 13, 14, 14, 15);
+  for (; i < len - 16 + 1; i += 16) {
+    __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)&x[(i / 2) * 3]), shuf0);
+    __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)&x[(i / 2) * 3 + 8]), shuf1);
+
+    a = _mm_blend_epi16(_mm_srai_epi16(_mm_slli_epi16(a, 4), 4), _mm_srai_epi16(a, 4), 0xAA);
+    b = _mm_blend_epi16(_mm_srai_epi16(_mm_slli_epi16(b, 4), 4), _mm_srai_epi16(b, 4), 0xAA);
+
+    _mm_storeu_si128((__m128i*)&z[i], a);
+    _mm_storeu_si128((__m128i*)&z[i + 8], b);
+  }
+#endif /* LV_HAVE_SSE */
+
+  for (; i < len - 1; i += 2) {
+    uint16_t a = (uint16_t)x[(i / 2) * 3] | ((uint16_t)x[(i / 2) * 3 + 1] << 8);
+    uint16_t b = (uint16_t)x[(i / 2) * 3 + 1] | ((uint16_t)x[(i / 2) * 3 + 2] << 8);
+
+    z[i]     = (int16_t)(a << 4) >> 4;
+    z[i + 1] = (int16_t)b >> 4;
+  }
+}
+
 float srslte_vec_acc_ff_simd(const float* x, const int len)
 {
   int   i       = 0;
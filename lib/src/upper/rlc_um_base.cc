@@ -141,7 +141,7 @@ uint32_t rlc_um_base::get_buffer_state()
 int rlc_um_base::read_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   if (tx && tx_enabled) {
-    uint32_t len = tx->build_data_pdu(payload, nof_bytes);
+    uint32_t len = tx->read_pdu(payload, nof_bytes);
     metrics.num_tx_bytes += len;
     metrics.num_tx_pdus++;
     return len;
@@ -280,9 +280,8 @@ void rlc_um_base::rlc_um_base_tx::discard_sdu(uint32_t discard_sn)
   log->warning("RLC UM: Discard SDU not implemented yet.\n");
 }
 
-int rlc_um_base::rlc_um_base_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
+int rlc_um_base::rlc_um_base_tx::read_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  unique_byte_buffer_t pdu;
   {
     std::lock_guard<std::mutex> lock(mutex);
     log->debug("MAC opportunity - %d bytes\n", nof_bytes);
@@ -291,14 +290,8 @@ int rlc_um_base::rlc_um_base_tx::build_data_pdu(uint8_t* payload, uint32_t nof_b
       log->info("No data available to be sent\n");
       return 0;
     }
-
-    pdu = allocate_unique_buffer(*pool);
-    if (!pdu || pdu->N_bytes != 0) {
-      log->error("Failed to allocate PDU buffer\n");
-      return 0;
-    }
   }
-  return build_data_pdu(std::move(pdu), payload, nof_bytes);
+  return build_data_pdu(payload, nof_bytes);
 }
 
 } // namespace srslte
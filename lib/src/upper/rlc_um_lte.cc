@@ -120,7 +120,9 @@ bool rlc_um_lte::rlc_um_lte_tx::configure(rlc_config_t cnfg_, std::string rb_nam
   return true;
 }
 
-int rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes)
+/* The SDUs are copied straight to the MAC payload once the header is known, without building the PDU in a buffer of
+ * the pool first. The segments are planned first, because the LIs that go in front of the data depend on them */
+int rlc_um_lte::rlc_um_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   std::lock_guard<std::mutex> lock(mutex);
   rlc_umd_pdu_header_t        header;
@@ -131,10 +133,11 @@ int rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t*
 
   uint32_t to_move = 0;
   uint32_t last_li = 0;
-  uint8_t* pdu_ptr = pdu->msg;
 
+  // The PDU no longer goes through a pool buffer, but the limit of its payload is kept so that the PDUs stay
+  // byte-identical to the ones built in a pool buffer, and fit in the pool buffer the receiving RLC copies them to
   int head_len  = rlc_um_packed_length(&header);
-  int pdu_space = SRSLTE_MIN(nof_bytes, pdu->get_tailroom());
+  int pdu_space = SRSLTE_MIN(nof_bytes, SRSLTE_MAX_BUFFER_SIZE_BYTES - SRSLTE_BUFFER_HEADER_OFFSET);
 
   if (pdu_space <= head_len + 1) {
     log->warning("%s Cannot build a PDU - %d bytes available, %d bytes required for header\n",
@@ -144,25 +147,17 @@ int rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t*
     return 0;
   }
 
+  pdu_segments.clear();
+
   // Check for SDU segment
   if (tx_sdu) {
     uint32_t space = pdu_space - head_len;
     to_move        = space >= tx_sdu->N_bytes ? tx_sdu->N_bytes : space;
     log->debug(
         "%s adding remainder of SDU segment - %d bytes of %d remaining\n", rb_name.c_str(), to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (tx_sdu->N_bytes == 0) {
-      log->debug(
-          "%s Complete SDU scheduled for tx. Stack latency: %ld us\n", rb_name.c_str(), tx_sdu->get_latency_us());
-
-      tx_sdu.reset();
-    }
-    pdu_space -= SRSLTE_MIN(to_move, pdu->get_tailroom());
+    pdu_segments.emplace_back(std::move(tx_sdu), to_move);
+    pdu_space -= to_move;
     header.fi |= RLC_FI_FIELD_NOT_START_ALIGNED; // First byte does not correspond to first byte of SDU
   }
 
@@ -171,27 +166,22 @@ int rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t*
     log->debug("pdu_space=%d, head_len=%d\n", pdu_space, head_len);
     if (last_li > 0)
       header.li[header.N_li++] = last_li;
-    head_len       = rlc_um_packed_length(&header);
-    tx_sdu         = tx_sdu_queue.read();
-    uint32_t space = pdu_space - head_len;
-    to_move        = space >= tx_sdu->N_bytes ? tx_sdu->N_bytes : space;
-    log->debug("%s adding new SDU segment - %d bytes of %d remaining\n", rb_name.c_str(), to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+    head_len = rlc_um_packed_length(&header);
+
+    unique_byte_buffer_t sdu   = tx_sdu_queue.read();
+    uint32_t             space = pdu_space - head_len;
+    to_move                    = space >= sdu->N_bytes ? sdu->N_bytes : space;
+    log->debug("%s adding new SDU segment - %d bytes of %d remaining\n", rb_name.c_str(), to_move, sdu->N_bytes);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (tx_sdu->N_bytes == 0) {
-      log->debug(
-          "%s Complete SDU scheduled for tx. Stack latency: %ld us\n", rb_name.c_str(), tx_sdu->get_latency_us());
-
-      tx_sdu.reset();
-    }
+    pdu_segments.emplace_back(std::move(sdu), to_move);
     pdu_space -= to_move;
   }
 
-  if (tx_sdu) {
+  if (pdu_segments.empty()) {
+    log->info("No data available to be sent\n");
+    return 0;
+  }
+  if (pdu_segments.back().second < pdu_segments.back().first->N_bytes) {
     header.fi |= RLC_FI_FIELD_NOT_END_ALIGNED; // Last byte does not correspond to last byte of SDU
   }
 
@@ -200,11 +190,26 @@ int rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t*
   vt_us     = (vt_us + 1) % cfg.um.tx_mod;
 
   // Add header and TX
-  rlc_um_write_data_pdu_header(&header, pdu.get());
-  memcpy(payload, pdu->msg, pdu->N_bytes);
-  uint32_t ret = pdu->N_bytes;
+  uint8_t* ptr = payload;
+  rlc_um_write_data_pdu_header(&header, &ptr);
+  for (auto& segment : pdu_segments) {
+    unique_byte_buffer_t& sdu = segment.first;
+    memcpy(ptr, sdu->msg, segment.second);
+    ptr += segment.second;
+    sdu->N_bytes -= segment.second;
+    sdu->msg += segment.second;
+    if (sdu->N_bytes == 0) {
+      log->debug("%s Complete SDU scheduled for tx. Stack latency: %ld us\n", rb_name.c_str(), sdu->get_latency_us());
+      sdu.reset();
+    } else {
+      // Only the last SDU can be segmented, its remainder goes in the next PDU
+      tx_sdu = std::move(sdu);
+    }
+  }
+  pdu_segments.clear();
+  uint32_t ret = ptr - payload;
 
-  log->info_hex(payload, ret, "%s Tx PDU SN=%d (%d B)\n", rb_name.c_str(), header.sn, pdu->N_bytes);
+  log->info_hex(payload, ret, "%s Tx PDU SN=%d (%d B)\n", rb_name.c_str(), header.sn, ret);
 
   debug_state();
 
@@ -742,12 +747,20 @@ void rlc_um_read_data_pdu_header(uint8_t*              payload,
 
 void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu)
 {
-  uint32_t i;
-  uint8_t  ext = (header->N_li > 0) ? 1 : 0;
   // Make room for the header
   uint32_t len = rlc_um_packed_length(header);
   pdu->msg -= len;
   uint8_t* ptr = pdu->msg;
+  rlc_um_write_data_pdu_header(header, &ptr);
+  pdu->N_bytes += ptr - pdu->msg;
+}
+
+// Write header to pointer & move pointer
+void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, uint8_t** payload)
+{
+  uint32_t i;
+  uint8_t  ext = (header->N_li > 0) ? 1 : 0;
+  uint8_t* ptr = *payload;
 
   // Fixed part
   if (header->sn_size == rlc_umd_sn_size_t::size5bits) {
@@ -787,7 +800,7 @@ void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* p
   if (header->N_li % 2 == 1)
     ptr++;
 
-  pdu->N_bytes += ptr - pdu->msg;
+  *payload = ptr;
 }
 
 uint32_t rlc_um_packed_length(rlc_umd_pdu_header_t* header)
@@ -117,6 +117,16 @@ bool rlc_um_nr::rlc_um_nr_tx::configure(rlc_config_t cnfg_, std::string rb_name_
   return true;
 }
 
+int rlc_um_nr::rlc_um_nr_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
+{
+  unique_byte_buffer_t pdu = allocate_unique_buffer(*pool);
+  if (!pdu || pdu->N_bytes != 0) {
+    log->error("Failed to allocate PDU buffer\n");
+    return 0;
+  }
+  return build_data_pdu(std::move(pdu), payload, nof_bytes);
+}
+
 int rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes)
 {
   std::lock_guard<std::mutex> lock(mutex);
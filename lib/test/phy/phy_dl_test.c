@@ -44,6 +44,7 @@ static bool     print_dci_table;
 static uint32_t mcs                     = 20;
 static int      cross_carrier_indicator = -1;
 static bool     enable_256qam           = false;
+static bool     output_llr              = false;
 
 void usage(char* prog)
 {
@@ -63,6 +64,8 @@ void usage(char* prog)
   }
   printf("\t-v [set srslte_verbose to debug, default none]\n");
   printf("\t-q Enable/Disable 256QAM modulation (default %s)\n", enable_256qam ? "enabled" : "disabled");
+  printf("\t-l Store the PDSCH LLRs and check the softbits, disables the fused PDSCH Rx (default %s)\n",
+         output_llr ? "enabled" : "disabled");
 }
 
 void parse_extensive_param(char* param, char* arg)
@@ -93,7 +96,7 @@ void parse_args(int argc, char** argv)
     nof_rx_ant     = 2;
   }
 
-  while ((opt = getopt(argc, argv, "cfapndvqstm")) != -1) {
+  while ((opt = getopt(argc, argv, "cfapndvqstml")) != -1) {
     switch (opt) {
       case 't':
         transmission_mode = (uint32_t)strtol(argv[optind], NULL, 10) - 1;
@@ -133,6 +136,9 @@ void parse_args(int argc, char** argv)
       case 'q':
         enable_256qam = (enable_256qam) ? false : true;
         break;
+      case 'l':
+        output_llr = true;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -424,6 +430,9 @@ int main(int argc, char** argv)
 
   srslte_ue_dl_set_rnti(ue_dl, rnti);
 
+  // The fused PDSCH Rx does not store the codeword LLRs, the softbits are only checked when they are kept
+  ue_dl->pdsch.output_llr = output_llr;
+
   /*
    * Create PDCCH Allocations
    */
@@ -617,7 +626,7 @@ int main(int argc, char** argv)
       if (ue_dl_cfg.cfg.pdsch.grant.tb[i].enabled) {
         if (check_evm(enb_dl, ue_dl, &ue_dl_cfg, i)) {
           count_failures++;
-        } else if (check_softbits(enb_dl, ue_dl, &ue_dl_cfg, sf_idx, i) != SRSLTE_SUCCESS) {
+        } else if (output_llr && check_softbits(enb_dl, ue_dl, &ue_dl_cfg, sf_idx, i) != SRSLTE_SUCCESS) {
           printf("TB%d: The received softbits in subframe %d DO NOT match the encoded bits (crc=%d)\n",
                  i,
                  sf_idx,
@@ -390,6 +390,53 @@ int reassmble_test2()
   return 0;
 }
 
+// Checks the PDUs written by the transmitter byte by byte, with the LIs of two SDUs and a segmented SDU
+int pdu_bytes_test()
+{
+  rlc_um_lte_test_context1 ctxt;
+
+  // SDUs of 10, 5 and 30 bytes, each with its own byte pattern
+  byte_buffer_pool* pool       = byte_buffer_pool::get_instance();
+  const uint32_t    sdu_lens[] = {10, 5, 30};
+  const uint8_t     sdu_seed[] = {0x00, 0x10, 0x20};
+  for (uint32_t i = 0; i < 3; i++) {
+    unique_byte_buffer_t sdu = srslte::allocate_unique_buffer(*pool, true);
+    for (uint32_t j = 0; j < sdu_lens[i]; j++) {
+      sdu->msg[j] = sdu_seed[i] + j;
+    }
+    sdu->N_bytes = sdu_lens[i];
+    ctxt.rlc1.write_sdu(std::move(sdu));
+  }
+
+  // FI=01, E=1, SN=0, LI=10, LI=5, the first two SDUs and the start of the third
+  const uint8_t pdu1[] = {0x0c, 0x00, 0x80, 0xa0, 0x05, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                          0x08, 0x09, 0x10, 0x11, 0x12, 0x13, 0x14, 0x20, 0x21, 0x22, 0x23, 0x24};
+  // FI=11, E=0, SN=1, a middle segment of the third SDU
+  const uint8_t pdu2[] = {0x18, 0x01, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e};
+  // FI=10, E=0, SN=2, the end of the third SDU, in a grant larger than the PDU
+  const uint8_t pdu3[] = {0x10, 0x02, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
+                          0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d};
+
+  const uint8_t* expected_pdus[] = {pdu1, pdu2, pdu3};
+  const uint32_t expected_lens[] = {sizeof(pdu1), sizeof(pdu2), sizeof(pdu3)};
+  const uint32_t grant_lens[]    = {sizeof(pdu1), sizeof(pdu2), 100};
+  for (uint32_t i = 0; i < 3; i++) {
+    // The PDU is written straight into the MAC payload, which must not be touched past its end
+    byte_buffer_t payload;
+    memset(payload.msg, 0xaa, grant_lens[i] + 1);
+    int len = ctxt.rlc1.read_pdu(payload.msg, grant_lens[i]);
+    TESTASSERT(len == (int)expected_lens[i]);
+    TESTASSERT(memcmp(payload.msg, expected_pdus[i], expected_lens[i]) == 0);
+    for (uint32_t j = expected_lens[i]; j <= grant_lens[i]; j++) {
+      TESTASSERT(payload.msg[j] == 0xaa);
+    }
+  }
+
+  TESTASSERT(0 == ctxt.rlc1.get_buffer_state());
+
+  return 0;
+}
+
 int main(int argc, char** argv)
 {
   if (basic_test()) {
@@ -416,4 +463,9 @@ int main(int argc, char** argv)
     return -1;
   }
   byte_buffer_pool::get_instance()->cleanup();
+
+  if (pdu_bytes_test()) {
+    return -1;
+  }
+  byte_buffer_pool::get_instance()->cleanup();
 }
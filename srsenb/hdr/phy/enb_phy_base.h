@@ -44,6 +44,8 @@ public:
   virtual void start_plot() = 0;
 
   virtual void get_metrics(phy_metrics_t* m) = 0;
+
+  virtual void get_timing_metrics(timing_metrics_t* m) = 0;
 };
 
 } // namespace srsenb
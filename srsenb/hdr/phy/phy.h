@@ -74,6 +74,7 @@ public:
   void set_config_dedicated(uint16_t rnti, asn1::rrc::phys_cfg_ded_s* dedicated);
 
   void get_metrics(phy_metrics_t metrics[ENB_METRICS_MAX_USERS]);
+  void get_timing_metrics(timing_metrics_t* m);
 
   void radio_overflow(){};
   void radio_failure(){};
@@ -33,6 +33,7 @@
 #include "srslte/phy/channel/channel.h"
 #include "srslte/radio/radio.h"
 #include <map>
+#include <mutex>
 #include <semaphore.h>
 #include <string.h>
 
@@ -49,6 +50,8 @@ typedef struct {
   bool        pusch_8bit_decoder;
   float       tx_amplitude;
   int         nof_phy_threads;
+  uint32_t    nof_prach_threads;
+  uint32_t    harq_delay_ms;
   std::string equalizer_mode;
   float       estimator_fil_w;
   bool        pregenerate_signals;
@@ -117,6 +120,9 @@ public:
   void           ue_db_set_last_ul_tb(uint16_t rnti, uint32_t pid, srslte_ra_tb_t tb);
   srslte_ra_tb_t ue_db_get_last_ul_tb(uint16_t rnti, uint32_t pid);
 
+  bool set_processing_time(float proc_ms);
+  void get_timing_metrics(timing_metrics_t* m);
+
   void configure_mbsfn(phy_interface_stack_lte::phy_cfg_mbsfn_t* cfg);
   void build_mch_table();
   void build_mcch_table();
@@ -132,6 +138,9 @@ private:
 
   pthread_mutex_t user_mutex = {};
 
+  std::mutex       timing_mutex;
+  timing_metrics_t timing_metrics = {};
+
   bool                                     have_mtch_stop = false;
   pthread_mutex_t                          mtch_mutex     = {};
   pthread_cond_t                           mtch_cvar      = {};
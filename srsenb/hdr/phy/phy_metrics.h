@@ -45,6 +45,13 @@ struct phy_metrics_t {
   ul_metrics_t ul;
 };
 
+// PHY processing deadline metrics, common to all users
+struct timing_metrics_t {
+  uint32_t nof_sf;
+  uint32_t nof_late_sf;
+  float    max_proc_ms;
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_PHY_METRICS_H
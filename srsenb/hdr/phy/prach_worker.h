@@ -22,40 +22,54 @@
 #ifndef SRSENB_PRACH_WORKER_H
 #define SRSENB_PRACH_WORKER_H
 
-#include "srslte/common/block_queue.h"
 #include "srslte/common/buffer_pool.h"
 #include "srslte/common/log.h"
-#include "srslte/common/threads.h"
+#include "srslte/common/thread_pool.h"
 #include "srslte/interfaces/enb_interfaces.h"
+#include <mutex>
 
 namespace srsenb {
 
-class prach_worker : thread
+/*
+ * Buffers the PRACH occasions of one carrier and detects them in a dedicated pool of threads, so detection bursts do
+ * not compete with the PHY workers and consecutive occasions do not queue behind each other. Every detector thread
+ * has its own PRACH object and combines the receive antennas non-coherently.
+ */
+class prach_worker
 {
 public:
-  prach_worker(uint32_t cc_idx_) : buffer_pool(8), thread("PRACH_WORKER") { cc_idx = cc_idx_; }
+  prach_worker(uint32_t cc_idx_, uint32_t nof_threads) : buffer_pool(8), detectors(nof_threads)
+  {
+    cc_idx = cc_idx_;
+    detector_vec.resize(nof_threads);
+  }
 
   int  init(const srslte_cell_t&      cell_,
             const srslte_prach_cfg_t& prach_cfg_,
             stack_interface_phy_lte*  mac,
             srslte::log*              log_h,
             int                       priority);
-  int  new_tti(uint32_t tti, cf_t* buffer);
+  int  new_tti(uint32_t tti, cf_t* buffer[SRSLTE_MAX_PORTS]);
   void set_max_prach_offset_us(float delay_us);
   void stop();
 
 private:
-  uint32_t cc_idx             = 0;
-  uint32_t prach_nof_det      = 0;
-  uint32_t prach_indices[165] = {};
-  float    prach_offsets[165] = {};
-  float    prach_p2avg[165]   = {};
+  typedef struct {
+    srslte_prach_t prach;
+    uint32_t       nof_det;
+    uint32_t       indices[165];
+    float          offsets[165];
+    float          p2avg[165];
+  } detector_t;
+
+  uint32_t cc_idx = 0;
 
   srslte_cell_t      cell      = {};
   srslte_prach_cfg_t prach_cfg = {};
   srslte_prach_t     prach     = {};
 
-  const static int sf_buffer_sz = 128 * 1024;
+  // Samples of every antenna are stored one after the other, buffer_len samples each
+  const static int sf_buffer_sz = 192 * 1024;
   class sf_buffer
   {
   public:
@@ -72,20 +86,23 @@ private:
     char debug_name[SRSLTE_BUFFER_POOL_LOG_NAME_LEN];
 #endif /* SRSLTE_BUFFER_POOL_LOG_ENABLED */
   };
-  srslte::buffer_pool<sf_buffer>  buffer_pool;
-  srslte::block_queue<sf_buffer*> pending_buffers;
+  srslte::buffer_pool<sf_buffer> buffer_pool;
+
+  srslte::task_thread_pool                  detectors;
+  std::vector<std::unique_ptr<detector_t> > detector_vec;
+  std::mutex                                stack_mutex;
 
   sf_buffer*               current_buffer      = nullptr;
   srslte::log*             log_h               = nullptr;
   stack_interface_phy_lte* stack               = nullptr;
   float                    max_prach_offset_us = 0.0f;
   bool                     initiated           = false;
-  bool                     running             = false;
   uint32_t                 nof_sf              = 0;
   uint32_t                 sf_cnt              = 0;
+  uint32_t                 buffer_len          = 0;
+  uint32_t                 nof_rx_ant          = 1;
 
-  void run_thread() final;
-  int  run_tti(sf_buffer* b);
+  int run_tti(sf_buffer* b, uint32_t detector_id);
 };
 
 class prach_worker_pool
@@ -102,11 +119,12 @@ public:
             const srslte_prach_cfg_t& prach_cfg_,
             stack_interface_phy_lte*  mac,
             srslte::log*              log_h,
-            int                       priority)
+            int                       priority,
+            uint32_t                  nof_threads = 1)
   {
     // Create PRACH worker if required
     while (cc_idx >= prach_vec.size()) {
-      prach_vec.push_back(std::unique_ptr<prach_worker>(new prach_worker(prach_vec.size())));
+      prach_vec.push_back(std::unique_ptr<prach_worker>(new prach_worker(prach_vec.size(), nof_threads)));
     }
 
     prach_vec[cc_idx]->init(cell_, prach_cfg_, mac, log_h, priority);
@@ -126,7 +144,7 @@ public:
     }
   }
 
-  int new_tti(uint32_t cc_idx, uint32_t tti, cf_t* buffer)
+  int new_tti(uint32_t cc_idx, uint32_t tti, cf_t* buffer[SRSLTE_MAX_PORTS])
   {
     int ret = SRSLTE_ERROR;
     if (cc_idx < prach_vec.size()) {
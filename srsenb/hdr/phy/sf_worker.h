@@ -24,6 +24,7 @@
 
 #include <mutex>
 #include <string.h>
+#include <sys/time.h>
 
 #include "cc_worker.h"
 #include "phy_common.h"
@@ -71,6 +72,7 @@ private:
   uint32_t           t_rx = 0, t_tx_dl = 0, t_tx_ul = 0;
   uint32_t           tx_worker_cnt = 0;
   srslte_timestamp_t tx_time       = {};
+  struct timeval     rx_done_time  = {};
 
   std::vector<std::unique_ptr<cc_worker> > cc_workers;
 
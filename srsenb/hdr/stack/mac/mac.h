@@ -32,6 +32,10 @@
 #include "srslte/interfaces/enb_metrics_interface.h"
 #include "srslte/interfaces/sched_interface.h"
 #include "ue.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <vector>
 
 namespace srsenb {
@@ -57,6 +61,7 @@ public:
   int rach_detected(uint32_t tti, uint32_t primary_cc_idx, uint32_t preamble_idx, uint32_t time_adv) final;
 
   int set_dl_ant_info(uint16_t rnti, asn1::rrc::phys_cfg_ded_s::ant_info_c_* dl_ant_info);
+  int set_sps_cfg(uint16_t rnti, const srslte::sps_cfg_t& sps_cfg);
 
   int ri_info(uint32_t tti, uint16_t rnti, uint32_t ri_value);
   int pmi_info(uint32_t tti, uint16_t rnti, uint32_t pmi_value);
@@ -104,7 +109,8 @@ private:
   static const uint32_t cfi                      = 3;
   srslte_dci_location_t locations[MAX_LOCATIONS] = {};
 
-  static const int MAC_PDU_THREAD_PRIO = 60;
+  static const int MAC_PDU_THREAD_PRIO   = 60;
+  static const int MAC_SCHED_THREAD_PRIO = 3;
 
   // We use a rwlock in MAC to allow multiple workers to access MAC simultaneously. No conflicts will happen since
   // access for different TTIs
@@ -126,8 +132,55 @@ private:
   sched                       scheduler;
   dl_metric_rr                sched_metric_dl_rr;
   ul_metric_rr                sched_metric_ul_rr;
+  dl_metric_edf               sched_metric_dl_edf;
+  ul_metric_edf               sched_metric_ul_edf;
   sched_interface::cell_cfg_t cell_config;
 
+  /* Scheduler thread. If the scheduler is configured with tti_lookahead > 0, the DL/UL decisions of each TTI are
+   * computed by this thread tti_lookahead TTIs before the PHY worker asks for them, and published in a per-TTI result
+   * slot. The PHY workers only collect the results and build the PDUs.
+   */
+  class sched_thread final : public thread
+  {
+  public:
+    explicit sched_thread(mac* parent_) : thread("MAC_SCHED"), parent(parent_) {}
+    void start_sched(uint32_t lookahead_);
+    void stop_sched();
+
+    // Get the results of tti_rx, waiting for them if they are not ready. Returns false if the thread is stopped
+    bool get_dl_result(uint32_t tti_rx, sched_interface::dl_sched_res_t* result);
+    bool get_ul_result(uint32_t tti_rx, sched_interface::ul_sched_res_t* result);
+
+  private:
+    const static uint32_t NOF_SLOTS   = 16; ///< divides 10240, so that the slot of a TTI survives the wrap-around
+    const static uint32_t INVALID_TTI = 0xffffffff;
+
+    // Written by the scheduler thread only. tti_rx is set once the results are complete, and invalidated while the
+    // slot is being overwritten, so that the readers can check that the copy they got is consistent
+    struct result_slot_t {
+      std::atomic<uint32_t>           tti_rx{INVALID_TTI};
+      sched_interface::dl_sched_res_t dl_result;
+      sched_interface::ul_sched_res_t ul_result;
+    };
+
+    void           run_thread() final;
+    void           request(uint32_t tti_rx);
+    result_slot_t* wait_slot(uint32_t tti_rx);
+
+    mac*                                 parent    = nullptr;
+    uint32_t                             lookahead = 0;
+    std::array<result_slot_t, NOF_SLOTS> slots;
+
+    // Protect the TTI counters below and notify new requests and results
+    std::mutex              mutex;
+    std::condition_variable cvar;
+    bool                    running    = false;
+    bool                    has_target = false;
+    uint32_t                next_tti   = 0; ///< next tti_rx to be scheduled
+    uint32_t                target_tti = 0; ///< last tti_rx requested
+  };
+  sched_thread sched_worker;
+
   sched_interface::dl_pdu_mch_t mch;
 
   /* Map of active UEs */
@@ -154,6 +207,10 @@ private:
   srslte_softbuffer_tx_t pcch_softbuffer_tx;
   srslte_softbuffer_tx_t rar_softbuffer_tx;
 
+  // Code block soft-buffers shared by the PUSCH HARQ processes of all UEs (if enabled)
+  srslte_softbuffer_rx_pool_t ul_softbuffer_pool            = {};
+  const static int            pusch_softbuffer_pool_max_mcs = 23;
+
   const static int           mcch_payload_len = 3000; // TODO FIND OUT MAX LENGTH
   int                        current_mcch_length;
   uint8_t                    mcch_payload_buffer[mcch_payload_len];
@@ -40,6 +40,8 @@ struct mac_metrics_t {
   float    dl_ri;
   float    dl_pmi;
   float    phr;
+  uint32_t ul_proactive_used_prb;   ///< PRBs of the proactive UL grants the UE sent data in
+  uint32_t ul_proactive_wasted_prb; ///< PRBs of the proactive UL grants left unused
 };
 
 } // namespace srsenb
@@ -25,9 +25,12 @@
 #include "scheduler_grid.h"
 #include "scheduler_harq.h"
 #include "scheduler_ue.h"
+#include "scheduler_ue_db.h"
 #include "srslte/common/log.h"
+#include "srslte/common/thread_pool.h"
 #include "srslte/interfaces/enb_interfaces.h"
 #include "srslte/interfaces/sched_interface.h"
+#include <condition_variable>
 #include <map>
 #include <mutex>
 #include <pthread.h>
@@ -63,6 +66,7 @@ public:
   std::array<uint32_t, 3>                                  nof_cce_table    = {}; ///< map cfix -> nof cces in PDCCH
   uint32_t                                                 P                = 0;
   uint32_t                                                 nof_rbgs         = 0;
+  sched_tbs_table                                          tbs_table;        ///< TBS/MCS per CQI and nof PRBs
 
   sched_params_t();
   bool set_cfg(srslte::log* log_, sched_interface::cell_cfg_t* cfg_, srslte_regs_t* regs_);
@@ -88,16 +92,16 @@ public:
   {
   public:
     /* Virtual methods for user metric calculation */
-    virtual void set_params(const sched_params_t& sched_params_)                                              = 0;
-    virtual void sched_users(std::map<uint16_t, sched_ue>& ue_db, dl_tti_sched_t* tti_sched, uint32_t cc_idx) = 0;
+    virtual void set_params(const sched_params_t& sched_params_)                             = 0;
+    virtual void sched_users(sched_ue_db& ue_db, dl_tti_sched_t* tti_sched, uint32_t cc_idx) = 0;
   };
 
   class metric_ul
   {
   public:
     /* Virtual methods for user metric calculation */
-    virtual void set_params(const sched_params_t& sched_params_)                                              = 0;
-    virtual void sched_users(std::map<uint16_t, sched_ue>& ue_db, ul_tti_sched_t* tti_sched, uint32_t cc_idx) = 0;
+    virtual void set_params(const sched_params_t& sched_params_)                             = 0;
+    virtual void sched_users(sched_ue_db& ue_db, ul_tti_sched_t* tti_sched, uint32_t cc_idx) = 0;
   };
 
   /*************************************************************
@@ -109,8 +113,9 @@ public:
   sched();
   ~sched();
 
-  void init(rrc_interface_mac* rrc, srslte::log* log);
+  void init(rrc_interface_mac* rrc, srslte::log* log, uint32_t nof_carriers = 1);
   void set_metric(metric_dl* dl_metric, metric_ul* ul_metric);
+  void set_metric(uint32_t enb_cc_idx, metric_dl* dl_metric, metric_ul* ul_metric);
   int  cell_cfg(cell_cfg_t* cell_cfg) final;
   void set_sched_cfg(sched_args_t* sched_cfg);
   int  reset() final;
@@ -127,11 +132,14 @@ public:
 
   uint32_t get_ul_buffer(uint16_t rnti) final;
   uint32_t get_dl_buffer(uint16_t rnti) final;
+  void     get_ul_proactive_prb(uint16_t rnti, uint32_t* used_prb, uint32_t* wasted_prb) final;
+  bool     ul_harq_active(uint32_t tti, uint16_t rnti, uint32_t cc_idx) final;
 
   int dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t retx_queue) final;
   int dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code) final;
 
   int dl_ant_info(uint16_t rnti, asn1::rrc::phys_cfg_ded_s::ant_info_c_* dedicated);
+  int ue_sps_cfg(uint16_t rnti, const srslte::sps_cfg_t& sps_cfg);
   int dl_ack_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t tb_idx, bool ack) final;
   int dl_rach_info(uint32_t cc_idx, dl_sched_rar_info_t rar_info) final;
   int dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t ri_value) final;
@@ -139,6 +147,7 @@ public:
   int dl_cqi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t cqi_value) final;
 
   int ul_crc_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, bool crc) final;
+  int ul_sdu_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_sdus) final;
   int ul_sr_info(uint32_t tti, uint16_t rnti) override;
   int ul_bsr(uint16_t rnti, uint32_t lcid, uint32_t bsr, bool set_value = true) final;
   int ul_recv_len(uint16_t rnti, uint32_t lcid, uint32_t len) final;
@@ -183,13 +192,21 @@ protected:
 
   // Helper methods
   template <typename Func>
-  int ue_db_access(uint16_t rnti, Func);
+  int  ue_db_access(uint16_t rnti, Func);
+  void generate_tti_results(uint32_t tti_rx);
 
-  std::map<uint16_t, sched_ue> ue_db;
+  sched_ue_db ue_db;
 
   // independent schedulers for each carrier
   std::vector<std::unique_ptr<carrier_sched> > carrier_schedulers;
 
+  // threads running the SCell scheduling passes of a TTI while the calling thread runs the PCell one
+  std::unique_ptr<srslte::task_thread_pool> carrier_workers;
+  std::mutex                                tti_mutex; ///< serializes the generation of the TTIs of all carriers
+  std::mutex                                carrier_workers_mutex;
+  std::condition_variable                   carrier_workers_cvar;
+  uint32_t                                  nof_pending_carriers = 0;
+
   std::array<uint32_t, 10> pdsch_re;
   uint32_t                 current_tti;
 
@@ -32,7 +32,7 @@ class ra_sched;
 class sched::carrier_sched
 {
 public:
-  explicit carrier_sched(rrc_interface_mac* rrc_, std::map<uint16_t, sched_ue>* ue_db_, uint32_t enb_cc_idx_);
+  explicit carrier_sched(rrc_interface_mac* rrc_, sched_ue_db* ue_db_, uint32_t enb_cc_idx_);
   void                reset();
   void                carrier_cfg(const sched_params_t& sched_params_);
   void                set_metric(sched::metric_dl* dl_metric_, sched::metric_ul* ul_metric_);
@@ -53,15 +53,18 @@ private:
   void alloc_dl_users(tti_sched_result_t* tti_result);
   //! Compute UL scheduler result for given TTI
   int alloc_ul_users(tti_sched_result_t* tti_sched);
+  //! Allocate the configured SPS grants, and their activations and releases
+  void alloc_dl_sps(tti_sched_result_t* tti_result);
+  void alloc_ul_sps(tti_sched_result_t* tti_sched);
 
   // args
-  const sched_params_t*         sched_params = nullptr;
-  srslte::log*                  log_h        = nullptr;
-  rrc_interface_mac*            rrc          = nullptr;
-  std::map<uint16_t, sched_ue>* ue_db        = nullptr;
-  metric_dl*                    dl_metric    = nullptr;
-  metric_ul*                    ul_metric    = nullptr;
-  const uint32_t                enb_cc_idx;
+  const sched_params_t* sched_params = nullptr;
+  srslte::log*          log_h        = nullptr;
+  rrc_interface_mac*    rrc          = nullptr;
+  sched_ue_db*          ue_db        = nullptr;
+  metric_dl*            dl_metric    = nullptr;
+  metric_ul*            ul_metric    = nullptr;
+  const uint32_t        enb_cc_idx;
 
   // derived from args
   prbmask_t prach_mask;
@@ -125,7 +128,7 @@ public:
     uint32_t mcs     = 0;
   };
 
-  explicit ra_sched(const sched::cell_cfg_t& cfg_, srslte::log* log_, std::map<uint16_t, sched_ue>& ue_db_);
+  explicit ra_sched(const sched::cell_cfg_t& cfg_, srslte::log* log_, sched_ue_db& ue_db_);
   void                  dl_sched(tti_sched_result_t* tti_sched);
   void                  ul_sched(tti_sched_result_t* tti_sched);
   int                   dl_rach_info(dl_sched_rar_info_t rar_info);
@@ -134,9 +137,9 @@ public:
 
 private:
   // args
-  srslte::log*                  log_h = nullptr;
-  const sched::cell_cfg_t*      cfg   = nullptr;
-  std::map<uint16_t, sched_ue>* ue_db = nullptr;
+  srslte::log*             log_h = nullptr;
+  const sched::cell_cfg_t* cfg   = nullptr;
+  sched_ue_db*             ue_db = nullptr;
 
   std::queue<dl_sched_rar_info_t>       pending_rars;
   std::array<pending_msg3_t, TTIMOD_SZ> pending_msg3;
@@ -55,6 +55,8 @@ struct tti_params_t {
 };
 
 //! Class responsible for managing a PDCCH CCE grid, namely cce allocs, and avoid collisions.
+//! New DCIs are placed greedily in the first free candidate of their search space. When that fails, the previous DCIs
+//! are relocated through a depth-first search bounded by a per-TTI budget of search nodes.
 class pdcch_grid_t
 {
 public:
@@ -62,10 +64,13 @@ public:
     uint16_t              rnti    = 0;
     srslte_dci_location_t dci_pos = {0, 0};
     pdcch_mask_t          current_mask; ///< this PDCCH alloc mask
-    pdcch_mask_t          total_mask;   ///< Accumulation of all PDCCH masks for the current solution (tree route)
+    pdcch_mask_t          total_mask;   ///< Accumulation of the PDCCH masks of this and all previous allocs
   };
   using alloc_result_t = std::vector<const alloc_t*>;
 
+  //! Max number of DCI relocations attempted per TTI when the greedy placement of a new DCI fails
+  const static uint32_t max_search_nodes = 512;
+
   void init(const sched_params_t& sched_params);
   void new_tti(const tti_params_t& tti_params_, uint32_t start_cfi);
   bool alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sched_ue* user = nullptr);
@@ -73,34 +78,39 @@ public:
 
   // getters
   uint32_t    get_cfi() const { return current_cfix + 1; }
-  void        get_allocs(alloc_result_t* vec = nullptr, pdcch_mask_t* tot_mask = nullptr, size_t idx = 0) const;
+  void        get_allocs(alloc_result_t* vec = nullptr, pdcch_mask_t* tot_mask = nullptr) const;
   uint32_t    nof_cces() const;
-  size_t      nof_allocs() const { return nof_dci_allocs; }
-  size_t      nof_alloc_combinations() const { return prev_end - prev_start; }
+  size_t      nof_allocs() const { return alloc_list.size(); }
+  uint32_t    nof_search_nodes() const { return search_nodes; }
   std::string result_to_string(bool verbose = false) const;
 
 private:
   const static uint32_t nof_cfis = 3;
-  using tree_node_t = std::pair<int, alloc_t>; ///< First represents the parent node idx, and second the alloc tree node
+  struct alloc_record_t {
+    alloc_type_t                     alloc_type = alloc_type_t::DL_DATA;
+    uint32_t                         aggr_idx   = 0;
+    sched_ue*                        user       = nullptr;
+    const sched_ue::sched_dci_cce_t* dci_locs   = nullptr;
+    uint32_t                         loc_idx    = 0; ///< index of the selected candidate in dci_locs
+  };
 
   void                             reset();
   const sched_ue::sched_dci_cce_t* get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user) const;
-  void                             update_alloc_tree(int                              node_idx,
-                                                     uint32_t                         aggr_idx,
-                                                     sched_ue*                        user,
-                                                     alloc_type_t                     alloc_type,
-                                                     const sched_ue::sched_dci_cce_t* dci_locs);
+  bool                             place_dci(size_t idx, uint32_t first_loc_idx);
+  bool                             relocate_dcis();
 
   // consts
   const sched_params_t* sched_params = nullptr;
   srslte::log*          log_h        = nullptr;
 
   // tti vars
-  const tti_params_t*      tti_params   = nullptr;
-  uint32_t                 current_cfix = 0;
-  size_t                   prev_start = 0, prev_end = 0;
-  std::vector<tree_node_t> dci_alloc_tree;
-  size_t                   nof_dci_allocs = 0;
+  const tti_params_t*         tti_params   = nullptr;
+  uint32_t                    current_cfix = 0;
+  uint32_t                    search_nodes = 0;
+  std::vector<alloc_t>        alloc_list;
+  std::vector<alloc_record_t> record_list;
+  std::vector<alloc_t>        saved_alloc_list;
+  std::vector<uint32_t>       saved_loc_idxs;
 };
 
 //! manages a full TTI grid resources, namely CCE and DL/UL RB allocations
@@ -116,6 +126,8 @@ public:
   void            new_tti(const tti_params_t& tti_params_, uint32_t start_cfi);
   dl_ctrl_alloc_t alloc_dl_ctrl(uint32_t aggr_lvl, alloc_type_t alloc_type);
   alloc_outcome_t alloc_dl_data(sched_ue* user, const rbgmask_t& user_mask);
+  alloc_outcome_t alloc_dl_data(sched_ue* user, const rbgmask_t& user_mask, srslte_dci_format_t dci_format);
+  alloc_outcome_t reserve_dl_rbgs(const rbgmask_t& alloc_mask);
   alloc_outcome_t alloc_ul_data(sched_ue* user, ul_harq_proc::ul_alloc_t alloc, bool needs_pdcch);
 
   // getters
@@ -194,13 +206,16 @@ public:
     explicit bc_alloc_t(const ctrl_alloc_t& c) : ctrl_alloc_t(c) {}
   };
   struct dl_alloc_t {
+    enum type_t { DATA, SPS_ACTIVATION, SPS_TX, SPS_RELEASE };
     size_t    dci_idx;
+    type_t    type = DATA;
     sched_ue* user_ptr;
     rbgmask_t user_mask;
     uint32_t  pid;
+    bool      needs_pdcch() const { return type != SPS_TX; }
   };
   struct ul_alloc_t {
-    enum type_t { NEWTX, NOADAPT_RETX, ADAPT_RETX, MSG3 };
+    enum type_t { NEWTX, NOADAPT_RETX, ADAPT_RETX, MSG3, SPS_ACTIVATION, SPS_TX };
     size_t                   dci_idx;
     type_t                   type;
     sched_ue*                user_ptr;
@@ -208,7 +223,11 @@ public:
     uint32_t                 mcs = 0;
     bool                     is_retx() const { return type == NOADAPT_RETX or type == ADAPT_RETX; }
     bool                     is_msg3() const { return type == MSG3; }
-    bool                     needs_pdcch() const { return type == NEWTX or type == ADAPT_RETX; }
+    bool                     is_sps() const { return type == SPS_ACTIVATION or type == SPS_TX; }
+    bool                     needs_pdcch() const
+    {
+      return type == NEWTX or type == ADAPT_RETX or type == SPS_ACTIVATION;
+    }
   };
   typedef std::pair<alloc_outcome_t, const rar_alloc_t*> rar_code_t;
   typedef std::pair<alloc_outcome_t, const ctrl_alloc_t> ctrl_code_t;
@@ -233,6 +252,9 @@ public:
   // ul_tti_sched itf
   alloc_outcome_t  alloc_ul_user(sched_ue* user, ul_harq_proc::ul_alloc_t alloc) final;
   alloc_outcome_t  alloc_ul_msg3(sched_ue* user, ul_harq_proc::ul_alloc_t alloc, uint32_t mcs);
+  // semi-persistent scheduling
+  alloc_outcome_t alloc_dl_sps(sched_ue* user, const rbgmask_t& user_mask, uint32_t pid, dl_alloc_t::type_t type);
+  alloc_outcome_t alloc_ul_sps(sched_ue* user, ul_harq_proc::ul_alloc_t alloc, uint32_t mcs, bool activation);
   const prbmask_t& get_ul_mask() const final { return tti_alloc.get_ul_mask(); }
   uint32_t         get_tti_tx_ul() const final { return tti_params.tti_tx_ul; }
 
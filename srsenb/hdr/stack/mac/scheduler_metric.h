@@ -32,32 +32,65 @@ class dl_metric_rr : public sched::metric_dl
 
 public:
   void set_params(const sched_params_t& sched_params_) final;
-  void sched_users(std::map<uint16_t, sched_ue>& ue_db, dl_tti_sched_t* tti_sched, uint32_t cc_idx) final;
+  void sched_users(sched_ue_db& ue_db, dl_tti_sched_t* tti_sched, uint32_t cc_idx) override;
 
-private:
+protected:
   bool          find_allocation(uint32_t nof_rbg, rbgmask_t* rbgmask);
+  dl_harq_proc* get_pending_dl_harq(sched_ue* user, uint32_t tti_dl, uint32_t cell_idx);
   dl_harq_proc* allocate_user(sched_ue* user, uint32_t cc_idx);
 
-  srslte::log*    log_h     = nullptr;
-  dl_tti_sched_t* tti_alloc = nullptr;
+  srslte::log*    log_h         = nullptr;
+  dl_tti_sched_t* tti_alloc     = nullptr;
+  uint32_t        tti_lookahead = 0;
 };
 
 class ul_metric_rr : public sched::metric_ul
 {
 public:
   void set_params(const sched_params_t& sched_params_) final;
-  void sched_users(std::map<uint16_t, sched_ue>& ue_db, ul_tti_sched_t* tti_sched, uint32_t cc_idx) final;
+  void sched_users(sched_ue_db& ue_db, ul_tti_sched_t* tti_sched, uint32_t cc_idx) override;
 
-private:
+protected:
   bool          find_allocation(uint32_t L, ul_harq_proc::ul_alloc_t* alloc);
   ul_harq_proc* allocate_user_newtx_prbs(sched_ue* user, uint32_t cc_idx);
   ul_harq_proc* allocate_user_retx_prbs(sched_ue* user, uint32_t cc_idx);
 
-  srslte::log*    log_h     = nullptr;
-  ul_tti_sched_t* tti_alloc = nullptr;
+  srslte::log*    log_h         = nullptr;
+  ul_tti_sched_t* tti_alloc     = nullptr;
+  uint32_t        tti_lookahead = 0;
   uint32_t        current_tti;
 };
 
+/// Users sorted by the slack to the packet delay budget of their most urgent bearer
+struct sched_deadline_t {
+  sched_ue* user;
+  int       slack_ms;
+  uint32_t  rr_idx; ///< position in the round-robin order, used to break ties
+  bool      retx;
+};
+
+/**
+ * Earliest-deadline-first metrics. Users are served in increasing order of slack, i.e. time left before the oldest
+ * pending data of any of their bearers exceeds the bearer delay budget. The RR allocation of resources is kept.
+ */
+class dl_metric_edf final : public dl_metric_rr
+{
+public:
+  void sched_users(sched_ue_db& ue_db, dl_tti_sched_t* tti_sched, uint32_t cc_idx) final;
+
+private:
+  std::vector<sched_deadline_t> ue_order;
+};
+
+class ul_metric_edf final : public ul_metric_rr
+{
+public:
+  void sched_users(sched_ue_db& ue_db, ul_tti_sched_t* tti_sched, uint32_t cc_idx) final;
+
+private:
+  std::vector<sched_deadline_t> ue_order;
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_SCHEDULER_METRIC_H
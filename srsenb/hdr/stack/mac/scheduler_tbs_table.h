@@ -0,0 +1,96 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_SCHEDULER_TBS_TABLE_H
+#define SRSENB_SCHEDULER_TBS_TABLE_H
+
+#include "srslte/phy/common/phy_common.h"
+#include <vector>
+
+namespace srsenb {
+
+/**
+ * Lookup tables of the TBS and MCS that the scheduler selects for a given CQI and number of PRBs, when no limit in the
+ * number of bytes is imposed. The tables are computed once per cell configuration with the cell maximum MCS, and
+ * replace the search of the MCS (sched_ue::cqi_to_tbs) in the loops that look for the number of PRBs required to
+ * transmit a given number of bytes.
+ *
+ * The DL tables assume the approximate number of REs of srslte_ra_dl_approx_nof_re(), one for each number of control
+ * symbols. The UL tables assume a PUSCH without SRS.
+ *
+ * The required number of PRBs is found through a binary search over the running maximum of the TBS, which is
+ * monotonic in the number of PRBs and returns the same result as the linear search.
+ */
+class sched_tbs_table
+{
+public:
+  const static uint32_t MAX_CQI          = 15;
+  const static uint32_t MAX_CTRL_SYMBOLS = 4;
+
+  void init(const srslte_cell_t& cell_, int max_mcs_dl_, int max_mcs_ul_);
+
+  //! Returns true if the table can be used for a user with the given CQI and maximum MCS
+  bool is_valid_dl(uint32_t cqi, uint32_t max_mcs, uint32_t nof_ctrl_symbols) const;
+  bool is_valid_ul(uint32_t cqi, uint32_t max_mcs) const;
+
+  //! TBS in bytes for 1 <= nof_prb <= cell.nof_prb. Equivalent to sched_ue_carrier::alloc_tbs() with req_bytes=0
+  int get_tbs_dl(uint32_t cqi, uint32_t nof_prb, uint32_t nof_ctrl_symbols, int* mcs = nullptr) const;
+  int get_tbs_ul(uint32_t cqi, uint32_t nof_prb, int* mcs = nullptr) const;
+
+  /**
+   * Minimum number of PRBs, within [1, max_prb], whose TBS fits req_bytes. Returns max_prb if req_bytes does not fit in
+   * max_prb PRBs.
+   */
+  uint32_t get_required_prb_dl(uint32_t cqi, uint32_t nof_ctrl_symbols, uint32_t req_bytes, uint32_t max_prb) const;
+  uint32_t get_required_prb_ul(uint32_t cqi, uint32_t req_bytes, uint32_t max_prb) const;
+
+private:
+  struct tbs_entry_t {
+    int tbs_bytes; ///< TBS (in bytes) for the given number of PRBs
+    int mcs;
+    int max_tbs_bytes; ///< Maximum TBS (in bytes) up to the given number of PRBs
+  };
+
+  bool     fill_row(tbs_entry_t* row, uint32_t cqi, uint32_t nof_ctrl_symbols, bool is_ul);
+  uint32_t find_prb(const tbs_entry_t* row, uint32_t req_bytes, uint32_t max_prb) const;
+
+  size_t dl_row_idx(uint32_t cqi, uint32_t nof_ctrl_symbols) const
+  {
+    return (nof_ctrl_symbols - 1) * (MAX_CQI + 1) + cqi;
+  }
+  const tbs_entry_t* dl_row(uint32_t cqi, uint32_t nof_ctrl_symbols) const
+  {
+    return &dl_table[dl_row_idx(cqi, nof_ctrl_symbols) * cell.nof_prb];
+  }
+  const tbs_entry_t* ul_row(uint32_t cqi) const { return &ul_table[cqi * cell.nof_prb]; }
+
+  srslte_cell_t            cell       = {};
+  uint32_t                 max_mcs_dl = 0;
+  uint32_t                 max_mcs_ul = 0;
+  std::vector<tbs_entry_t> dl_table; ///< [nof_ctrl_symbols][cqi][nof_prb]
+  std::vector<tbs_entry_t> ul_table; ///< [cqi][nof_prb]
+  std::vector<bool>        dl_valid; ///< false for the rows with an invalid TBS, which use the non-tabulated search
+  std::vector<bool>        ul_valid;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_SCHEDULER_TBS_TABLE_H
@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "scheduler_harq.h"
+#include "scheduler_tbs_table.h"
 #include "srslte/asn1/rrc_asn1.h"
 #include <mutex>
 
@@ -43,6 +44,7 @@ struct sched_ue_carrier {
                    srslte_cell_t*             cell_cfg_,
                    uint16_t                   rnti_,
                    uint32_t                   cc_idx_,
+                   const sched_tbs_table*     tbs_table_,
                    srslte::log*               log_);
   void reset();
 
@@ -76,14 +78,56 @@ struct sched_ue_carrier {
   uint32_t max_aggr_level = 3;
   int      fixed_mcs_ul = 0, fixed_mcs_dl = 0;
 
+  // share of the UE pending new data this carrier may allocate in the current TTI, when the UE has several carriers
+  uint32_t dl_data_quota = 0;
+  uint32_t ul_data_quota = 0;
+
 private:
-  srslte::log*               log_h = nullptr;
-  sched_interface::ue_cfg_t* cfg   = nullptr;
-  srslte_cell_t*             cell  = nullptr;
+  srslte::log*               log_h     = nullptr;
+  sched_interface::ue_cfg_t* cfg       = nullptr;
+  srslte_cell_t*             cell      = nullptr;
+  const sched_tbs_table*     tbs_table = nullptr;
   uint32_t                   cc_idx;
   uint16_t                   rnti;
 };
 
+//! Configured grant of the semi-persistent scheduling of a UE, in one direction
+struct sched_sps_grant_t {
+  bool                     active    = false;
+  bool                     release   = false; ///< the grant must be released with a PDCCH (DL only)
+  uint32_t                 start_tti = 0;     ///< TTI of the transmission of the activation DCI
+  uint32_t                 mcs       = 0;
+  uint32_t                 nof_empty = 0; ///< consecutive occasions without new data
+  rbgmask_t                rbgmask;       ///< DL resources of the grant
+  ul_harq_proc::ul_alloc_t alloc = {};    ///< UL resources of the grant
+
+  bool is_occasion(uint32_t tti, uint32_t interval) const
+  {
+    return active and interval > 0 and srslte_tti_interval(tti, start_tti) % interval == 0;
+  }
+  void reset()
+  {
+    active    = false;
+    release   = false;
+    nof_empty = 0;
+  }
+};
+
+//! UL grants given periodically to a UE with latency-critical bearers, without waiting for a SR or BSR (PCell only)
+struct sched_proactive_ul_t {
+  uint32_t                 cfg_period_ms  = 0;  ///< smallest configured period of the UL bearers, 0 if disabled
+  uint32_t                 period_ms      = 0;  ///< period adapted to the observed UL traffic
+  uint32_t                 ref_tti        = 0;  ///< tti_tx_ul of the last proactive grant or UL data burst
+  int                      last_burst_tti = -1; ///< tti_tx_ul the last UL data burst was detected, -1 if none yet
+  bool                     new_burst      = false;
+  bool                     data_reported  = false; ///< UL data was reported since the last grants were accounted
+  uint32_t                 nof_unused     = 0;     ///< consecutive proactive grants without UL data
+  std::array<uint32_t, 16> grant_prb      = {};    ///< PRBs of the grants not accounted yet, by tti_tx_ul % 16
+  std::array<uint32_t, 16> grant_tti      = {};
+  uint32_t                 used_prb       = 0;
+  uint32_t                 wasted_prb     = 0;
+};
+
 /** This class is designed to be thread-safe because it is called from workers through scheduler thread and from
  * higher layers and mac threads.
  *
@@ -120,12 +164,15 @@ public:
   void mac_buffer_state(uint32_t ce_code);
   void ul_recv_len(uint32_t lcid, uint32_t len);
   void set_dl_ant_info(asn1::rrc::phys_cfg_ded_s::ant_info_c_* dedicated);
+  void set_sps_cfg(const srslte::sps_cfg_t& sps_cfg);
   void set_ul_cqi(uint32_t tti, uint32_t cc_idx, uint32_t cqi, uint32_t ul_ch_code);
   void set_dl_ri(uint32_t tti, uint32_t cc_idx, uint32_t ri);
   void set_dl_pmi(uint32_t tti, uint32_t cc_idx, uint32_t ri);
   void set_dl_cqi(uint32_t tti, uint32_t cc_idx, uint32_t cqi);
   int  set_ack_info(uint32_t tti, uint32_t cc_idx, uint32_t tb_idx, bool ack);
   void set_ul_crc(uint32_t tti, uint32_t cc_idx, bool crc_res);
+  void set_ul_sdu_info(uint32_t tti, uint32_t cc_idx, uint32_t nof_sdus);
+  bool is_ul_harq_active(uint32_t tti, uint32_t cc_idx);
 
   /*******************************************************
    * Custom functions
@@ -153,8 +200,12 @@ public:
 
   uint32_t get_pending_dl_new_data();
   uint32_t get_pending_ul_new_data(uint32_t tti);
+  uint32_t get_pending_ul_new_data(uint32_t tti, uint32_t cc_idx);
   uint32_t get_pending_ul_old_data(uint32_t cc_idx);
   uint32_t get_pending_dl_new_data_total();
+  uint32_t get_pending_dl_new_data_total(uint32_t cc_idx);
+  int      get_dl_slack_ms(uint32_t tti_tx_dl) const;
+  int      get_ul_slack_ms(uint32_t tti_tx_ul) const;
 
   void          reset_pending_pids(uint32_t tti_rx, uint32_t cc_idx);
   dl_harq_proc* get_pending_dl_harq(uint32_t tti, uint32_t cc_idx);
@@ -171,6 +222,8 @@ public:
    * Functions used by the scheduler object
    *******************************************************/
 
+  void new_tti(const tti_params_t& tti_params);
+
   void set_sr();
   void unset_sr();
 
@@ -200,7 +253,42 @@ public:
                        ul_harq_proc::ul_alloc_t          alloc,
                        bool                              needs_pdcch,
                        srslte_dci_location_t             cce_range,
-                       int                               explicit_mcs = -1);
+                       int                               explicit_mcs = -1,
+                       bool                              is_sps       = false);
+  int generate_sps_format1(dl_harq_proc*                     h,
+                           sched_interface::dl_sched_data_t* data,
+                           uint32_t                          tti,
+                           uint32_t                          cc_idx,
+                           uint32_t                          cfi,
+                           const rbgmask_t&                  user_mask,
+                           bool                              activation);
+  int generate_sps_release(sched_interface::dl_sched_data_t* data);
+
+  /*******************************************************
+   * Semi-persistent scheduling, in the PCell only
+   *******************************************************/
+
+  const static uint32_t SPS_MAX_GRANT_BYTES = 128; ///< SPS grants are sized for small periodic packets, e.g. VoIP
+  const static uint32_t SPS_DL_MAX_EMPTY    = 8;   ///< empty DL occasions after which the grant is released
+
+  const srslte::sps_cfg_t& get_sps_cfg() const { return cfg.sps_cfg; }
+  bool                     can_activate_sps() const { return phy_config_dedicated_enabled; }
+  sched_sps_grant_t&       get_sps_dl_grant() { return sps_dl; }
+  sched_sps_grant_t&       get_sps_ul_grant() { return sps_ul; }
+  uint32_t                 get_sps_dl_pid(uint32_t tti_tx_dl) const;
+  bool                     is_sps_dl_harq(const dl_harq_proc* h, uint32_t cc_idx) const;
+  uint32_t                 get_required_prb_sps(uint32_t req_bytes, bool is_ul, uint32_t* mcs);
+  uint32_t                 get_pending_ul_bsr();
+
+  /*******************************************************
+   * Proactive UL grants, in the PCell only
+   *******************************************************/
+
+  const static uint32_t PROACTIVE_UL_BYTES             = 64; ///< room for a BSR and a small packet
+  const static uint32_t PROACTIVE_UL_MAX_UNUSED        = 8;  ///< unused grants after which they are released
+  const static uint32_t PROACTIVE_UL_MAX_PERIOD_FACTOR = 8;  ///< max adapted period, in configured periods
+
+  void read_proactive_ul_prb(uint32_t* used_prb, uint32_t* wasted_prb);
 
   srslte_dci_format_t get_dci_format();
   sched_dci_cce_t*    get_locations(uint32_t current_cfi, uint32_t sf_idx);
@@ -226,21 +314,32 @@ private:
     int                              buf_tx;
     int                              buf_retx;
     int                              bsr;
+    int                              dl_hol_tti; ///< tti_tx_dl the oldest pending DL data was enqueued, -1 if none
+    int                              ul_hol_tti; ///< tti_tx_ul the oldest pending UL data was reported, -1 if none
   } ue_bearer_t;
 
-  bool is_sr_triggered();
+  const static int      DEFAULT_DELAY_BUDGET_MS = 300;
+  const static uint32_t MIN_CARRIER_SHARE_BYTES = 128; ///< below this share per carrier, new data stays in the PCell
+  const static uint32_t SPS_MAX_MCS             = 15;  ///< MSB of the MCS field of SPS activation DCIs must be 0
+  const static uint32_t PROACTIVE_UL_REPORT_MS  = 12;  ///< the PUSCH is received 8 TTIs after the grant, plus margin
+
+  bool is_sr_triggered() const;
   int  alloc_pdu(int tbs, sched_interface::dl_sched_pdu_t* pdu);
 
   uint32_t format1_count_prb(const rbgmask_t& bitmask);
 
-  static bool bearer_is_ul(ue_bearer_t* lch);
+  static bool bearer_is_ul(const ue_bearer_t* lch);
   static bool bearer_is_dl(const ue_bearer_t* lch);
 
   uint32_t get_pending_dl_new_data_unlocked();
   uint32_t get_pending_ul_old_data_unlocked(uint32_t cc_idx);
   uint32_t get_pending_ul_new_data_unlocked(uint32_t tti);
+  uint32_t get_pending_ul_new_data_unlocked(uint32_t tti, uint32_t cc_idx);
   uint32_t get_pending_dl_new_data_total_unlocked();
+  uint32_t get_carrier_share(uint32_t data, uint32_t cc_idx) const;
   bool     is_conres_ce_pending() const;
+  int      get_bearer_slack_ms(const ue_bearer_t* b, int hol_tti, uint32_t tti) const;
+  void     update_hol_ttis();
 
   bool needs_cqi_unlocked(uint32_t tti, uint32_t cc_idx, bool will_send = false);
 
@@ -252,6 +351,14 @@ private:
                                  const rbgmask_t&                  user_mask);
 
   bool is_first_dl_tx();
+  bool compute_first_dl_tx() const;
+
+  uint32_t get_sps_mcs_unlocked(bool is_ul);
+
+  uint32_t get_pending_ul_bsr_unlocked();
+  bool     is_proactive_ul_due(uint32_t tti_tx_ul);
+  void     update_proactive_ul(uint32_t tti_tx_ul);
+  void     update_proactive_ul_cfg();
 
   /* Args */
   sched_interface::ue_cfg_t cfg          = {};
@@ -259,7 +366,7 @@ private:
   srslte::log*              log_h        = nullptr;
   const sched_params_t*     sched_params = nullptr;
 
-  std::mutex mutex;
+  mutable std::mutex mutex;
 
   /* Buffer states */
   bool                                             sr      = false;
@@ -271,15 +378,25 @@ private:
   uint32_t cqi_request_tti = 0;
   uint16_t rnti            = 0;
   uint32_t max_msg3retx    = 0;
+  int      next_tti_rx     = -1; ///< tti_rx of the next TTI to schedule, to timestamp new data. -1 before the first
 
   /* User State */
   bool conres_ce_pending = true;
+  bool first_dl_tx       = true; ///< is_first_dl_tx() before the carrier passes of the TTI, if there are several
 
   uint32_t nof_ta_cmd = 0;
 
   int next_tpc_pusch = 0;
   int next_tpc_pucch = 0;
 
+  // Semi-persistent scheduling state. The UL HARQ processes are synchronous, so the ones of configured grants are
+  // tracked with a mask of pids
+  sched_sps_grant_t sps_dl;
+  sched_sps_grant_t sps_ul;
+  uint32_t          sps_ul_pids = 0;
+
+  sched_proactive_ul_t proactive_ul;
+
   // Allowed DCI locations per CFI and per subframe
   std::array<std::array<sched_dci_cce_t, 10>, 3> dci_locations = {};
 
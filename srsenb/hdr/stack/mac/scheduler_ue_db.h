@@ -0,0 +1,119 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_SCHEDULER_UE_DB_H
+#define SRSENB_SCHEDULER_UE_DB_H
+
+#include "scheduler_ue.h"
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace srsenb {
+
+/**
+ * Container of the scheduler users, indexed by RNTI.
+ *
+ * The sched_ue objects live in a pool of slots that are allocated in chunks and never move. The RNTIs and pointers of
+ * the active users are kept in dense arrays, so the metrics can iterate them, or start from any position, without
+ * walking tree nodes. The dense position of a RNTI is found through an open-addressing (linear probing) index.
+ * Removing a user moves the last user of the dense arrays to its position.
+ *
+ * Like the std::map it replaces, the container is not thread-safe. Additions and removals must be protected by the
+ * owner of the container.
+ */
+class sched_ue_db
+{
+public:
+  class iterator
+  {
+  public:
+    explicit iterator(std::vector<sched_ue*>::const_iterator it_) : it(it_) {}
+    sched_ue& operator*() const { return **it; }
+    sched_ue* operator->() const { return *it; }
+    bool      operator==(const iterator& other) const { return it == other.it; }
+    bool      operator!=(const iterator& other) const { return it != other.it; }
+    iterator& operator++()
+    {
+      ++it;
+      return *this;
+    }
+
+  private:
+    std::vector<sched_ue*>::const_iterator it;
+  };
+
+  sched_ue_db() = default;
+  ~sched_ue_db();
+  sched_ue_db(const sched_ue_db&) = delete;
+  sched_ue_db& operator=(const sched_ue_db&) = delete;
+
+  //! Returns the user with the given RNTI, adding it if it does not exist
+  sched_ue& operator[](uint16_t rnti);
+  sched_ue* find(uint16_t rnti);
+  size_t    count(uint16_t rnti) const { return find_index(rnti) < 0 ? 0 : 1; }
+  bool      erase(uint16_t rnti);
+  void      clear();
+
+  size_t size() const { return users.size(); }
+  bool   empty() const { return users.empty(); }
+
+  //! Access by position in the dense array of active users, with 0 <= idx < size()
+  sched_ue& at(uint32_t idx) { return *users[idx]; }
+  uint16_t  rnti_at(uint32_t idx) const { return rntis[idx]; }
+
+  iterator begin() const { return iterator(users.begin()); }
+  iterator end() const { return iterator(users.end()); }
+
+private:
+  const static uint32_t SLOTS_PER_CHUNK = 64;
+  const static uint32_t INVALID_POS     = std::numeric_limits<uint32_t>::max();
+
+  typedef std::aligned_storage<sizeof(sched_ue), alignof(sched_ue)>::type slot_t;
+
+  struct index_entry_t {
+    uint16_t rnti;
+    uint32_t pos; ///< position in the dense arrays, INVALID_POS if the entry is empty
+  };
+
+  int       find_index(uint16_t rnti) const;
+  void      insert_index(uint16_t rnti, uint32_t pos);
+  void      erase_index(uint32_t entry);
+  void      resize_index(size_t nof_entries);
+  sched_ue* alloc_slot(uint32_t* slot_id);
+
+  // Dense arrays of active users
+  std::vector<uint16_t>  rntis;
+  std::vector<sched_ue*> users;
+  std::vector<uint32_t>  user_slots;
+
+  // RNTI -> dense position. Its size is a power of two, at least twice the number of users
+  std::vector<index_entry_t> index;
+
+  // Storage of the sched_ue objects
+  std::vector<std::unique_ptr<slot_t[]> > chunks;
+  std::vector<uint32_t>                   free_slots;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_SCHEDULER_UE_DB_H
@@ -30,6 +30,8 @@
 #include "srslte/common/pdu_queue.h"
 #include "srslte/interfaces/enb_interfaces.h"
 #include "srslte/interfaces/sched_interface.h"
+#include <atomic>
+#include <mutex>
 #include <pthread.h>
 #include <vector>
 
@@ -38,14 +40,15 @@ namespace srsenb {
 class ue : public srslte::read_pdu_interface, public srslte::pdu_queue::process_callback
 {
 public:
-  ue(uint16_t           rnti,
-     uint32_t           nof_prb,
-     sched_interface*   sched,
-     rrc_interface_mac* rrc_,
-     rlc_interface_mac* rlc,
-     srslte::log*       log_,
-     uint32_t           nof_rx_harq_proc = SRSLTE_FDD_NOF_HARQ,
-     uint32_t           nof_tx_harq_proc = SRSLTE_FDD_NOF_HARQ * SRSLTE_MAX_TB);
+  ue(uint16_t                     rnti,
+     uint32_t                     nof_prb,
+     sched_interface*             sched,
+     rrc_interface_mac*           rrc_,
+     rlc_interface_mac*           rlc,
+     srslte::log*                 log_,
+     uint32_t                     nof_rx_harq_proc = SRSLTE_FDD_NOF_HARQ,
+     uint32_t                     nof_tx_harq_proc = SRSLTE_FDD_NOF_HARQ * SRSLTE_MAX_TB,
+     srslte_softbuffer_rx_pool_t* rx_pool          = nullptr);
   virtual ~ue();
 
   void reset();
@@ -74,7 +77,7 @@ public:
   srslte_softbuffer_rx_t* get_rx_softbuffer(uint32_t tti);
 
   bool     process_pdus();
-  uint8_t* request_buffer(uint32_t tti, uint32_t len);
+  uint8_t* request_buffer(uint32_t tti, uint32_t len, bool is_sps = false);
   void     process_pdu(uint8_t* pdu, uint32_t nof_bytes, srslte::pdu_queue::channel_t channel);
   void     push_pdu(uint32_t tti, uint32_t len);
   void     deallocate_pdu(uint32_t tti);
@@ -125,6 +128,15 @@ private:
   std::vector<srslte_softbuffer_tx_t> softbuffer_tx;
   std::vector<srslte_softbuffer_rx_t> softbuffer_rx;
   std::vector<uint8_t*>               pending_buffers;
+  std::vector<std::atomic<bool> >     pending_sps; // Buffers of PUSCHs in a configured (SPS) UL grant
+
+  // SPS PDUs pushed and not processed yet. Their MAC SDUs are counted for the implicit release of the UL grant
+  struct sps_pdu_t {
+    uint8_t* pdu;
+    uint32_t tti;
+  };
+  std::mutex             sps_pdus_mutex;
+  std::vector<sps_pdu_t> sps_pdus;
 
   // For DL there are two buffers, one for each Transport block
   srslte::byte_buffer_t tx_payload_buffer[SRSLTE_FDD_NOF_HARQ][SRSLTE_MAX_TB];
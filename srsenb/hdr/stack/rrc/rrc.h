@@ -64,6 +64,8 @@ typedef struct {
   asn1::rrc::lc_ch_cfg_s::ul_specific_params_s_ lc_cfg;
   asn1::rrc::pdcp_cfg_s                         pdcp_cfg;
   asn1::rrc::rlc_cfg_c                          rlc_cfg;
+  uint32_t                                      proactive_ul_period_ms; ///< 0 if the UL grants wait for SR/BSR
+  asn1::rrc::sps_cfg_s                          sps_cfg;                ///< C-RNTI and n1PUCCH-AN set per UE
 } rrc_cfg_qci_t;
 
 //! Cell to measure for HO. Filled by cfg file parser.
@@ -266,6 +268,10 @@ public:
     void cqi_get(uint16_t* pmi_idx, uint16_t* n_pucch);
     int  cqi_free();
 
+    int  sps_allocate(uint16_t* sps_rnti, uint16_t* n1_pucch_an);
+    int  sps_free();
+    void sps_add(uint32_t qci, asn1::rrc::rr_cfg_ded_s* rr_cfg);
+
     int ri_get(uint32_t m_ri, uint16_t* ri_idx);
 
     bool select_security_algorithms();
@@ -337,6 +343,8 @@ public:
     bool                      cqi_allocated     = false;
     int                       cqi_sched_sf_idx  = 0;
     int                       cqi_sched_prb_idx = 0;
+    bool                      sps_allocated     = false;
+    uint32_t                  sps_idx           = 0;
     int                       get_drbid_config(asn1::rrc::drb_to_add_mod_s* drb, int drbid);
     bool                      nas_pending = false;
     srslte::byte_buffer_t     erab_info;
@@ -408,8 +416,18 @@ private:
     uint32_t nof_users[100][80];
   };
 
+  // SPS C-RNTIs are taken above the C-RNTIs given by the MAC. The persistent PUCCH resources of the SPS HARQ-ACKs
+  // are taken above the dynamic ones, which follow the CCEs of the PDCCH
+  static const uint32_t SPS_RNTI_START    = 60000;
+  static const uint32_t MAX_NOF_SPS_USERS = 16;
+  struct sps_sched_t {
+    bool     allocated[MAX_NOF_SPS_USERS];
+    uint32_t n1_pucch_start;
+  };
+
   sr_sched_t             sr_sched  = {};
   sr_sched_t             cqi_sched = {};
+  sps_sched_t            sps_sched = {};
   asn1::rrc::mcch_msg_s  mcch;
   bool                   enable_mbms     = false;
   rrc_cfg_t              cfg             = {};
@@ -529,7 +529,52 @@ int field_qci::parse(libconfig::Setting& root)
 
     parser::field<uint8> log_chan_group("log_chan_group", &lc_cfg->lc_ch_group);
     lc_cfg->lc_ch_group_present = not log_chan_group.parse(q["logical_channel_config"]);
-    cfg[qci].configured         = true;
+
+    // Optional periodic UL grants without SR/BSR, for latency-critical bearers
+    cfg[qci].proactive_ul_period_ms = 0;
+    q["logical_channel_config"].lookupValue("proactive_ul_period", cfg[qci].proactive_ul_period_ms);
+
+    // Optional semi-persistent scheduling of the UEs with a bearer of this QCI
+    cfg[qci].sps_cfg = {};
+    if (q.exists("sps_config")) {
+      sps_cfg_s* sps_cfg = &cfg[qci].sps_cfg;
+
+      if (q["sps_config"].exists("dl_interval")) {
+        sps_cfg_dl_c::setup_s_* sps_dl = &sps_cfg->sps_cfg_dl.set_setup();
+
+        field_asn1_enum_number<sps_cfg_dl_c::setup_s_::semi_persist_sched_interv_dl_e_> dl_interval(
+            "dl_interval", &sps_dl->semi_persist_sched_interv_dl);
+        if (dl_interval.parse(q["sps_config"])) {
+          ERROR("Error parsing dl_interval in section sps_config\n");
+          return -1;
+        }
+        parser::field<uint8> dl_nof_processes("dl_nof_processes", &sps_dl->nof_conf_sps_processes);
+        if (dl_nof_processes.parse(q["sps_config"])) {
+          sps_dl->nof_conf_sps_processes = 1;
+        }
+        sps_cfg->sps_cfg_dl_present = true;
+      }
+
+      if (q["sps_config"].exists("ul_interval")) {
+        sps_cfg_ul_c::setup_s_* sps_ul = &sps_cfg->sps_cfg_ul.set_setup();
+
+        field_asn1_enum_number<sps_cfg_ul_c::setup_s_::semi_persist_sched_interv_ul_e_> ul_interval(
+            "ul_interval", &sps_ul->semi_persist_sched_interv_ul);
+        if (ul_interval.parse(q["sps_config"])) {
+          ERROR("Error parsing ul_interval in section sps_config\n");
+          return -1;
+        }
+        field_asn1_enum_number<sps_cfg_ul_c::setup_s_::implicit_release_after_e_> ul_implicit_release(
+            "ul_implicit_release_after", &sps_ul->implicit_release_after);
+        if (ul_implicit_release.parse(q["sps_config"])) {
+          ERROR("Error parsing ul_implicit_release_after in section sps_config\n");
+          return -1;
+        }
+        sps_cfg->sps_cfg_ul_present = true;
+      }
+    }
+
+    cfg[qci].configured = true;
   }
 
   return 0;
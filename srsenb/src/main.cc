@@ -54,6 +54,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string tac;
   string mcc;
   string mnc;
+  string sched_metric;
 
   // Command line only options
   bpo::options_description general("General options");
@@ -136,12 +137,15 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.pusch_max_mcs", bpo::value<int>(&args->stack.mac.sched.pusch_max_mcs)->default_value(-1), "Optional PUSCH MCS limit")
     ("scheduler.max_aggr_level", bpo::value<int>(&args->stack.mac.sched.max_aggr_level)->default_value(-1), "Optional maximum aggregation level index (l=log2(L)) ")
     ("scheduler.nof_ctrl_symbols", bpo::value<int>(&args->stack.mac.sched.nof_ctrl_symbols)->default_value(3), "Number of control symbols")
+    ("scheduler.metric", bpo::value<string>(&sched_metric)->default_value("rr"), "Scheduler metric: rr (round-robin) or edf (earliest deadline first)")
+    ("scheduler.tti_lookahead", bpo::value<uint32_t>(&args->stack.mac.sched.tti_lookahead)->default_value(0), "TTIs (0, 1 or 2) the scheduler thread runs ahead of the PHY workers. 0 schedules in the PHY workers")
 
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable", bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false), "Enable/Disable internal Downlink channel emulator")
     ("channel.dl.fading.enable", bpo::value<bool>(&args->phy.dl_channel_args.fading_enable)->default_value(false), "Enable/Disable Fading model")
     ("channel.dl.fading.model", bpo::value<std::string>(&args->phy.dl_channel_args.fading_model)->default_value("none"), "Fading model + maximum doppler (E.g. none, epa5, eva70, etu300, etc)")
+    ("channel.dl.fading.nof_threads", bpo::value<uint32_t>(&args->phy.dl_channel_args.fading_nof_threads)->default_value(1), "Number of threads fading the antenna ports in parallel")
     ("channel.dl.delay.enable", bpo::value<bool>(&args->phy.dl_channel_args.delay_enable)->default_value(false), "Enable/Disable Delay simulator")
     ("channel.dl.delay.period_s", bpo::value<float>(&args->phy.dl_channel_args.delay_period_s)->default_value(3600), "Delay period in seconds (integer)")
     ("channel.dl.delay.init_time_s", bpo::value<float>(&args->phy.dl_channel_args.delay_init_time_s)->default_value(0), "Initial time in seconds")
@@ -159,6 +163,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("channel.ul.enable", bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false), "Enable/Disable internal Uplink channel emulator")
     ("channel.ul.fading.enable", bpo::value<bool>(&args->phy.ul_channel_args.fading_enable)->default_value(false), "Enable/Disable Fading model")
     ("channel.ul.fading.model", bpo::value<std::string>(&args->phy.ul_channel_args.fading_model)->default_value("none"), "Fading model + maximum doppler (E.g. none, epa5, eva70, etu300, etc)")
+    ("channel.ul.fading.nof_threads", bpo::value<uint32_t>(&args->phy.ul_channel_args.fading_nof_threads)->default_value(1), "Number of threads fading the antenna ports in parallel")
     ("channel.ul.delay.enable", bpo::value<bool>(&args->phy.ul_channel_args.delay_enable)->default_value(false), "Enable/Disable Delay simulator")
     ("channel.ul.delay.period_s", bpo::value<float>(&args->phy.ul_channel_args.delay_period_s)->default_value(3600), "Delay period in seconds (integer)")
     ("channel.ul.delay.init_time_s", bpo::value<float>(&args->phy.ul_channel_args.delay_init_time_s)->default_value(0), "Initial time in seconds")
@@ -181,6 +186,9 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.pusch_8bit_decoder", bpo::value<bool>(&args->phy.pusch_8bit_decoder)->default_value(false), "Use 8-bit for LLR representation and turbo decoder trellis computation (Experimental)")
     ("expert.tx_amplitude", bpo::value<float>(&args->phy.tx_amplitude)->default_value(0.6), "Transmit amplitude factor")
     ("expert.nof_phy_threads", bpo::value<int>(&args->phy.nof_phy_threads)->default_value(3), "Number of PHY threads")
+    ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH detection threads per carrier")
+    ("expert.harq_delay_ms", bpo::value<uint32_t>(&args->phy.harq_delay_ms)->default_value(4), "FDD processing time in ms (4, or 3 and 2 for reduced processing time)")
+    ("expert.pusch_softbuffer_pool", bpo::value<bool>(&args->stack.mac.pusch_softbuffer_pool)->default_value(false), "Store the PUSCH soft bits as 8-bit in a shared pool sized to the transport blocks in flight")
     ("expert.link_failure_nof_err", bpo::value<int>(&args->stack.mac.link_failure_nof_err)->default_value(100), "Number of PUSCH failures after which a radio-link failure is triggered")
     ("expert.max_prach_offset_us", bpo::value<float>(&args->phy.max_prach_offset_us)->default_value(30), "Maximum allowed RACH offset (in us)")
     ("expert.equalizer_mode", bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"), "Equalizer mode")
@@ -285,6 +293,21 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     cout << "Error parsing enb.mnc:" << mnc << " - must be a 2 or 3-digit string." << endl;
   }
 
+  // Convert scheduler metric string
+  if (sched_metric == "edf") {
+    args->stack.mac.sched.metric = srsenb::sched_interface::sched_args_t::METRIC_EDF;
+  } else if (sched_metric == "rr") {
+    args->stack.mac.sched.metric = srsenb::sched_interface::sched_args_t::METRIC_RR;
+  } else {
+    cout << "Error parsing scheduler.metric:" << sched_metric << " - must be rr or edf." << endl;
+    exit(1);
+  }
+  if (args->stack.mac.sched.tti_lookahead > 2) {
+    cout << "Error parsing scheduler.tti_lookahead:" << args->stack.mac.sched.tti_lookahead << " - must be 0, 1 or 2."
+         << endl;
+    exit(1);
+  }
+
   // Convert UL/DL EARFCN to frequency if needed
   if (args->rf.dl_freq < 0) {
     args->rf.dl_freq = 1e6 * srslte_band_fd(args->enb.dl_earfcn);
@@ -83,6 +83,13 @@ void metrics_stdout::set_metrics(enb_metrics_t& metrics, const uint32_t period_u
     printf("RF status: O=%d, U=%d, L=%d\n", metrics.rf.rf_o, metrics.rf.rf_u, metrics.rf.rf_l);
   }
 
+  if (metrics.phy_timing.nof_late_sf > 0) {
+    printf("PHY deadline: late=%d/%d, max=%.2f ms\n",
+           metrics.phy_timing.nof_late_sf,
+           metrics.phy_timing.nof_sf,
+           metrics.phy_timing.max_proc_ms);
+  }
+
   if (metrics.stack.rrc.n_ues == 0) {
     return;
   }
@@ -151,6 +158,16 @@ void metrics_stdout::set_metrics(enb_metrics_t& metrics, const uint32_t period_u
     cout << endl;
   }
 
+  for (int i = 0; i < metrics.stack.rrc.n_ues; i++) {
+    const mac_metrics_t& m = metrics.stack.mac[i];
+    if (m.ul_proactive_used_prb > 0 or m.ul_proactive_wasted_prb > 0) {
+      printf("UL proactive grants: rnti=0x%x, used=%u PRB, wasted=%u PRB\n",
+             m.rnti,
+             m.ul_proactive_used_prb,
+             m.ul_proactive_wasted_prb);
+    }
+  }
+
   cout.flags(f); // For avoiding Coverity defect: Not restoring ostream format
 }
 
@@ -472,6 +472,9 @@ int cc_worker::decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, u
       // mark this tti as having an ul dci to avoid pucch
       ue_db[rnti]->is_grant_available = true;
 
+      // The transmissions in configured SPS grants are scrambled with the SPS C-RNTI
+      ue_db[rnti]->ul_cfg.pusch.rnti = grants[i].sps_rnti ? grants[i].sps_rnti : rnti;
+
       fill_uci_cfg(rnti, grants->dci.cqi_request, &ue_db[rnti]->ul_cfg.pusch.uci_cfg);
 
       // Compute UL grant
@@ -481,7 +484,7 @@ int cc_worker::decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, u
         return SRSLTE_ERROR;
       }
 
-      uint32_t ul_pid = TTI_RX(ul_sf.tti) % SRSLTE_FDD_NOF_HARQ;
+      uint32_t ul_pid = TTI_RX(ul_sf.tti) % srslte_fdd_nof_harq();
 
       // Handle Format0 adaptive retx
       // Use last TBS for this TB in case of mcs>28
@@ -604,14 +607,19 @@ int cc_worker::encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants
 {
   for (uint32_t i = 0; i < nof_grants; i++) {
     if (grants[i].needs_pdcch) {
-      if (srslte_enb_dl_put_pdcch_ul(&enb_dl, &grants[i].dci_cfg, &grants[i].dci)) {
+      // The DCIs of SPS grants are scrambled with the SPS C-RNTI, in the search space of the C-RNTI
+      srslte_dci_ul_t dci = grants[i].dci;
+      if (grants[i].sps_rnti) {
+        dci.rnti = grants[i].sps_rnti;
+      }
+      if (srslte_enb_dl_put_pdcch_ul(&enb_dl, &grants[i].dci_cfg, &dci)) {
         ERROR("Error putting PUSCH %d\n", i);
         return SRSLTE_ERROR;
       }
 
       // Logging
       char str[512];
-      srslte_dci_ul_info(&grants[i].dci, str, 512);
+      srslte_dci_ul_info(&dci, str, 512);
       Info("PDCCH: %s, tti_tx_dl=%d\n", str, tti_tx_dl);
     }
   }
@@ -622,8 +630,13 @@ int cc_worker::encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants
 {
   for (uint32_t i = 0; i < nof_grants; i++) {
     uint16_t rnti = grants[i].dci.rnti;
-    if (rnti) {
-      if (srslte_enb_dl_put_pdcch_dl(&enb_dl, &grants[i].dci_cfg, &grants[i].dci)) {
+    if (rnti and grants[i].needs_pdcch) {
+      // The DCIs of SPS grants are scrambled with the SPS C-RNTI, in the search space of the C-RNTI
+      srslte_dci_dl_t dci = grants[i].dci;
+      if (grants[i].sps_rnti) {
+        dci.rnti = grants[i].sps_rnti;
+      }
+      if (srslte_enb_dl_put_pdcch_dl(&enb_dl, &grants[i].dci_cfg, &dci)) {
         ERROR("Error putting PDCCH %d\n", i);
         return SRSLTE_ERROR;
       }
@@ -631,7 +644,7 @@ int cc_worker::encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants
       if (LOG_THIS(rnti)) {
         // Logging
         char str[512];
-        srslte_dci_dl_info(&grants[i].dci, str, 512);
+        srslte_dci_dl_info(&dci, str, 512);
         Info("PDCCH: %s, tti_tx_dl=%d\n", str, tti_tx_dl);
       }
     }
@@ -677,6 +690,13 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
   for (uint32_t i = 0; i < nof_grants; i++) {
     uint16_t rnti = grants[i].dci.rnti;
     if (rnti) {
+      // The Format1A DCI that releases a SPS assignment does not schedule a PDSCH
+      if (grants[i].sps_rnti and grants[i].dci.format == SRSLTE_DCI_FORMAT1A) {
+        continue;
+      }
+
+      // The PDSCH of SPS assignments is scrambled with the SPS C-RNTI
+      ue_db[rnti]->dl_cfg.pdsch.rnti = grants[i].sps_rnti ? grants[i].sps_rnti : rnti;
 
       // Compute DL grant
       if (srslte_ra_dl_dci_to_grant(
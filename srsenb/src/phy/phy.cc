@@ -112,8 +112,19 @@ int phy::init(const phy_args_t&            args,
 {
   mlockall((uint32_t)MCL_CURRENT | (uint32_t)MCL_FUTURE);
 
+  if (srslte_set_fdd_harq_delay(args.harq_delay_ms)) {
+    return SRSLTE_ERROR;
+  }
+
+  // A subframe received in n is transmitted in n+k, with a reduced processing time a worker still busy after k-1 ms
+  // has already missed its deadline
+  nof_workers = (uint32_t)args.nof_phy_threads;
+  if (srslte_fdd_harq_delay() < FDD_HARQ_DELAY_MS) {
+    nof_workers = SRSLTE_MIN(nof_workers, srslte_fdd_harq_delay() - 1);
+  }
+
   // Create array of pointers to phy_logs
-  for (int i = 0; i < args.nof_phy_threads; i++) {
+  for (uint32_t i = 0; i < nof_workers; i++) {
     auto mylog   = std::unique_ptr<srslte::log_filter>(new srslte::log_filter);
     char tmp[16] = {};
     sprintf(tmp, "PHY%d", i);
@@ -136,8 +147,18 @@ int phy::init(const phy_args_t&            args,
     log_vec.push_back(nullptr);
   }
 
-  radio       = radio_;
-  nof_workers = args.nof_phy_threads;
+  radio = radio_;
+
+  if (nof_workers < (uint32_t)args.nof_phy_threads) {
+    log_vec.at(0)->warning("Reducing the PHY threads from %d to %d for a processing time of %d ms\n",
+                           args.nof_phy_threads,
+                           nof_workers,
+                           srslte_fdd_harq_delay());
+    log_vec.at(0)->console("Warning: Reducing the PHY threads from %d to %d for a processing time of %d ms\n",
+                           args.nof_phy_threads,
+                           nof_workers,
+                           srslte_fdd_harq_delay());
+  }
 
   workers_common.params = args;
 
@@ -153,7 +174,13 @@ int phy::init(const phy_args_t&            args,
 
   // For each carrier, initialise PRACH worker
   for (uint32_t cc = 0; cc < args.nof_carriers; cc++) {
-    prach.init(cc, cfg.cell, prach_cfg, stack_, log_vec.at(0).get(), PRACH_WORKER_THREAD_PRIO);
+    prach.init(cc,
+               cfg.cell,
+               prach_cfg,
+               stack_,
+               log_vec.at(0).get(),
+               PRACH_WORKER_THREAD_PRIO,
+               SRSLTE_MAX(args.nof_prach_threads, 1));
   }
   prach.set_max_prach_offset_us(args.max_prach_offset_us);
 
@@ -250,6 +277,11 @@ void phy::get_metrics(phy_metrics_t metrics[ENB_METRICS_MAX_USERS])
   }
 }
 
+void phy::get_timing_metrics(timing_metrics_t* m)
+{
+  workers_common.get_timing_metrics(m);
+}
+
 /***** RRC->PHY interface **********/
 
 void phy::set_config_dedicated(uint16_t rnti, phys_cfg_ded_s* dedicated)
@@ -70,6 +70,29 @@ void phy_common::set_nof_workers(uint32_t nof_workers_)
   nof_workers = nof_workers_;
 }
 
+/* Accounts the time a worker took since its subframe was received until the signal was handed to the radio. The
+ * subframe received in n is transmitted in n+k, which leaves k-1 ms. Returns true if the deadline was missed.
+ */
+bool phy_common::set_processing_time(float proc_ms)
+{
+  std::lock_guard<std::mutex> lock(timing_mutex);
+  bool                        late = proc_ms > (float)(srslte_fdd_harq_delay() - 1);
+
+  timing_metrics.nof_sf++;
+  if (late) {
+    timing_metrics.nof_late_sf++;
+  }
+  timing_metrics.max_proc_ms = SRSLTE_MAX(timing_metrics.max_proc_ms, proc_ms);
+  return late;
+}
+
+void phy_common::get_timing_metrics(timing_metrics_t* m)
+{
+  std::lock_guard<std::mutex> lock(timing_mutex);
+  *m             = timing_metrics;
+  timing_metrics = {};
+}
+
 void phy_common::reset()
 {
   bzero(ul_grants, sizeof(stack_interface_phy_lte::ul_sched_t) * TTIMOD_SZ);
@@ -37,6 +37,7 @@ int prach_worker::init(const srslte_cell_t&      cell_,
 
   max_prach_offset_us = 50;
 
+  // This object is only used for the PRACH occasions, the detectors have their own
   if (srslte_prach_init(&prach, srslte_symbol_sz(cell.nof_prb))) {
     return -1;
   }
@@ -46,11 +47,30 @@ int prach_worker::init(const srslte_cell_t&      cell_,
     return -1;
   }
 
-  srslte_prach_set_detect_factor(&prach, 60);
+  for (std::unique_ptr<detector_t>& d : detector_vec) {
+    d = std::unique_ptr<detector_t>(new detector_t);
+    if (srslte_prach_init(&d->prach, srslte_symbol_sz(cell.nof_prb))) {
+      return -1;
+    }
+
+    if (srslte_prach_set_cfg(&d->prach, &prach_cfg, cell.nof_prb)) {
+      ERROR("Error initiating PRACH\n");
+      return -1;
+    }
+
+    srslte_prach_set_detect_factor(&d->prach, 60);
+  }
+
+  nof_sf     = (uint32_t)ceilf(prach.T_tot * 1000);
+  buffer_len = nof_sf * SRSLTE_SF_LEN_PRB(cell.nof_prb);
 
-  nof_sf = (uint32_t)ceilf(prach.T_tot * 1000);
+  // Combine as many antennas as fit in the buffers
+  nof_rx_ant = SRSLTE_MIN(SRSLTE_MAX(cell.nof_ports, 1), sf_buffer_sz / buffer_len);
+  if (nof_rx_ant < cell.nof_ports) {
+    log_h->warning("PRACH: only %d of %d antennas are combined\n", nof_rx_ant, cell.nof_ports);
+  }
 
-  start(priority);
+  detectors.start(priority);
   initiated = true;
 
   sf_cnt = 0;
@@ -59,12 +79,14 @@ int prach_worker::init(const srslte_cell_t&      cell_,
 
 void prach_worker::stop()
 {
-  srslte_prach_free(&prach);
+  detectors.stop();
 
-  running      = false;
-  sf_buffer* s = nullptr;
-  pending_buffers.push(s);
-  wait_thread_finish();
+  srslte_prach_free(&prach);
+  for (std::unique_ptr<detector_t>& d : detector_vec) {
+    if (d) {
+      srslte_prach_free(&d->prach);
+    }
+  }
 }
 
 void prach_worker::set_max_prach_offset_us(float delay_us)
@@ -72,7 +94,7 @@ void prach_worker::set_max_prach_offset_us(float delay_us)
   max_prach_offset_us = delay_us;
 }
 
-int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx)
+int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx[SRSLTE_MAX_PORTS])
 {
   // Save buffer only if it's a PRACH TTI
   if (srslte_prach_tti_opportunity(&prach, tti_rx, -1) || sf_cnt) {
@@ -87,11 +109,14 @@ int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx)
       log_h->error("PRACH: Expected available current_buffer\n");
       return -1;
     }
-    if (current_buffer->nof_samples + SRSLTE_SF_LEN_PRB(cell.nof_prb) < sf_buffer_sz) {
-      memcpy(&current_buffer->samples[sf_cnt * SRSLTE_SF_LEN_PRB(cell.nof_prb)],
-             buffer_rx,
-             sizeof(cf_t) * SRSLTE_SF_LEN_PRB(cell.nof_prb));
-      current_buffer->nof_samples += SRSLTE_SF_LEN_PRB(cell.nof_prb);
+    uint32_t sf_len = SRSLTE_SF_LEN_PRB(cell.nof_prb);
+    if (current_buffer->nof_samples + sf_len <= buffer_len) {
+      for (uint32_t a = 0; a < nof_rx_ant; a++) {
+        memcpy(&current_buffer->samples[a * buffer_len + current_buffer->nof_samples],
+               buffer_rx[a],
+               sizeof(cf_t) * sf_len);
+      }
+      current_buffer->nof_samples += sf_len;
       if (sf_cnt == 0) {
         current_buffer->tti = tti_rx;
       }
@@ -101,42 +126,57 @@ int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx)
     }
     sf_cnt++;
     if (sf_cnt == nof_sf) {
-      sf_cnt = 0;
-      pending_buffers.push(current_buffer);
+      sf_cnt       = 0;
+      sf_buffer* b = current_buffer;
+      detectors.push_task([this, b](uint32_t detector_id) {
+        run_tti(b, detector_id);
+        b->reset();
+        buffer_pool.deallocate(b);
+      });
     }
   }
   return 0;
 }
 
-int prach_worker::run_tti(sf_buffer* b)
+int prach_worker::run_tti(sf_buffer* b, uint32_t detector_id)
 {
-  if (srslte_prach_tti_opportunity(&prach, b->tti, -1)) {
+  detector_t& d = *detector_vec[detector_id];
+
+  if (srslte_prach_tti_opportunity(&d.prach, b->tti, -1)) {
+    cf_t* signal[SRSLTE_MAX_PORTS] = {};
+    for (uint32_t a = 0; a < nof_rx_ant; a++) {
+      signal[a] = &b->samples[a * buffer_len + d.prach.N_cp];
+    }
+
     // Detect possible PRACHs
-    if (srslte_prach_detect_offset(&prach,
-                                   prach_cfg.freq_offset,
-                                   &b->samples[prach.N_cp],
-                                   nof_sf * SRSLTE_SF_LEN_PRB(cell.nof_prb) - prach.N_cp,
-                                   prach_indices,
-                                   prach_offsets,
-                                   prach_p2avg,
-                                   &prach_nof_det)) {
+    if (srslte_prach_detect_offset_multi(&d.prach,
+                                         prach_cfg.freq_offset,
+                                         signal,
+                                         nof_rx_ant,
+                                         buffer_len - d.prach.N_cp,
+                                         d.indices,
+                                         d.offsets,
+                                         d.p2avg,
+                                         &d.nof_det)) {
       log_h->error("Error detecting PRACH\n");
       return SRSLTE_ERROR;
     }
 
-    if (prach_nof_det) {
-      for (uint32_t i = 0; i < prach_nof_det; i++) {
+    if (d.nof_det) {
+      // Occasions may be detected concurrently, report them one at a time
+      std::lock_guard<std::mutex> lock(stack_mutex);
+      for (uint32_t i = 0; i < d.nof_det; i++) {
         log_h->info("PRACH: cc=%d, %d/%d, preamble=%d, offset=%.1f us, peak2avg=%.1f, max_offset=%.1f us\n",
                     cc_idx,
                     i,
-                    prach_nof_det,
-                    prach_indices[i],
-                    prach_offsets[i] * 1e6,
-                    prach_p2avg[i],
+                    d.nof_det,
+                    d.indices[i],
+                    d.offsets[i] * 1e6,
+                    d.p2avg[i],
                     max_prach_offset_us);
 
-        if (prach_offsets[i] * 1e6 < max_prach_offset_us) {
-          stack->rach_detected(b->tti, cc_idx, prach_indices[i], (uint32_t)(prach_offsets[i] * 1e6));
+        if (d.offsets[i] * 1e6 < max_prach_offset_us) {
+          stack->rach_detected(b->tti, cc_idx, d.indices[i], (uint32_t)(d.offsets[i] * 1e6));
         }
       }
     }
@@ -144,20 +184,4 @@ int prach_worker::run_tti(sf_buffer* b)
   return 0;
 }
 
-void prach_worker::run_thread()
-{
-  running = true;
-  while (running) {
-    sf_buffer* b = pending_buffers.wait_pop();
-    if (running && b) {
-      int ret = run_tti(b);
-      b->reset();
-      buffer_pool.deallocate(b);
-      if (ret) {
-        running = false;
-      }
-    }
-  }
-}
-
 } // namespace srsenb
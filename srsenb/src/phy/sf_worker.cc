@@ -131,6 +131,9 @@ void sf_worker::set_time(uint32_t tti_, uint32_t tx_worker_cnt_, srslte_timestam
   tx_worker_cnt = tx_worker_cnt_;
   srslte_timestamp_copy(&tx_time, &tx_time_);
 
+  // The subframe has just been received, the processing deadline counts from here
+  gettimeofday(&rx_done_time, nullptr);
+
   for (auto& w : cc_workers) {
     w->set_tti(tti_);
   }
@@ -238,6 +241,16 @@ void sf_worker::work_imp()
     }
   }
 
+  // Check the processing deadline
+  struct timeval t[3];
+  t[1] = rx_done_time;
+  gettimeofday(&t[2], nullptr);
+  get_time_interval(t);
+  float proc_ms = t[0].tv_sec * 1e3f + t[0].tv_usec * 1e-3f;
+  if (phy->set_processing_time(proc_ms)) {
+    Warning("TTI %d: processing took %.2f ms, deadline is %d ms\n", tti_rx, proc_ms, srslte_fdd_harq_delay() - 1);
+  }
+
   Debug("Sending to radio\n");
   phy->worker_end(tx_worker_cnt, signal_buffer_tx, SRSLTE_SF_LEN_PRB(phy->cell.nof_prb), tx_time);
 
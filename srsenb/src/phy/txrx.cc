@@ -123,9 +123,9 @@ void txrx::run_thread()
         ul_channel->run(buffer, buffer, sf_len, rx_time);
       }
 
-      /* Compute TX time: Any transmission happens in TTI+4 thus advance 4 ms the reception time */
+      /* Compute TX time: Any transmission happens in TTI+k thus advance k ms the reception time */
       srslte_timestamp_copy(&tx_time, &rx_time);
-      srslte_timestamp_add(&tx_time, 0, TX_DELAY * 1e-3);
+      srslte_timestamp_add(&tx_time, 0, srslte_fdd_harq_delay() * 1e-3);
 
       Debug("Settting TTI=%d, tx_mutex=%d, tx_time=%ld:%f to worker %d\n",
             tti,
@@ -142,7 +142,7 @@ void txrx::run_thread()
 
       // Trigger prach worker execution
       for (uint32_t cc = 0; cc < worker_com->params.nof_carriers; cc++) {
-        prach->new_tti(cc, tti, buffer[cc * worker_com->cell.nof_ports]);
+        prach->new_tti(cc, tti, &buffer[cc * worker_com->cell.nof_ports]);
       }
     } else {
       // wait_worker() only returns NULL if it's being closed. Quit now to avoid unnecessary loops here
@@ -38,7 +38,7 @@ using namespace asn1::rrc;
 
 namespace srsenb {
 
-mac::mac() : last_rnti(0), rar_pdu_msg(sched_interface::MAX_RAR_LIST), rar_payload()
+mac::mac() : sched_worker(this), last_rnti(0), rar_pdu_msg(sched_interface::MAX_RAR_LIST), rar_payload()
 {
   bzero(&cell, sizeof(cell));
   bzero(&bcch_dlsch_payload, sizeof(bcch_dlsch_payload));
@@ -76,8 +76,24 @@ bool mac::init(const mac_args_t&        args_,
     cell = *cell_;
 
     scheduler.init(rrc, log_h);
-    // Set default scheduler (RR)
-    scheduler.set_metric(&sched_metric_dl_rr, &sched_metric_ul_rr);
+    // Set scheduler metric (RR by default)
+    if (args.sched.metric == sched_interface::sched_args_t::METRIC_EDF) {
+      scheduler.set_metric(&sched_metric_dl_edf, &sched_metric_ul_edf);
+    } else {
+      scheduler.set_metric(&sched_metric_dl_rr, &sched_metric_ul_rr);
+    }
+
+    // 8-bit soft bits do not decode the highest rate 16QAM PUSCH MCS (the UL does not use 64QAM)
+    if (args.pusch_softbuffer_pool) {
+      if (args.sched.pusch_max_mcs < 0 || args.sched.pusch_max_mcs > pusch_softbuffer_pool_max_mcs) {
+        Warning("Limiting the PUSCH MCS to %d with the PUSCH soft-buffer pool\n", pusch_softbuffer_pool_max_mcs);
+        args.sched.pusch_max_mcs = pusch_softbuffer_pool_max_mcs;
+      }
+      if (args.sched.pusch_mcs > pusch_softbuffer_pool_max_mcs) {
+        Warning("Fixed PUSCH MCS limited to %d with the PUSCH soft-buffer pool\n", pusch_softbuffer_pool_max_mcs);
+        args.sched.pusch_mcs = pusch_softbuffer_pool_max_mcs;
+      }
+    }
 
     // Set default scheduler configuration
     scheduler.set_sched_cfg(&args.sched);
@@ -92,8 +108,25 @@ bool mac::init(const mac_args_t&        args_,
     // Init softbuffer for RAR
     srslte_softbuffer_tx_init(&rar_softbuffer_tx, cell.nof_prb);
 
+    // Init PUSCH soft-buffer pool. Each HARQ process can not hold more than the largest TB of the cell, plus one
+    // code block per grant for the segmentation of the TBs sharing its TTI
+    if (args.pusch_softbuffer_pool) {
+      uint32_t max_cb = (uint32_t)srslte_ra_tbs_from_idx(33, cell.nof_prb) / (SRSLTE_TCOD_MAX_LEN_CB - 24) + 1;
+      uint32_t nof_cb = SRSLTE_FDD_NOF_HARQ * (max_cb + sched_interface::MAX_DATA_LIST);
+      if (srslte_softbuffer_rx_pool_init(&ul_softbuffer_pool, nof_cb, true)) {
+        Error("Initiating PUSCH soft-buffer pool\n");
+        return false;
+      }
+      Info("PUSCH soft-buffer pool of %d code blocks (%d kB)\n", nof_cb, nof_cb * ul_softbuffer_pool.cb_size / 1024);
+    }
+
     reset();
 
+    // Compute the scheduling decisions ahead of the PHY workers
+    if (args.sched.tti_lookahead > 0) {
+      sched_worker.start_sched(args.sched.tti_lookahead);
+    }
+
     started = true;
   }
 
@@ -102,6 +135,10 @@ bool mac::init(const mac_args_t&        args_,
 
 void mac::stop()
 {
+  if (args.sched.tti_lookahead > 0) {
+    sched_worker.stop_sched();
+  }
+
   pthread_rwlock_wrlock(&rwlock);
   if (started) {
     for (uint32_t i = 0; i < ue_db.size(); i++) {
@@ -112,6 +149,7 @@ void mac::stop()
     }
     srslte_softbuffer_tx_free(&pcch_softbuffer_tx);
     srslte_softbuffer_tx_free(&rar_softbuffer_tx);
+    srslte_softbuffer_rx_pool_free(&ul_softbuffer_pool);
     started = false;
   }
   pthread_rwlock_unlock(&rwlock);
@@ -347,6 +385,11 @@ int mac::crc_info(uint32_t tti, uint16_t rnti, uint32_t nof_bytes, bool crc)
     }
 
     ret = scheduler.ul_crc_info(tti, rnti, cc_idx, crc);
+
+    // A discarded TB gives its code blocks back to the shared pool now, its HARQ process may not be used again soon
+    if (!crc && args.pusch_softbuffer_pool && !scheduler.ul_harq_active(tti, rnti, cc_idx)) {
+      srslte_softbuffer_rx_reset(ue_db[rnti]->get_rx_softbuffer(tti));
+    }
   } else {
     Error("User rnti=0x%x not found\n", rnti);
   }
@@ -368,6 +411,20 @@ int mac::set_dl_ant_info(uint16_t rnti, phys_cfg_ded_s::ant_info_c_* dl_ant_info
   return ret;
 }
 
+int mac::set_sps_cfg(uint16_t rnti, const srslte::sps_cfg_t& sps_cfg)
+{
+  int ret = -1;
+  pthread_rwlock_rdlock(&rwlock);
+  if (ue_db.count(rnti)) {
+    scheduler.ue_sps_cfg(rnti, sps_cfg);
+    ret = 0;
+  } else {
+    Error("User rnti=0x%x not found\n", rnti);
+  }
+  pthread_rwlock_unlock(&rwlock);
+  return ret;
+}
+
 int mac::ri_info(uint32_t tti, uint16_t rnti, uint32_t ri_value)
 {
   // TODO: add cc_idx to interface
@@ -466,7 +523,15 @@ int mac::rach_detected(uint32_t tti, uint32_t enb_cc_idx, uint32_t preamble_idx,
 
   // Create new UE
   if (!ue_db.count(rnti)) {
-    ue_db[rnti] = new ue(rnti, cell.nof_prb, &scheduler, rrc_h, rlc_h, log_h, SRSLTE_FDD_NOF_HARQ);
+    ue_db[rnti] = new ue(rnti,
+                         cell.nof_prb,
+                         &scheduler,
+                         rrc_h,
+                         rlc_h,
+                         log_h,
+                         SRSLTE_FDD_NOF_HARQ,
+                         SRSLTE_FDD_NOF_HARQ * SRSLTE_MAX_TB,
+                         args.pusch_softbuffer_pool ? &ul_softbuffer_pool : nullptr);
   }
 
   // Set PCAP if available
@@ -526,9 +591,14 @@ int mac::get_dl_sched(uint32_t tti, dl_sched_t* dl_sched_res)
     return SRSLTE_ERROR_INVALID_INPUTS;
   }
 
-  // Run scheduler with current info
+  // Run scheduler with current info, or collect the result computed ahead by the scheduler thread
   sched_interface::dl_sched_res_t sched_result = {};
-  if (scheduler.dl_sched(tti, 0, sched_result) < 0) {
+  if (args.sched.tti_lookahead > 0) {
+    if (not sched_worker.get_dl_result(TTI_RX(tti), &sched_result)) {
+      Error("Getting DL scheduling result for tti=%d\n", tti);
+      return SRSLTE_ERROR;
+    }
+  } else if (scheduler.dl_sched(tti, 0, sched_result) < 0) {
     Error("Running scheduler\n");
     return SRSLTE_ERROR;
   }
@@ -545,7 +615,9 @@ int mac::get_dl_sched(uint32_t tti, dl_sched_t* dl_sched_res)
 
     if (ue_db.count(rnti)) {
       // Copy dci info
-      dl_sched_res->pdsch[n].dci = sched_result.data[i].dci;
+      dl_sched_res->pdsch[n].dci         = sched_result.data[i].dci;
+      dl_sched_res->pdsch[n].needs_pdcch = sched_result.data[i].needs_pdcch;
+      dl_sched_res->pdsch[n].sps_rnti    = sched_result.data[i].sps_rnti;
 
       for (uint32_t tb = 0; tb < SRSLTE_MAX_TB; tb++) {
         dl_sched_res->pdsch[n].softbuffer_tx[tb] = ue_db[rnti]->get_tx_softbuffer(sched_result.data[i].dci.pid, tb);
@@ -583,7 +655,9 @@ int mac::get_dl_sched(uint32_t tti, dl_sched_t* dl_sched_res)
   // Copy RAR grants
   for (uint32_t i = 0; i < sched_result.nof_rar_elems; i++) {
     // Copy dci info
-    dl_sched_res->pdsch[n].dci = sched_result.rar[i].dci;
+    dl_sched_res->pdsch[n].dci         = sched_result.rar[i].dci;
+    dl_sched_res->pdsch[n].needs_pdcch = true;
+    dl_sched_res->pdsch[n].sps_rnti    = 0;
 
     // Set softbuffer (there are no retx in RAR but a softbuffer is required)
     dl_sched_res->pdsch[n].softbuffer_tx[0] = &rar_softbuffer_tx;
@@ -603,7 +677,9 @@ int mac::get_dl_sched(uint32_t tti, dl_sched_t* dl_sched_res)
   // Copy SI and Paging grants
   for (uint32_t i = 0; i < sched_result.nof_bc_elems; i++) {
     // Copy dci info
-    dl_sched_res->pdsch[n].dci = sched_result.bc[i].dci;
+    dl_sched_res->pdsch[n].dci         = sched_result.bc[i].dci;
+    dl_sched_res->pdsch[n].needs_pdcch = true;
+    dl_sched_res->pdsch[n].sps_rnti    = 0;
 
     // Set softbuffer
     if (sched_result.bc[i].type == sched_interface::dl_sched_bc_t::BCCH) {
@@ -783,9 +859,14 @@ int mac::get_ul_sched(uint32_t tti, ul_sched_t* ul_sched_res)
     return SRSLTE_ERROR_INVALID_INPUTS;
   }
 
-  // Run scheduler with current info
+  // Run scheduler with current info, or collect the result computed ahead by the scheduler thread
   sched_interface::ul_sched_res_t sched_result = {};
-  if (scheduler.ul_sched(tti, 0, sched_result) < 0) {
+  if (args.sched.tti_lookahead > 0) {
+    if (not sched_worker.get_ul_result(TTI_SUB(tti, 2 * srslte_fdd_harq_delay()), &sched_result)) {
+      Error("Getting UL scheduling result for tti=%d\n", tti);
+      return SRSLTE_ERROR;
+    }
+  } else if (scheduler.ul_sched(tti, 0, sched_result) < 0) {
     Error("Running scheduler\n");
     return SRSLTE_ERROR;
   }
@@ -805,13 +886,15 @@ int mac::get_ul_sched(uint32_t tti, ul_sched_t* ul_sched_res)
         // Copy grant info
         ul_sched_res->pusch[n].current_tx_nb = sched_result.pusch[i].current_tx_nb;
         ul_sched_res->pusch[n].needs_pdcch   = sched_result.pusch[i].needs_pdcch;
+        ul_sched_res->pusch[n].sps_rnti      = sched_result.pusch[i].sps_rnti;
         ul_sched_res->pusch[n].dci           = sched_result.pusch[i].dci;
         ul_sched_res->pusch[n].softbuffer_rx = ue_db[rnti]->get_rx_softbuffer(tti);
 
         if (sched_result.pusch[n].current_tx_nb == 0) {
           srslte_softbuffer_rx_reset_tbs(ul_sched_res->pusch[n].softbuffer_rx, sched_result.pusch[i].tbs * 8);
         }
-        ul_sched_res->pusch[n].data = ue_db[rnti]->request_buffer(tti, sched_result.pusch[i].tbs);
+        ul_sched_res->pusch[n].data =
+            ue_db[rnti]->request_buffer(tti, sched_result.pusch[i].tbs, sched_result.pusch[i].sps_rnti != 0);
         ul_sched_res->nof_grants++;
         n++;
       } else {
@@ -835,6 +918,126 @@ int mac::get_ul_sched(uint32_t tti, ul_sched_t* ul_sched_res)
   return SRSLTE_SUCCESS;
 }
 
+/********************************************************
+ *
+ * Scheduler thread
+ *
+ *******************************************************/
+
+void mac::sched_thread::start_sched(uint32_t lookahead_)
+{
+  lookahead  = lookahead_;
+  running    = true;
+  has_target = false;
+  start(MAC_SCHED_THREAD_PRIO);
+}
+
+void mac::sched_thread::stop_sched()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not running) {
+      return;
+    }
+    running = false;
+  }
+  cvar.notify_all();
+  wait_thread_finish();
+}
+
+// Asks the scheduler thread to compute the results up to tti_rx + lookahead
+void mac::sched_thread::request(uint32_t tti_rx)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint32_t                    new_target = TTI_ADD(tti_rx, lookahead);
+    bool                        in_window =
+        has_target and (TTI_SUB(next_tti, tti_rx) <= NOF_SLOTS / 2 or TTI_SUB(tti_rx, next_tti) < NOF_SLOTS / 2);
+    if (not in_window) {
+      // First request, or jump in the TTIs asked by the PHY. Restart from tti_rx
+      next_tti   = tti_rx;
+      target_tti = new_target;
+      has_target = true;
+    } else if (TTI_SUB(new_target, target_tti) < NOF_SLOTS / 2) {
+      target_tti = new_target;
+    }
+  }
+  cvar.notify_all();
+}
+
+mac::sched_thread::result_slot_t* mac::sched_thread::wait_slot(uint32_t tti_rx)
+{
+  request(tti_rx);
+
+  result_slot_t* slot = &slots[tti_rx % NOF_SLOTS];
+  if (slot->tti_rx.load(std::memory_order_acquire) != tti_rx) {
+    // The scheduler thread is late (or this is the first TTI)
+    std::unique_lock<std::mutex> lock(mutex);
+    while (slot->tti_rx.load(std::memory_order_acquire) != tti_rx) {
+      // Give up if the thread was stopped, or if tti_rx was skipped after a jump in the TTIs
+      bool skipped = TTI_SUB(next_tti, tti_rx) > 0 and TTI_SUB(next_tti, tti_rx) < 10240 / 2;
+      if (not running or skipped) {
+        return nullptr;
+      }
+      cvar.wait(lock);
+    }
+  }
+  return slot;
+}
+
+bool mac::sched_thread::get_dl_result(uint32_t tti_rx, sched_interface::dl_sched_res_t* result)
+{
+  result_slot_t* slot = wait_slot(tti_rx);
+  if (slot == nullptr) {
+    return false;
+  }
+  *result = slot->dl_result;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return slot->tti_rx.load(std::memory_order_relaxed) == tti_rx;
+}
+
+bool mac::sched_thread::get_ul_result(uint32_t tti_rx, sched_interface::ul_sched_res_t* result)
+{
+  result_slot_t* slot = wait_slot(tti_rx);
+  if (slot == nullptr) {
+    return false;
+  }
+  *result = slot->ul_result;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return slot->tti_rx.load(std::memory_order_relaxed) == tti_rx;
+}
+
+void mac::sched_thread::run_thread()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (running) {
+    // Wait until there is a requested TTI not computed yet
+    if (not has_target or next_tti == TTI_ADD(target_tti, 1)) {
+      cvar.wait(lock);
+      continue;
+    }
+    uint32_t tti_rx = next_tti;
+    lock.unlock();
+
+    result_slot_t* slot = &slots[tti_rx % NOF_SLOTS];
+    slot->tti_rx.store(INVALID_TTI, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    parent->log_h->step(tti_rx);
+    if (parent->scheduler.dl_sched(TTI_TX(tti_rx), 0, slot->dl_result) < 0 or
+        parent->scheduler.ul_sched(TTI_RX_ACK(tti_rx), 0, slot->ul_result) < 0) {
+      parent->log_h->error("Running scheduler\n");
+    }
+
+    lock.lock();
+    slot->tti_rx.store(tti_rx, std::memory_order_release);
+    if (next_tti == tti_rx) {
+      next_tti = TTI_ADD(tti_rx, 1);
+    }
+    cvar.notify_all();
+  }
+}
+
 bool mac::process_pdus()
 {
   pthread_rwlock_rdlock(&rwlock);
@@ -54,12 +54,14 @@ uint32_t max_tti(uint32_t tti1, uint32_t tti2)
 
 sched_params_t::sched_params_t()
 {
-  sched_cfg.pdsch_max_mcs    = 28;
-  sched_cfg.pdsch_mcs        = -1;
-  sched_cfg.pusch_max_mcs    = 28;
-  sched_cfg.pusch_mcs        = -1;
-  sched_cfg.nof_ctrl_symbols = 3;
-  sched_cfg.max_aggr_level   = 3;
+  sched_cfg.pdsch_max_mcs       = 28;
+  sched_cfg.pdsch_mcs           = -1;
+  sched_cfg.pusch_max_mcs       = 28;
+  sched_cfg.pusch_mcs           = -1;
+  sched_cfg.nof_ctrl_symbols    = 3;
+  sched_cfg.max_aggr_level      = 3;
+  sched_cfg.tti_lookahead       = 0;
+  sched_cfg.nof_carrier_workers = 0;
 }
 
 bool sched_params_t::set_cfg(srslte::log* log_, sched_interface::cell_cfg_t* cfg_, srslte_regs_t* regs_)
@@ -99,6 +101,9 @@ bool sched_params_t::set_cfg(srslte::log* log_, sched_interface::cell_cfg_t* cfg
     nof_cce_table[cfix] = (uint32_t)ret;
   }
 
+  // precompute the TBS and MCS of each CQI and nof PRBs, used in the search of the PRBs required by a user
+  tbs_table.init(cfg->cell, sched_cfg.pdsch_max_mcs, sched_cfg.pusch_max_mcs);
+
   if (common_locations[sched_cfg.nof_ctrl_symbols - 1].nof_loc[2] == 0) {
     log_h->error("SCHED: Current cfi=%d is not valid for broadcast (check scheduler.nof_ctrl_symbols in conf file).\n",
                  sched_cfg.nof_ctrl_symbols);
@@ -144,17 +149,22 @@ sched::sched()
 
 sched::~sched()
 {
+  if (carrier_workers != nullptr) {
+    carrier_workers->stop();
+  }
   srslte_regs_free(&regs);
   pthread_rwlock_destroy(&rwlock);
 }
 
-void sched::init(rrc_interface_mac* rrc_, srslte::log* log)
+void sched::init(rrc_interface_mac* rrc_, srslte::log* log, uint32_t nof_carriers)
 {
   log_h = log;
   rrc   = rrc_;
 
-  // Initialize Independent carrier schedulers
-  carrier_schedulers.emplace_back(new carrier_sched{rrc, &ue_db, 0});
+  // Initialize Independent carrier schedulers. All the carriers share the cell configuration
+  for (uint32_t enb_cc_idx = 0; enb_cc_idx < nof_carriers; ++enb_cc_idx) {
+    carrier_schedulers.emplace_back(new carrier_sched{rrc, &ue_db, enb_cc_idx});
+  }
 
   reset();
 }
@@ -185,6 +195,14 @@ void sched::set_metric(sched::metric_dl* dl_metric_, sched::metric_ul* ul_metric
   }
 }
 
+// Carriers scheduled by the carrier workers need their own metric objects, as the metrics keep the TTI being scheduled
+void sched::set_metric(uint32_t enb_cc_idx, sched::metric_dl* dl_metric_, sched::metric_ul* ul_metric_)
+{
+  if (enb_cc_idx < carrier_schedulers.size()) {
+    carrier_schedulers[enb_cc_idx]->set_metric(dl_metric_, ul_metric_);
+  }
+}
+
 int sched::cell_cfg(sched_interface::cell_cfg_t* cell_cfg)
 {
   cfg = *cell_cfg;
@@ -204,6 +222,13 @@ int sched::cell_cfg(sched_interface::cell_cfg_t* cell_cfg)
   for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
     c->carrier_cfg(sched_params);
   }
+
+  // Run the SCell scheduling passes of each TTI concurrently with the PCell one
+  uint32_t nof_workers = std::min(sched_params.sched_cfg.nof_carrier_workers, (uint32_t)carrier_schedulers.size() - 1);
+  if (nof_workers > 0 and carrier_workers == nullptr) {
+    carrier_workers.reset(new srslte::task_thread_pool(nof_workers));
+    carrier_workers->start();
+  }
   configured = true;
 
   return 0;
@@ -287,6 +312,20 @@ uint32_t sched::get_ul_buffer(uint16_t rnti)
   return ret;
 }
 
+void sched::get_ul_proactive_prb(uint16_t rnti, uint32_t* used_prb, uint32_t* wasted_prb)
+{
+  *used_prb   = 0;
+  *wasted_prb = 0;
+  ue_db_access(rnti, [used_prb, wasted_prb](sched_ue& ue) { ue.read_proactive_ul_prb(used_prb, wasted_prb); });
+}
+
+bool sched::ul_harq_active(uint32_t tti, uint16_t rnti, uint32_t cc_idx)
+{
+  bool ret = false;
+  ue_db_access(rnti, [tti, cc_idx, &ret](sched_ue& ue) { ret = ue.is_ul_harq_active(tti, cc_idx); });
+  return ret;
+}
+
 int sched::dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t retx_queue)
 {
   return ue_db_access(rnti,
@@ -303,6 +342,11 @@ int sched::dl_ant_info(uint16_t rnti, asn1::rrc::phys_cfg_ded_s::ant_info_c_* dl
   return ue_db_access(rnti, [dl_ant_info](sched_ue& ue) { ue.set_dl_ant_info(dl_ant_info); });
 }
 
+int sched::ue_sps_cfg(uint16_t rnti, const srslte::sps_cfg_t& sps_cfg)
+{
+  return ue_db_access(rnti, [&sps_cfg](sched_ue& ue) { ue.set_sps_cfg(sps_cfg); });
+}
+
 int sched::dl_ack_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t tb_idx, bool ack)
 {
   int ret = -1;
@@ -316,6 +360,11 @@ int sched::ul_crc_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, bool crc)
   return ue_db_access(rnti, [tti, cc_idx, crc](sched_ue& ue) { ue.set_ul_crc(tti, cc_idx, crc); });
 }
 
+int sched::ul_sdu_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_sdus)
+{
+  return ue_db_access(rnti, [tti, cc_idx, nof_sdus](sched_ue& ue) { ue.set_ul_sdu_info(tti, cc_idx, nof_sdus); });
+}
+
 int sched::dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t ri_value)
 {
   return ue_db_access(rnti, [tti, cc_idx, ri_value](sched_ue& ue) { ue.set_dl_ri(tti, cc_idx, ri_value); });
@@ -390,12 +439,13 @@ int sched::dl_sched(uint32_t tti, uint32_t cc_idx, sched_interface::dl_sched_res
     return 0;
   }
 
-  uint32_t tti_rx = sched_utils::tti_subtract(tti, TX_DELAY);
+  uint32_t tti_rx = sched_utils::tti_subtract(tti, srslte_fdd_harq_delay());
   current_tti     = sched_utils::max_tti(current_tti, tti_rx);
 
   if (cc_idx < carrier_schedulers.size()) {
     // Compute scheduling Result for tti_rx
     pthread_rwlock_rdlock(&rwlock);
+    generate_tti_results(tti_rx);
     tti_sched_result_t* tti_sched = carrier_schedulers[cc_idx]->generate_tti_result(tti_rx);
     pthread_rwlock_unlock(&rwlock);
 
@@ -414,10 +464,11 @@ int sched::ul_sched(uint32_t tti, uint32_t cc_idx, srsenb::sched_interface::ul_s
   }
 
   // Compute scheduling Result for tti_rx
-  uint32_t tti_rx = sched_utils::tti_subtract(tti, 2 * FDD_HARQ_DELAY_MS);
+  uint32_t tti_rx = sched_utils::tti_subtract(tti, 2 * srslte_fdd_harq_delay());
 
   if (cc_idx < carrier_schedulers.size()) {
     pthread_rwlock_rdlock(&rwlock);
+    generate_tti_results(tti_rx);
     tti_sched_result_t* tti_sched = carrier_schedulers[cc_idx]->generate_tti_result(tti_rx);
     pthread_rwlock_unlock(&rwlock);
 
@@ -434,6 +485,61 @@ int sched::ul_sched(uint32_t tti, uint32_t cc_idx, srsenb::sched_interface::ul_s
  *
  *******************************************************/
 
+/**
+ * Computes the scheduling result of all the carriers for a TTI. The UE state shared by the carriers is reconciled
+ * before their passes run, so they do not depend on each other's outcome and can run concurrently:
+ * - the pending new data of each UE is split among its carriers, which only allocate their share
+ * - HARQ entities are per carrier (sched_ue_carrier), and the buffers are consumed under the sched_ue mutex
+ * - PUCCH regions are reserved per carrier when configured, so there is nothing to reconcile per TTI
+ */
+void sched::generate_tti_results(uint32_t tti_rx)
+{
+  if (carrier_schedulers.size() == 1) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(tti_mutex);
+
+  // The TTI was already scheduled for all the carriers
+  if (carrier_schedulers[0]->get_tti_sched_view(tti_rx)->get_tti_rx() == tti_rx) {
+    return;
+  }
+
+  tti_params_t tti_params{tti_rx};
+  for (sched_ue& user : ue_db) {
+    user.new_tti(tti_params);
+  }
+
+  if (carrier_workers == nullptr) {
+    for (uint32_t enb_cc_idx = 1; enb_cc_idx < carrier_schedulers.size(); ++enb_cc_idx) {
+      carrier_schedulers[enb_cc_idx]->generate_tti_result(tti_rx);
+    }
+  } else {
+    {
+      std::lock_guard<std::mutex> workers_lock(carrier_workers_mutex);
+      nof_pending_carriers = carrier_schedulers.size() - 1;
+    }
+    for (uint32_t enb_cc_idx = 1; enb_cc_idx < carrier_schedulers.size(); ++enb_cc_idx) {
+      carrier_workers->push_task([this, enb_cc_idx, tti_rx](uint32_t worker_id) {
+        carrier_schedulers[enb_cc_idx]->generate_tti_result(tti_rx);
+        std::lock_guard<std::mutex> workers_lock(carrier_workers_mutex);
+        if (--nof_pending_carriers == 0) {
+          carrier_workers_cvar.notify_one();
+        }
+      });
+    }
+  }
+
+  carrier_schedulers[0]->generate_tti_result(tti_rx);
+
+  if (carrier_workers != nullptr) {
+    std::unique_lock<std::mutex> workers_lock(carrier_workers_mutex);
+    while (nof_pending_carriers > 0) {
+      carrier_workers_cvar.wait(workers_lock);
+    }
+  }
+}
+
 void sched::generate_cce_location(srslte_regs_t*             regs_,
                                   sched_ue::sched_dci_cce_t* location,
                                   uint32_t                   cfi,
@@ -464,9 +570,9 @@ int sched::ue_db_access(uint16_t rnti, Func f)
 {
   int ret = 0;
   pthread_rwlock_rdlock(&rwlock);
-  auto it = ue_db.find(rnti);
-  if (it != ue_db.end()) {
-    f(it->second);
+  sched_ue* user = ue_db.find(rnti);
+  if (user != nullptr) {
+    f(*user);
   } else {
     Error("User rnti=0x%x not found\n", rnti);
     ret = -1;
@@ -134,7 +134,7 @@ void bc_sched::reset()
  *                 RAR scheduling
  *******************************************************/
 
-ra_sched::ra_sched(const sched::cell_cfg_t& cfg_, srslte::log* log_, std::map<uint16_t, sched_ue>& ue_db_) :
+ra_sched::ra_sched(const sched::cell_cfg_t& cfg_, srslte::log* log_, sched_ue_db& ue_db_) :
   cfg(&cfg_),
   log_h(log_),
   ue_db(&ue_db_)
@@ -227,16 +227,16 @@ void ra_sched::ul_sched(tti_sched_result_t* tti_sched)
     return;
   }
 
-  uint16_t rnti    = pending_msg3[pending_tti].rnti;
-  auto     user_it = ue_db->find(rnti);
-  if (user_it == ue_db->end()) {
+  uint16_t  rnti = pending_msg3[pending_tti].rnti;
+  sched_ue* user = ue_db->find(rnti);
+  if (user == nullptr) {
     log_h->warning("SCHED: Msg3 allocated for user rnti=0x%x that no longer exists\n", rnti);
     return;
   }
 
   /* Allocate RBGs and HARQ for Msg3 */
   ul_harq_proc::ul_alloc_t msg3 = {pending_msg3[pending_tti].n_prb, pending_msg3[pending_tti].L};
-  if (not tti_sched->alloc_ul_msg3(&user_it->second, msg3, pending_msg3[pending_tti].mcs)) {
+  if (not tti_sched->alloc_ul_msg3(user, msg3, pending_msg3[pending_tti].mcs)) {
     log_h->warning("SCHED: Could not allocate msg3 within (%d,%d)\n", msg3.RB_start, msg3.RB_start + msg3.L);
     return;
   }
@@ -276,9 +276,7 @@ const ra_sched::pending_msg3_t& ra_sched::find_pending_msg3(uint32_t tti) const
  *                 Carrier scheduling
  *******************************************************/
 
-sched::carrier_sched::carrier_sched(rrc_interface_mac*            rrc_,
-                                    std::map<uint16_t, sched_ue>* ue_db_,
-                                    uint32_t                      enb_cc_idx_) :
+sched::carrier_sched::carrier_sched(rrc_interface_mac* rrc_, sched_ue_db* ue_db_, uint32_t enb_cc_idx_) :
   rrc(rrc_),
   ue_db(ue_db_),
   enb_cc_idx(enb_cc_idx_)
@@ -375,8 +373,8 @@ tti_sched_result_t* sched::carrier_sched::generate_tti_result(uint32_t tti_rx)
     tti_sched->generate_dcis();
 
     /* clean-up blocked pids */
-    for (auto& user : *ue_db) {
-      user.second.finish_tti(tti_sched->get_tti_params(), enb_cc_idx);
+    for (sched_ue& user : *ue_db) {
+      user.finish_tti(tti_sched->get_tti_params(), enb_cc_idx);
     }
   }
 
@@ -387,10 +385,9 @@ void sched::carrier_sched::generate_phich(tti_sched_result_t* tti_sched)
 {
   // Allocate user PHICHs
   uint32_t nof_phich_elems = 0;
-  for (auto& ue_pair : *ue_db) {
-    sched_ue& user = ue_pair.second;
-    uint16_t  rnti = ue_pair.first;
-    auto      p    = user.get_cell_index(enb_cc_idx);
+  for (sched_ue& user : *ue_db) {
+    uint16_t rnti = user.get_rnti();
+    auto     p    = user.get_cell_index(enb_cc_idx);
     if (not p.first) {
       // user does not support this carrier
       continue;
@@ -401,6 +398,18 @@ void sched::carrier_sched::generate_phich(tti_sched_result_t* tti_sched)
 
     ul_harq_proc* h = user.get_ul_harq(tti_sched->get_tti_rx(), cell_index);
 
+    /* When the TTI is scheduled ahead of the PHY, the CRC of the PUSCH received in tti_rx is not known yet. ACK it, so
+     * that the UE suspends the HARQ process instead of doing a non-adaptive retx in PRBs that may be given away, and
+     * retransmit adaptively once the CRC arrives */
+    if (sched_params->sched_cfg.tti_lookahead > 0) {
+      if (not h->is_empty(0) and h->get_tti() == tti_sched->get_tti_rx()) {
+        tti_sched->ul_sched_result.phich[nof_phich_elems].phich = ul_sched_phich_t::ACK;
+        tti_sched->ul_sched_result.phich[nof_phich_elems].rnti  = rnti;
+        nof_phich_elems++;
+      }
+      continue;
+    }
+
     /* Indicate PHICH acknowledgment if needed */
     if (h->has_pending_ack()) {
       tti_sched->ul_sched_result.phich[nof_phich_elems].phich =
@@ -433,6 +442,9 @@ void sched::carrier_sched::alloc_dl_users(tti_sched_result_t* tti_result)
     }
   }
 
+  /* Allocate the configured SPS DL assignments before the dynamic ones */
+  alloc_dl_sps(tti_result);
+
   // call DL scheduler metric to fill RB grid
   dl_metric->sched_users(*ue_db, tti_result, enb_cc_idx);
 }
@@ -459,12 +471,186 @@ int sched::carrier_sched::alloc_ul_users(tti_sched_result_t* tti_sched)
   }
   ul_mask |= pucch_mask;
 
+  /* Allocate the configured SPS UL grants, where the UEs transmit without PDCCH */
+  alloc_ul_sps(tti_sched);
+
   /* Call scheduler for UL data */
   ul_metric->sched_users(*ue_db, tti_sched, enb_cc_idx);
 
   return SRSLTE_SUCCESS;
 }
 
+void sched::carrier_sched::alloc_dl_sps(tti_sched_result_t* tti_result)
+{
+  uint32_t   tti_tx_dl = tti_result->get_tti_tx_dl();
+  rbgmask_t& dl_mask   = tti_result->get_dl_mask();
+
+  for (sched_ue& user : *ue_db) {
+    const srslte::sps_cfg_t& sps_cfg = user.get_sps_cfg();
+    auto                     p       = user.get_cell_index(enb_cc_idx);
+    if (not sps_cfg.dl_enabled or not p.first or p.second != 0) {
+      // SPS is only configured in the PCell
+      continue;
+    }
+    sched_sps_grant_t& grant   = user.get_sps_dl_grant();
+    uint32_t           pid     = user.get_sps_dl_pid(tti_tx_dl);
+    uint32_t           pending = user.get_pending_dl_new_data_total();
+    dl_harq_proc*      h       = user.get_dl_harq(pid, 0);
+
+    if (grant.release) {
+      // If there is no space in the PDCCH, the release is retried in the next TTI
+      tti_result->alloc_dl_sps(&user, rbgmask_t(dl_mask.size()), 0, tti_sched_result_t::dl_alloc_t::SPS_RELEASE);
+      continue;
+    }
+
+    if (grant.active) {
+      if (not grant.is_occasion(tti_tx_dl, sps_cfg.dl_interval)) {
+        continue;
+      }
+      if (pending == 0) {
+        grant.nof_empty++;
+        grant.release = grant.nof_empty >= sched_ue::SPS_DL_MAX_EMPTY;
+        continue;
+      }
+      grant.nof_empty = 0;
+
+      // The new transmission in the configured assignment flushes the HARQ process
+      if (not h->is_empty()) {
+        h->reset(0);
+      }
+      alloc_outcome_t ret =
+          tti_result->alloc_dl_sps(&user, grant.rbgmask, pid, tti_sched_result_t::dl_alloc_t::SPS_TX);
+      if (ret != alloc_outcome_t::SUCCESS) {
+        log_h->warning(
+            "SCHED: Could not allocate SPS DL occasion of rnti=0x%x: %s\n", user.get_rnti(), ret.to_string());
+      }
+      continue;
+    }
+
+    // The HARQ process field of the activation DCI is 0, so the grant is activated in a TTI whose configured HARQ
+    // process is 0 as well
+    if (pending == 0 or pid != 0 or not h->is_empty() or user.get_dci_format() != SRSLTE_DCI_FORMAT1 or
+        not user.can_activate_sps()) {
+      continue;
+    }
+    uint32_t mcs     = 0;
+    uint32_t nof_prb = user.get_required_prb_sps(SRSLTE_MIN(pending, sched_ue::SPS_MAX_GRANT_BYTES), false, &mcs);
+
+    // The configured RBGs are taken from the top of the band, away from the control allocations. The last RBG may
+    // have less than P PRBs
+    uint32_t  P        = sched_params->P;
+    uint32_t  cell_prb = sched_params->cfg->cell.nof_prb;
+    rbgmask_t mask(dl_mask.size());
+    uint32_t  run_prb = 0, run_end = dl_mask.size();
+    for (int i = dl_mask.size() - 1; i >= 0; --i) {
+      if (dl_mask.test(i)) {
+        run_prb = 0;
+        run_end = i;
+        continue;
+      }
+      run_prb += SRSLTE_MIN(P, cell_prb - i * P);
+      if (run_prb >= nof_prb) {
+        mask.fill(i, run_end);
+        break;
+      }
+    }
+    if (mask.none()) {
+      continue;
+    }
+
+    if (tti_result->alloc_dl_sps(&user, mask, pid, tti_sched_result_t::dl_alloc_t::SPS_ACTIVATION) ==
+        alloc_outcome_t::SUCCESS) {
+      grant.active    = true;
+      grant.release   = false;
+      grant.start_tti = tti_tx_dl;
+      grant.mcs       = mcs;
+      grant.rbgmask   = mask;
+      grant.nof_empty = 0;
+      log_h->info("SCHED: Activating SPS DL grant of rnti=0x%x, mask=0x%s, mcs=%d, interval=%d\n",
+                  user.get_rnti(),
+                  mask.to_hex().c_str(),
+                  mcs,
+                  sps_cfg.dl_interval);
+    }
+  }
+}
+
+void sched::carrier_sched::alloc_ul_sps(tti_sched_result_t* tti_sched)
+{
+  uint32_t   tti_tx_ul = tti_sched->get_tti_tx_ul();
+  prbmask_t& ul_mask   = tti_sched->get_ul_mask();
+
+  for (sched_ue& user : *ue_db) {
+    const srslte::sps_cfg_t& sps_cfg = user.get_sps_cfg();
+    auto                     p       = user.get_cell_index(enb_cc_idx);
+    if (not sps_cfg.ul_enabled or not p.first or p.second != 0) {
+      // SPS is only configured in the PCell
+      continue;
+    }
+    sched_sps_grant_t& grant   = user.get_sps_ul_grant();
+    uint32_t           pending = user.get_pending_ul_bsr();
+    ul_harq_proc*      h       = user.get_ul_harq(tti_tx_ul, 0);
+
+    if (grant.active) {
+      if (not grant.is_occasion(tti_tx_ul, sps_cfg.ul_interval)) {
+        continue;
+      }
+      // Mirror the implicit release of the UE. The new transmissions without MAC SDUs are counted from the decoded
+      // PUSCHs of the configured grant
+      if (grant.nof_empty >= sps_cfg.ul_implicit_release) {
+        log_h->info("SCHED: Implicit release of SPS UL grant of rnti=0x%x\n", user.get_rnti());
+        grant.reset();
+        continue;
+      }
+
+      // The UE transmits in every occasion, with padding if it has no data. The new transmission in the configured
+      // grant flushes the HARQ process
+      if (not h->is_empty(0)) {
+        h->reset(0);
+      }
+      alloc_outcome_t ret = tti_sched->alloc_ul_sps(&user, grant.alloc, grant.mcs, false);
+      if (ret != alloc_outcome_t::SUCCESS) {
+        log_h->warning(
+            "SCHED: Could not allocate SPS UL occasion of rnti=0x%x: %s\n", user.get_rnti(), ret.to_string());
+      }
+      continue;
+    }
+
+    if (pending == 0 or not h->is_empty(0) or not user.can_activate_sps()) {
+      continue;
+    }
+    uint32_t mcs     = 0;
+    uint32_t nof_prb = user.get_required_prb_sps(SRSLTE_MIN(pending, sched_ue::SPS_MAX_GRANT_BYTES), true, &mcs);
+
+    // The configured PRBs are taken from the top of the band, next to the PUCCH
+    ul_harq_proc::ul_alloc_t alloc    = {};
+    uint32_t                 nof_free = 0;
+    for (int i = ul_mask.size() - 1; i >= 0 and nof_free < nof_prb; --i) {
+      nof_free = ul_mask.test(i) ? 0 : nof_free + 1;
+      if (nof_free == nof_prb) {
+        alloc.set(i, nof_prb);
+      }
+    }
+    if (nof_free < nof_prb) {
+      continue;
+    }
+
+    if (tti_sched->alloc_ul_sps(&user, alloc, mcs, true) == alloc_outcome_t::SUCCESS) {
+      grant.active    = true;
+      grant.start_tti = tti_tx_ul;
+      grant.mcs       = mcs;
+      grant.alloc     = alloc;
+      grant.nof_empty = 0;
+      log_h->info("SCHED: Activating SPS UL grant of rnti=0x%x, prb=(%d,%d), mcs=%d, interval=%d\n",
+                  user.get_rnti(),
+                  alloc.RB_start,
+                  alloc.RB_end(),
+                  mcs,
+                  sps_cfg.ul_interval);
+    }
+  }
+}
+
 int sched::carrier_sched::dl_rach_info(dl_sched_rar_info_t rar_info)
 {
   std::lock_guard<std::mutex> lock(carrier_mutex);
@@ -92,89 +92,119 @@ const sched_ue::sched_dci_cce_t* pdcch_grid_t::get_cce_loc_table(alloc_type_t al
 
 bool pdcch_grid_t::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sched_ue* user)
 {
-  // TODO: Make the alloc tree update lazy
-
   /* Get DCI Location Table */
   const sched_ue::sched_dci_cce_t* dci_locs = get_cce_loc_table(alloc_type, user);
   if (dci_locs == nullptr) {
     return false;
   }
 
-  /* Search for potential DCI positions */
-  if (prev_end > 0) {
-    for (size_t j = prev_start; j < prev_end; ++j) {
-      update_alloc_tree((int)j, aggr_idx, user, alloc_type, dci_locs);
-    }
-  } else {
-    update_alloc_tree(-1, aggr_idx, user, alloc_type, dci_locs);
-  }
+  alloc_record_t record;
+  record.alloc_type = alloc_type;
+  record.aggr_idx   = aggr_idx;
+  record.user       = user;
+  record.dci_locs   = dci_locs;
+  record_list.push_back(record);
 
-  // if no pdcch space was available
-  if (dci_alloc_tree.size() == prev_end) {
-    return false;
-  }
+  alloc_t alloc;
+  alloc.rnti      = (user != nullptr) ? user->get_rnti() : (uint16_t)0u;
+  alloc.dci_pos.L = aggr_idx;
+  alloc_list.push_back(alloc);
 
-  prev_start = prev_end;
-  prev_end   = dci_alloc_tree.size();
+  /* Greedy placement on top of the current solution */
+  if (place_dci(alloc_list.size() - 1, 0)) {
+    return true;
+  }
 
-  nof_dci_allocs++;
+  /* Relocate the previous DCIs to make room for the new one */
+  if (relocate_dcis()) {
+    return true;
+  }
 
-  return true;
+  // if no pdcch space was available
+  record_list.pop_back();
+  alloc_list.pop_back();
+  return false;
 }
 
-void pdcch_grid_t::update_alloc_tree(int                              parent_node_idx,
-                                     uint32_t                         aggr_idx,
-                                     sched_ue*                        user,
-                                     alloc_type_t                     alloc_type,
-                                     const sched_ue::sched_dci_cce_t* dci_locs)
+//! Places the DCI at position idx in the first free candidate, starting from first_loc_idx, that does not collide
+//! with the DCIs placed before it
+bool pdcch_grid_t::place_dci(size_t idx, uint32_t first_loc_idx)
 {
-  alloc_t alloc;
-  alloc.rnti      = (user != nullptr) ? user->get_rnti() : (uint16_t)0u;
-  alloc.dci_pos.L = aggr_idx;
-
-  // get cumulative pdcch mask
-  pdcch_mask_t cum_mask;
-  if (parent_node_idx >= 0) {
-    cum_mask = dci_alloc_tree[parent_node_idx].second.total_mask;
-  } else {
-    cum_mask.resize(nof_cces());
-  }
+  alloc_record_t& record = record_list[idx];
+  alloc_t&        alloc  = alloc_list[idx];
 
-  uint32_t nof_locs = dci_locs->nof_loc[aggr_idx];
-  for (uint32_t i = 0; i < nof_locs; ++i) {
-    uint32_t startpos = dci_locs->cce_start[aggr_idx][i];
+  uint32_t nof_locs = record.dci_locs->nof_loc[record.aggr_idx];
+  for (uint32_t i = first_loc_idx; i < nof_locs; ++i) {
+    uint32_t startpos = record.dci_locs->cce_start[record.aggr_idx][i];
 
-    if (alloc_type == alloc_type_t::DL_DATA and user->pucch_sr_collision(tti_params->tti_tx_dl, startpos)) {
+    if (record.alloc_type == alloc_type_t::DL_DATA and
+        record.user->pucch_sr_collision(tti_params->tti_tx_dl, startpos)) {
       // will cause a collision in the PUCCH
       continue;
     }
 
     pdcch_mask_t alloc_mask(nof_cces());
-    alloc_mask.fill(startpos, startpos + (1u << aggr_idx));
-    if ((cum_mask & alloc_mask).any()) {
+    alloc_mask.fill(startpos, startpos + (1u << record.aggr_idx));
+    if (idx > 0 and (alloc_list[idx - 1].total_mask & alloc_mask).any()) {
       // there is collision. Try another mask
       continue;
     }
 
     // Allocation successful
     alloc.current_mask = alloc_mask;
-    alloc.total_mask   = cum_mask | alloc_mask;
+    alloc.total_mask   = alloc_mask;
+    if (idx > 0) {
+      alloc.total_mask |= alloc_list[idx - 1].total_mask;
+    }
     alloc.dci_pos.ncce = startpos;
+    record.loc_idx     = i;
+    return true;
+  }
+  return false;
+}
 
-    // Prune if repetition
-    uint32_t j = prev_end;
-    for (; j < dci_alloc_tree.size(); ++j) {
-      if (dci_alloc_tree[j].second.total_mask == alloc.total_mask) {
+//! Depth-first search over the candidates of the already placed DCIs, in allocation order, for a solution that also
+//! fits the last DCI. The search resumes from the current solution, so the first solution found is the same the
+//! exhaustive search would pick. The number of visited nodes per TTI is bounded by max_search_nodes.
+bool pdcch_grid_t::relocate_dcis()
+{
+  size_t last_idx = alloc_list.size() - 1;
+  if (last_idx == 0 or search_nodes >= max_search_nodes) {
+    return false;
+  }
+
+  // save current solution, in case the search fails
+  saved_alloc_list.assign(alloc_list.begin(), alloc_list.end() - 1);
+  saved_loc_idxs.resize(last_idx);
+  for (size_t i = 0; i < last_idx; ++i) {
+    saved_loc_idxs[i] = record_list[i].loc_idx;
+  }
+
+  size_t   idx      = last_idx - 1;
+  uint32_t next_loc = record_list[idx].loc_idx + 1;
+  while (search_nodes < max_search_nodes) {
+    search_nodes++;
+    if (place_dci(idx, next_loc)) {
+      if (idx == last_idx) {
+        return true;
+      }
+      idx++;
+      next_loc = 0;
+    } else {
+      if (idx == 0) {
         break;
       }
+      idx--;
+      next_loc = record_list[idx].loc_idx + 1;
     }
-    if (j < dci_alloc_tree.size()) {
-      continue;
-    }
+  }
 
-    // Register allocation
-    dci_alloc_tree.emplace_back(parent_node_idx, alloc);
+  // restore previous solution
+  std::copy(saved_alloc_list.begin(), saved_alloc_list.end(), alloc_list.begin());
+  for (size_t i = 0; i < last_idx; ++i) {
+    record_list[i].loc_idx = saved_loc_idxs[i];
   }
+  return false;
 }
 
 bool pdcch_grid_t::set_cfi(uint32_t cfi)
@@ -192,68 +222,52 @@ uint32_t pdcch_grid_t::nof_cces() const
 
 void pdcch_grid_t::reset()
 {
-  prev_start = 0;
-  prev_end   = 0;
-  dci_alloc_tree.clear();
-  nof_dci_allocs = 0;
+  alloc_list.clear();
+  record_list.clear();
+  search_nodes = 0;
 }
 
-void pdcch_grid_t::get_allocs(alloc_result_t* vec, pdcch_mask_t* tot_mask, size_t idx) const
+void pdcch_grid_t::get_allocs(alloc_result_t* vec, pdcch_mask_t* tot_mask) const
 {
-  // if alloc tree is empty
-  if (prev_start == prev_end) {
-    if (vec != nullptr) {
-      vec->clear();
-    }
-    if (tot_mask != nullptr) {
-      tot_mask->reset();
-    }
-    return;
-  }
-
   // set vector of allocations
   if (vec != nullptr) {
     vec->clear();
-    size_t i = prev_start + idx;
-    while (dci_alloc_tree[i].first >= 0) {
-      vec->push_back(&dci_alloc_tree[i].second);
-      i = (size_t)dci_alloc_tree[i].first;
+    for (const auto& alloc : alloc_list) {
+      vec->push_back(&alloc);
     }
-    vec->push_back(&dci_alloc_tree[i].second);
-    std::reverse(vec->begin(), vec->end());
   }
 
   // set final cce mask
   if (tot_mask != nullptr) {
-    *tot_mask = dci_alloc_tree[prev_start + idx].second.total_mask;
+    if (alloc_list.empty()) {
+      tot_mask->reset();
+    } else {
+      *tot_mask = alloc_list.back().total_mask;
+    }
   }
 }
 
 std::string pdcch_grid_t::result_to_string(bool verbose) const
 {
   std::stringstream ss;
-  ss << "cfi=" << get_cfi() << ", mask_size=" << nof_cces() << ", " << prev_end - prev_start
-     << " DCI allocation combinations:\n";
-  // get all the possible combinations of DCI allocations
-  uint32_t count = 0;
-  for (size_t i = prev_start; i < prev_end; ++i) {
-    alloc_result_t vec;
-    pdcch_mask_t   tot_mask;
-    get_allocs(&vec, &tot_mask, i - prev_start);
-
-    ss << "                          combination " << count << ": mask=0x" << tot_mask.to_hex().c_str();
-    if (verbose) {
-      ss << ", DCI allocs:\n";
-      for (const auto& dci_alloc : vec) {
-        char hex[5];
-        sprintf(hex, "%x", dci_alloc->rnti);
-        ss << "                          > rnti=0x" << hex << ": " << dci_alloc->current_mask.to_hex().c_str() << " / "
-           << dci_alloc->total_mask.to_hex().c_str() << "\n";
-      }
-    } else {
-      ss << "\n";
+  ss << "cfi=" << get_cfi() << ", mask_size=" << nof_cces() << ", " << alloc_list.size() << " DCI allocations, "
+     << search_nodes << " search nodes";
+  if (alloc_list.empty()) {
+    ss << "\n";
+    return ss.str();
+  }
+
+  ss << ", mask=0x" << alloc_list.back().total_mask.to_hex().c_str();
+  if (verbose) {
+    ss << ", DCI allocs:\n";
+    for (const auto& dci_alloc : alloc_list) {
+      char hex[5];
+      sprintf(hex, "%x", dci_alloc.rnti);
+      ss << "                          > rnti=0x" << hex << ": " << dci_alloc.current_mask.to_hex().c_str() << " / "
+         << dci_alloc.total_mask.to_hex().c_str() << "\n";
     }
-    count++;
+  } else {
+    ss << "\n";
   }
 
   return ss.str();
@@ -341,12 +355,27 @@ tti_grid_t::dl_ctrl_alloc_t tti_grid_t::alloc_dl_ctrl(uint32_t aggr_lvl, alloc_t
 //! Allocates CCEs and RBs for a user DL data alloc.
 alloc_outcome_t tti_grid_t::alloc_dl_data(sched_ue* user, const rbgmask_t& user_mask)
 {
-  srslte_dci_format_t dci_format = user->get_dci_format();
-  uint32_t            nof_bits   = srslte_dci_format_sizeof(&sched_params->cfg->cell, nullptr, nullptr, dci_format);
-  uint32_t            aggr_level = user->get_ue_carrier(cc_idx)->get_aggr_level(nof_bits);
+  return alloc_dl_data(user, user_mask, user->get_dci_format());
+}
+
+alloc_outcome_t tti_grid_t::alloc_dl_data(sched_ue* user, const rbgmask_t& user_mask, srslte_dci_format_t dci_format)
+{
+  uint32_t nof_bits   = srslte_dci_format_sizeof(&sched_params->cfg->cell, nullptr, nullptr, dci_format);
+  uint32_t aggr_level = user->get_ue_carrier(cc_idx)->get_aggr_level(nof_bits);
   return alloc_dl(aggr_level, alloc_type_t::DL_DATA, user_mask, user);
 }
 
+//! Reserves RBGs without DCI, e.g. for the transmissions in configured SPS DL assignments
+alloc_outcome_t tti_grid_t::reserve_dl_rbgs(const rbgmask_t& alloc_mask)
+{
+  if ((dl_mask & alloc_mask).any()) {
+    return alloc_outcome_t::RB_COLLISION;
+  }
+  dl_mask |= alloc_mask;
+  avail_rbg -= alloc_mask.count();
+  return alloc_outcome_t::SUCCESS;
+}
+
 alloc_outcome_t tti_grid_t::alloc_ul_data(sched_ue* user, ul_harq_proc::ul_alloc_t alloc, bool needs_pdcch)
 {
   if (alloc.RB_start + alloc.L > ul_mask.size()) {
@@ -554,15 +583,15 @@ alloc_outcome_t tti_sched_result_t::alloc_ul(sched_ue*
     return alloc_outcome_t::ERROR;
   }
 
+  ul_alloc_t ul_alloc = {};
+  ul_alloc.type       = alloc_type;
+
   // Allocate RBGs and DCI space
-  bool            needs_pdcch = alloc_type == ul_alloc_t::ADAPT_RETX or alloc_type == ul_alloc_t::NEWTX;
-  alloc_outcome_t ret         = tti_alloc.alloc_ul_data(user, alloc, needs_pdcch);
+  alloc_outcome_t ret = tti_alloc.alloc_ul_data(user, alloc, ul_alloc.needs_pdcch());
   if (ret != alloc_outcome_t::SUCCESS) {
     return ret;
   }
 
-  ul_alloc_t ul_alloc = {};
-  ul_alloc.type       = alloc_type;
   ul_alloc.dci_idx    = tti_alloc.get_pdcch_grid().nof_allocs() - 1;
   ul_alloc.user_ptr   = user;
   ul_alloc.alloc      = alloc;
@@ -580,7 +609,9 @@ alloc_outcome_t tti_sched_result_t::alloc_ul_user(sched_ue* user, ul_harq_proc::
   bool          has_retx = h->has_pending_retx();
   if (has_retx) {
     ul_harq_proc::ul_alloc_t prev_alloc = h->get_alloc();
-    if (prev_alloc.L == alloc.L and prev_alloc.RB_start == prev_alloc.L) {
+    // The PHICH of TTIs scheduled ahead of the PHY is always an ACK, so the retxs need a PDCCH
+    if (sched_params->sched_cfg.tti_lookahead == 0 and prev_alloc.L == alloc.L and
+        prev_alloc.RB_start == prev_alloc.L) {
       alloc_type = ul_alloc_t::NOADAPT_RETX;
     } else {
       alloc_type = ul_alloc_t::ADAPT_RETX;
@@ -597,6 +628,52 @@ alloc_outcome_t tti_sched_result_t::alloc_ul_msg3(sched_ue* user, ul_harq_proc::
   return alloc_ul(user, alloc, ul_alloc_t::MSG3, mcs);
 }
 
+//! Allocates the activation, release or a transmission without PDCCH of the configured SPS DL assignment of a user
+alloc_outcome_t tti_sched_result_t::alloc_dl_sps(sched_ue*          user,
+                                                 const rbgmask_t&   user_mask,
+                                                 uint32_t           pid,
+                                                 dl_alloc_t::type_t type)
+{
+  if (is_dl_alloc(user)) {
+    log_h->warning("SCHED: Attempt to assign multiple harq pids to the same user rnti=0x%x\n", user->get_rnti());
+    return alloc_outcome_t::ERROR;
+  }
+
+  alloc_outcome_t ret;
+  switch (type) {
+    case dl_alloc_t::SPS_ACTIVATION:
+      ret = tti_alloc.alloc_dl_data(user, user_mask, SRSLTE_DCI_FORMAT1);
+      break;
+    case dl_alloc_t::SPS_RELEASE:
+      ret = tti_alloc.alloc_dl_data(user, rbgmask_t(user_mask.size()), SRSLTE_DCI_FORMAT1A);
+      break;
+    case dl_alloc_t::SPS_TX:
+      ret = tti_alloc.reserve_dl_rbgs(user_mask);
+      break;
+    default:
+      return alloc_outcome_t::ERROR;
+  }
+  if (ret != alloc_outcome_t::SUCCESS) {
+    return ret;
+  }
+
+  dl_alloc_t alloc;
+  alloc.dci_idx   = tti_alloc.get_pdcch_grid().nof_allocs() - 1;
+  alloc.type      = type;
+  alloc.user_ptr  = user;
+  alloc.user_mask = type == dl_alloc_t::SPS_RELEASE ? rbgmask_t(user_mask.size()) : user_mask;
+  alloc.pid       = pid;
+  data_allocs.push_back(alloc);
+
+  return alloc_outcome_t::SUCCESS;
+}
+
+alloc_outcome_t
+tti_sched_result_t::alloc_ul_sps(sched_ue* user, ul_harq_proc::ul_alloc_t alloc, uint32_t mcs, bool activation)
+{
+  return alloc_ul(user, alloc, activation ? ul_alloc_t::SPS_ACTIVATION : ul_alloc_t::SPS_TX, mcs);
+}
+
 void tti_sched_result_t::set_bc_sched_result(const pdcch_grid_t::alloc_result_t& dci_result)
 {
   for (const auto& bc_alloc : bc_allocs) {
@@ -719,10 +796,23 @@ void tti_sched_result_t::set_dl_data_sched_result(const pdcch_grid_t::alloc_resu
     sched_interface::dl_sched_data_t* data = &dl_sched_result.data[dl_sched_result.nof_data_elems];
 
     // Assign NCCE/L
-    data->dci.location = dci_result[data_alloc.dci_idx]->dci_pos;
+    if (data_alloc.needs_pdcch()) {
+      data->dci.location = dci_result[data_alloc.dci_idx]->dci_pos;
+    }
+
+    // Release of the configured SPS DL assignment, without PDSCH
+    sched_ue* user = data_alloc.user_ptr;
+    if (data_alloc.type == dl_alloc_t::SPS_RELEASE) {
+      user->generate_sps_release(data);
+      log_h->info("SCHED: DL SPS release rnti=0x%x, dci=(%d,%d)\n",
+                  user->get_rnti(),
+                  data->dci.location.L,
+                  data->dci.location.ncce);
+      dl_sched_result.nof_data_elems++;
+      continue;
+    }
 
     // Generate DCI Format1/2/2A
-    sched_ue*           user        = data_alloc.user_ptr;
     uint32_t            cell_index  = user->get_cell_index(enb_cc_idx).second;
     dl_harq_proc*       h           = user->get_dl_harq(data_alloc.pid, cell_index);
     uint32_t            data_before = user->get_pending_dl_new_data();
@@ -730,18 +820,29 @@ void tti_sched_result_t::set_dl_data_sched_result(const pdcch_grid_t::alloc_resu
     bool                is_newtx    = h->is_empty();
 
     int tbs = 0;
-    switch (dci_format) {
-      case SRSLTE_DCI_FORMAT1:
-        tbs = user->generate_format1(h, data, get_tti_tx_dl(), cell_index, get_cfi(), data_alloc.user_mask);
-        break;
-      case SRSLTE_DCI_FORMAT2:
-        tbs = user->generate_format2(h, data, get_tti_tx_dl(), cell_index, get_cfi(), data_alloc.user_mask);
-        break;
-      case SRSLTE_DCI_FORMAT2A:
-        tbs = user->generate_format2a(h, data, get_tti_tx_dl(), cell_index, get_cfi(), data_alloc.user_mask);
-        break;
-      default:
-        Error("DCI format (%d) not implemented\n", dci_format);
+    if (data_alloc.type != dl_alloc_t::DATA) {
+      tbs = user->generate_sps_format1(h,
+                                       data,
+                                       get_tti_tx_dl(),
+                                       cell_index,
+                                       get_cfi(),
+                                       data_alloc.user_mask,
+                                       data_alloc.type == dl_alloc_t::SPS_ACTIVATION);
+    } else {
+      data->needs_pdcch = true;
+      switch (dci_format) {
+        case SRSLTE_DCI_FORMAT1:
+          tbs = user->generate_format1(h, data, get_tti_tx_dl(), cell_index, get_cfi(), data_alloc.user_mask);
+          break;
+        case SRSLTE_DCI_FORMAT2:
+          tbs = user->generate_format2(h, data, get_tti_tx_dl(), cell_index, get_cfi(), data_alloc.user_mask);
+          break;
+        case SRSLTE_DCI_FORMAT2A:
+          tbs = user->generate_format2a(h, data, get_tti_tx_dl(), cell_index, get_cfi(), data_alloc.user_mask);
+          break;
+        default:
+          Error("DCI format (%d) not implemented\n", dci_format);
+      }
     }
 
     if (tbs <= 0) {
@@ -756,7 +857,8 @@ void tti_sched_result_t::set_dl_data_sched_result(const pdcch_grid_t::alloc_resu
     }
 
     // Print Resulting DL Allocation
-    log_h->info("SCHED: DL %s rnti=0x%x, pid=%d, mask=0x%s, dci=(%d,%d), n_rtx=%d, tbs=%d, buffer=%d/%d\n",
+    log_h->info("SCHED: DL %s%s rnti=0x%x, pid=%d, mask=0x%s, dci=(%d,%d), n_rtx=%d, tbs=%d, buffer=%d/%d\n",
+                data_alloc.type == dl_alloc_t::DATA ? "" : "SPS ",
                 !is_newtx ? "retx" : "tx",
                 user->get_rnti(),
                 h->get_id(),
@@ -787,12 +889,18 @@ void tti_sched_result_t::set_ul_sched_result(const pdcch_grid_t::alloc_result_t&
     }
 
     /* Set fixed mcs if specified */
-    int fixed_mcs = (ul_alloc.type == ul_alloc_t::MSG3) ? ul_alloc.mcs : -1;
+    int fixed_mcs = (ul_alloc.type == ul_alloc_t::MSG3 or ul_alloc.is_sps()) ? ul_alloc.mcs : -1;
 
     /* Generate DCI Format1A */
-    uint32_t pending_data_before = user->get_pending_ul_new_data(get_tti_tx_ul());
-    int      tbs                 = user->generate_format0(
-        pusch, get_tti_tx_ul(), cell_index, ul_alloc.alloc, ul_alloc.needs_pdcch(), cce_range, fixed_mcs);
+    uint32_t pending_data_before = user->get_pending_ul_new_data(get_tti_tx_ul(), cell_index);
+    int      tbs                 = user->generate_format0(pusch,
+                                                          get_tti_tx_ul(),
+                                                          cell_index,
+                                                          ul_alloc.alloc,
+                                                          ul_alloc.needs_pdcch(),
+                                                          cce_range,
+                                                          fixed_mcs,
+                                                          ul_alloc.is_sps());
 
     ul_harq_proc* h = user->get_ul_harq(get_tti_tx_ul(), cell_index);
     if (tbs <= 0) {
@@ -806,19 +914,19 @@ void tti_sched_result_t::set_ul_sched_result(const pdcch_grid_t::alloc_result_t&
                      ul_alloc.alloc.RB_start,
                      ul_alloc.alloc.RB_start + ul_alloc.alloc.L,
                      tbs,
-                     user->get_pending_ul_new_data(get_tti_tx_ul()));
+                     user->get_pending_ul_new_data(get_tti_tx_ul(), cell_index));
       continue;
     }
 
     // Allocation was successful
-    if (ul_alloc.type == ul_alloc_t::NEWTX) {
+    if (ul_alloc.type == ul_alloc_t::NEWTX or ul_alloc.is_sps()) {
       // Un-trigger SR
       user->unset_sr();
     }
 
     // Print Resulting UL Allocation
     log_h->info("SCHED: %s %s rnti=0x%x, pid=%d, dci=(%d,%d), prb=(%d,%d), n_rtx=%d, tbs=%d, bsr=%d (%d-%d)\n",
-                ul_alloc.is_msg3() ? "Msg3" : "UL",
+                ul_alloc.is_msg3() ? "Msg3" : (ul_alloc.is_sps() ? "UL SPS" : "UL"),
                 ul_alloc.is_retx() ? "retx" : "tx",
                 user->get_rnti(),
                 h->get_id(),
@@ -828,7 +936,7 @@ void tti_sched_result_t::set_ul_sched_result(const pdcch_grid_t::alloc_result_t&
                 ul_alloc.alloc.RB_start + ul_alloc.alloc.L,
                 h->nof_retx(0),
                 tbs,
-                user->get_pending_ul_new_data(get_tti_tx_ul()),
+                user->get_pending_ul_new_data(get_tti_tx_ul(), cell_index),
                 pending_data_before,
                 user->get_pending_ul_old_data(cell_index));
 
@@ -21,6 +21,7 @@
 
 #include "srsenb/hdr/stack/mac/scheduler_metric.h"
 #include "srsenb/hdr/stack/mac/scheduler_harq.h"
+#include <algorithm>
 #include <string.h>
 
 #define Error(fmt, ...) log_h->error(fmt, ##__VA_ARGS__)
@@ -38,10 +39,24 @@ namespace srsenb {
 
 void dl_metric_rr::set_params(const sched_params_t& sched_params_)
 {
-  log_h = sched_params_.log_h;
+  log_h         = sched_params_.log_h;
+  tti_lookahead = sched_params_.sched_cfg.tti_lookahead;
 }
 
-void dl_metric_rr::sched_users(std::map<uint16_t, sched_ue>& ue_db, dl_tti_sched_t* tti_sched, uint32_t enb_cc_idx)
+/* Returns the DL HARQ process of the user to retransmit in tti_dl, if any. When scheduling ahead of the PHY, the ACKs
+ * of the transmissions of the last 2k + tti_lookahead TTIs may not have been received yet, so these HARQ processes
+ * are not retransmitted */
+dl_harq_proc* dl_metric_rr::get_pending_dl_harq(sched_ue* user, uint32_t tti_dl, uint32_t cell_idx)
+{
+  dl_harq_proc* h = user->get_pending_dl_harq(tti_dl, cell_idx);
+  if (tti_lookahead > 0 and h != nullptr and not h->is_empty() and
+      srslte_tti_interval(tti_dl, h->get_tti()) < srslte_fdd_nof_harq() + tti_lookahead) {
+    return nullptr;
+  }
+  return h;
+}
+
+void dl_metric_rr::sched_users(sched_ue_db& ue_db, dl_tti_sched_t* tti_sched, uint32_t enb_cc_idx)
 {
   tti_alloc = tti_sched;
 
@@ -50,15 +65,10 @@ void dl_metric_rr::sched_users(std::map<uint16_t, sched_ue>& ue_db, dl_tti_sched
   }
 
   // give priority in a time-domain RR basis
-  uint32_t priority_idx = tti_alloc->get_tti_tx_dl() % (uint32_t)ue_db.size();
-  auto     iter         = ue_db.begin();
-  std::advance(iter, priority_idx);
-  for (uint32_t ue_count = 0; ue_count < ue_db.size(); ++iter, ++ue_count) {
-    if (iter == ue_db.end()) {
-      iter = ue_db.begin(); // wrap around
-    }
-    sched_ue* user = &iter->second;
-    allocate_user(user, enb_cc_idx);
+  uint32_t nof_ues      = (uint32_t)ue_db.size();
+  uint32_t priority_idx = tti_alloc->get_tti_tx_dl() % nof_ues;
+  for (uint32_t ue_count = 0; ue_count < nof_ues; ++ue_count) {
+    allocate_user(&ue_db.at((priority_idx + ue_count) % nof_ues), enb_cc_idx);
   }
 }
 
@@ -91,8 +101,8 @@ dl_harq_proc* dl_metric_rr::allocate_user(sched_ue* user, uint32_t enb_cc_idx)
   // TODO: First do reTxs for all users. Only then do the rest.
   alloc_outcome_t code;
   uint32_t        tti_dl    = tti_alloc->get_tti_tx_dl();
-  dl_harq_proc*   h         = user->get_pending_dl_harq(tti_dl, cell_idx);
-  uint32_t        req_bytes = user->get_pending_dl_new_data_total();
+  dl_harq_proc*   h         = get_pending_dl_harq(user, tti_dl, cell_idx);
+  uint32_t        req_bytes = user->get_pending_dl_new_data_total(cell_idx);
 
   // Schedule retx if we have space
 #if ASYNC_DL_SCHED
@@ -157,10 +167,11 @@ dl_harq_proc* dl_metric_rr::allocate_user(sched_ue* user, uint32_t enb_cc_idx)
 
 void ul_metric_rr::set_params(const sched_params_t& sched_params_)
 {
-  log_h = sched_params_.log_h;
+  log_h         = sched_params_.log_h;
+  tti_lookahead = sched_params_.sched_cfg.tti_lookahead;
 }
 
-void ul_metric_rr::sched_users(std::map<uint16_t, sched_ue>& ue_db, ul_tti_sched_t* tti_sched, uint32_t enb_cc_idx)
+void ul_metric_rr::sched_users(sched_ue_db& ue_db, ul_tti_sched_t* tti_sched, uint32_t enb_cc_idx)
 {
   tti_alloc   = tti_sched;
   current_tti = tti_alloc->get_tti_tx_ul();
@@ -170,29 +181,17 @@ void ul_metric_rr::sched_users(std::map<uint16_t, sched_ue>& ue_db, ul_tti_sched
   }
 
   // give priority in a time-domain RR basis
-  uint32_t priority_idx =
-      (current_tti + (uint32_t)ue_db.size() / 2) % (uint32_t)ue_db.size(); // make DL and UL interleaved
+  uint32_t nof_ues      = (uint32_t)ue_db.size();
+  uint32_t priority_idx = (current_tti + nof_ues / 2) % nof_ues; // make DL and UL interleaved
 
   // allocate reTxs first
-  auto iter = ue_db.begin();
-  std::advance(iter, priority_idx);
-  for (uint32_t ue_count = 0; ue_count < ue_db.size(); ++iter, ++ue_count) {
-    if (iter == ue_db.end()) {
-      iter = ue_db.begin(); // wrap around
-    }
-    sched_ue* user = &iter->second;
-    allocate_user_retx_prbs(user, enb_cc_idx);
+  for (uint32_t ue_count = 0; ue_count < nof_ues; ++ue_count) {
+    allocate_user_retx_prbs(&ue_db.at((priority_idx + ue_count) % nof_ues), enb_cc_idx);
   }
 
   // give priority in a time-domain RR basis
-  iter = ue_db.begin();
-  std::advance(iter, priority_idx);
-  for (uint32_t ue_count = 0; ue_count < ue_db.size(); ++iter, ++ue_count) {
-    if (iter == ue_db.end()) {
-      iter = ue_db.begin(); // wrap around
-    }
-    sched_ue* user = &iter->second;
-    allocate_user_newtx_prbs(user, enb_cc_idx);
+  for (uint32_t ue_count = 0; ue_count < nof_ues; ++ue_count) {
+    allocate_user_newtx_prbs(&ue_db.at((priority_idx + ue_count) % nof_ues), enb_cc_idx);
   }
 }
 
@@ -248,6 +247,12 @@ ul_harq_proc* ul_metric_rr::allocate_user_retx_prbs(sched_ue* user, uint32_t enb
   alloc_outcome_t ret;
   ul_harq_proc*   h = user->get_ul_harq(current_tti, cell_idx);
 
+  // When scheduling ahead of the PHY, the CRC of the last transmission of this pid (received in tti_rx) is not known
+  // yet, and the NACK state is the one set by its own (re)transmission
+  if (tti_lookahead > 0 and h->get_tti() == TTI_SUB(current_tti, srslte_fdd_nof_harq())) {
+    return nullptr;
+  }
+
   // if there are procedures and we have space
   if (h->has_pending_retx()) {
     ul_harq_proc::ul_alloc_t alloc = h->get_alloc();
@@ -287,7 +292,7 @@ ul_harq_proc* ul_metric_rr::allocate_user_newtx_prbs(sched_ue* user, uint32_t en
   }
   uint32_t cell_idx = p.second;
 
-  uint32_t      pending_data = user->get_pending_ul_new_data(current_tti);
+  uint32_t      pending_data = user->get_pending_ul_new_data(current_tti, cell_idx);
   ul_harq_proc* h            = user->get_ul_harq(current_tti, cell_idx);
 
   // find an empty PID
@@ -309,4 +314,89 @@ ul_harq_proc* ul_metric_rr::allocate_user_newtx_prbs(sched_ue* user, uint32_t en
   return nullptr;
 }
 
+/*****************************************************************
+ *
+ * Earliest Deadline First Metrics
+ *
+ *****************************************************************/
+
+static bool deadline_cmp(const sched_deadline_t& a, const sched_deadline_t& b)
+{
+  if (a.retx != b.retx) {
+    return a.retx;
+  }
+  if (a.slack_ms != b.slack_ms) {
+    return a.slack_ms < b.slack_ms;
+  }
+  return a.rr_idx < b.rr_idx;
+}
+
+void dl_metric_edf::sched_users(sched_ue_db& ue_db, dl_tti_sched_t* tti_sched, uint32_t enb_cc_idx)
+{
+  tti_alloc = tti_sched;
+
+  if (ue_db.empty()) {
+    return;
+  }
+
+  // pending reTxs go first, then the users closest to their delay budget. Ties are broken in a time-domain RR basis
+  uint32_t tti_dl       = tti_alloc->get_tti_tx_dl();
+  uint32_t nof_ues      = (uint32_t)ue_db.size();
+  uint32_t priority_idx = tti_dl % nof_ues;
+  ue_order.clear();
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    sched_deadline_t d = {};
+    d.user             = &ue_db.at(i);
+    d.rr_idx           = (i + nof_ues - priority_idx) % nof_ues;
+    auto p             = d.user->get_cell_index(enb_cc_idx);
+    if (not p.first) {
+      continue;
+    }
+    dl_harq_proc* h = get_pending_dl_harq(d.user, tti_dl, p.second);
+#if ASYNC_DL_SCHED
+    d.retx = h != nullptr;
+#else
+    d.retx = h != nullptr and not h->is_empty();
+#endif
+    d.slack_ms = d.user->get_dl_slack_ms(tti_dl);
+    ue_order.push_back(d);
+  }
+  std::sort(ue_order.begin(), ue_order.end(), deadline_cmp);
+
+  for (sched_deadline_t& d : ue_order) {
+    allocate_user(d.user, enb_cc_idx);
+  }
+}
+
+void ul_metric_edf::sched_users(sched_ue_db& ue_db, ul_tti_sched_t* tti_sched, uint32_t enb_cc_idx)
+{
+  tti_alloc   = tti_sched;
+  current_tti = tti_alloc->get_tti_tx_ul();
+
+  if (ue_db.empty()) {
+    return;
+  }
+
+  // same RR tie-break as ul_metric_rr, so that DL and UL stay interleaved
+  uint32_t nof_ues      = (uint32_t)ue_db.size();
+  uint32_t priority_idx = (current_tti + nof_ues / 2) % nof_ues;
+  ue_order.clear();
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    sched_deadline_t d = {};
+    d.user             = &ue_db.at(i);
+    d.rr_idx           = (i + nof_ues - priority_idx) % nof_ues;
+    d.slack_ms         = d.user->get_ul_slack_ms(current_tti);
+    ue_order.push_back(d);
+  }
+  std::sort(ue_order.begin(), ue_order.end(), deadline_cmp);
+
+  // allocate reTxs first
+  for (sched_deadline_t& d : ue_order) {
+    allocate_user_retx_prbs(d.user, enb_cc_idx);
+  }
+  for (sched_deadline_t& d : ue_order) {
+    allocate_user_newtx_prbs(d.user, enb_cc_idx);
+  }
+}
+
 } // namespace srsenb
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/scheduler_tbs_table.h"
+#include "srsenb/hdr/stack/mac/scheduler_ue.h"
+#include <algorithm>
+
+namespace srsenb {
+
+void sched_tbs_table::init(const srslte_cell_t& cell_, int max_mcs_dl_, int max_mcs_ul_)
+{
+  cell       = cell_;
+  max_mcs_dl = max_mcs_dl_ >= 0 ? max_mcs_dl_ : 28;
+  max_mcs_ul = max_mcs_ul_ >= 0 ? max_mcs_ul_ : 28;
+
+  dl_table.resize(MAX_CTRL_SYMBOLS * (MAX_CQI + 1) * cell.nof_prb);
+  dl_valid.resize(MAX_CTRL_SYMBOLS * (MAX_CQI + 1));
+  for (uint32_t nof_ctrl_symbols = 1; nof_ctrl_symbols <= MAX_CTRL_SYMBOLS; ++nof_ctrl_symbols) {
+    for (uint32_t cqi = 0; cqi <= MAX_CQI; ++cqi) {
+      size_t idx    = dl_row_idx(cqi, nof_ctrl_symbols);
+      dl_valid[idx] = fill_row(&dl_table[idx * cell.nof_prb], cqi, nof_ctrl_symbols, false);
+    }
+  }
+
+  ul_table.resize((MAX_CQI + 1) * cell.nof_prb);
+  ul_valid.resize(MAX_CQI + 1);
+  for (uint32_t cqi = 0; cqi <= MAX_CQI; ++cqi) {
+    ul_valid[cqi] = fill_row(&ul_table[cqi * cell.nof_prb], cqi, 0, true);
+  }
+}
+
+bool sched_tbs_table::fill_row(tbs_entry_t* row, uint32_t cqi, uint32_t nof_ctrl_symbols, bool is_ul)
+{
+  uint32_t max_mcs = is_ul ? max_mcs_ul : max_mcs_dl;
+  uint32_t max_Qm  = is_ul ? 4 : 6; // Allow 16-QAM in PUSCH Only
+  uint32_t N_srs   = 0;
+  int      max_tbs = 0;
+
+  for (uint32_t n = 1; n <= cell.nof_prb; ++n) {
+    uint32_t nof_re = is_ul ? (2 * (SRSLTE_CP_NSYMB(cell.cp) - 1) - N_srs) * n * SRSLTE_NRE
+                            : srslte_ra_dl_approx_nof_re(&cell, n, nof_ctrl_symbols);
+    uint32_t mcs       = 0;
+    int      tbs_bytes = sched_ue::cqi_to_tbs(cqi, n, nof_re, max_mcs, max_Qm, is_ul, &mcs) / 8;
+
+    // Same as sched_ue_carrier::alloc_tbs(), avoid n_prb=1, mcs=6
+    if (n == 1 && mcs == 6) {
+      mcs--;
+      tbs_bytes = srslte_ra_tbs_from_idx(srslte_ra_tbs_idx_from_mcs(mcs, is_ul), n) / 8;
+    }
+    if (tbs_bytes < 0) {
+      return false;
+    }
+
+    max_tbs                  = std::max(max_tbs, tbs_bytes);
+    row[n - 1].tbs_bytes     = tbs_bytes;
+    row[n - 1].mcs           = (int)mcs;
+    row[n - 1].max_tbs_bytes = max_tbs;
+  }
+  return true;
+}
+
+bool sched_tbs_table::is_valid_dl(uint32_t cqi, uint32_t max_mcs, uint32_t nof_ctrl_symbols) const
+{
+  return max_mcs == max_mcs_dl and cqi <= MAX_CQI and nof_ctrl_symbols >= 1 and
+         nof_ctrl_symbols <= MAX_CTRL_SYMBOLS and dl_valid[dl_row_idx(cqi, nof_ctrl_symbols)];
+}
+
+bool sched_tbs_table::is_valid_ul(uint32_t cqi, uint32_t max_mcs) const
+{
+  return max_mcs == max_mcs_ul and cqi <= MAX_CQI and ul_valid[cqi];
+}
+
+int sched_tbs_table::get_tbs_dl(uint32_t cqi, uint32_t nof_prb, uint32_t nof_ctrl_symbols, int* mcs) const
+{
+  const tbs_entry_t& e = dl_row(cqi, nof_ctrl_symbols)[nof_prb - 1];
+  if (mcs) {
+    *mcs = e.mcs;
+  }
+  return e.tbs_bytes;
+}
+
+int sched_tbs_table::get_tbs_ul(uint32_t cqi, uint32_t nof_prb, int* mcs) const
+{
+  const tbs_entry_t& e = ul_row(cqi)[nof_prb - 1];
+  if (mcs) {
+    *mcs = e.mcs;
+  }
+  return e.tbs_bytes;
+}
+
+uint32_t sched_tbs_table::find_prb(const tbs_entry_t* row, uint32_t req_bytes, uint32_t max_prb) const
+{
+  max_prb = std::min(max_prb, cell.nof_prb);
+  if (max_prb == 0) {
+    return 0;
+  }
+  // The first number of PRBs whose TBS fits req_bytes is also the first whose running maximum does
+  const tbs_entry_t* it = std::lower_bound(
+      row, row + max_prb, req_bytes, [](const tbs_entry_t& e, uint32_t val) { return e.max_tbs_bytes < (int)val; });
+  return std::min((uint32_t)(it - row) + 1, max_prb);
+}
+
+uint32_t
+sched_tbs_table::get_required_prb_dl(uint32_t cqi, uint32_t nof_ctrl_symbols, uint32_t req_bytes, uint32_t max_prb) const
+{
+  return find_prb(dl_row(cqi, nof_ctrl_symbols), req_bytes, max_prb);
+}
+
+uint32_t sched_tbs_table::get_required_prb_ul(uint32_t cqi, uint32_t req_bytes, uint32_t max_prb) const
+{
+  return find_prb(ul_row(cqi), req_bytes, max_prb);
+}
+
+} // namespace srsenb
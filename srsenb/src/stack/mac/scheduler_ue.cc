@@ -19,6 +19,7 @@
  *
  */
 
+#include <limits>
 #include <string.h>
 
 #include "srsenb/hdr/stack/mac/scheduler.h"
@@ -80,10 +81,13 @@ void sched_ue::set_cfg(uint16_t rnti_, const sched_params_t& sched_params_, sche
 
     Info("SCHED: Added user rnti=0x%x\n", rnti);
 
-    // Init sched_ue carriers
-    // TODO: check config for number of carriers
-    carriers.emplace_back(&cfg, &cell, rnti, 0, log_h);
-    enb_ue_cellindex_map.insert(std::make_pair(0, 0)); // TODO: use real values
+    // Init sched_ue carriers, the PCell first. Without carrier list, the UE is only configured in eNB carrier 0
+    uint32_t nof_cc = SRSLTE_MIN(SRSLTE_MAX(cfg.nof_supported_cc, 1u), (uint32_t)SRSLTE_MAX_CARRIERS);
+    for (uint32_t ue_cc_idx = 0; ue_cc_idx < nof_cc; ++ue_cc_idx) {
+      uint32_t enb_cc_idx = cfg.nof_supported_cc > 0 ? cfg.supported_cc_idxs[ue_cc_idx] : 0;
+      carriers.emplace_back(&cfg, &cell, rnti, ue_cc_idx, &sched_params->tbs_table, log_h);
+      enb_ue_cellindex_map.insert(std::make_pair(enb_cc_idx, ue_cc_idx));
+    }
 
     // Generate allowed CCE locations
     for (int cfi = 0; cfi < 3; cfi++) {
@@ -116,7 +120,12 @@ void sched_ue::reset()
     phy_config_dedicated_enabled = false;
     cqi_request_tti              = 0;
     conres_ce_pending            = true;
+    sps_ul_pids                  = 0;
+    sps_dl.reset();
+    sps_ul.reset();
+    proactive_ul = sched_proactive_ul_t();
     carriers.clear();
+    enb_ue_cellindex_map.clear();
   }
 
   for (int i = 0; i < sched_interface::MAX_LC; i++) {
@@ -157,11 +166,14 @@ void sched_ue::set_bearer_cfg(uint32_t lc_id, sched_interface::ue_bearer_cfg_t*
   std::lock_guard<std::mutex> lock(mutex);
   if (lc_id < sched_interface::MAX_LC) {
     memcpy(&lch[lc_id].cfg, cfg_, sizeof(sched_interface::ue_bearer_cfg_t));
-    lch[lc_id].buf_tx   = 0;
-    lch[lc_id].buf_retx = 0;
+    lch[lc_id].buf_tx     = 0;
+    lch[lc_id].buf_retx   = 0;
+    lch[lc_id].dl_hol_tti = -1;
+    lch[lc_id].ul_hol_tti = -1;
     if (lch[lc_id].cfg.direction != sched_interface::ue_bearer_cfg_t::IDLE) {
       Info("SCHED: Set bearer config lc_id=%d, direction=%d\n", lc_id, (int)lch[lc_id].cfg.direction);
     }
+    update_proactive_ul_cfg();
   }
 }
 
@@ -170,6 +182,9 @@ void sched_ue::rem_bearer(uint32_t lc_id)
   std::lock_guard<std::mutex> lock(mutex);
   if (lc_id < sched_interface::MAX_LC) {
     bzero(&lch[lc_id], sizeof(ue_bearer_t));
+    lch[lc_id].dl_hol_tti = -1;
+    lch[lc_id].ul_hol_tti = -1;
+    update_proactive_ul_cfg();
   }
 }
 
@@ -185,11 +200,18 @@ void sched_ue::ul_buffer_state(uint8_t lc_id, uint32_t bsr, bool set_value)
 {
   std::lock_guard<std::mutex> lock(mutex);
   if (lc_id < sched_interface::MAX_LC) {
+    bool had_data = get_pending_ul_bsr_unlocked() > 0;
     if (set_value) {
       lch[lc_id].bsr = bsr;
     } else {
       lch[lc_id].bsr += bsr;
     }
+    update_hol_ttis();
+    // UL data reported after a proactive grant means it was used. The start of the bursts gives the traffic period
+    if (bearer_is_ul(&lch[lc_id]) and lch[lc_id].bsr > 0) {
+      proactive_ul.data_reported = true;
+      proactive_ul.new_burst |= not had_data;
+    }
   }
   Debug("SCHED: bsr=%d, lcid=%d, bsr={%d,%d,%d,%d}\n", bsr, lc_id, lch[0].bsr, lch[1].bsr, lch[2].bsr, lch[3].bsr);
 }
@@ -205,6 +227,7 @@ void sched_ue::dl_buffer_state(uint8_t lc_id, uint32_t tx_queue, uint32_t retx_q
   if (lc_id < sched_interface::MAX_LC) {
     lch[lc_id].buf_retx = retx_queue;
     lch[lc_id].buf_tx   = tx_queue;
+    update_hol_ttis();
     Debug("SCHED: DL lcid=%d buffer_state=%d,%d\n", lc_id, tx_queue, retx_queue);
   }
 }
@@ -311,7 +334,8 @@ void sched_ue::ul_recv_len(uint32_t lcid, uint32_t len)
       if (lch[lcid].bsr > (int)len) {
         lch[lcid].bsr -= len;
       } else {
-        lch[lcid].bsr = 0;
+        lch[lcid].bsr        = 0;
+        lch[lcid].ul_hol_tti = -1;
       }
     }
   }
@@ -324,6 +348,22 @@ void sched_ue::set_ul_crc(uint32_t tti, uint32_t cc_idx, bool crc_res)
   get_ul_harq(tti, cc_idx)->set_ack(0, crc_res);
 }
 
+/* The UE releases the configured UL grant after implicitReleaseAfter consecutive new transmissions without MAC SDUs
+ * (36.321 Section 5.10.2). They are counted as the PUSCHs of the grant are decoded */
+void sched_ue::set_ul_sdu_info(uint32_t tti, uint32_t cc_idx, uint32_t nof_sdus)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (cc_idx == 0 and sps_ul.active and (sps_ul_pids & (1u << get_ul_harq(tti, cc_idx)->get_id())) != 0) {
+    sps_ul.nof_empty = nof_sdus > 0 ? 0 : sps_ul.nof_empty + 1;
+  }
+}
+
+bool sched_ue::is_ul_harq_active(uint32_t tti, uint32_t cc_idx)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return !get_ul_harq(tti, cc_idx)->is_empty(0);
+}
+
 void sched_ue::set_dl_ri(uint32_t tti, uint32_t cc_idx, uint32_t ri)
 {
   std::lock_guard<std::mutex> lock(mutex);
@@ -351,6 +391,17 @@ void sched_ue::set_dl_ant_info(asn1::rrc::phys_cfg_ded_s::ant_info_c_* d)
   dl_ant_info = *d;
 }
 
+/* Replaces the SPS-Config of the UE. Any configured grant is dropped, as the UE clears them on reconfiguration. The
+ * new grants are only activated after the UE applied the dedicated configuration */
+void sched_ue::set_sps_cfg(const srslte::sps_cfg_t& sps_cfg)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  cfg.sps_cfg = sps_cfg;
+  sps_ul_pids = 0;
+  sps_dl.reset();
+  sps_ul.reset();
+}
+
 void sched_ue::set_ul_cqi(uint32_t tti, uint32_t cc_idx, uint32_t cqi, uint32_t ul_ch_code)
 {
   std::lock_guard<std::mutex> lock(mutex);
@@ -477,6 +528,12 @@ int sched_ue::generate_format1(dl_harq_proc*                     h,
     dci->tb[0].rv      = sched::get_rvidx(h->nof_retx(0));
     dci->tb[0].ndi     = h->get_ndi(0);
 
+    // The retxs of configured grants are addressed to the SPS C-RNTI with NDI=1
+    if (h->nof_retx(0) > 0 and is_sps_dl_harq(h, cc_idx)) {
+      data->sps_rnti = cfg.sps_cfg.sps_rnti;
+      dci->tb[0].ndi = true;
+    }
+
     dci->tpc_pucch = (uint8_t)next_tpc_pucch;
     next_tpc_pucch = 1;
     data->tbs[0]   = (uint32_t)tbs;
@@ -634,20 +691,117 @@ int sched_ue::generate_format2(dl_harq_proc*                     h,
   return ret;
 }
 
+// Generates the Format1 dci of the configured SPS DL grant, either its activation or a transmission without PDCCH.
+// The grant state is set by the carrier scheduler when the activation is allocated
+// > return 0 if TBS<MIN_DATA_TBS
+int sched_ue::generate_sps_format1(dl_harq_proc*                     h,
+                                   sched_interface::dl_sched_data_t* data,
+                                   uint32_t                          tti_tx_dl,
+                                   uint32_t                          cc_idx,
+                                   uint32_t                          cfi,
+                                   const rbgmask_t&                  user_mask,
+                                   bool                              activation)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  srslte_dci_dl_t* dci = &data->dci;
+
+  uint32_t mcs     = sps_dl.mcs;
+  uint32_t nof_prb = format1_count_prb(user_mask);
+  int      tbs     = srslte_ra_tbs_from_idx(srslte_ra_tbs_idx_from_mcs(mcs, false), nof_prb) / 8;
+  if (tbs < MIN_DATA_TBS) {
+    log_h->warning("SCHED: SPS allocation of TBS=%d that does not account header\n", tbs);
+    return 0;
+  }
+
+  // The HARQ-ACK of a PDSCH without PDCCH goes in the configured PUCCH resource. Store the CCE that maps to that
+  // resource, from which the PHY and the PUCCH scheduling derive it
+  if (not activation) {
+    dci->location.ncce = SRSLTE_MAX(cfg.sps_cfg.dl_n1_pucch_an, cfg.pucch_cfg.N_pucch_1) - cfg.pucch_cfg.N_pucch_1;
+  }
+
+  h->new_tx(user_mask, 0, tti_tx_dl, mcs, tbs, dci->location.ncce);
+
+  int rem_tbs = tbs;
+  int x       = 0;
+  while (nof_ta_cmd > 0 && rem_tbs > 2) {
+    data->pdu[0][data->nof_pdu_elems[0]].lcid = srslte::sch_subh::TA_CMD;
+    data->nof_pdu_elems[0]++;
+    Info("SCHED: Added MAC TA CMD CE for rnti=0x%x\n", rnti);
+    nof_ta_cmd--;
+    rem_tbs -= 2;
+  }
+  do {
+    x = alloc_pdu(rem_tbs, &data->pdu[0][data->nof_pdu_elems[0]]);
+    if (x) {
+      rem_tbs -= x + 2; // count 2-byte header
+      data->nof_pdu_elems[0]++;
+    }
+  } while (rem_tbs >= MIN_DATA_TBS && x > 0);
+
+  // Validation of the activation: HARQ process, RV and NDI set to 0. TPC selects the first n1PUCCH-AN-Persistent
+  dci->alloc_type              = SRSLTE_RA_ALLOC_TYPE0;
+  dci->type0_alloc.rbg_bitmask = (uint32_t)user_mask.to_uint64();
+  dci->rnti                    = rnti;
+  dci->pid                     = h->get_id();
+  dci->tb[0].mcs_idx           = mcs;
+  dci->tb[0].rv                = 0;
+  dci->tb[0].ndi               = false;
+  dci->tpc_pucch               = 0;
+  dci->format                  = SRSLTE_DCI_FORMAT1;
+
+  data->needs_pdcch = activation;
+  data->sps_rnti    = cfg.sps_cfg.sps_rnti;
+  data->tbs[0]      = (uint32_t)tbs;
+  data->tbs[1]      = 0;
+
+  return tbs;
+}
+
+// Generates the Format1A dci that releases the configured SPS DL grant, as in 36.213 Table 9.2-1A
+int sched_ue::generate_sps_release(sched_interface::dl_sched_data_t* data)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  srslte_dci_dl_t* dci       = &data->dci;
+  uint32_t         riv_nbits = (uint32_t)ceilf(log2f((float)cell.nof_prb * ((float)cell.nof_prb + 1) / 2));
+
+  dci->alloc_type       = SRSLTE_RA_ALLOC_TYPE2;
+  dci->type2_alloc.mode = srslte_ra_type2_t::SRSLTE_RA_TYPE2_LOC;
+  dci->type2_alloc.riv  = (1u << riv_nbits) - 1;
+  dci->rnti             = rnti;
+  dci->pid              = 0;
+  dci->tb[0].mcs_idx    = 31;
+  dci->tb[0].rv         = 0;
+  dci->tb[0].ndi        = false;
+  dci->tpc_pucch        = 0;
+  dci->format           = SRSLTE_DCI_FORMAT1A;
+
+  data->needs_pdcch = true;
+  data->sps_rnti    = cfg.sps_cfg.sps_rnti;
+  data->tbs[0]      = 0;
+  data->tbs[1]      = 0;
+
+  sps_dl.reset();
+  Info("SCHED: Released SPS DL grant rnti=0x%x\n", rnti);
+  return SRSLTE_SUCCESS;
+}
+
 int sched_ue::generate_format0(sched_interface::ul_sched_data_t* data,
                                uint32_t                          tti,
                                uint32_t                          cc_idx,
                                ul_harq_proc::ul_alloc_t          alloc,
                                bool                              needs_pdcch,
                                srslte_dci_location_t             dci_pos,
-                               int                               explicit_mcs)
+                               int                               explicit_mcs,
+                               bool                              is_sps)
 {
   std::lock_guard<std::mutex> lock(mutex);
 
   ul_harq_proc*    h   = get_ul_harq(tti, cc_idx);
   srslte_dci_ul_t* dci = &data->dci;
 
-  bool cqi_request = needs_cqi_unlocked(tti, true);
+  bool cqi_request = needs_cqi_unlocked(tti, cc_idx, true);
 
   // Set DCI position
   data->needs_pdcch = needs_pdcch;
@@ -661,19 +815,41 @@ int sched_ue::generate_format0(sched_interface::ul_sched_data_t* data,
     uint32_t nof_retx;
 
     // If Msg3 set different nof retx
-    nof_retx = (data->needs_pdcch) ? get_max_retx() : max_msg3retx;
+    nof_retx = (data->needs_pdcch or is_sps) ? get_max_retx() : max_msg3retx;
 
     if (mcs >= 0) {
       tbs = srslte_ra_tbs_from_idx(srslte_ra_tbs_idx_from_mcs(mcs, true), alloc.L) / 8;
     } else {
       // dynamic mcs
-      uint32_t req_bytes = get_pending_ul_new_data_unlocked(tti);
+      uint32_t req_bytes = get_pending_ul_new_data_unlocked(tti, cc_idx);
       uint32_t N_srs     = 0;
       uint32_t nof_re    = (2 * (SRSLTE_CP_NSYMB(cell.cp) - 1) - N_srs) * alloc.L * SRSLTE_NRE;
       tbs                = carriers[cc_idx].alloc_tbs_ul(alloc.L, nof_re, req_bytes, &mcs);
     }
+    bool is_proactive = cc_idx == 0 and not is_sps and needs_pdcch and not sr and get_pending_ul_bsr_unlocked() == 0 and
+                        is_proactive_ul_due(tti);
+
     h->new_tx(tti, mcs, tbs, alloc, nof_retx);
 
+    // The use of the proactive grants is accounted once their PUSCH has been received
+    if (is_proactive) {
+      proactive_ul.grant_prb[tti % proactive_ul.grant_prb.size()] = alloc.L;
+      proactive_ul.grant_tti[tti % proactive_ul.grant_tti.size()] = tti;
+      proactive_ul.ref_tti                                        = tti;
+    }
+
+    // Keep track of the pids of the configured grant, whose retxs are addressed to the SPS C-RNTI
+    if (cc_idx == 0) {
+      uint32_t pid_mask = 1u << h->get_id();
+      sps_ul_pids       = is_sps ? (sps_ul_pids | pid_mask) : (sps_ul_pids & ~pid_mask);
+    }
+
+    // The grant serves the oldest reported data, the age of the remaining data is measured from now on
+    for (ue_bearer_t& b : lch) {
+      b.ul_hol_tti = -1;
+    }
+    update_hol_ttis();
+
   } else {
     // retx
     h->new_retx(0, tti, &mcs, nullptr, alloc);
@@ -697,6 +873,19 @@ int sched_ue::generate_format0(sched_interface::ul_sched_data_t* data,
     dci->freq_hop_fl = srslte_dci_ul_t::SRSLTE_RA_PUSCH_HOP_DISABLED;
     dci->tpc_pusch   = next_tpc_pusch;
     next_tpc_pusch   = 1;
+
+    if (cc_idx == 0 and (sps_ul_pids & (1u << h->get_id())) != 0) {
+      data->sps_rnti = cfg.sps_cfg.sps_rnti;
+      if (is_newtx) {
+        // Validation of the activation: NDI, TPC and cyclic shift DMRS set to 0. The TPC goes in the next grant
+        next_tpc_pusch = dci->tpc_pusch;
+        dci->tb.ndi    = false;
+        dci->tpc_pusch = 0;
+        dci->n_dmrs    = 0;
+      } else {
+        dci->tb.ndi = true;
+      }
+    }
   }
 
   return tbs;
@@ -708,7 +897,7 @@ int sched_ue::generate_format0(sched_interface::ul_sched_data_t* data,
  *
  *******************************************************/
 
-bool sched_ue::bearer_is_ul(ue_bearer_t* lch)
+bool sched_ue::bearer_is_ul(const ue_bearer_t* lch)
 {
   return lch->cfg.direction == sched_interface::ue_bearer_cfg_t::UL ||
          lch->cfg.direction == sched_interface::ue_bearer_cfg_t::BOTH;
@@ -726,6 +915,15 @@ uint32_t sched_ue::get_max_retx()
 }
 
 bool sched_ue::is_first_dl_tx()
+{
+  // The HARQs of the other carriers may be in use by their scheduling passes
+  if (carriers.size() > 1) {
+    return first_dl_tx;
+  }
+  return compute_first_dl_tx();
+}
+
+bool sched_ue::compute_first_dl_tx() const
 {
   for (const sched_ue_carrier& c : carriers) {
     for (auto& h : c.dl_harq) {
@@ -784,6 +982,16 @@ uint32_t sched_ue::get_pending_dl_new_data_total()
   return get_pending_dl_new_data_total_unlocked();
 }
 
+/// Same as get_pending_dl_new_data_total(). When the UE has several carriers, the share of the carrier
+uint32_t sched_ue::get_pending_dl_new_data_total(uint32_t cc_idx)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (carriers.size() > 1) {
+    return carriers[cc_idx].dl_data_quota;
+  }
+  return get_pending_dl_new_data_total_unlocked();
+}
+
 uint32_t sched_ue::get_pending_dl_new_data_total_unlocked()
 {
   uint32_t req_bytes = get_pending_dl_new_data_unlocked();
@@ -796,6 +1004,69 @@ uint32_t sched_ue::get_pending_dl_new_data_total_unlocked()
   return req_bytes;
 }
 
+/**
+ * Time left until the oldest pending DL data of the user exceeds the packet delay budget of its bearer. RLC does not
+ * report packet arrival times, so the head-of-line age is measured from the TTI the bearer became backlogged, or from
+ * the last TTI it was served.
+ * @return slack in ms (negative if the budget was already exceeded) or INT_MAX if there is no pending data
+ */
+int sched_ue::get_dl_slack_ms(uint32_t tti_tx_dl) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (is_conres_ce_pending()) {
+    return 0;
+  }
+  int slack = std::numeric_limits<int>::max();
+  for (const ue_bearer_t& b : lch) {
+    if (bearer_is_dl(&b) and (b.buf_tx > 0 or b.buf_retx > 0)) {
+      slack = std::min(slack, get_bearer_slack_ms(&b, b.dl_hol_tti, tti_tx_dl));
+    }
+  }
+  return slack;
+}
+
+/// Same as get_dl_slack_ms() for the data reported in the BSRs. A pending SR without BSR is considered urgent
+int sched_ue::get_ul_slack_ms(uint32_t tti_tx_ul) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  int                         slack = std::numeric_limits<int>::max();
+  for (const ue_bearer_t& b : lch) {
+    if (bearer_is_ul(&b) and b.bsr > 0) {
+      slack = std::min(slack, get_bearer_slack_ms(&b, b.ul_hol_tti, tti_tx_ul));
+    }
+  }
+  if (slack == std::numeric_limits<int>::max() and is_sr_triggered()) {
+    return 0;
+  }
+  return slack;
+}
+
+// Private lock-free implementation
+int sched_ue::get_bearer_slack_ms(const ue_bearer_t* b, int hol_tti, uint32_t tti) const
+{
+  // Data enqueued before the first TTI of the user is timestamped once it is known
+  int budget = b->cfg.delay_budget_ms > 0 ? b->cfg.delay_budget_ms : DEFAULT_DELAY_BUDGET_MS;
+  return hol_tti < 0 ? budget : budget - (int)srslte_tti_interval(tti, (uint32_t)hol_tti);
+}
+
+// Private lock-free implementation. Timestamps the bearers that became backlogged with the next TTI to schedule, and
+// clears the timestamps of the ones that were emptied
+void sched_ue::update_hol_ttis()
+{
+  for (ue_bearer_t& b : lch) {
+    if (b.buf_tx == 0 and b.buf_retx == 0) {
+      b.dl_hol_tti = -1;
+    } else if (b.dl_hol_tti < 0 and next_tti_rx >= 0) {
+      b.dl_hol_tti = TTI_TX(next_tti_rx);
+    }
+    if (b.bsr == 0) {
+      b.ul_hol_tti = -1;
+    } else if (b.ul_hol_tti < 0 and next_tti_rx >= 0) {
+      b.ul_hol_tti = TTI_RX_ACK(next_tti_rx);
+    }
+  }
+}
+
 // Private lock-free implementation
 uint32_t sched_ue::get_pending_dl_new_data_unlocked()
 {
@@ -817,6 +1088,13 @@ uint32_t sched_ue::get_pending_ul_new_data(uint32_t tti)
   return get_pending_ul_new_data_unlocked(tti);
 }
 
+/// Same as get_pending_ul_new_data(). When the UE has several carriers, the share of the carrier
+uint32_t sched_ue::get_pending_ul_new_data(uint32_t tti, uint32_t cc_idx)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return get_pending_ul_new_data_unlocked(tti, cc_idx);
+}
+
 uint32_t sched_ue::get_pending_ul_old_data(uint32_t cc_idx)
 {
   std::lock_guard<std::mutex> lock(mutex);
@@ -841,6 +1119,9 @@ uint32_t sched_ue::get_pending_ul_new_data_unlocked(uint32_t tti)
         return 128;
       }
     }
+    if (is_proactive_ul_due(tti)) {
+      return PROACTIVE_UL_BYTES;
+    }
   }
 
   // Subtract all the UL data already allocated in the UL harqs
@@ -862,12 +1143,62 @@ uint32_t sched_ue::get_pending_ul_new_data_unlocked(uint32_t tti)
   return pending_data;
 }
 
+// Private lock-free implementation. The carrier passes must not look at the HARQs of the other carriers, which may be
+// scheduled concurrently, so they use the share computed in new_tti()
+uint32_t sched_ue::get_pending_ul_new_data_unlocked(uint32_t tti, uint32_t cc_idx)
+{
+  if (carriers.size() > 1) {
+    return carriers[cc_idx].ul_data_quota;
+  }
+  return get_pending_ul_new_data_unlocked(tti);
+}
+
 // Private lock-free implementation
 uint32_t sched_ue::get_pending_ul_old_data_unlocked(uint32_t cc_idx)
 {
   return carriers[cc_idx].get_pending_ul_old_data();
 }
 
+/**
+ * Computes the UE state that depends on several carriers before their scheduling passes of the TTI, which may run
+ * concurrently. The pending new data is split among the carriers, so that two carriers do not allocate resources
+ * for the same bytes
+ */
+void sched_ue::new_tti(const tti_params_t& tti_params)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (carriers.size() <= 1) {
+    return;
+  }
+
+  first_dl_tx = compute_first_dl_tx();
+
+  uint32_t dl_data = get_pending_dl_new_data_total_unlocked();
+  uint32_t ul_data = get_pending_ul_new_data_unlocked(tti_params.tti_tx_ul);
+
+  // The grants for SR or CQI reports are not data, and only go in the PCell
+  bool has_ul_bsr = false;
+  for (ue_bearer_t& b : lch) {
+    has_ul_bsr |= bearer_is_ul(&b) and b.bsr > 0;
+  }
+
+  for (uint32_t cc_idx = 0; cc_idx < carriers.size(); ++cc_idx) {
+    carriers[cc_idx].dl_data_quota = get_carrier_share(dl_data, cc_idx);
+    carriers[cc_idx].ul_data_quota = has_ul_bsr ? get_carrier_share(ul_data, cc_idx) : (cc_idx == 0 ? ul_data : 0);
+  }
+}
+
+// Private lock-free implementation. The PCell takes the remainder of the split, including the MAC CEs
+uint32_t sched_ue::get_carrier_share(uint32_t data, uint32_t cc_idx) const
+{
+  uint32_t nof_cc = carriers.size();
+  if (data < nof_cc * MIN_CARRIER_SHARE_BYTES) {
+    return cc_idx == 0 ? data : 0;
+  }
+  uint32_t share = data / nof_cc;
+  return cc_idx == 0 ? data - share * (nof_cc - 1) : share;
+}
+
 uint32_t sched_ue::prb_to_rbg(uint32_t nof_prb)
 {
   return (uint32_t)ceil((float)nof_prb / sched_params->P);
@@ -889,6 +1220,13 @@ uint32_t sched_ue::get_required_prb_dl(uint32_t cc_idx, uint32_t req_bytes, uint
   uint32_t nbytes = 0;
   uint32_t n;
   int      mcs0 = (is_first_dl_tx() and cell.nof_prb == 6) ? MCS_FIRST_DL : carriers[cc_idx].fixed_mcs_dl;
+
+  const sched_ue_carrier& carrier = carriers[cc_idx];
+  if (mcs0 < 0 and req_bytes > 0 and
+      sched_params->tbs_table.is_valid_dl(carrier.dl_cqi, carrier.max_mcs_dl, nof_ctrl_symbols)) {
+    return sched_params->tbs_table.get_required_prb_dl(carrier.dl_cqi, nof_ctrl_symbols, req_bytes, cell.nof_prb);
+  }
+
   for (n = 0; n < cell.nof_prb && nbytes < req_bytes; ++n) {
     nof_re = srslte_ra_dl_approx_nof_re(&cell, n + 1, nof_ctrl_symbols);
     if (mcs0 < 0) {
@@ -912,7 +1250,157 @@ uint32_t sched_ue::get_required_prb_ul(uint32_t cc_idx, uint32_t req_bytes)
   return carriers[cc_idx].get_required_prb_ul(req_bytes);
 }
 
-bool sched_ue::is_sr_triggered()
+/* UL data reported in BSRs, which does not count the grants given for SRs or CQI reports */
+uint32_t sched_ue::get_pending_ul_bsr()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return get_pending_ul_bsr_unlocked();
+}
+
+// Private lock-free implementation
+uint32_t sched_ue::get_pending_ul_bsr_unlocked()
+{
+  uint32_t pending_data = 0;
+  for (ue_bearer_t& b : lch) {
+    if (bearer_is_ul(&b)) {
+      pending_data += b.bsr;
+    }
+  }
+  return pending_data;
+}
+
+void sched_ue::read_proactive_ul_prb(uint32_t* used_prb, uint32_t* wasted_prb)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  *used_prb               = proactive_ul.used_prb;
+  *wasted_prb             = proactive_ul.wasted_prb;
+  proactive_ul.used_prb   = 0;
+  proactive_ul.wasted_prb = 0;
+}
+
+/* A proactive grant is due once per period without UL data, as long as the previous ones were not left unused */
+bool sched_ue::is_proactive_ul_due(uint32_t tti_tx_ul)
+{
+  return proactive_ul.cfg_period_ms > 0 and phy_config_dedicated_enabled and not sps_ul.active and
+         proactive_ul.nof_unused < PROACTIVE_UL_MAX_UNUSED and
+         srslte_tti_interval(tti_tx_ul, proactive_ul.ref_tti) >= proactive_ul.period_ms;
+}
+
+/* The period follows the interval between UL data bursts, between the configured one and
+ * PROACTIVE_UL_MAX_PERIOD_FACTOR times it. Longer gaps are not periodic traffic and are ignored */
+void sched_ue::update_proactive_ul(uint32_t tti_tx_ul)
+{
+  sched_proactive_ul_t& p = proactive_ul;
+  if (p.cfg_period_ms == 0) {
+    return;
+  }
+
+  if (p.new_burst) {
+    uint32_t max_period = p.cfg_period_ms * PROACTIVE_UL_MAX_PERIOD_FACTOR;
+    if (p.last_burst_tti >= 0) {
+      uint32_t interval = srslte_tti_interval(tti_tx_ul, (uint32_t)p.last_burst_tti);
+      if (interval <= max_period) {
+        p.period_ms = SRSLTE_MIN(SRSLTE_MAX((3 * p.period_ms + interval) / 4, p.cfg_period_ms), max_period);
+      }
+    }
+    p.last_burst_tti = tti_tx_ul;
+    p.ref_tti        = tti_tx_ul;
+    p.nof_unused     = 0;
+    p.new_burst      = false;
+  }
+
+  // Grants whose PUSCH was already received are used if the UE reported UL data since then
+  bool accounted = false;
+  for (uint32_t i = 0; i < p.grant_prb.size(); ++i) {
+    if (p.grant_prb[i] == 0 or srslte_tti_interval(tti_tx_ul, p.grant_tti[i]) < PROACTIVE_UL_REPORT_MS) {
+      continue;
+    }
+    if (p.data_reported) {
+      p.used_prb += p.grant_prb[i];
+      p.nof_unused = 0;
+    } else {
+      p.wasted_prb += p.grant_prb[i];
+      p.nof_unused++;
+      if (p.nof_unused == PROACTIVE_UL_MAX_UNUSED) {
+        Info("SCHED: Releasing proactive UL grants of rnti=0x%x after %d unused\n", rnti, p.nof_unused);
+      }
+    }
+    p.grant_prb[i] = 0;
+    accounted      = true;
+  }
+  if (accounted) {
+    p.data_reported = false;
+  }
+}
+
+void sched_ue::update_proactive_ul_cfg()
+{
+  uint32_t period = 0;
+  for (ue_bearer_t& b : lch) {
+    if (bearer_is_ul(&b) and b.cfg.proactive_ul_period_ms > 0) {
+      period = (period == 0) ? b.cfg.proactive_ul_period_ms : SRSLTE_MIN(period, b.cfg.proactive_ul_period_ms);
+    }
+  }
+  if (period != proactive_ul.cfg_period_ms) {
+    proactive_ul.cfg_period_ms = period;
+    proactive_ul.period_ms     = period;
+    proactive_ul.nof_unused    = 0;
+  }
+}
+
+/* The HARQ processes of the configured DL assignments are computed from the TTI, as in 36.321 Section 5.3.1 */
+uint32_t sched_ue::get_sps_dl_pid(uint32_t tti_tx_dl) const
+{
+  return (tti_tx_dl / cfg.sps_cfg.dl_interval) % cfg.sps_cfg.dl_nof_harq;
+}
+
+bool sched_ue::is_sps_dl_harq(const dl_harq_proc* h, uint32_t cc_idx) const
+{
+  return cc_idx == 0 and cfg.sps_cfg.dl_enabled and h->get_id() < cfg.sps_cfg.dl_nof_harq;
+}
+
+/* Computes the number of PRBs of a configured grant that carries req_bytes, and its MCS */
+uint32_t sched_ue::get_required_prb_sps(uint32_t req_bytes, bool is_ul, uint32_t* mcs)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  uint32_t sel_mcs = get_sps_mcs_unlocked(is_ul);
+  uint32_t tbs_idx = srslte_ra_tbs_idx_from_mcs(sel_mcs, is_ul);
+  uint32_t n       = 1;
+  for (; n < cell.nof_prb; ++n) {
+    if (is_ul and not srslte_dft_precoding_valid_prb(n)) {
+      continue;
+    }
+    if (srslte_ra_tbs_from_idx(tbs_idx, n) / 8 >= (int)req_bytes) {
+      break;
+    }
+  }
+  if (mcs != nullptr) {
+    *mcs = sel_mcs;
+  }
+  return n;
+}
+
+// Private lock-free implementation. The MCS of the configured grants is derived from the last CQI of the PCell
+// for a single PRB, assuming the largest DL control region
+uint32_t sched_ue::get_sps_mcs_unlocked(bool is_ul)
+{
+  const sched_ue_carrier& carrier   = carriers[0];
+  int                     fixed_mcs = is_ul ? carrier.fixed_mcs_ul : carrier.fixed_mcs_dl;
+  uint32_t                mcs       = 0;
+  if (fixed_mcs >= 0) {
+    mcs = (uint32_t)fixed_mcs;
+  } else if (is_ul) {
+    uint32_t nof_re = 2 * (SRSLTE_CP_NSYMB(cell.cp) - 1) * SRSLTE_NRE;
+    cqi_to_tbs(carrier.ul_cqi, 1, nof_re, carrier.max_mcs_ul, 4, true, &mcs);
+  } else {
+    uint32_t nof_re = srslte_ra_dl_approx_nof_re(&cell, 1, cell.nof_prb <= 10 ? 4 : 3);
+    cqi_to_tbs(carrier.dl_cqi, 1, nof_re, carrier.max_mcs_dl, 6, false, &mcs);
+  }
+  return SRSLTE_MIN(mcs, SPS_MAX_MCS);
+}
+
+bool sched_ue::is_sr_triggered() const
 {
   return sr;
 }
@@ -959,7 +1447,7 @@ std::pair<bool, uint32_t> sched_ue::get_cell_index(uint32_t enb_cc_idx) const
 {
   auto it = enb_ue_cellindex_map.find(enb_cc_idx);
   if (it == enb_ue_cellindex_map.end()) {
-    log_h->error("The carrier with eNB_cc_idx=%d does not exist\n", enb_cc_idx);
+    // the UE is not configured in this carrier
     return std::make_pair(false, 0);
   }
   return std::make_pair(true, it->second);
@@ -977,6 +1465,13 @@ void sched_ue::finish_tti(const tti_params_t& tti_params, uint32_t enb_cc_idx)
 
   /* reset PIDs with pending data or blocked */
   reset_pending_pids(tti_params.tti_rx, it->second);
+
+  if (it->second == 0) {
+    std::lock_guard<std::mutex> lock(mutex);
+    update_proactive_ul(tti_params.tti_tx_ul);
+    next_tti_rx = TTI_ADD(tti_params.tti_rx, 1);
+    update_hol_ttis();
+  }
 }
 
 srslte_dci_format_t sched_ue::get_dci_format()
@@ -1036,8 +1531,10 @@ int sched_ue::alloc_pdu(int tbs_bytes, sched_interface::dl_sched_pdu_t* pdu)
     }
   }
   if (x) {
-    pdu->lcid   = i - 1;
-    pdu->nbytes = x;
+    pdu->lcid             = i - 1;
+    pdu->nbytes           = x;
+    lch[i - 1].dl_hol_tti = -1;
+    update_hol_ttis();
     Debug("SCHED: Allocated lcid=%d, nbytes=%d, tbs_bytes=%d\n", pdu->lcid, pdu->nbytes, tbs_bytes);
   }
   return x;
@@ -1092,9 +1589,11 @@ sched_ue_carrier::sched_ue_carrier(sched_interface::ue_cfg_t* cfg_,
                                    srslte_cell_t*             cell_cfg_,
                                    uint16_t                   rnti_,
                                    uint32_t                   cc_idx_,
+                                   const sched_tbs_table*     tbs_table_,
                                    srslte::log*               log_) :
   cfg(cfg_),
   cell(cell_cfg_),
+  tbs_table(tbs_table_),
   rnti(rnti_),
   cc_idx(cc_idx_),
   log_h(log_)
@@ -1168,14 +1667,16 @@ dl_harq_proc* sched_ue_carrier::get_pending_dl_harq(uint32_t tti_tx_dl)
   return h;
 
 #else
-  return &dl_harq[tti % SCHED_MAX_HARQ_PROC];
+  return &dl_harq[tti % srslte_fdd_nof_harq()];
 #endif
 }
 
 dl_harq_proc* sched_ue_carrier::get_empty_dl_harq()
 {
-  auto it =
-      std::find_if(dl_harq.begin(), dl_harq.end(), [](dl_harq_proc& h) { return h.is_empty(0) and h.is_empty(1); });
+  // The first HARQ processes of the PCell are reserved to the configured SPS DL assignments
+  uint32_t first_pid = (cc_idx == 0 and cfg->sps_cfg.dl_enabled) ? cfg->sps_cfg.dl_nof_harq : 0;
+  auto     it        = std::find_if(
+      dl_harq.begin() + first_pid, dl_harq.end(), [](dl_harq_proc& h) { return h.is_empty(0) and h.is_empty(1); });
   return it != dl_harq.end() ? &(*it) : nullptr;
 }
 
@@ -1195,7 +1696,7 @@ int sched_ue_carrier::set_ack_info(uint32_t tti_rx, uint32_t tb_idx, bool ack)
 
 ul_harq_proc* sched_ue_carrier::get_ul_harq(uint32_t tti)
 {
-  return &ul_harq[tti % SCHED_MAX_HARQ_PROC];
+  return &ul_harq[tti % srslte_fdd_nof_harq()];
 }
 
 uint32_t sched_ue_carrier::get_pending_ul_old_data()
@@ -1292,16 +1793,21 @@ uint32_t sched_ue_carrier::get_required_prb_ul(uint32_t req_bytes)
     return 0;
   }
 
-  for (n = 1; n < cell->nof_prb && nbytes < req_bytes + 4; n++) {
-    uint32_t nof_re = (2 * (SRSLTE_CP_NSYMB(cell->cp) - 1) - N_srs) * n * SRSLTE_NRE;
-    int      tbs    = 0;
-    if (fixed_mcs_ul < 0) {
-      tbs = alloc_tbs_ul(n, nof_re, 0, &mcs);
-    } else {
-      tbs = srslte_ra_tbs_from_idx(srslte_ra_tbs_idx_from_mcs(fixed_mcs_ul, true), n) / 8;
-    }
-    if (tbs > 0) {
-      nbytes = tbs;
+  if (fixed_mcs_ul < 0 and tbs_table != nullptr and tbs_table->is_valid_ul(ul_cqi, max_mcs_ul)) {
+    // Same result as the loop below, which stops one PRB after the first one whose TBS fits req_bytes + 4
+    n = tbs_table->get_required_prb_ul(ul_cqi, req_bytes + 4, cell->nof_prb - 1) + 1;
+  } else {
+    for (n = 1; n < cell->nof_prb && nbytes < req_bytes + 4; n++) {
+      uint32_t nof_re = (2 * (SRSLTE_CP_NSYMB(cell->cp) - 1) - N_srs) * n * SRSLTE_NRE;
+      int      tbs    = 0;
+      if (fixed_mcs_ul < 0) {
+        tbs = alloc_tbs_ul(n, nof_re, 0, &mcs);
+      } else {
+        tbs = srslte_ra_tbs_from_idx(srslte_ra_tbs_idx_from_mcs(fixed_mcs_ul, true), n) / 8;
+      }
+      if (tbs > 0) {
+        nbytes = tbs;
+      }
     }
   }
 
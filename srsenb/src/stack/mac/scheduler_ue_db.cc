@@ -0,0 +1,164 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/scheduler_ue_db.h"
+#include <algorithm>
+#include <new>
+
+namespace srsenb {
+
+sched_ue_db::~sched_ue_db()
+{
+  clear();
+}
+
+sched_ue& sched_ue_db::operator[](uint16_t rnti)
+{
+  int entry = find_index(rnti);
+  if (entry >= 0) {
+    return *users[index[entry].pos];
+  }
+
+  // Keep the index at most half full, so that the probe sequences stay short
+  if (2 * (users.size() + 1) > index.size()) {
+    resize_index(std::max(index.size() * 2, (size_t)SLOTS_PER_CHUNK));
+  }
+
+  uint32_t  slot_id = 0;
+  sched_ue* user    = alloc_slot(&slot_id);
+  insert_index(rnti, (uint32_t)users.size());
+  rntis.push_back(rnti);
+  users.push_back(user);
+  user_slots.push_back(slot_id);
+  return *user;
+}
+
+sched_ue* sched_ue_db::find(uint16_t rnti)
+{
+  int entry = find_index(rnti);
+  return entry < 0 ? nullptr : users[index[entry].pos];
+}
+
+bool sched_ue_db::erase(uint16_t rnti)
+{
+  int entry = find_index(rnti);
+  if (entry < 0) {
+    return false;
+  }
+  uint32_t pos = index[entry].pos;
+  erase_index((uint32_t)entry);
+
+  users[pos]->~sched_ue();
+  free_slots.push_back(user_slots[pos]);
+
+  // Fill the hole with the last user
+  uint32_t last = (uint32_t)users.size() - 1;
+  if (pos != last) {
+    index[find_index(rntis[last])].pos = pos;
+    rntis[pos]                         = rntis[last];
+    users[pos]                         = users[last];
+    user_slots[pos]                    = user_slots[last];
+  }
+  rntis.pop_back();
+  users.pop_back();
+  user_slots.pop_back();
+  return true;
+}
+
+void sched_ue_db::clear()
+{
+  for (uint32_t i = 0; i < users.size(); ++i) {
+    users[i]->~sched_ue();
+    free_slots.push_back(user_slots[i]);
+  }
+  rntis.clear();
+  users.clear();
+  user_slots.clear();
+  for (index_entry_t& e : index) {
+    e.pos = INVALID_POS;
+  }
+}
+
+int sched_ue_db::find_index(uint16_t rnti) const
+{
+  if (index.empty()) {
+    return -1;
+  }
+  uint32_t mask = (uint32_t)index.size() - 1;
+  for (uint32_t i = rnti & mask; index[i].pos != INVALID_POS; i = (i + 1) & mask) {
+    if (index[i].rnti == rnti) {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
+void sched_ue_db::insert_index(uint16_t rnti, uint32_t pos)
+{
+  uint32_t mask = (uint32_t)index.size() - 1;
+  uint32_t i    = rnti & mask;
+  while (index[i].pos != INVALID_POS) {
+    i = (i + 1) & mask;
+  }
+  index[i].rnti = rnti;
+  index[i].pos  = pos;
+}
+
+/// Backward shift deletion, so that no tombstones are needed
+void sched_ue_db::erase_index(uint32_t entry)
+{
+  uint32_t mask = (uint32_t)index.size() - 1;
+  uint32_t hole = entry;
+  for (uint32_t i = (hole + 1) & mask; index[i].pos != INVALID_POS; i = (i + 1) & mask) {
+    uint32_t home = index[i].rnti & mask;
+    // move the entry to the hole if the hole lies in its probe sequence [home, i)
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      index[hole] = index[i];
+      hole        = i;
+    }
+  }
+  index[hole].pos = INVALID_POS;
+}
+
+void sched_ue_db::resize_index(size_t nof_entries)
+{
+  index.assign(nof_entries, index_entry_t{0, INVALID_POS});
+  for (uint32_t pos = 0; pos < rntis.size(); ++pos) {
+    insert_index(rntis[pos], pos);
+  }
+}
+
+sched_ue* sched_ue_db::alloc_slot(uint32_t* slot_id)
+{
+  if (free_slots.empty()) {
+    uint32_t first_slot = (uint32_t)chunks.size() * SLOTS_PER_CHUNK;
+    chunks.emplace_back(new slot_t[SLOTS_PER_CHUNK]);
+    for (uint32_t i = SLOTS_PER_CHUNK; i > 0; --i) {
+      free_slots.push_back(first_slot + i - 1);
+    }
+  }
+  *slot_id = free_slots.back();
+  free_slots.pop_back();
+  slot_t* slot = &chunks[*slot_id / SLOTS_PER_CHUNK][*slot_id % SLOTS_PER_CHUNK];
+  return new (slot) sched_ue();
+}
+
+} // namespace srsenb
@@ -33,14 +33,15 @@
 
 namespace srsenb {
 
-ue::ue(uint16_t           rnti_,
-       uint32_t           nof_prb,
-       sched_interface*   sched_,
-       rrc_interface_mac* rrc_,
-       rlc_interface_mac* rlc_,
-       srslte::log*       log_,
-       uint32_t           nof_rx_harq_proc_,
-       uint32_t           nof_tx_harq_proc_) :
+ue::ue(uint16_t                     rnti_,
+       uint32_t                     nof_prb,
+       sched_interface*             sched_,
+       rrc_interface_mac*           rrc_,
+       rlc_interface_mac*           rlc_,
+       srslte::log*                 log_,
+       uint32_t                     nof_rx_harq_proc_,
+       uint32_t                     nof_tx_harq_proc_,
+       srslte_softbuffer_rx_pool_t* rx_pool) :
   rnti(rnti_),
   sched(sched_),
   rrc(rrc_),
@@ -51,7 +52,8 @@ ue::ue(uint16_t           rnti_,
   mac_msg_ul(20, log_),
   pdus(128),
   nof_rx_harq_proc(nof_rx_harq_proc_),
-  nof_tx_harq_proc(nof_tx_harq_proc_)
+  nof_tx_harq_proc(nof_tx_harq_proc_),
+  pending_sps(nof_rx_harq_proc_)
 {
   bzero(&metrics, sizeof(mac_metrics_t));
   bzero(&mutex, sizeof(pthread_mutex_t));
@@ -62,9 +64,14 @@ ue::ue(uint16_t           rnti_,
   softbuffer_tx.reserve(nof_tx_harq_proc);
   softbuffer_rx.reserve(nof_rx_harq_proc);
   pending_buffers.reserve(nof_rx_harq_proc);
+  sps_pdus.reserve(nof_rx_harq_proc);
 
   for (int i = 0; i < nof_rx_harq_proc; i++) {
-    srslte_softbuffer_rx_init(&softbuffer_rx[i], nof_prb);
+    if (rx_pool) {
+      srslte_softbuffer_rx_init_pool(&softbuffer_rx[i], nof_prb, rx_pool);
+    } else {
+      srslte_softbuffer_rx_init(&softbuffer_rx[i], nof_prb);
+    }
     pending_buffers[i] = nullptr;
   }
   for (int i = 0; i < nof_tx_harq_proc; i++) {
@@ -128,7 +135,8 @@ void ue::set_lcg(uint32_t lcid, uint32_t lcg)
 
 srslte_softbuffer_rx_t* ue::get_rx_softbuffer(uint32_t tti)
 {
-  return &softbuffer_rx[tti % nof_rx_harq_proc];
+  // UL HARQ is synchronous, a retransmission uses the soft-buffer of the PUSCH transmitted one HARQ RTT earlier
+  return &softbuffer_rx[tti % SRSLTE_MIN((uint32_t)nof_rx_harq_proc, srslte_fdd_nof_harq())];
 }
 
 srslte_softbuffer_tx_t* ue::get_tx_softbuffer(uint32_t harq_process, uint32_t tb_idx)
@@ -136,13 +144,14 @@ srslte_softbuffer_tx_t* ue::get_tx_softbuffer(uint32_t harq_process, uint32_t tb
   return &softbuffer_tx[(harq_process * SRSLTE_MAX_TB + tb_idx) % nof_tx_harq_proc];
 }
 
-uint8_t* ue::request_buffer(uint32_t tti, uint32_t len)
+uint8_t* ue::request_buffer(uint32_t tti, uint32_t len, bool is_sps)
 {
   uint8_t* ret = NULL;
   if (len > 0) {
     if (!pending_buffers[tti % nof_rx_harq_proc]) {
       ret                                     = pdus.request(len);
       pending_buffers[tti % nof_rx_harq_proc] = ret;
+      pending_sps[tti % nof_rx_harq_proc]     = is_sps;
     } else {
       log_h->console("Error requesting buffer for pid %d, not pushed yet\n", tti % nof_rx_harq_proc);
       log_h->error("Requesting buffer for pid %d, not pushed yet\n", tti % nof_rx_harq_proc);
@@ -183,6 +192,21 @@ uint32_t ue::set_ta(int ta_)
 
 void ue::process_pdu(uint8_t* pdu, uint32_t nof_bytes, srslte::pdu_queue::channel_t channel)
 {
+  // Find out if the PDU was received in a configured grant before its buffer is released
+  bool     is_sps  = false;
+  uint32_t sps_tti = 0;
+  {
+    std::lock_guard<std::mutex> lock(sps_pdus_mutex);
+    for (auto it = sps_pdus.begin(); it != sps_pdus.end(); ++it) {
+      if (it->pdu == pdu) {
+        is_sps  = true;
+        sps_tti = it->tti;
+        sps_pdus.erase(it);
+        break;
+      }
+    }
+  }
+
   // Unpack ULSCH MAC PDU
   mac_msg_ul.init_rx(nof_bytes, true);
   mac_msg_ul.parse_packet(pdu);
@@ -195,10 +219,12 @@ void ue::process_pdu(uint8_t* pdu, uint32_t nof_bytes, srslte::pdu_queue::channe
 
   uint32_t lcid_most_data = 0;
   int      most_data      = -99;
+  uint32_t nof_sdus       = 0;
 
   while (mac_msg_ul.next()) {
     assert(mac_msg_ul.get());
     if (mac_msg_ul.get()->is_sdu()) {
+      nof_sdus++;
       // Route logical channel
       log_h->debug_hex(mac_msg_ul.get()->get_sdu_ptr(),
                        mac_msg_ul.get()->get_payload_size(),
@@ -261,6 +287,11 @@ void ue::process_pdu(uint8_t* pdu, uint32_t nof_bytes, srslte::pdu_queue::channe
   }
   mac_msg_ul.reset();
 
+  // The scheduler releases the configured UL grant after the PUSCHs without MAC SDUs
+  if (is_sps) {
+    sched->ul_sdu_info(sps_tti, rnti, 0, nof_sdus);
+  }
+
   /* Process CE after all SDUs because we need to update BSR after */
   bool bsr_received = false;
   while (mac_msg_ul.next()) {
@@ -294,6 +325,10 @@ void ue::deallocate_pdu(uint32_t tti)
 void ue::push_pdu(uint32_t tti, uint32_t len)
 {
   if (pending_buffers[tti % nof_rx_harq_proc]) {
+    if (pending_sps[tti % nof_rx_harq_proc]) {
+      std::lock_guard<std::mutex> lock(sps_pdus_mutex);
+      sps_pdus.push_back({pending_buffers[tti % nof_rx_harq_proc], tti});
+    }
     pdus.push(pending_buffers[tti % nof_rx_harq_proc], len);
     pending_buffers[tti % nof_rx_harq_proc] = NULL;
   } else {
@@ -493,6 +528,7 @@ void ue::metrics_read(mac_metrics_t* metrics_)
   metrics.rnti      = rnti;
   metrics.ul_buffer = sched->get_ul_buffer(rnti);
   metrics.dl_buffer = sched->get_dl_buffer(rnti);
+  sched->get_ul_proactive_prb(rnti, &metrics.ul_proactive_used_prb, &metrics.ul_proactive_wasted_prb);
 
   memcpy(metrics_, &metrics, sizeof(mac_metrics_t));
 
@@ -38,6 +38,19 @@ using namespace asn1::rrc;
 
 namespace srsenb {
 
+/// Packet delay budget of the standardized QCIs (TS 23.203, Table 6.1.7). Returns 0 (scheduler default) otherwise
+static int qci_to_delay_budget_ms(uint32_t qci)
+{
+  static const int pdb_ms[MAX_NOF_QCI] = {0, 100, 150, 50, 300, 100, 300, 100, 300, 300};
+  return qci < MAX_NOF_QCI ? pdb_ms[qci] : 0;
+}
+
+/// Period of the UL grants the scheduler gives without SR/BSR to the bearers of the QCI, 0 if disabled
+static uint32_t qci_to_proactive_ul_period_ms(const rrc_cfg_t& cfg, uint32_t qci)
+{
+  return (qci < MAX_NOF_QCI and cfg.qci_cfg[qci].configured) ? cfg.qci_cfg[qci].proactive_ul_period_ms : 0;
+}
+
 rrc::rrc() : cnotifier(nullptr), nof_si_messages(0)
 {
   pending_paging.clear();
@@ -76,6 +89,10 @@ void rrc::init(rrc_cfg_t*             cfg_,
 
   nof_si_messages = generate_sibs();
   config_mac();
+
+  // The dynamic HARQ-ACK resources of the PUCCH go up to the number of CCEs of the PDCCH. With up to 3 symbols, a PRB
+  // has less than 9 REGs for the PDCCH, so there are less CCEs than PRBs
+  sps_sched.n1_pucch_start = sib2.rr_cfg_common.pucch_cfg_common.n1_pucch_an + cfg.cell.nof_prb;
   enb_mobility_cfg.reset(new mobility_cfg(&cfg, log_rrc));
 
   pthread_mutex_init(&user_mutex, nullptr);
@@ -769,6 +786,7 @@ void rrc::rem_user(uint16_t rnti)
     // And deallocate resources from RRC
     user_it->second->sr_free();
     user_it->second->cqi_free();
+    user_it->second->sps_free();
 
     users.erase(rnti);
     rrc_log->info("Removed user rnti=0x%x\n", rnti);
@@ -1829,12 +1847,15 @@ void rrc::ue::send_connection_reconf(srslte::unique_byte_buffer_t pdu)
   }
 
   // Add SRB2 and DRB1 to the scheduler
-  srsenb::sched_interface::ue_bearer_cfg_t bearer_cfg;
+  srsenb::sched_interface::ue_bearer_cfg_t bearer_cfg = {};
   bearer_cfg.direction = srsenb::sched_interface::ue_bearer_cfg_t::BOTH;
   bearer_cfg.group     = 0;
   parent->mac->bearer_ue_cfg(rnti, 2, &bearer_cfg);
   bearer_cfg.group = conn_reconf->rr_cfg_ded.drb_to_add_mod_list[0].lc_ch_cfg.ul_specific_params.lc_ch_group;
+  bearer_cfg.delay_budget_ms        = qci_to_delay_budget_ms(erabs[5].qos_params.qCI.QCI);
+  bearer_cfg.proactive_ul_period_ms = qci_to_proactive_ul_period_ms(parent->cfg, erabs[5].qos_params.qCI.QCI);
   parent->mac->bearer_ue_cfg(rnti, 3, &bearer_cfg);
+  sps_add(erabs[5].qos_params.qCI.QCI, &conn_reconf->rr_cfg_ded);
 
   // Configure SRB2 in RLC and PDCP
   parent->rlc->add_bearer(rnti, 2, srslte::rlc_config_t::srb_config(2));
@@ -1912,9 +1933,12 @@ void rrc::ue::send_connection_reconf_new_bearer(LIBLTE_S1AP_E_RABTOBESETUPLISTBE
     }
 
     // Add DRB to the scheduler
-    srsenb::sched_interface::ue_bearer_cfg_t bearer_cfg;
-    bearer_cfg.direction = srsenb::sched_interface::ue_bearer_cfg_t::BOTH;
+    srsenb::sched_interface::ue_bearer_cfg_t bearer_cfg = {};
+    bearer_cfg.direction              = srsenb::sched_interface::ue_bearer_cfg_t::BOTH;
+    bearer_cfg.delay_budget_ms        = qci_to_delay_budget_ms(erabs[id].qos_params.qCI.QCI);
+    bearer_cfg.proactive_ul_period_ms = qci_to_proactive_ul_period_ms(parent->cfg, erabs[id].qos_params.qCI.QCI);
     parent->mac->bearer_ue_cfg(rnti, lcid, &bearer_cfg);
+    sps_add(erabs[id].qos_params.qCI.QCI, &conn_reconf->rr_cfg_ded);
 
     // Configure DRB in RLC
     parent->rlc->add_bearer(rnti, lcid, srslte::make_rlc_config_t(drb_item.rlc_cfg));
@@ -2334,6 +2358,64 @@ int rrc::ue::cqi_allocate(uint32_t period, uint16_t* pmi_idx, uint16_t* n_pucch)
   return 0;
 }
 
+int rrc::ue::sps_free()
+{
+  if (sps_allocated) {
+    parent->sps_sched.allocated[sps_idx] = false;
+    sps_allocated                        = false;
+    parent->rrc_log->info("Deallocated SPS resources, sps_rnti=0x%x\n", SPS_RNTI_START + sps_idx);
+  }
+  return 0;
+}
+
+int rrc::ue::sps_allocate(uint16_t* sps_rnti, uint16_t* n1_pucch_an)
+{
+  for (uint32_t i = 0; i < MAX_NOF_SPS_USERS; i++) {
+    if (not parent->sps_sched.allocated[i]) {
+      parent->sps_sched.allocated[i] = true;
+      sps_idx                        = i;
+      sps_allocated                  = true;
+      *sps_rnti                      = (uint16_t)(SPS_RNTI_START + i);
+      *n1_pucch_an                   = (uint16_t)(parent->sps_sched.n1_pucch_start + i);
+
+      parent->rrc_log->info("Allocated SPS resources, sps_rnti=0x%x, n1_pucch_an=%d\n", *sps_rnti, *n1_pucch_an);
+      return 0;
+    }
+  }
+  parent->rrc_log->error("Not enough resources to allocate SPS\n");
+  return -1;
+}
+
+/* Adds the SPS-Config of a QCI to a reconfiguration. The UE has a single SPS-Config, taken from the first of its
+ * bearers whose QCI has one. The MAC activates the grants once the UE applied the reconfiguration */
+void rrc::ue::sps_add(uint32_t qci, rr_cfg_ded_s* rr_cfg)
+{
+  if (sps_allocated or qci >= MAX_NOF_QCI) {
+    return;
+  }
+  const sps_cfg_s& qci_sps_cfg = parent->cfg.qci_cfg[qci].sps_cfg;
+  if (not qci_sps_cfg.sps_cfg_dl_present and not qci_sps_cfg.sps_cfg_ul_present) {
+    return;
+  }
+
+  uint16_t sps_rnti = 0, n1_pucch_an = 0;
+  if (sps_allocate(&sps_rnti, &n1_pucch_an)) {
+    parent->rrc_log->warning("The bearer with QCI=%d of rnti=0x%x is scheduled without SPS\n", qci, rnti);
+    return;
+  }
+  rr_cfg->sps_cfg_present                           = true;
+  rr_cfg->sps_cfg                                   = qci_sps_cfg;
+  rr_cfg->sps_cfg.semi_persist_sched_c_rnti_present = true;
+  rr_cfg->sps_cfg.semi_persist_sched_c_rnti.from_number(sps_rnti);
+  if (rr_cfg->sps_cfg.sps_cfg_dl_present) {
+    rr_cfg->sps_cfg.sps_cfg_dl.setup().n1_pucch_an_persistent_list.resize(1);
+    rr_cfg->sps_cfg.sps_cfg_dl.setup().n1_pucch_an_persistent_list[0] = n1_pucch_an;
+  }
+
+  parent->mac->set_sps_cfg(rnti, srslte::make_sps_cfg_t(rr_cfg->sps_cfg));
+  parent->mac->phy_config_enabled(rnti, false);
+}
+
 int rrc::ue::ri_get(uint32_t m_ri, uint16_t* ri_idx)
 {
   int32_t ret = SRSLTE_SUCCESS;
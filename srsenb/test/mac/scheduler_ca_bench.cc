@@ -0,0 +1,231 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Schedules full-buffer UEs configured in all the carriers of the eNB, first running the carrier scheduling passes of
+ * each TTI in series and then with carrier workers, and compares the scheduling time. The allocations must not depend
+ * on the threading.
+ */
+
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsenb/hdr/stack/mac/scheduler.h"
+#include "srsenb/hdr/stack/mac/scheduler_metric.h"
+#include "srslte/common/log_filter.h"
+#include "srslte/phy/utils/debug.h"
+
+static uint32_t nof_carriers = 2;
+static uint32_t nof_ues      = 16;
+static uint32_t nof_prb      = 100;
+static uint32_t nof_workers  = 1;
+static uint32_t nof_ttis     = 10000;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [cupwt]\n", prog);
+  printf("\t-c Number of carriers: [Default %d]\n", nof_carriers);
+  printf("\t-u Number of UEs: [Default %d]\n", nof_ues);
+  printf("\t-p Number of PRB per carrier: [Default %d]\n", nof_prb);
+  printf("\t-w Number of carrier workers: [Default %d]\n", nof_workers);
+  printf("\t-t Number of TTIs: [Default %d]\n", nof_ttis);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "cupwt")) != -1) {
+    switch (opt) {
+      case 'c':
+        nof_carriers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'u':
+        nof_ues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'p':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'w':
+        nof_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        nof_ttis = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+
+  if (nof_carriers < 2 || nof_carriers > SRSLTE_MAX_CARRIERS || nof_ues == 0 || !srslte_nofprb_isvalid(nof_prb)) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+typedef struct {
+  uint64_t sched_usec;
+  uint64_t dl_bytes[SRSLTE_MAX_CARRIERS];
+  uint64_t ul_bytes[SRSLTE_MAX_CARRIERS];
+} bench_result_t;
+
+// Runs all the TTIs with the given number of carrier workers, feeding back ACKs and full buffers
+static void run_sched(uint32_t workers, bench_result_t* result)
+{
+  srslte::log_filter log_out("MAC");
+  log_out.set_level(srslte::LOG_LEVEL_ERROR);
+
+  srsenb::sched                     sched;
+  std::vector<srsenb::dl_metric_rr> dl_metrics(nof_carriers);
+  std::vector<srsenb::ul_metric_rr> ul_metrics(nof_carriers);
+
+  sched.init(nullptr, &log_out, nof_carriers);
+  for (uint32_t cc = 0; cc < nof_carriers; cc++) {
+    sched.set_metric(cc, &dl_metrics[cc], &ul_metrics[cc]);
+  }
+
+  srsenb::sched_interface::sched_args_t sched_args = {};
+  sched_args.pdsch_mcs                             = -1;
+  sched_args.pdsch_max_mcs                         = 28;
+  sched_args.pusch_mcs                             = -1;
+  sched_args.pusch_max_mcs                         = 28;
+  sched_args.nof_ctrl_symbols                      = 3;
+  sched_args.max_aggr_level                        = 3;
+  sched_args.nof_carrier_workers                   = workers;
+  sched.set_sched_cfg(&sched_args);
+
+  srsenb::sched_interface::cell_cfg_t cell_cfg = {};
+  cell_cfg.cell.id                             = 1;
+  cell_cfg.cell.cp                             = SRSLTE_CP_NORM;
+  cell_cfg.cell.nof_ports                      = 1;
+  cell_cfg.cell.nof_prb                        = nof_prb;
+  cell_cfg.cell.phich_length                   = SRSLTE_PHICH_NORM;
+  cell_cfg.cell.phich_resources                = SRSLTE_PHICH_R_1;
+  cell_cfg.sibs[0].len                         = 18;
+  cell_cfg.sibs[0].period_rf                   = 8;
+  cell_cfg.sibs[1].len                         = 41;
+  cell_cfg.sibs[1].period_rf                   = 16;
+  cell_cfg.si_window_ms                        = 40;
+  cell_cfg.nrb_pucch                           = 2;
+  cell_cfg.prach_freq_offset                   = 2;
+  cell_cfg.maxharq_msg3tx                      = 3;
+  if (sched.cell_cfg(&cell_cfg) != SRSLTE_SUCCESS) {
+    ERROR("Error configuring the scheduler\n");
+    exit(-1);
+  }
+
+  srsenb::sched_interface::ue_cfg_t ue_cfg = {};
+  ue_cfg.maxharq_tx                        = 5;
+  ue_cfg.nof_supported_cc                  = nof_carriers;
+  for (uint32_t cc = 0; cc < nof_carriers; cc++) {
+    ue_cfg.supported_cc_idxs[cc] = cc;
+  }
+  srsenb::sched_interface::ue_bearer_cfg_t bearer_cfg = {};
+  bearer_cfg.direction                                = srsenb::sched_interface::ue_bearer_cfg_t::BOTH;
+
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    uint16_t rnti = 0x46 + i;
+    sched.ue_cfg(rnti, &ue_cfg);
+    sched.bearer_ue_cfg(rnti, 3, &bearer_cfg);
+    for (uint32_t cc = 0; cc < nof_carriers; cc++) {
+      sched.dl_cqi_info(0, rnti, cc, 15);
+      sched.ul_cqi_info(0, rnti, cc, 15, 0);
+    }
+  }
+
+  srsenb::sched_interface::dl_sched_res_t dl_res[SRSLTE_MAX_CARRIERS];
+  srsenb::sched_interface::ul_sched_res_t ul_res[SRSLTE_MAX_CARRIERS];
+  struct timeval                          t[3] = {};
+
+  bzero(result, sizeof(bench_result_t));
+  for (uint32_t tti = 0; tti < nof_ttis; tti++) {
+    for (uint32_t i = 0; i < nof_ues; i++) {
+      sched.dl_rlc_buffer_state(0x46 + i, 3, 1000000, 0);
+      sched.ul_bsr(0x46 + i, 3, 1000000, true);
+    }
+
+    gettimeofday(&t[1], NULL);
+    for (uint32_t cc = 0; cc < nof_carriers; cc++) {
+      sched.dl_sched(tti, cc, dl_res[cc]);
+      sched.ul_sched(tti, cc, ul_res[cc]);
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    result->sched_usec += (uint64_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+
+    // All the transmissions are received correctly
+    for (uint32_t cc = 0; cc < nof_carriers; cc++) {
+      for (uint32_t i = 0; i < dl_res[cc].nof_data_elems; i++) {
+        result->dl_bytes[cc] += dl_res[cc].data[i].tbs[0];
+        sched.dl_ack_info(tti, dl_res[cc].data[i].dci.rnti, cc, 0, true);
+      }
+      for (uint32_t i = 0; i < ul_res[cc].nof_dci_elems; i++) {
+        result->ul_bytes[cc] += ul_res[cc].pusch[i].tbs;
+        sched.ul_crc_info(tti, ul_res[cc].pusch[i].dci.rnti, cc, true);
+      }
+    }
+  }
+}
+
+static void print_result(const char* name, const bench_result_t* result)
+{
+  printf("%-12s %7.1f us/TTI", name, (double)result->sched_usec / nof_ttis);
+  for (uint32_t cc = 0; cc < nof_carriers; cc++) {
+    printf("; cc=%d DL %.1f UL %.1f Mbps",
+           cc,
+           result->dl_bytes[cc] * 8.0 / (nof_ttis * 1e3),
+           result->ul_bytes[cc] * 8.0 / (nof_ttis * 1e3));
+  }
+  printf("\n");
+}
+
+int main(int argc, char** argv)
+{
+  bench_result_t serial   = {};
+  bench_result_t parallel = {};
+
+  parse_args(argc, argv);
+
+  printf("-- CA scheduler benchmark. carriers=%d; ues=%d; prb=%d; workers=%d; ttis=%d\n",
+         nof_carriers,
+         nof_ues,
+         nof_prb,
+         nof_workers,
+         nof_ttis);
+
+  run_sched(0, &serial);
+  print_result("serial:", &serial);
+  run_sched(nof_workers, &parallel);
+  print_result("parallel:", &parallel);
+  printf("speedup: %.2f\n", (double)serial.sched_usec / SRSLTE_MAX(parallel.sched_usec, 1));
+
+  // Each carrier only allocates its share of the UE data, so its allocations do not depend on the other carriers
+  int ret = SRSLTE_SUCCESS;
+  for (uint32_t cc = 0; cc < nof_carriers; cc++) {
+    if (serial.dl_bytes[cc] != parallel.dl_bytes[cc] || serial.ul_bytes[cc] != parallel.ul_bytes[cc]) {
+      ERROR("Carrier %d allocations depend on the carrier workers\n", cc);
+      ret = SRSLTE_ERROR;
+    }
+  }
+
+  printf("%s!\n", (ret == SRSLTE_SUCCESS) ? "Ok" : "Failed");
+  return ret;
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Fills the PDCCH of every subframe with small DL and UL DCIs of many UEs and measures the time and search nodes spent
+ * by the CCE allocator per TTI. The allocator must place at least the requested number of DCIs per subframe without
+ * exceeding its search budget.
+ */
+
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsenb/hdr/stack/mac/scheduler.h"
+#include "srslte/common/log_filter.h"
+#include "srslte/phy/utils/debug.h"
+
+static uint32_t nof_ues       = 48;
+static uint32_t nof_prb       = 100;
+static uint32_t max_aggr_idx  = 1;
+static uint32_t min_nof_dcis  = 20;
+static uint32_t nof_ttis      = 10000;
+static uint32_t nof_ctrl_symb = 3;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [upadtc]\n", prog);
+  printf("\t-u Number of UEs: [Default %d]\n", nof_ues);
+  printf("\t-p Number of PRB: [Default %d]\n", nof_prb);
+  printf("\t-a Max aggregation level index of the DCIs: [Default %d]\n", max_aggr_idx);
+  printf("\t-d Min average number of DCIs per subframe: [Default %d]\n", min_nof_dcis);
+  printf("\t-t Number of TTIs: [Default %d]\n", nof_ttis);
+  printf("\t-c Number of control symbols: [Default %d]\n", nof_ctrl_symb);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "upadtc")) != -1) {
+    switch (opt) {
+      case 'u':
+        nof_ues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'p':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'a':
+        max_aggr_idx = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        min_nof_dcis = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        nof_ttis = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'c':
+        nof_ctrl_symb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+
+  if (nof_ues == 0 || !srslte_nofprb_isvalid(nof_prb) || max_aggr_idx > 3 || nof_ctrl_symb < 1 || nof_ctrl_symb > 3) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslte::log_filter log_out("MAC");
+  log_out.set_level(srslte::LOG_LEVEL_ERROR);
+
+  srsenb::sched_interface::cell_cfg_t cell_cfg = {};
+  cell_cfg.cell.id                             = 1;
+  cell_cfg.cell.cp                             = SRSLTE_CP_NORM;
+  cell_cfg.cell.nof_ports                      = 1;
+  cell_cfg.cell.nof_prb                        = nof_prb;
+  cell_cfg.cell.phich_length                   = SRSLTE_PHICH_NORM;
+  cell_cfg.cell.phich_resources                = SRSLTE_PHICH_R_1;
+  cell_cfg.si_window_ms                        = 40;
+
+  srslte_regs_t regs;
+  if (srslte_regs_init(&regs, cell_cfg.cell) != SRSLTE_SUCCESS) {
+    ERROR("Error initiating REGs\n");
+    exit(-1);
+  }
+
+  srsenb::sched_params_t sched_params;
+  sched_params.sched_cfg.pdsch_max_mcs    = 28;
+  sched_params.sched_cfg.pusch_max_mcs    = 28;
+  sched_params.sched_cfg.nof_ctrl_symbols = nof_ctrl_symb;
+  sched_params.sched_cfg.max_aggr_level   = 3;
+  if (not sched_params.set_cfg(&log_out, &cell_cfg, &regs)) {
+    ERROR("Error configuring the scheduler parameters\n");
+    exit(-1);
+  }
+
+  srsenb::sched_interface::ue_cfg_t ue_cfg = {};
+  ue_cfg.maxharq_tx                        = 5;
+  std::vector<srsenb::sched_ue>     ues(nof_ues);
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    ues[i].set_cfg(0x46 + i, sched_params, &ue_cfg);
+  }
+
+  printf("-- PDCCH allocator benchmark. ues=%d; prb=%d; cces=%d; max_aggr_idx=%d; ttis=%d\n",
+         nof_ues,
+         nof_prb,
+         sched_params.nof_cce_table[nof_ctrl_symb - 1],
+         max_aggr_idx,
+         nof_ttis);
+
+  srsenb::pdcch_grid_t pdcch;
+  pdcch.init(sched_params);
+
+  uint64_t              total_usec = 0, max_usec = 0;
+  uint64_t              total_dcis = 0, total_nodes = 0;
+  uint32_t              min_dcis = UINT32_MAX, max_nodes = 0;
+  std::vector<uint32_t> aggr_idxs(2 * nof_ues);
+  struct timeval        t[3] = {};
+
+  srand(0);
+  for (uint32_t tti = 0; tti < nof_ttis; tti++) {
+    srsenb::tti_params_t tti_params{tti};
+
+    // Random aggregation levels, so that the greedy placement often needs to relocate DCIs
+    for (uint32_t i = 0; i < 2 * nof_ues; i++) {
+      aggr_idxs[i] = (uint32_t)rand() % (max_aggr_idx + 1);
+    }
+
+    gettimeofday(&t[1], NULL);
+    pdcch.new_tti(tti_params, nof_ctrl_symb);
+    for (uint32_t i = 0; i < nof_ues; i++) {
+      srsenb::sched_ue* user = &ues[(tti + i) % nof_ues];
+      pdcch.alloc_dci(srsenb::alloc_type_t::DL_DATA, aggr_idxs[2 * i], user);
+      pdcch.alloc_dci(srsenb::alloc_type_t::UL_DATA, aggr_idxs[2 * i + 1], user);
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+
+    uint64_t usec = (uint64_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+    total_usec += usec;
+    max_usec = SRSLTE_MAX(max_usec, usec);
+    total_dcis += pdcch.nof_allocs();
+    min_dcis = SRSLTE_MIN(min_dcis, (uint32_t)pdcch.nof_allocs());
+    total_nodes += pdcch.nof_search_nodes();
+    max_nodes = SRSLTE_MAX(max_nodes, pdcch.nof_search_nodes());
+  }
+
+  double avg_dcis = (double)total_dcis / nof_ttis;
+  printf("DCIs/TTI: avg %.1f, min %d\n", avg_dcis, min_dcis);
+  printf("Search nodes/TTI: avg %.1f, max %d (budget %d)\n",
+         (double)total_nodes / nof_ttis,
+         max_nodes,
+         srsenb::pdcch_grid_t::max_search_nodes);
+  printf("Time/TTI: avg %.2f us, max %d us\n", (double)total_usec / nof_ttis, (uint32_t)max_usec);
+
+  int ret = SRSLTE_SUCCESS;
+  if (max_nodes > srsenb::pdcch_grid_t::max_search_nodes) {
+    ERROR("The CCE allocator exceeded its search budget\n");
+    ret = SRSLTE_ERROR;
+  }
+  if (avg_dcis < min_nof_dcis) {
+    ERROR("The CCE allocator placed less than %d DCIs per subframe\n", min_nof_dcis);
+    ret = SRSLTE_ERROR;
+  }
+
+  srslte_regs_free(&regs);
+
+  printf("%s!\n", (ret == SRSLTE_SUCCESS) ? "Ok" : "Failed");
+  return ret;
+}
@@ -0,0 +1,250 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/scheduler.h"
+#include "srsenb/hdr/stack/mac/scheduler_metric.h"
+#include <map>
+#include <vector>
+
+#include "srslte/common/log_filter.h"
+#include "srslte/common/test_common.h"
+
+/*
+ * Runs the scheduler with a single UE whose UL bearer has proactive grants configured, and checks the period of the
+ * grants, its adaptation to the UL traffic, the accounting of the used and wasted PRBs, and the release of the grants
+ * after PROACTIVE_UL_MAX_UNUSED of them are left unused
+ */
+
+const uint16_t rnti     = 70;
+const uint32_t drb_lcid = 3;
+const uint32_t nof_ttis = 1000;
+const uint32_t nof_prb  = 25;
+
+srslte::log_filter log_global("TEST");
+
+struct ul_grant_t {
+  uint32_t tti_tx_ul;
+  uint32_t nof_prb;
+};
+
+class proactive_ul_tester : public srsenb::sched
+{
+public:
+  int  add_user(uint32_t period_ms);
+  void run_tti(uint32_t tti_rx);
+
+  // The UE reports burst_bytes of UL data every burst_period_ms TTIs within [burst_start_tti, burst_stop_tti)
+  uint32_t burst_period_ms = 0;
+  uint32_t burst_start_tti = 0;
+  uint32_t burst_stop_tti  = 0;
+  uint32_t burst_bytes     = 20;
+
+  std::vector<ul_grant_t> proactive_grants; ///< grants given without UL data reported
+  std::vector<uint32_t>   burst_ttis;
+  uint32_t                used_prb   = 0;
+  uint32_t                wasted_prb = 0;
+
+private:
+  srsenb::dl_metric_rr dl_metric;
+  srsenb::ul_metric_rr ul_metric;
+
+  uint32_t                     bsr = 0;      ///< UL data reported by the UE and not received yet
+  std::map<uint32_t, uint32_t> pending_crcs; ///< bytes of UL data sent in the PUSCH, by the TTI its CRC is reported
+};
+
+int proactive_ul_tester::add_user(uint32_t period_ms)
+{
+  srsenb::sched_interface::cell_cfg_t cell_cfg_;
+  bzero(&cell_cfg_, sizeof(srsenb::sched_interface::cell_cfg_t));
+  cell_cfg_.cell.id              = 1;
+  cell_cfg_.cell.cp              = SRSLTE_CP_NORM;
+  cell_cfg_.cell.nof_ports       = 1;
+  cell_cfg_.cell.nof_prb         = nof_prb;
+  cell_cfg_.cell.phich_length    = SRSLTE_PHICH_NORM;
+  cell_cfg_.cell.phich_resources = SRSLTE_PHICH_R_1;
+  cell_cfg_.sibs[0].len          = 18;
+  cell_cfg_.sibs[0].period_rf    = 8;
+  cell_cfg_.sibs[1].len          = 41;
+  cell_cfg_.sibs[1].period_rf    = 16;
+  cell_cfg_.si_window_ms         = 40;
+  cell_cfg_.nrb_pucch            = 2;
+  cell_cfg_.prach_freq_offset    = 2;
+  cell_cfg_.prach_rar_window     = 3;
+  cell_cfg_.maxharq_msg3tx       = 3;
+
+  init(nullptr, &log_global);
+  set_metric(&dl_metric, &ul_metric);
+  TESTASSERT(cell_cfg(&cell_cfg_) == SRSLTE_SUCCESS);
+
+  srsenb::sched_interface::ue_cfg_t ue_cfg_ = {};
+  ue_cfg_.maxharq_tx                        = 4;
+  ue_cfg_.aperiodic_cqi_period              = 0;
+  TESTASSERT(ue_cfg(rnti, &ue_cfg_) == SRSLTE_SUCCESS);
+
+  srsenb::sched_interface::ue_bearer_cfg_t bearer_cfg = {};
+  bearer_cfg.direction                                = srsenb::sched_interface::ue_bearer_cfg_t::BOTH;
+  bearer_cfg.proactive_ul_period_ms                   = period_ms;
+  TESTASSERT(bearer_ue_cfg(rnti, drb_lcid, &bearer_cfg) == SRSLTE_SUCCESS);
+
+  phy_config_enabled(rnti, true);
+  dl_cqi_info(0, rnti, 0, 15);
+  ul_cqi_info(0, rnti, 0, 15, 0);
+
+  return SRSLTE_SUCCESS;
+}
+
+void proactive_ul_tester::run_tti(uint32_t tti_rx)
+{
+  uint32_t tti_tx_dl = TTI_TX(tti_rx);
+  uint32_t tti_tx_ul = TTI_RX_ACK(tti_rx);
+  log_global.step(tti_rx);
+
+  // The PUSCHs are always decoded. Once the reported data is received the BSR drops to zero
+  auto crc = pending_crcs.find(tti_rx);
+  if (crc != pending_crcs.end()) {
+    if (crc->second > 0) {
+      bsr = 0;
+      ul_bsr(rnti, drb_lcid, 0, true);
+    }
+    ul_crc_info(tti_rx, rnti, 0, true);
+    pending_crcs.erase(crc);
+  }
+
+  // New burst of UL data
+  if (burst_period_ms > 0 and tti_tx_ul >= burst_start_tti and tti_tx_ul < burst_stop_tti and
+      (tti_tx_ul - burst_start_tti) % burst_period_ms == 0) {
+    bsr = burst_bytes;
+    ul_bsr(rnti, drb_lcid, bsr, true);
+    burst_ttis.push_back(tti_tx_ul);
+  }
+
+  srsenb::sched_interface::dl_sched_res_t dl_res;
+  srsenb::sched_interface::ul_sched_res_t ul_res;
+  dl_sched(tti_tx_dl, 0, dl_res);
+  ul_sched(tti_tx_ul, 0, ul_res);
+
+  for (uint32_t i = 0; i < ul_res.nof_dci_elems; ++i) {
+    if (ul_res.pusch[i].dci.rnti != rnti or ul_res.pusch[i].dci.tb.rv != 0) {
+      continue;
+    }
+    if (bsr == 0) {
+      uint32_t L_crb = 0, RB_start = 0;
+      srslte_ra_type2_from_riv(ul_res.pusch[i].dci.type2_alloc.riv, &L_crb, &RB_start, nof_prb, nof_prb);
+      proactive_grants.push_back({tti_tx_ul, L_crb});
+    }
+    pending_crcs[tti_tx_ul] = bsr;
+  }
+
+  uint32_t used = 0, wasted = 0;
+  get_ul_proactive_prb(rnti, &used, &wasted);
+  used_prb += used;
+  wasted_prb += wasted;
+}
+
+/// Without UL data, the grants are given at the configured period until PROACTIVE_UL_MAX_UNUSED of them are wasted
+int test_unused_grants()
+{
+  const uint32_t period_ms = 10;
+
+  proactive_ul_tester tester;
+  TESTASSERT(tester.add_user(period_ms) == SRSLTE_SUCCESS);
+  for (uint32_t tti_rx = 0; tti_rx < nof_ttis; ++tti_rx) {
+    tester.run_tti(tti_rx);
+  }
+
+  const std::vector<ul_grant_t>& grants = tester.proactive_grants;
+  TESTASSERT(grants.size() >= srsenb::sched_ue::PROACTIVE_UL_MAX_UNUSED);
+  uint32_t total_prb = 0;
+  for (uint32_t i = 0; i < grants.size(); ++i) {
+    TESTASSERT(grants[i].nof_prb > 0);
+    TESTASSERT(i == 0 or grants[i].tti_tx_ul - grants[i - 1].tti_tx_ul == period_ms);
+    total_prb += grants[i].nof_prb;
+  }
+
+  // The grants already given when the last unused one is accounted are wasted too, then they stop
+  TESTASSERT(grants.size() <= srsenb::sched_ue::PROACTIVE_UL_MAX_UNUSED + 2);
+  TESTASSERT(tester.used_prb == 0);
+  TESTASSERT(tester.wasted_prb == total_prb);
+
+  return SRSLTE_SUCCESS;
+}
+
+/// With periodic UL data, the grants are used, their period follows the bursts, and they stop once the data stops
+int test_periodic_traffic()
+{
+  const uint32_t period_ms = 20;
+
+  proactive_ul_tester tester;
+  tester.burst_period_ms = 2 * period_ms;
+  tester.burst_start_tti = 100;
+  tester.burst_stop_tti  = 500;
+  TESTASSERT(tester.add_user(period_ms) == SRSLTE_SUCCESS);
+  for (uint32_t tti_rx = 0; tti_rx < nof_ttis; ++tti_rx) {
+    tester.run_tti(tti_rx);
+  }
+
+  const std::vector<ul_grant_t>& grants = tester.proactive_grants;
+  const std::vector<uint32_t>&   bursts = tester.burst_ttis;
+  TESTASSERT(not grants.empty() and not bursts.empty());
+
+  // Before the first burst, the grants follow the configured period
+  TESTASSERT(grants[0].tti_tx_ul < bursts[0]);
+  TESTASSERT(grants[1].tti_tx_ul - grants[0].tti_tx_ul == period_ms);
+
+  // Between bursts, the first proactive grant goes one period after the burst. The period grows towards the interval
+  // between bursts, so the grant after the first burst goes earlier than the one after the last burst
+  std::vector<uint32_t> burst_delays;
+  for (uint32_t burst_tti : bursts) {
+    for (const ul_grant_t& g : grants) {
+      if (g.tti_tx_ul > burst_tti) {
+        burst_delays.push_back(g.tti_tx_ul - burst_tti);
+        break;
+      }
+    }
+  }
+  TESTASSERT(burst_delays.size() == bursts.size());
+  TESTASSERT(burst_delays.front() == period_ms);
+  TESTASSERT(burst_delays.back() > period_ms);
+  TESTASSERT(burst_delays.back() <= tester.burst_period_ms);
+
+  // The grants followed by UL data are used. Those after the data stops are wasted, and released
+  TESTASSERT(tester.used_prb > 0);
+  TESTASSERT(tester.wasted_prb > 0);
+  uint32_t nof_grants_after_data = 0;
+  for (const ul_grant_t& g : grants) {
+    nof_grants_after_data += g.tti_tx_ul > bursts.back() ? 1 : 0;
+  }
+  TESTASSERT(nof_grants_after_data >= srsenb::sched_ue::PROACTIVE_UL_MAX_UNUSED);
+  TESTASSERT(nof_grants_after_data <= srsenb::sched_ue::PROACTIVE_UL_MAX_UNUSED + 2);
+
+  return SRSLTE_SUCCESS;
+}
+
+int main()
+{
+  log_global.set_level(srslte::LOG_LEVEL_INFO);
+
+  TESTASSERT(test_unused_grants() == SRSLTE_SUCCESS);
+  TESTASSERT(test_periodic_traffic() == SRSLTE_SUCCESS);
+
+  printf("Success\n");
+  return SRSLTE_SUCCESS;
+}
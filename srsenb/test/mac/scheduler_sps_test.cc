@@ -0,0 +1,324 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/scheduler.h"
+#include "srsenb/hdr/stack/mac/scheduler_metric.h"
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "srslte/common/log_filter.h"
+#include "srslte/common/test_common.h"
+
+/*
+ * Runs the scheduler with a single UE that has SPS configured in both directions and checks the activation of the
+ * configured grants, their occasions without PDCCH, the retxs addressed to the SPS C-RNTI and the release
+ */
+
+const uint16_t rnti     = 70;
+const uint16_t sps_rnti = 0xea60;
+const uint32_t drb_lcid = 3;
+
+const uint32_t dl_interval    = 20;
+const uint32_t dl_nof_harq    = 2;
+const uint32_t dl_n1_pucch_an = 10;
+const uint32_t ul_interval    = 20;
+const uint32_t ul_nof_empty   = 2;
+
+// The DL data of a SPS voice-like bearer arrives every dl_interval TTIs until dl_stop_tti. UL MAC SDUs are received
+// in the PUSCHs of the configured grant until ul_stop_tti, then only padding
+const uint32_t dl_stop_tti = 200;
+const uint32_t ul_stop_tti = 120;
+const uint32_t nof_ttis    = 400;
+
+// The first occasion of each direction after the activation is NACKed once
+const uint32_t dl_nack_tti = 60;
+const uint32_t ul_nack_tti = 28;
+
+srslte::log_filter log_global("TEST");
+
+struct dl_alloc_t {
+  uint32_t                                 tti_tx_dl;
+  srsenb::sched_interface::dl_sched_data_t data;
+};
+
+struct ul_alloc_t {
+  uint32_t                                 tti_tx_ul;
+  srsenb::sched_interface::ul_sched_data_t data;
+};
+
+class sps_tester : public srsenb::sched
+{
+public:
+  int  add_user();
+  void run_tti(uint32_t tti_rx);
+
+  std::vector<dl_alloc_t> dl_allocs;
+  std::vector<ul_alloc_t> ul_allocs;
+
+private:
+  srsenb::dl_metric_rr dl_metric;
+  srsenb::ul_metric_rr ul_metric;
+
+  // Feedback of the PDSCHs and PUSCHs of the UE, indexed by the TTI the PHY reports it in
+  std::multimap<uint32_t, bool> pending_acks;
+  std::map<uint32_t, bool>      pending_crcs; ///< the value tells if the PUSCH is sent in the configured grant
+};
+
+int sps_tester::add_user()
+{
+  srsenb::sched_interface::cell_cfg_t cell_cfg_;
+  bzero(&cell_cfg_, sizeof(srsenb::sched_interface::cell_cfg_t));
+  cell_cfg_.cell.id              = 1;
+  cell_cfg_.cell.cp              = SRSLTE_CP_NORM;
+  cell_cfg_.cell.nof_ports       = 1;
+  cell_cfg_.cell.nof_prb         = 25;
+  cell_cfg_.cell.phich_length    = SRSLTE_PHICH_NORM;
+  cell_cfg_.cell.phich_resources = SRSLTE_PHICH_R_1;
+  cell_cfg_.sibs[0].len          = 18;
+  cell_cfg_.sibs[0].period_rf    = 8;
+  cell_cfg_.sibs[1].len          = 41;
+  cell_cfg_.sibs[1].period_rf    = 16;
+  cell_cfg_.si_window_ms         = 40;
+  cell_cfg_.nrb_pucch            = 2;
+  cell_cfg_.prach_freq_offset    = 2;
+  cell_cfg_.prach_rar_window     = 3;
+  cell_cfg_.maxharq_msg3tx       = 3;
+
+  init(nullptr, &log_global);
+  set_metric(&dl_metric, &ul_metric);
+  TESTASSERT(cell_cfg(&cell_cfg_) == SRSLTE_SUCCESS);
+
+  srsenb::sched_interface::ue_cfg_t ue_cfg_ = {};
+  ue_cfg_.maxharq_tx                        = 4;
+  ue_cfg_.aperiodic_cqi_period              = 0;
+  TESTASSERT(ue_cfg(rnti, &ue_cfg_) == SRSLTE_SUCCESS);
+
+  srsenb::sched_interface::ue_bearer_cfg_t bearer_cfg = {};
+  bearer_cfg.direction                                = srsenb::sched_interface::ue_bearer_cfg_t::BOTH;
+  TESTASSERT(bearer_ue_cfg(rnti, drb_lcid, &bearer_cfg) == SRSLTE_SUCCESS);
+
+  asn1::rrc::phys_cfg_ded_s::ant_info_c_ ant_info;
+  ant_info.set_explicit_value();
+  ant_info.explicit_value().tx_mode.value = asn1::rrc::ant_info_ded_s::tx_mode_e_::tm1;
+  TESTASSERT(dl_ant_info(rnti, &ant_info) == SRSLTE_SUCCESS);
+
+  srslte::sps_cfg_t sps_cfg;
+  sps_cfg.sps_rnti            = sps_rnti;
+  sps_cfg.dl_enabled          = true;
+  sps_cfg.dl_interval         = dl_interval;
+  sps_cfg.dl_nof_harq         = dl_nof_harq;
+  sps_cfg.dl_n1_pucch_an      = dl_n1_pucch_an;
+  sps_cfg.ul_enabled          = true;
+  sps_cfg.ul_interval         = ul_interval;
+  sps_cfg.ul_implicit_release = ul_nof_empty;
+  TESTASSERT(ue_sps_cfg(rnti, sps_cfg) == SRSLTE_SUCCESS);
+
+  phy_config_enabled(rnti, true);
+  dl_cqi_info(0, rnti, 0, 15);
+  ul_cqi_info(0, rnti, 0, 15, 0);
+  ul_bsr(rnti, drb_lcid, 50, true);
+
+  return SRSLTE_SUCCESS;
+}
+
+void sps_tester::run_tti(uint32_t tti_rx)
+{
+  uint32_t tti_tx_dl = TTI_TX(tti_rx);
+  uint32_t tti_tx_ul = TTI_RX_ACK(tti_rx);
+  log_global.step(tti_rx);
+
+  // Feedback received by the PHY in tti_rx. As the eNB MAC does, the SDUs of the decoded PUSCHs of the configured
+  // grant are reported before their CRC
+  auto acks = pending_acks.equal_range(tti_rx);
+  for (auto it = acks.first; it != acks.second; ++it) {
+    dl_ack_info(tti_rx, rnti, 0, 0, it->second);
+  }
+  pending_acks.erase(acks.first, acks.second);
+  auto crc = pending_crcs.find(tti_rx);
+  if (crc != pending_crcs.end()) {
+    bool crc_ok = not(crc->second and tti_rx == ul_nack_tti);
+    if (crc_ok and crc->second) {
+      ul_sdu_info(tti_rx, rnti, 0, tti_rx < ul_stop_tti ? 1 : 0);
+    }
+    ul_crc_info(tti_rx, rnti, 0, crc_ok);
+    pending_crcs.erase(crc);
+  }
+
+  // New DL data of the bearer
+  if (tti_tx_dl % dl_interval == 0 and tti_tx_dl < dl_stop_tti) {
+    dl_rlc_buffer_state(rnti, drb_lcid, 50, 0);
+  }
+
+  srsenb::sched_interface::dl_sched_res_t dl_res;
+  srsenb::sched_interface::ul_sched_res_t ul_res;
+  dl_sched(tti_tx_dl, 0, dl_res);
+  ul_sched(tti_tx_ul, 0, ul_res);
+
+  for (uint32_t i = 0; i < dl_res.nof_data_elems; ++i) {
+    if (dl_res.data[i].dci.rnti != rnti) {
+      continue;
+    }
+    dl_allocs.push_back({tti_tx_dl, dl_res.data[i]});
+    if (dl_res.data[i].tbs[0] > 0) {
+      bool is_nacked = tti_tx_dl == dl_nack_tti and dl_res.data[i].sps_rnti != 0;
+      pending_acks.insert(std::make_pair(TTI_TX(tti_tx_dl), not is_nacked));
+    }
+  }
+  for (uint32_t i = 0; i < ul_res.nof_dci_elems; ++i) {
+    if (ul_res.pusch[i].dci.rnti != rnti) {
+      continue;
+    }
+    ul_allocs.push_back({tti_tx_ul, ul_res.pusch[i]});
+    pending_crcs[tti_tx_ul] = ul_res.pusch[i].sps_rnti != 0;
+
+    // The activation grant takes the whole UL buffer
+    if (ul_res.pusch[i].sps_rnti != 0 and ul_res.pusch[i].needs_pdcch) {
+      ul_bsr(rnti, drb_lcid, 0, true);
+    }
+  }
+}
+
+int test_sps_dl(const sps_tester& tester)
+{
+  // The activation goes in the first TTI with data whose configured HARQ process is 0
+  auto act = std::find_if(tester.dl_allocs.begin(), tester.dl_allocs.end(), [](const dl_alloc_t& a) {
+    return a.data.sps_rnti == sps_rnti;
+  });
+  TESTASSERT(act != tester.dl_allocs.end());
+  TESTASSERT(act->tti_tx_dl == 2 * dl_interval);
+  TESTASSERT(act->data.needs_pdcch);
+  TESTASSERT(act->data.dci.format == SRSLTE_DCI_FORMAT1);
+  TESTASSERT(act->data.dci.pid == 0);
+  TESTASSERT(not act->data.dci.tb[0].ndi);
+  TESTASSERT(act->data.dci.tb[0].rv == 0);
+  TESTASSERT(act->data.dci.tpc_pucch == 0);
+  TESTASSERT(act->data.dci.tb[0].mcs_idx <= 15);
+  uint32_t rbg_bitmask = act->data.dci.type0_alloc.rbg_bitmask;
+
+  // Occasions without PDCCH in the configured RBGs until the data stops, then the release after SPS_DL_MAX_EMPTY
+  // empty occasions
+  uint32_t release_tti   = dl_stop_tti + (srsenb::sched_ue::SPS_DL_MAX_EMPTY - 1) * dl_interval;
+  uint32_t nof_occasions = 0;
+  bool     retx_found = false, release_found = false;
+  for (auto it = act + 1; it != tester.dl_allocs.end(); ++it) {
+    const srsenb::sched_interface::dl_sched_data_t& data = it->data;
+    if (data.sps_rnti == 0) {
+      // Dynamic allocations use the HARQ processes that are not configured for SPS
+      TESTASSERT(data.dci.pid >= dl_nof_harq);
+      continue;
+    }
+    TESTASSERT(not release_found);
+    if (data.dci.format == SRSLTE_DCI_FORMAT1A) {
+      TESTASSERT(it->tti_tx_dl == release_tti + 1);
+      TESTASSERT(data.needs_pdcch);
+      TESTASSERT(data.dci.tb[0].mcs_idx == 31);
+      TESTASSERT(data.dci.pid == 0);
+      TESTASSERT(data.tbs[0] == 0);
+      release_found = true;
+    } else if (data.needs_pdcch) {
+      // Retx of the NACKed occasion, addressed to the SPS C-RNTI with NDI=1
+      TESTASSERT(it->tti_tx_dl > dl_nack_tti and it->tti_tx_dl < dl_nack_tti + dl_interval);
+      TESTASSERT(data.dci.pid == (dl_nack_tti / dl_interval) % dl_nof_harq);
+      TESTASSERT(data.dci.tb[0].ndi);
+      TESTASSERT(data.dci.tb[0].rv != 0);
+      TESTASSERT(not retx_found);
+      retx_found = true;
+    } else {
+      TESTASSERT(it->tti_tx_dl % dl_interval == 0 and it->tti_tx_dl < dl_stop_tti);
+      TESTASSERT(data.dci.type0_alloc.rbg_bitmask == rbg_bitmask);
+      TESTASSERT(data.dci.pid == (it->tti_tx_dl / dl_interval) % dl_nof_harq);
+      TESTASSERT(data.dci.location.ncce == dl_n1_pucch_an);
+      TESTASSERT(data.tbs[0] > 0);
+      nof_occasions++;
+    }
+  }
+  TESTASSERT(nof_occasions == (dl_stop_tti - act->tti_tx_dl) / dl_interval - 1);
+  TESTASSERT(retx_found);
+  TESTASSERT(release_found);
+
+  return SRSLTE_SUCCESS;
+}
+
+int test_sps_ul(const sps_tester& tester)
+{
+  // The activation goes in the first UL grant, as the UE has a BSR pending
+  auto act = std::find_if(tester.ul_allocs.begin(), tester.ul_allocs.end(), [](const ul_alloc_t& a) {
+    return a.data.sps_rnti == sps_rnti;
+  });
+  TESTASSERT(act != tester.ul_allocs.end());
+  TESTASSERT(act->tti_tx_ul == TTI_RX_ACK(0));
+  TESTASSERT(act->data.needs_pdcch);
+  TESTASSERT(act->data.dci.tb.rv == 0);
+  TESTASSERT(not act->data.dci.tb.ndi);
+  TESTASSERT(act->data.dci.tpc_pusch == 0);
+  TESTASSERT(act->data.dci.n_dmrs == 0);
+  TESTASSERT(act->data.dci.tb.mcs_idx <= 15);
+  uint32_t riv = act->data.dci.type2_alloc.riv;
+
+  // The UE transmits in every occasion. After ul_nof_empty new transmissions without MAC SDUs, both sides release the
+  // grant implicitly
+  uint32_t last_occasion = ul_stop_tti + (ul_nof_empty - 1) * ul_interval;
+  last_occasion += (act->tti_tx_ul - last_occasion % ul_interval + ul_interval) % ul_interval;
+  uint32_t nof_occasions = 0;
+  bool     retx_found    = false;
+  for (auto it = act + 1; it != tester.ul_allocs.end(); ++it) {
+    const srsenb::sched_interface::ul_sched_data_t& data = it->data;
+    if (data.sps_rnti == 0) {
+      continue;
+    }
+    if (data.dci.tb.rv != 0) {
+      // Retx of the PUSCH of the occasion that failed the CRC. If adaptive, addressed to the SPS C-RNTI with NDI=1
+      TESTASSERT(it->tti_tx_ul == ul_nack_tti + SRSLTE_FDD_NOF_HARQ);
+      TESTASSERT(data.dci.tb.rv == srsenb::sched::get_rvidx(1));
+      TESTASSERT(not data.needs_pdcch or data.dci.tb.ndi);
+      TESTASSERT(not retx_found);
+      retx_found = true;
+      continue;
+    }
+    TESTASSERT(not data.needs_pdcch);
+    TESTASSERT(srslte_tti_interval(it->tti_tx_ul, act->tti_tx_ul) % ul_interval == 0);
+    TESTASSERT(it->tti_tx_ul <= last_occasion);
+    TESTASSERT(data.dci.type2_alloc.riv == riv);
+    nof_occasions++;
+  }
+  TESTASSERT(nof_occasions == (last_occasion - act->tti_tx_ul) / ul_interval);
+  TESTASSERT(retx_found);
+
+  return SRSLTE_SUCCESS;
+}
+
+int main()
+{
+  log_global.set_level(srslte::LOG_LEVEL_INFO);
+
+  sps_tester tester;
+  TESTASSERT(tester.add_user() == SRSLTE_SUCCESS);
+  for (uint32_t tti_rx = 0; tti_rx < nof_ttis; ++tti_rx) {
+    tester.run_tti(tti_rx);
+  }
+
+  TESTASSERT(test_sps_dl(tester) == SRSLTE_SUCCESS);
+  TESTASSERT(test_sps_ul(tester) == SRSLTE_SUCCESS);
+
+  printf("Success\n");
+  return SRSLTE_SUCCESS;
+}
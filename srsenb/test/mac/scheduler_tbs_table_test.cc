@@ -0,0 +1,142 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/scheduler_tbs_table.h"
+#include "srsenb/hdr/stack/mac/scheduler_ue.h"
+
+#include "srslte/common/log_filter.h"
+#include "srslte/common/test_common.h"
+
+/*
+ * Checks that the TBS/MCS tables of the scheduler give the same TBS, MCS and required number of PRBs as the MCS search
+ * of sched_ue_carrier::alloc_tbs() and the linear PRB searches they replace, for every cell bandwidth, CQI and number
+ * of control symbols
+ */
+
+using srsenb::sched_tbs_table;
+using srsenb::sched_ue_carrier;
+
+srslte::log_filter log_global("TEST");
+
+const uint32_t cell_nof_prb[] = {6, 15, 25, 50, 75, 100};
+const uint32_t max_req_bytes  = 12000;
+
+// Request sizes, every byte count for the small requests
+uint32_t next_req_bytes(uint32_t req_bytes)
+{
+  return req_bytes + (req_bytes < 500 ? 1 : 37);
+}
+
+/// Linear search of the number of PRBs of sched_ue::get_required_prb_dl() without the table
+uint32_t linear_required_prb_dl(sched_ue_carrier* carrier,
+                                srslte_cell_t*    cell,
+                                uint32_t          nof_ctrl_symbols,
+                                uint32_t          req_bytes)
+{
+  uint32_t nbytes = 0;
+  uint32_t n;
+  for (n = 0; n < cell->nof_prb && nbytes < req_bytes; ++n) {
+    int mcs    = 0;
+    int nof_re = srslte_ra_dl_approx_nof_re(cell, n + 1, nof_ctrl_symbols);
+    int tbs    = carrier->alloc_tbs_dl(n + 1, nof_re, 0, &mcs);
+    if (tbs > 0) {
+      nbytes = tbs;
+    } else if (tbs < 0) {
+      return 0;
+    }
+  }
+  return n;
+}
+
+int test_cell(uint32_t nof_prb, int max_mcs, uint32_t* nof_cases)
+{
+  srslte_cell_t cell = {};
+  cell.nof_prb       = nof_prb;
+  cell.nof_ports     = 1;
+  cell.cp            = SRSLTE_CP_NORM;
+
+  sched_tbs_table tbs_table;
+  tbs_table.init(cell, max_mcs, max_mcs);
+
+  // Same user with and without the tables
+  srsenb::sched_interface::ue_cfg_t ue_cfg = {};
+  sched_ue_carrier                  ref_carrier(&ue_cfg, &cell, 70, 0, nullptr, &log_global);
+  sched_ue_carrier                  carrier(&ue_cfg, &cell, 70, 0, &tbs_table, &log_global);
+  for (sched_ue_carrier* c : {&ref_carrier, &carrier}) {
+    c->fixed_mcs_dl = -1;
+    c->fixed_mcs_ul = -1;
+    c->max_mcs_dl   = max_mcs;
+    c->max_mcs_ul   = max_mcs;
+  }
+
+  for (uint32_t cqi = 0; cqi <= sched_tbs_table::MAX_CQI; ++cqi) {
+    ref_carrier.dl_cqi = carrier.dl_cqi = cqi;
+    ref_carrier.ul_cqi = carrier.ul_cqi = cqi;
+
+    // DL, with the approximate number of REs of every number of control symbols
+    for (uint32_t nof_ctrl_symbols = 1; nof_ctrl_symbols <= sched_tbs_table::MAX_CTRL_SYMBOLS; ++nof_ctrl_symbols) {
+      TESTASSERT(tbs_table.is_valid_dl(cqi, max_mcs, nof_ctrl_symbols));
+      for (uint32_t n = 1; n <= nof_prb; ++n) {
+        int mcs     = 0;
+        int ref_mcs = 0;
+        int nof_re  = srslte_ra_dl_approx_nof_re(&cell, n, nof_ctrl_symbols);
+        TESTASSERT(tbs_table.get_tbs_dl(cqi, n, nof_ctrl_symbols, &mcs) ==
+                   ref_carrier.alloc_tbs_dl(n, nof_re, 0, &ref_mcs));
+        TESTASSERT(mcs == ref_mcs);
+      }
+      for (uint32_t req_bytes = 1; req_bytes < max_req_bytes; req_bytes = next_req_bytes(req_bytes)) {
+        TESTASSERT(tbs_table.get_required_prb_dl(cqi, nof_ctrl_symbols, req_bytes, nof_prb) ==
+                   linear_required_prb_dl(&ref_carrier, &cell, nof_ctrl_symbols, req_bytes));
+        (*nof_cases)++;
+      }
+    }
+
+    // UL, for a PUSCH without SRS
+    TESTASSERT(tbs_table.is_valid_ul(cqi, max_mcs));
+    for (uint32_t n = 1; n <= nof_prb; ++n) {
+      int mcs     = 0;
+      int ref_mcs = 0;
+      int nof_re  = 2 * (SRSLTE_CP_NSYMB(cell.cp) - 1) * n * SRSLTE_NRE;
+      TESTASSERT(tbs_table.get_tbs_ul(cqi, n, &mcs) == ref_carrier.alloc_tbs_ul(n, nof_re, 0, &ref_mcs));
+      TESTASSERT(mcs == ref_mcs);
+    }
+    for (uint32_t req_bytes = 1; req_bytes < max_req_bytes; req_bytes = next_req_bytes(req_bytes)) {
+      TESTASSERT(carrier.get_required_prb_ul(req_bytes) == ref_carrier.get_required_prb_ul(req_bytes));
+      (*nof_cases)++;
+    }
+  }
+
+  return SRSLTE_SUCCESS;
+}
+
+int main()
+{
+  uint32_t nof_cases = 0;
+  for (uint32_t nof_prb : cell_nof_prb) {
+    TESTASSERT(test_cell(nof_prb, 28, &nof_cases) == SRSLTE_SUCCESS);
+    // Cell configured with a lower maximum MCS
+    TESTASSERT(test_cell(nof_prb, 20, &nof_cases) == SRSLTE_SUCCESS);
+  }
+
+  printf("Checked %u cases\n", nof_cases);
+  printf("Success\n");
+  return SRSLTE_SUCCESS;
+}
@@ -21,8 +21,10 @@
 
 #include "srsenb/hdr/stack/mac/scheduler.h"
 #include "srsenb/hdr/stack/mac/scheduler_carrier.h"
+#include "srsenb/hdr/stack/mac/scheduler_metric.h"
 #include "srsenb/hdr/stack/mac/scheduler_ue.h"
 #include <algorithm>
+#include <chrono>
 #include <random>
 #include <set>
 #include <srslte/srslte.h>
@@ -120,6 +122,7 @@ public:
 };
 log_tester log_global;
 bool       check_old_pids = true;
+uint32_t   tti_lookahead  = 0;
 
 /*******************
  *     Dummies     *
@@ -143,6 +146,7 @@ struct sched_sim_args {
 
   std::vector<tti_event_t>                 tti_events;
   uint32_t                                 nof_ttis;
+  uint32_t                                 tti_lookahead = 0; ///< the HARQ feedback reaches the scheduler this late
   float                                    P_retx;
   srsenb::sched_interface::ue_cfg_t        ue_cfg;
   srsenb::sched_interface::ue_bearer_cfg_t bearer_cfg;
@@ -204,6 +208,13 @@ struct sched_tester : public srsenb::sched {
   uint32_t       nof_rbgs = 0;
   sched_sim_args sim_args;
 
+  // number of user TTIs with pending data older than the bearer delay budget
+  uint32_t nof_dl_late = 0;
+  uint32_t nof_ul_late = 0;
+
+  // time spent by the scheduler
+  std::chrono::nanoseconds sched_time{0};
+
   // tester control data
   std::map<uint16_t, ue_info>                           tester_ues;
   std::multimap<uint32_t, ack_info_t>                   to_ack;
@@ -339,9 +350,9 @@ int sched_tester::process_tti_args()
 void sched_tester::before_sched()
 {
   // check pending data buffers
-  for (auto& it : ue_db) {
-    uint16_t              rnti = it.first;
-    srsenb::sched_ue*     user = &it.second;
+  for (srsenb::sched_ue& it : ue_db) {
+    uint16_t              rnti = it.get_rnti();
+    srsenb::sched_ue*     user = &it;
     tester_user_results   d;
     srsenb::ul_harq_proc* hul = user->get_ul_harq(tti_data.tti_tx_ul, CARRIER_IDX);
     d.ul_pending_data         = get_ul_buffer(rnti);
@@ -351,8 +362,14 @@ void sched_tester::before_sched()
     d.has_ul_tx               = d.has_ul_retx or d.ul_pending_data > 0;
     srsenb::dl_harq_proc* hdl = user->get_pending_dl_harq(tti_data.tti_tx_dl, CARRIER_IDX);
     d.has_dl_retx             = (hdl != nullptr) and hdl->has_pending_retx(0, tti_data.tti_tx_dl);
-    d.has_dl_tx = (hdl != nullptr) or (it.second.get_empty_dl_harq(CARRIER_IDX) != nullptr and d.dl_pending_data > 0);
+    d.has_dl_tx = (hdl != nullptr) or (it.get_empty_dl_harq(CARRIER_IDX) != nullptr and d.dl_pending_data > 0);
     d.has_ul_newtx = not d.has_ul_retx and d.ul_pending_data > 0;
+    if (user->get_dl_slack_ms(tti_data.tti_tx_dl) < 0) {
+      nof_dl_late++;
+    }
+    if (user->get_ul_slack_ms(tti_data.tti_tx_ul) < 0) {
+      nof_ul_late++;
+    }
     tti_data.ue_data.insert(std::make_pair(rnti, d));
     tti_data.total_ues.dl_pending_data += d.dl_pending_data;
     tti_data.total_ues.ul_pending_data += d.ul_pending_data;
@@ -410,8 +427,10 @@ void sched_tester::run_tti(uint32_t tti_rx)
   ack_txs();
   before_sched();
 
+  auto tic = std::chrono::steady_clock::now();
   dl_sched(tti_data.tti_tx_dl, CARRIER_IDX, tti_data.sched_result_dl);
   ul_sched(tti_data.tti_tx_ul, CARRIER_IDX, tti_data.sched_result_ul);
+  sched_time += std::chrono::steady_clock::now() - tic;
 
   process_results();
 }
@@ -475,7 +494,10 @@ int sched_tester::test_ra()
         if (ue_data.pdu[0][j].lcid == srslte::sch_subh::CON_RES_ID) {
           // ConRes found
           CONDERROR(ue_data.dci.format != SRSLTE_DCI_FORMAT1, "ConRes must be format1\n");
-          CONDERROR(userinfo.msg3_tti > (int)tti_data.tti_rx, "Transmitting ConRes without receiving Msg3\n");
+          // NOTE: a Msg3 received before the TTI wrap-around is not in the future
+          CONDERROR(userinfo.msg3_tti > (int)tti_data.tti_rx and
+                        srslte_tti_interval(userinfo.msg3_tti, tti_data.tti_rx) < 10240 / 2,
+                    "Transmitting ConRes without receiving Msg3\n");
           CONDERROR(userinfo.msg4_tti >= 0, "ConRes CE cannot be retransmitted for the same rnti\n");
           userinfo.msg4_tti = tti_data.tti_tx_dl;
         }
@@ -664,6 +686,11 @@ int sched_tester::test_harqs()
   for (uint32_t i = 0; i < tti_data.sched_result_ul.nof_phich_elems; ++i) {
     const auto& phich = tti_data.sched_result_ul.phich[i];
     CONDERROR(tti_data.ue_data.count(phich.rnti) == 0, "[TESTER] Allocated PHICH rnti no longer exists\n");
+    if (sim_args.tti_lookahead > 0) {
+      // The CRC is not known yet, the UE suspends the HARQ process and retxs are adaptive
+      CONDERROR(phich.phich != sched_interface::ul_sched_phich_t::ACK, "[TESTER] PHICH NACK scheduling ahead\n");
+      continue;
+    }
     const auto& hprev = tti_data.ue_data[phich.rnti].ul_harq;
     const auto* h     = ue_db[phich.rnti].get_ul_harq(tti_data.tti_tx_ul, CARRIER_IDX);
     CONDERROR(not hprev.has_pending_ack(), "[TESTER] Alloc PHICH did not have any pending ack\n");
@@ -674,15 +701,15 @@ int sched_tester::test_harqs()
       CONDERROR(h->get_pending_data() == 0 and !maxretx_flag, "[TESTER] NACKed harq has no pending data\n");
     }
   }
-  for (const auto& ue : ue_db) {
-    const auto& hprev = tti_data.ue_data[ue.first].ul_harq;
-    if (not hprev.has_pending_ack()) {
+  for (const srsenb::sched_ue& ue : ue_db) {
+    const auto& hprev = tti_data.ue_data[ue.get_rnti()].ul_harq;
+    if (not hprev.has_pending_ack() or sim_args.tti_lookahead > 0) {
       continue;
     }
     uint32_t i = 0;
     for (; i < tti_data.sched_result_ul.nof_phich_elems; ++i) {
       const auto& phich = tti_data.sched_result_ul.phich[i];
-      if (phich.rnti == ue.first) {
+      if (phich.rnti == ue.get_rnti()) {
         break;
       }
     }
@@ -708,7 +735,7 @@ int sched_tester::test_harqs()
     ack_it_t it = to_ack.begin();
     while (it != to_ack.end() and it->first < ack_data.tti) {
       if (it->second.rnti == ack_data.rnti and it->second.dl_harq.get_id() == ack_data.dl_harq.get_id()) {
-        CONDERROR(it->second.tti + 2 * FDD_HARQ_DELAY_MS > ack_data.tti,
+        CONDERROR(it->second.tti + 2 * FDD_HARQ_DELAY_MS + sim_args.tti_lookahead > ack_data.tti,
                   "[TESTER] The retx dl harq id=%d was transmitted too soon\n",
                   ack_data.dl_harq.get_id());
         ack_it_t toerase_it = it++;
@@ -730,6 +757,11 @@ int sched_tester::test_harqs()
     ack_data.ul_harq   = *ue_db[ack_data.rnti].get_ul_harq(tti_data.tti_tx_ul, CARRIER_IDX);
     ack_data.tti_tx_ul = tti_data.tti_tx_ul;
     ack_data.tti_ack   = tti_data.tti_tx_ul + FDD_HARQ_DELAY_MS;
+    for (const auto& e : to_ul_ack) {
+      CONDERROR(e.second.rnti == ack_data.rnti and e.second.ul_harq.get_id() == ack_data.ul_harq.get_id(),
+                "[TESTER] The UL harq pid=%d was scheduled before its CRC was received\n",
+                ack_data.ul_harq.get_id());
+    }
     if (ack_data.ul_harq.nof_retx(0) == 0) {
       ack_data.ack = randf() > sim_args.P_retx;
     } else {
@@ -740,13 +772,13 @@ int sched_tester::test_harqs()
 
   // Check whether some pids got old
   if (check_old_pids) {
-    for (auto& user : ue_db) {
+    for (srsenb::sched_ue& user : ue_db) {
       for (int i = 0; i < 2 * FDD_HARQ_DELAY_MS; i++) {
-        if (not(user.second.get_dl_harq(i, CARRIER_IDX)->is_empty(0) and user.second.get_dl_harq(1, CARRIER_IDX))) {
-          if (srslte_tti_interval(tti_data.tti_tx_dl, user.second.get_dl_harq(i, CARRIER_IDX)->get_tti()) > 49) {
+        if (not(user.get_dl_harq(i, CARRIER_IDX)->is_empty(0) and user.get_dl_harq(1, CARRIER_IDX))) {
+          if (srslte_tti_interval(tti_data.tti_tx_dl, user.get_dl_harq(i, CARRIER_IDX)->get_tti()) > 49) {
             TESTERROR("[TESTER] The pid=%d for rnti=0x%x got old.\n",
-                      user.second.get_dl_harq(i, CARRIER_IDX)->get_id(),
-                      user.first);
+                      user.get_dl_harq(i, CARRIER_IDX)->get_id(),
+                      user.get_rnti());
           }
         }
       }
@@ -951,9 +983,12 @@ int sched_tester::ack_txs()
   erase_if(to_ul_ack,
            [this](std::pair<const uint32_t, ul_ack_info_t>& elem) { return this->ue_db.count(elem.second.rnti) == 0; });
 
+  // When scheduling ahead of the PHY, the HARQ feedback received in a TTI is only known tti_lookahead TTIs later
+  uint32_t tti_ack_rx = TTI_SUB(tti_data.tti_rx, sim_args.tti_lookahead);
+
   /* Ack DL HARQs */
   for (const auto& ack_it : to_ack) {
-    if (ack_it.second.tti != tti_data.tti_rx) {
+    if (ack_it.second.tti != tti_ack_rx) {
       continue;
     }
     srsenb::dl_harq_proc*       h = ue_db[ack_it.second.rnti].get_dl_harq(ack_it.second.dl_harq.get_id(), CARRIER_IDX);
@@ -965,7 +1000,7 @@ int sched_tester::ack_txs()
       if (ack_it.second.dl_harq.is_empty(tb)) {
         continue;
       }
-      ret |= dl_ack_info(tti_data.tti_rx, ack_it.second.rnti, CARRIER_IDX, tb, ack_it.second.dl_ack) > 0;
+      ret |= dl_ack_info(tti_ack_rx, ack_it.second.rnti, CARRIER_IDX, tb, ack_it.second.dl_ack) > 0;
     }
     CONDERROR(not ret, "[TESTER] The dl harq proc that was acked does not exist\n");
 
@@ -973,7 +1008,7 @@ int sched_tester::ack_txs()
       CONDERROR(!h->is_empty(), "[TESTER] ACKed dl harq was not emptied\n");
       CONDERROR(h->has_pending_retx(0, tti_data.tti_tx_dl), "[TESTER] ACKed dl harq still has pending retx\n");
       log_global.info("[TESTER] DL ACK tti=%u rnti=0x%x pid=%d\n",
-                      tti_data.tti_rx,
+                      tti_ack_rx,
                       ack_it.second.rnti,
                       ack_it.second.dl_harq.get_id());
     } else {
@@ -983,16 +1018,16 @@ int sched_tester::ack_txs()
 
   /* Ack UL HARQs */
   for (const auto& ack_it : to_ul_ack) {
-    if (ack_it.first != tti_data.tti_rx) {
+    if (ack_it.first != tti_ack_rx) {
       continue;
     }
-    srsenb::ul_harq_proc*       h    = ue_db[ack_it.second.rnti].get_ul_harq(tti_data.tti_rx, CARRIER_IDX);
+    srsenb::ul_harq_proc*       h    = ue_db[ack_it.second.rnti].get_ul_harq(tti_ack_rx, CARRIER_IDX);
     const srsenb::ul_harq_proc& hack = ack_it.second.ul_harq;
     CONDERROR(h == nullptr or h->get_tti() != hack.get_tti(), "[TESTER] UL Harq TTI does not match the ACK TTI\n");
     CONDERROR(h->is_empty(0), "[TESTER] The acked UL harq is not active\n");
     CONDERROR(hack.is_empty(0), "[TESTER] The acked UL harq was not active\n");
 
-    ul_crc_info(tti_data.tti_rx, ack_it.second.rnti, CARRIER_IDX, ack_it.second.ack);
+    ul_crc_info(tti_ack_rx, ack_it.second.rnti, CARRIER_IDX, ack_it.second.ack);
 
     CONDERROR(!h->get_pending_data(), "[TESTER] UL harq lost its pending data\n");
     CONDERROR(!h->has_pending_ack(), "[TESTER] ACK/NACKed UL harq should have a pending ACK\n");
@@ -1000,7 +1035,7 @@ int sched_tester::ack_txs()
     if (ack_it.second.ack) {
       CONDERROR(!h->is_empty(), "[TESTER] ACKed UL harq did not get emptied\n");
       CONDERROR(h->has_pending_retx(), "[TESTER] ACKed UL harq still has pending retx\n");
-      log_global.info("[TESTER] UL ACK tti=%u rnti=0x%x pid=%d\n", tti_data.tti_rx, ack_it.second.rnti, hack.get_id());
+      log_global.info("[TESTER] UL ACK tti=%u rnti=0x%x pid=%d\n", tti_ack_rx, ack_it.second.rnti, hack.get_id());
     } else {
       // NACK
       CONDERROR(!h->is_empty() and !h->has_pending_retx(), "[TESTER] If NACKed, UL harq has to have pending retx\n");
@@ -1010,8 +1045,8 @@ int sched_tester::ack_txs()
   }
 
   // erase processed acks
-  to_ack.erase(tti_data.tti_rx);
-  to_ul_ack.erase(tti_data.tti_rx);
+  to_ack.erase(tti_ack_rx);
+  to_ul_ack.erase(tti_ack_rx);
 
   //  bool ack = true; //(tti_data.tti_rx % 3) == 0;
   //  if (tti_data.tti_rx >= FDD_HARQ_DELAY_MS) {
@@ -1054,13 +1089,15 @@ srsenb::sched_interface::cell_cfg_t generate_cell_cfg()
   return cell_cfg;
 }
 
-void test_scheduler_rand(srsenb::sched_interface::cell_cfg_t cell_cfg, const sched_sim_args& args)
+/// Runs the simulation with the given metrics and returns the number of DL and UL user TTIs with late data
+std::pair<uint32_t, uint32_t> test_scheduler_rand(srsenb::sched_interface::cell_cfg_t cell_cfg,
+                                                  const sched_sim_args&               args,
+                                                  srsenb::sched::metric_dl*           dl_metric,
+                                                  srsenb::sched::metric_ul*           ul_metric)
 {
   // Create classes
-  sched_tester         tester;
-  srsenb::sched        my_sched;
-  srsenb::dl_metric_rr dl_metric;
-  srsenb::ul_metric_rr ul_metric;
+  sched_tester  tester;
+  srsenb::sched my_sched;
 
   log_global.set_level(srslte::LOG_LEVEL_INFO);
 
@@ -1070,7 +1107,10 @@ void test_scheduler_rand(srsenb::sched_interface::cell_cfg_t cell_cfg, const sch
   //  srsenb::sched_interface::ul_sched_res_t& sched_result_ul = tester.tti_data.sched_result_ul;
 
   tester.init(nullptr, &log_global);
-  tester.set_metric(&dl_metric, &ul_metric);
+  srsenb::sched_interface::sched_args_t sched_args = srsenb::sched_params_t{}.sched_cfg;
+  sched_args.tti_lookahead                         = args.tti_lookahead;
+  tester.set_sched_cfg(&sched_args);
+  tester.set_metric(dl_metric, ul_metric);
   tester.cell_cfg(&cell_cfg);
 
   bool     running  = true;
@@ -1087,6 +1127,11 @@ void test_scheduler_rand(srsenb::sched_interface::cell_cfg_t cell_cfg, const sch
     nof_ttis++;
     tti = (tti + 1) % 10240;
   }
+
+  printf("[TESTER] Late user TTIs: DL=%u, UL=%u\n", tester.nof_dl_late, tester.nof_ul_late);
+  printf("[TESTER] Average scheduling time: %.1f us/TTI\n",
+         std::chrono::duration_cast<std::chrono::nanoseconds>(tester.sched_time).count() / (1000.0 * nof_ttis));
+  return std::make_pair(tester.nof_dl_late, tester.nof_ul_late);
 }
 
 sched_sim_args rand_sim_params(const srsenb::sched_interface::cell_cfg_t& cell_cfg, uint32_t nof_ttis)
@@ -1107,7 +1152,8 @@ sched_sim_args rand_sim_params(const srsenb::sched_interface::cell_cfg_t& cell_c
   sim_args.ue_cfg.maxharq_tx           = 5;
 
   bzero(&sim_args.bearer_cfg, sizeof(srsenb::sched_interface::ue_bearer_cfg_t));
-  sim_args.bearer_cfg.direction = srsenb::sched_interface::ue_bearer_cfg_t::BOTH;
+  sim_args.bearer_cfg.direction       = srsenb::sched_interface::ue_bearer_cfg_t::BOTH;
+  sim_args.bearer_cfg.delay_budget_ms = 50;
 
   sim_args.nof_ttis = nof_ttis;
   sim_args.P_retx   = 0.1;
@@ -1154,8 +1200,40 @@ sched_sim_args rand_sim_params(const srsenb::sched_interface::cell_cfg_t& cell_c
   return sim_args;
 }
 
-int main()
+static void usage(char* prog)
+{
+  printf("Usage: %s [lo]\n", prog);
+  printf("\t-l TTIs the scheduler runs ahead of the HARQ feedback (0, 1 or 2): [Default %d]\n", tti_lookahead);
+  printf("\t-o Do not check for DL HARQ processes pending for more than 49 TTIs\n");
+}
+
+static void parse_args(int argc, char** argv)
 {
+  int opt;
+  while ((opt = getopt(argc, argv, "lo")) != -1) {
+    switch (opt) {
+      case 'l':
+        tti_lookahead = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'o':
+        check_old_pids = false;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+
+  if (tti_lookahead > 2) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
   printf("[TESTER] This is the chosen seed: %u\n", seed);
   /* initialize random seed: */
   uint32_t N_runs = 1, nof_ttis = 10240 + 10;
@@ -1164,8 +1242,21 @@ int main()
     printf("Sim run number: %u\n", n + 1);
     srsenb::sched_interface::cell_cfg_t cell_cfg = generate_cell_cfg();
     sched_sim_args                      sim_args = rand_sim_params(cell_cfg, nof_ttis);
+    sim_args.tti_lookahead                       = tti_lookahead;
+
+    printf("Round-robin metric\n");
+    srsenb::dl_metric_rr          dl_metric_rr;
+    srsenb::ul_metric_rr          ul_metric_rr;
+    std::pair<uint32_t, uint32_t> rr_late = test_scheduler_rand(cell_cfg, sim_args, &dl_metric_rr, &ul_metric_rr);
+
+    printf("Earliest deadline first metric\n");
+    srsenb::dl_metric_edf         dl_metric_edf;
+    srsenb::ul_metric_edf         ul_metric_edf;
+    std::pair<uint32_t, uint32_t> edf_late = test_scheduler_rand(cell_cfg, sim_args, &dl_metric_edf, &ul_metric_edf);
 
-    test_scheduler_rand(cell_cfg, sim_args);
+    // Same users and traffic, so serving the data closest to its delay budget first should not leave more of it late
+    TESTASSERT(edf_late.first <= rr_late.first);
+    TESTASSERT(edf_late.second <= rr_late.second);
   }
 
   //  // low UL-Txs
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2013-2019 Software Radio Systems Limited
+ *
+ * This file is part of srsLTE.
+ *
+ * srsLTE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsLTE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/scheduler_ue_db.h"
+#include <map>
+#include <random>
+#include <set>
+
+#include "srslte/common/test_common.h"
+
+/*
+ * Checks the open-addressing container of the scheduler users against a std::map of the addresses of the users
+ */
+
+using srsenb::sched_ue;
+using srsenb::sched_ue_db;
+
+// The RNTIs of the same group map to the same entry of the initial index, which has 64 entries
+const uint16_t nof_collisions = 5;
+const uint16_t collision_step = 64;
+
+/// Checks that the container holds the users of the reference map, and that they did not move since their insertion
+int check_users(sched_ue_db& ue_db, const std::map<uint16_t, sched_ue*>& ref)
+{
+  TESTASSERT(ue_db.size() == ref.size());
+  TESTASSERT(ue_db.empty() == ref.empty());
+  for (const auto& p : ref) {
+    TESTASSERT(ue_db.count(p.first) == 1);
+    TESTASSERT(ue_db.find(p.first) == p.second);
+    TESTASSERT(&ue_db[p.first] == p.second);
+  }
+  TESTASSERT(ue_db.size() == ref.size());
+
+  // The iteration and the dense positions visit every user once
+  std::set<sched_ue*> visited;
+  for (sched_ue& u : ue_db) {
+    TESTASSERT(visited.insert(&u).second);
+  }
+  TESTASSERT(visited.size() == ref.size());
+  for (uint32_t i = 0; i < ue_db.size(); ++i) {
+    auto it = ref.find(ue_db.rnti_at(i));
+    TESTASSERT(it != ref.end());
+    TESTASSERT(&ue_db.at(i) == it->second);
+  }
+  return SRSLTE_SUCCESS;
+}
+
+int test_insert_erase()
+{
+  sched_ue_db                   ue_db;
+  std::map<uint16_t, sched_ue*> ref;
+
+  TESTASSERT(ue_db.empty());
+  TESTASSERT(ue_db.find(70) == nullptr);
+  TESTASSERT(ue_db.count(70) == 0);
+  TESTASSERT(not ue_db.erase(70));
+  TESTASSERT(ue_db.begin() == ue_db.end());
+
+  for (uint16_t rnti = 70; rnti < 80; ++rnti) {
+    ref[rnti] = &ue_db[rnti];
+  }
+  TESTASSERT(check_users(ue_db, ref) == SRSLTE_SUCCESS);
+
+  // Remove the first, a middle and the last user of the dense arrays
+  for (uint16_t rnti : {70, 75, 79}) {
+    TESTASSERT(ue_db.erase(rnti));
+    TESTASSERT(not ue_db.erase(rnti));
+    TESTASSERT(ue_db.find(rnti) == nullptr);
+    ref.erase(rnti);
+    TESTASSERT(check_users(ue_db, ref) == SRSLTE_SUCCESS);
+  }
+
+  // The released slots are reused
+  ref[75] = &ue_db[75];
+  TESTASSERT(check_users(ue_db, ref) == SRSLTE_SUCCESS);
+
+  ue_db.clear();
+  ref.clear();
+  TESTASSERT(check_users(ue_db, ref) == SRSLTE_SUCCESS);
+  ref[70] = &ue_db[70];
+  TESTASSERT(check_users(ue_db, ref) == SRSLTE_SUCCESS);
+
+  return SRSLTE_SUCCESS;
+}
+
+int test_collisions()
+{
+  sched_ue_db                   ue_db;
+  std::map<uint16_t, sched_ue*> ref;
+
+  // Two groups of colliding RNTIs, interleaved so that their probe sequences overlap
+  for (uint32_t i = 0; i < nof_collisions; ++i) {
+    for (uint16_t base : {70, 71}) {
+      uint16_t rnti = base + i * collision_step;
+      ref[rnti]     = &ue_db[rnti];
+    }
+  }
+  TESTASSERT(check_users(ue_db, ref) == SRSLTE_SUCCESS);
+
+  // Removing the head or the middle of a probe sequence must shift back the entries after it
+  for (uint16_t rnti : {70, 71 + 2 * collision_step, 70 + 3 * collision_step}) {
+    TESTASSERT(ue_db.erase(rnti));
+    ref.erase(rnti);
+    TESTASSERT(check_users(ue_db, ref) == SRSLTE_SUCCESS);
+  }
+
+  // Re-insertion in the shortened probe sequences
+  for (uint16_t rnti : {70, 70 + 3 * collision_step, 70 + nof_collisions * collision_step}) {
+    ref[rnti] = &ue_db[rnti];
+    TESTASSERT(check_users(ue_db, ref) == SRSLTE_SUCCESS);
+  }
+
+  // The probe sequence wraps around the end of the index
+  for (uint32_t i = 0; i < 3; ++i) {
+    uint16_t rnti = 63 + i * collision_step;
+    ref[rnti]     = &ue_db[rnti];
+  }
+  TESTASSERT(check_users(ue_db, ref) == SRSLTE_SUCCESS);
+  TESTASSERT(ue_db.erase(63));
+  ref.erase(63);
+  TESTASSERT(check_users(ue_db, ref) == SRSLTE_SUCCESS);
+
+  return SRSLTE_SUCCESS;
+}
+
+/// Random additions and removals, beyond the size of a chunk of slots and of the initial index
+int test_random()
+{
+  sched_ue_db                             ue_db;
+  std::map<uint16_t, sched_ue*>           ref;
+  std::mt19937                            rand_gen(0);
+  std::uniform_int_distribution<uint16_t> rnti_dist(70, 70 + 400);
+
+  for (uint32_t i = 0; i < 4000; ++i) {
+    uint16_t rnti = rnti_dist(rand_gen);
+    if (ref.count(rnti) > 0) {
+      TESTASSERT(ue_db.erase(rnti));
+      ref.erase(rnti);
+    } else {
+      ref[rnti] = &ue_db[rnti];
+    }
+    if (i % 100 == 0) {
+      TESTASSERT(check_users(ue_db, ref) == SRSLTE_SUCCESS);
+    }
+  }
+  TESTASSERT(ref.size() > 2 * 64);
+  TESTASSERT(check_users(ue_db, ref) == SRSLTE_SUCCESS);
+
+  return SRSLTE_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_insert_erase() == SRSLTE_SUCCESS);
+  TESTASSERT(test_collisions() == SRSLTE_SUCCESS);
+  TESTASSERT(test_random() == SRSLTE_SUCCESS);
+
+  printf("Success\n");
+  return SRSLTE_SUCCESS;
+}
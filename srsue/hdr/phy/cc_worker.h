@@ -43,6 +43,7 @@ public:
 
   void  set_tti(uint32_t tti);
   void  set_cfo(float cfo);
+  void  set_rx_cfo(float cfo);
   float get_ref_cfo();
 
   void set_tdd_config(srslte_tdd_config_t config);
@@ -79,6 +80,12 @@ private:
                     bool                                   acks[SRSLTE_MAX_CODEWORDS]);
   int  decode_pmch(mac_interface_phy_lte::tb_action_dl_t* action, srslte_mbsfn_cfg_t* mbsfn_cfg);
 
+  /* Methods for the PDCCH on the SPS C-RNTI */
+  bool is_sps_dci_valid(const srslte_dci_dl_t* dci, uint32_t grant_cc_idx);
+  bool is_sps_dci_valid(const srslte_dci_ul_t* dci, uint32_t grant_cc_idx);
+  bool is_sps_release(const srslte_dci_dl_t* dci);
+  bool is_sps_release(const srslte_dci_ul_t* dci);
+
   /* Methods for UL */
   bool     encode_uplink(mac_interface_phy_lte::tb_action_ul_t* action, srslte_uci_data_t* uci_data);
   void     set_uci_sr(srslte_uci_data_t* uci_data);
@@ -133,6 +133,12 @@ public:
                           srslte_pdsch_ack_resource_t resource);
   bool get_dl_pending_ack(srslte_ul_sf_cfg_t* sf, uint32_t cc_idx, srslte_pdsch_ack_cc_t* ack);
 
+  // DCIs that activated the SPS configured assignment and grant, used in the occasions without PDCCH
+  void set_sps_dl_dci(const srslte_dci_dl_t* dci);
+  void get_sps_dl_dci(srslte_dci_dl_t* dci);
+  void set_sps_ul_dci(const srslte_dci_ul_t* dci);
+  void get_sps_ul_dci(srslte_dci_ul_t* dci);
+
   void worker_end(void*              h,
                   bool               tx_enable,
                   cf_t*              buffer[SRSLTE_MAX_RADIOS][SRSLTE_MAX_PORTS],
@@ -153,6 +159,8 @@ public:
   void get_ul_metrics(ul_metrics_t m[SRSLTE_MAX_CARRIERS]);
   void set_sync_metrics(const uint32_t& cc_idx, const sync_metrics_t& m);
   void get_sync_metrics(sync_metrics_t m[SRSLTE_MAX_CARRIERS]);
+  bool set_processing_time(float proc_ms);
+  void get_timing_metrics(timing_metrics_t* m);
 
   void reset();
   void reset_radio();
@@ -223,6 +231,10 @@ private:
   } pending_dl_grant_t;
   pending_dl_grant_t pending_dl_grant[FDD_HARQ_DELAY_MS][SRSLTE_MAX_CARRIERS] = {};
 
+  srslte_dci_dl_t sps_dl_dci = {};
+  srslte_dci_ul_t sps_ul_dci = {};
+  std::mutex      sps_dci_mutex;
+
   srslte_cell_t cell = {};
 
   dl_metrics_t   dl_metrics[SRSLTE_MAX_CARRIERS]   = {};
@@ -235,6 +247,9 @@ private:
   uint32_t       sync_metrics_count                = 0;
   bool           sync_metrics_read                 = true;
 
+  std::mutex       timing_metrics_mutex;
+  timing_metrics_t timing_metrics = {};
+
   // MBSFN
   bool     sib13_configured = false;
   bool     mcch_configured  = false;
@@ -55,12 +55,19 @@ struct ul_metrics_t {
   float power;
 };
 
+struct timing_metrics_t {
+  uint32_t nof_sf;
+  uint32_t nof_late_sf;
+  float    max_proc_ms;
+};
+
 struct phy_metrics_t {
   info_metrics_t info[SRSLTE_MAX_CARRIERS];
   sync_metrics_t sync[SRSLTE_MAX_CARRIERS];
   dl_metrics_t   dl[SRSLTE_MAX_CARRIERS];
-  ul_metrics_t   ul[SRSLTE_MAX_CARRIERS];
-  uint32_t       nof_active_cc;
+  ul_metrics_t     ul[SRSLTE_MAX_CARRIERS];
+  timing_metrics_t timing;
+  uint32_t         nof_active_cc;
 };
 
 } // namespace srsue
@@ -44,7 +44,7 @@ public:
   void set_primary_cell(uint32_t earfcn, srslte_cell_t cell);
   void clear_cells();
   int  get_offset(uint32_t pci);
-  void write(uint32_t tti, cf_t* data, uint32_t nsamples);
+  void write(uint32_t tti, cf_t* data, uint32_t nsamples, float cfo = 0.0f);
 
 private:
   void             run_thread();
@@ -62,6 +62,7 @@ private:
   srslte::tti_sync_cv tti_sync;
 
   cf_t* search_buffer = nullptr;
+  cf_t* cfo_buffer    = nullptr;
 
   scell_recv::cell_info_t info[scell_recv::MAX_CELLS] = {};
 
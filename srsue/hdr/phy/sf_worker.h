@@ -27,6 +27,7 @@
 #include "srslte/common/thread_pool.h"
 #include "srslte/srslte.h"
 #include <string.h>
+#include <sys/time.h>
 
 namespace srsue {
 
@@ -57,6 +58,7 @@ public:
   void  set_tx_time(uint32_t radio_idx, srslte_timestamp_t tx_time, int next_offset);
   void  set_prach(cf_t* prach_ptr, float prach_power);
   void  set_cfo(const uint32_t& cc_idx, float cfo);
+  void  set_rx_cfo(const uint32_t& cc_idx, float cfo);
 
   void set_tdd_config(srslte_tdd_config_t config);
   void set_config(uint32_t cc_idx, srslte::phy_cfg_t& phy_cfg);
@@ -111,6 +113,7 @@ private:
   uint32_t           tti                            = 0;
   srslte_timestamp_t tx_time[SRSLTE_MAX_RADIOS]     = {};
   int                next_offset[SRSLTE_MAX_RADIOS] = {};
+  struct timeval     rx_done_time                   = {};
 
   uint32_t rssi_read_cnt = 0;
 };
@@ -51,6 +51,8 @@ public:
   void tb_decoded(mac_interface_phy_lte::mac_grant_dl_t grant, bool ack[SRSLTE_MAX_CODEWORDS]);
 
   void set_si_window_start(int si_window_start);
+  void set_sps_config(const srslte::sps_cfg_t& sps_cfg);
+  bool get_sps_grant(uint32_t tti, mac_interface_phy_lte::mac_grant_dl_t* grant);
 
   float get_average_retx();
 
@@ -67,6 +69,8 @@ private:
     void tb_decoded(mac_interface_phy_lte::mac_grant_dl_t grant, bool ack[SRSLTE_MAX_CODEWORDS]);
 
     bool is_sps();
+    void set_sps(bool enable);
+    bool get_ndi(uint32_t tb_idx);
 
   private:
     const static int RESET_DUPLICATE_TIMEOUT = 6;
@@ -83,6 +87,7 @@ private:
 
       void new_grant_dl(mac_interface_phy_lte::mac_grant_dl_t grant, mac_interface_phy_lte::tb_action_dl_t* action);
       void tb_decoded(mac_interface_phy_lte::mac_grant_dl_t grant, bool* ack_ptr);
+      bool get_ndi() { return cur_grant.tb[tid].ndi; }
 
     private:
       // Determine if it's a new transmission 5.3.2.2
@@ -111,6 +116,8 @@ private:
 
     /* Transport blocks */
     std::vector<dl_tb_process> subproc;
+
+    bool sps_grant = false;
   };
 
   // Private members of dl_harq_entity
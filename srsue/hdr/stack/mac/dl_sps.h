@@ -24,6 +24,8 @@
 
 #include "srslte/common/log.h"
 #include "srslte/common/timers.h"
+#include "srslte/interfaces/rrc_interface_types.h"
+#include "srslte/interfaces/ue_interfaces.h"
 
 /* Downlink Semi-Persistent schedulign (Section 5.10.1) */
 
@@ -32,11 +34,52 @@ namespace srsue {
 class dl_sps
 {
 public:
-  void clear() {}
-  void reset() {}
-  bool get_pending_grant(uint32_t tti, mac_interface_phy_lte::mac_grant_dl_t* grant) { return false; }
+  void set_config(const srslte::sps_cfg_t& cfg_)
+  {
+    cfg = cfg_;
+    if (not cfg.dl_enabled) {
+      clear();
+    }
+  }
+  void clear() { active = false; }
+  void reset() { clear(); }
+
+  // Stores the configured downlink assignment received on the SPS C-RNTI with NDI=0 (Section 5.10.1)
+  void activate(const mac_interface_phy_lte::mac_grant_dl_t& grant)
+  {
+    configured_grant = grant;
+    start_tti        = grant.tti;
+    active           = true;
+  }
+  bool is_active() const { return active; }
+
+  // HARQ Process ID = floor(CURRENT_TTI / semiPersistSchedIntervalDL) modulo numberOfConfSPS-Processes
+  uint32_t get_pid(uint32_t tti) const
+  {
+    return (cfg.dl_interval and cfg.dl_nof_harq) ? (tti / cfg.dl_interval) % cfg.dl_nof_harq : 0;
+  }
+
+  // Returns the configured assignment if the N-th configured assignment occurs in this TTI
+  bool get_pending_grant(uint32_t tti, mac_interface_phy_lte::mac_grant_dl_t* grant)
+  {
+    if (not active or cfg.dl_interval == 0 or tti == start_tti or TTI_SUB(tti, start_tti) % cfg.dl_interval != 0) {
+      return false;
+    }
+    *grant     = configured_grant;
+    grant->tti = tti;
+    grant->pid = get_pid(tti);
+    for (uint32_t i = 0; i < SRSLTE_MAX_TB; i++) {
+      grant->tb[i].ndi_present = false;
+      grant->tb[i].rv          = 0;
+    }
+    return true;
+  }
 
 private:
+  srslte::sps_cfg_t                     cfg;
+  bool                                  active           = false;
+  uint32_t                              start_tti        = 0;
+  mac_interface_phy_lte::mac_grant_dl_t configured_grant = {};
 };
 
 } // namespace srsue
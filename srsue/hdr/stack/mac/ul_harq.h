@@ -50,6 +50,8 @@ public:
   void reset();
   void reset_ndi();
   void set_config(srslte::ul_harq_cfg_t& harq_cfg);
+  void set_sps_config(const srslte::sps_cfg_t& sps_cfg);
+  bool get_sps_grant(uint32_t tti_tx, mac_interface_phy_lte::mac_grant_ul_t* grant);
 
   void start_pcap(srslte::mac_pcap* pcap_);
 
@@ -74,6 +76,7 @@ private:
     bool     has_grant();
     bool     get_ndi();
     bool     is_sps();
+    void     set_sps(bool enable);
 
     uint32_t get_nof_retx();
     int      get_current_tbs();
@@ -90,6 +93,7 @@ private:
     bool     harq_feedback;
     bool     is_grant_configured;
     bool     is_initiated;
+    bool     sps_grant = false;
 
     srslte::log*           log_h;
     ul_harq_entity*        harq_entity;
@@ -104,7 +108,8 @@ private:
     void generate_new_tx(mac_interface_phy_lte::mac_grant_ul_t grant, mac_interface_phy_lte::tb_action_ul_t* action);
   };
 
-  ul_sps ul_sps_assig;
+  ul_sps            ul_sps_assig;
+  srslte::sps_cfg_t sps_cfg;
 
   std::vector<ul_harq_process> proc;
 
@@ -24,6 +24,8 @@
 
 #include "srslte/common/log.h"
 #include "srslte/common/timers.h"
+#include "srslte/interfaces/rrc_interface_types.h"
+#include "srslte/interfaces/ue_interfaces.h"
 
 /* Uplink Semi-Persistent schedulign (Section 5.10.2) */
 
@@ -34,11 +36,62 @@ typedef _Complex float cf_t;
 class ul_sps
 {
 public:
-  void clear() {}
-  void reset(uint32_t tti) {}
-  bool get_pending_grant(uint32_t tti, mac_interface_phy_lte::mac_grant_ul_t* grant) { return false; }
+  void set_config(const srslte::sps_cfg_t& cfg_)
+  {
+    cfg = cfg_;
+    if (not cfg.ul_enabled) {
+      clear();
+    }
+  }
+  void clear()
+  {
+    active    = false;
+    nof_empty = 0;
+  }
+  void reset(uint32_t tti) { clear(); }
+
+  // Stores the configured uplink grant received on the SPS C-RNTI with NDI=0 (Section 5.10.2)
+  void activate(const mac_interface_phy_lte::mac_grant_ul_t& grant)
+  {
+    configured_grant = grant;
+    start_tti        = grant.tti_tx;
+    nof_empty        = 0;
+    active           = true;
+  }
+  bool is_active() const { return active; }
+
+  // Counts the consecutive new transmissions on the configured grant without MAC SDUs. Returns true and clears the
+  // configured grant once implicitReleaseAfter is reached.
+  bool new_tx_occasion(bool has_sdu)
+  {
+    nof_empty = has_sdu ? 0 : nof_empty + 1;
+    if (active and cfg.ul_implicit_release > 0 and nof_empty >= cfg.ul_implicit_release) {
+      clear();
+      return true;
+    }
+    return false;
+  }
+
+  // Returns the configured grant if the N-th configured grant occurs in this TTI
+  bool get_pending_grant(uint32_t tti, mac_interface_phy_lte::mac_grant_ul_t* grant)
+  {
+    if (not active or cfg.ul_interval == 0 or tti == start_tti or TTI_SUB(tti, start_tti) % cfg.ul_interval != 0) {
+      return false;
+    }
+    *grant                = configured_grant;
+    grant->tti_tx         = tti;
+    grant->pid            = tti % srslte_fdd_nof_harq(); // same as the PHY ul_pidof() in FDD
+    grant->tb.ndi_present = false;
+    grant->tb.rv          = 0;
+    return true;
+  }
 
 private:
+  srslte::sps_cfg_t                     cfg;
+  bool                                  active           = false;
+  uint32_t                              start_tti        = 0;
+  uint32_t                              nof_empty        = 0;
+  mac_interface_phy_lte::mac_grant_ul_t configured_grant = {};
 };
 
 } // namespace srsue
@@ -101,6 +101,10 @@ public:
     mac.tb_decoded(cc_idx, grant, ack);
   }
 
+  bool get_dl_sps_grant(uint32_t tti, mac_grant_dl_t* grant) { return mac.get_dl_sps_grant(tti, grant); }
+
+  bool get_ul_sps_grant(uint32_t tti_tx, mac_grant_ul_t* grant) { return mac.get_ul_sps_grant(tti_tx, grant); }
+
   void bch_decoded_ok(uint8_t* payload, uint32_t len) { mac.bch_decoded_ok(payload, len); }
 
   void mch_decoded(uint32_t len, bool crc) { mac.mch_decoded(len, crc); }
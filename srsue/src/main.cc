@@ -159,6 +159,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("channel.dl.enable", bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false), "Enable/Disable internal Downlink channel emulator")
     ("channel.dl.fading.enable", bpo::value<bool>(&args->phy.dl_channel_args.fading_enable)->default_value(false), "Enable/Disable Fading model")
     ("channel.dl.fading.model", bpo::value<std::string>(&args->phy.dl_channel_args.fading_model)->default_value("none"), "Fading model + maximum doppler (E.g. none, epa5, eva70, etu300, etc)")
+    ("channel.dl.fading.nof_threads", bpo::value<uint32_t>(&args->phy.dl_channel_args.fading_nof_threads)->default_value(1), "Number of threads fading the antenna ports in parallel")
     ("channel.dl.delay.enable", bpo::value<bool>(&args->phy.dl_channel_args.delay_enable)->default_value(false), "Enable/Disable Delay simulator")
     ("channel.dl.delay.period_s", bpo::value<float>(&args->phy.dl_channel_args.delay_period_s)->default_value(3600), "Delay period in seconds (integer)")
     ("channel.dl.delay.init_time_s", bpo::value<float>(&args->phy.dl_channel_args.delay_init_time_s)->default_value(0), "Initial time in seconds")
@@ -176,6 +177,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("channel.ul.enable", bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false), "Enable/Disable internal Uplink channel emulator")
     ("channel.ul.fading.enable", bpo::value<bool>(&args->phy.ul_channel_args.fading_enable)->default_value(false), "Enable/Disable Fading model")
     ("channel.ul.fading.model", bpo::value<std::string>(&args->phy.ul_channel_args.fading_model)->default_value("none"), "Fading model + maximum doppler (E.g. none, epa5, eva70, etu300, etc)")
+    ("channel.ul.fading.nof_threads", bpo::value<uint32_t>(&args->phy.ul_channel_args.fading_nof_threads)->default_value(1), "Number of threads fading the antenna ports in parallel")
     ("channel.ul.delay.enable", bpo::value<bool>(&args->phy.ul_channel_args.delay_enable)->default_value(false), "Enable/Disable Delay simulator")
     ("channel.ul.delay.period_s", bpo::value<float>(&args->phy.ul_channel_args.delay_period_s)->default_value(3600), "Delay period in seconds (integer)")
     ("channel.ul.delay.init_time_s", bpo::value<float>(&args->phy.ul_channel_args.delay_init_time_s)->default_value(0), "Initial time in seconds")
@@ -242,6 +244,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<int>(&args->phy.nof_phy_threads)->default_value(3),
      "Number of PHY threads")
 
+    ("phy.harq_delay_ms",
+     bpo::value<uint32_t>(&args->phy.harq_delay_ms)->default_value(4),
+     "FDD processing time in ms (4, or 3 and 2 for reduced processing time)")
+
     ("phy.equalizer_mode",
      bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"),
      "Equalizer mode")
@@ -263,6 +269,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<bool>(&args->phy.cfo_integer_enabled)->default_value(false),
      "Enables integer CFO estimation and correction.")
 
+    ("phy.cfo_fused_ofdm",
+     bpo::value<bool>(&args->phy.cfo_fused_ofdm)->default_value(true),
+     "Corrects the CFO of data subframes in the OFDM demodulator instead of in the synchronization thread.")
+
     ("phy.cfo_correct_tol_hz",
      bpo::value<float>(&args->phy.cfo_correct_tol_hz)->default_value(1.0),
      "Tolerance (in Hz) for digital CFO compensation (needs to be low if interpolate_subframe_enabled=true.")
@@ -86,6 +86,14 @@ void metrics_stdout::set_metrics(ue_metrics_t& metrics, const uint32_t period_us
     printf("RF status: O=%d, U=%d, L=%d\n", metrics.rf.rf_o, metrics.rf.rf_u, metrics.rf.rf_l);
   }
 
+  // and PHY deadline misses
+  if (metrics.phy.timing.nof_late_sf > 0) {
+    printf("PHY deadline: late=%d/%d, max=%.2f ms\n",
+           metrics.phy.timing.nof_late_sf,
+           metrics.phy.timing.nof_sf,
+           metrics.phy.timing.max_proc_ms);
+  }
+
   if (!do_print) {
     return;
   }
@@ -176,6 +176,11 @@ void cc_worker::set_cfo(float cfo)
   ue_ul_cfg.cfo_value = cfo;
 }
 
+void cc_worker::set_rx_cfo(float cfo)
+{
+  srslte_ue_dl_set_cfo(&ue_dl, cfo);
+}
+
 float cc_worker::get_ref_cfo()
 {
   return ue_dl.chest_res.cfo;
@@ -253,6 +258,31 @@ bool cc_worker::work_dl_regular()
   uint32_t        grant_cc_idx = 0;
   bool            has_dl_grant = phy->get_dl_pending_grant(CURRENT_TTI, cc_idx, &grant_cc_idx, &dci_dl);
 
+  // The SPS release has no PDSCH, it is acknowledged in the PUCCH resource of its PDCCH (36.213 Section 10.1.2)
+  if (has_dl_grant && is_sps_release(&dci_dl)) {
+    mac_interface_phy_lte::mac_grant_dl_t mac_grant = {};
+    mac_grant.rnti                                  = dci_dl.rnti;
+    mac_grant.tti                                   = CURRENT_TTI;
+    mac_grant.is_sps_release                        = true;
+    phy->stack->new_grant_dl(cc_idx, mac_grant, &dl_action);
+
+    srslte_pdsch_ack_resource_t ack_resource = {dci_dl.dai, dci_dl.location.ncce, grant_cc_idx, dci_dl.tpc_pucch};
+
+    uint8_t release_ack[SRSLTE_MAX_CODEWORDS] = {1, 2};
+    phy->set_dl_pending_ack(&sf_cfg_dl, cc_idx, release_ack, ack_resource);
+    has_dl_grant = false;
+  }
+
+  // Without PDCCH, the configured SPS assignment of this TTI uses the allocation of the DCI that activated it
+  mac_interface_phy_lte::mac_grant_dl_t sps_grant       = {};
+  bool                                  is_sps_occasion = false;
+  if (!has_dl_grant && cc_idx == 0 && phy->stack->get_dl_sps_grant(CURRENT_TTI, &sps_grant)) {
+    phy->get_sps_dl_dci(&dci_dl);
+    dci_dl.pid      = sps_grant.pid;
+    has_dl_grant    = true;
+    is_sps_occasion = true;
+  }
+
   // If found a dci for this carrier, generate a grant, pass it to MAC and decode the associated PDSCH
   if (has_dl_grant) {
 
@@ -281,6 +311,19 @@ bool cc_worker::work_dl_regular()
     // Save ACK resource configuration
     srslte_pdsch_ack_resource_t ack_resource = {dci_dl.dai, dci_dl.location.ncce, grant_cc_idx, dci_dl.tpc_pucch};
 
+    // The PDCCH on the SPS C-RNTI always carries the NDI, the configured assignments carry none and are acknowledged
+    // in the n1PUCCH-AN-Persistent selected by the TPC of the activation. Signal it with its equivalent CCE
+    if (dci_dl.rnti == ue_dl_cfg.cfg.sps_rnti) {
+      for (uint32_t i = 0; i < SRSLTE_MAX_CODEWORDS; i++) {
+        mac_grant.tb[i].ndi_present = !is_sps_occasion;
+      }
+      if (is_sps_occasion) {
+        uint32_t n1_pucch  = ue_ul_cfg.ul_cfg.pucch.n_pucch_1[dci_dl.tpc_pucch % 4];
+        uint32_t N1_pucch  = ue_ul_cfg.ul_cfg.pucch.N_pucch_1;
+        ack_resource.n_cce = SRSLTE_MAX(n1_pucch, N1_pucch) - N1_pucch;
+      }
+    }
+
     // Send grant to MAC and get action for this TB, then call tb_decoded to unlock MAC
     phy->stack->new_grant_dl(cc_idx, mac_grant, &dl_action);
     decode_pdsch(ack_resource, &dl_action, dl_ack);
@@ -385,8 +428,22 @@ int cc_worker::decode_pdcch_dl()
     }
 
     for (int k = 0; k < nof_grants; k++) {
+      uint32_t grant_cc_idx = dci[k].cif_present ? dci[k].cif : cc_idx;
+
+      // Discard the PDCCH on the SPS C-RNTI that fail the validation and keep the activation for the configured
+      // assignments
+      if (dci[k].rnti == ue_dl_cfg.cfg.sps_rnti) {
+        if (!is_sps_dci_valid(&dci[k], grant_cc_idx)) {
+          Info("PDCCH: Discarding DL DCI on SPS C-RNTI that fails the validation\n");
+          continue;
+        }
+        if (!dci[k].tb[0].ndi && !is_sps_release(&dci[k])) {
+          phy->set_sps_dl_dci(&dci[k]);
+        }
+      }
+
       // Save dci to CC index
-      phy->set_dl_pending_grant(CURRENT_TTI, dci[k].cif_present ? dci[k].cif : cc_idx, cc_idx, &dci[k]);
+      phy->set_dl_pending_grant(CURRENT_TTI, grant_cc_idx, cc_idx, &dci[k]);
 
       // Logging
       char str[512] = {};
@@ -466,6 +523,53 @@ int cc_worker::decode_pdsch(srslte_pdsch_ack_resource_t            ack_resource,
   return SRSLTE_SUCCESS;
 }
 
+/* Validates the PDCCH received on the SPS C-RNTI with NDI=0 as in 36.213 Table 9.2-1 (activation) and Table 9.2-1A
+ * (release). The retransmissions, with NDI=1, are not validated. SPS is only supported in the PCell */
+bool cc_worker::is_sps_dci_valid(const srslte_dci_dl_t* dci, uint32_t grant_cc_idx)
+{
+  if (grant_cc_idx != 0) {
+    return false;
+  }
+  if (dci->tb[0].ndi) {
+    return true;
+  }
+  return is_sps_release(dci) || (dci->pid == 0 && dci->tb[0].mcs_idx < 16 && dci->tb[0].rv == 0);
+}
+
+bool cc_worker::is_sps_dci_valid(const srslte_dci_ul_t* dci, uint32_t grant_cc_idx)
+{
+  if (grant_cc_idx != 0) {
+    return false;
+  }
+  if (dci->tb.ndi) {
+    return true;
+  }
+  return is_sps_release(dci) || (dci->tpc_pusch == 0 && dci->n_dmrs == 0 && dci->tb.mcs_idx < 16);
+}
+
+bool cc_worker::is_sps_release(const srslte_dci_dl_t* dci)
+{
+  uint32_t riv_nbits = (uint32_t)ceilf(log2f((float)cell.nof_prb * ((float)cell.nof_prb + 1) / 2));
+  return dci->rnti == ue_dl_cfg.cfg.sps_rnti && dci->format == SRSLTE_DCI_FORMAT1A && !dci->tb[0].ndi &&
+         dci->pid == 0 && dci->tb[0].mcs_idx == 31 && dci->tb[0].rv == 0 &&
+         dci->type2_alloc.riv == (1u << riv_nbits) - 1;
+}
+
+bool cc_worker::is_sps_release(const srslte_dci_ul_t* dci)
+{
+  // The resource block assignment and hopping resource allocation field is all ones, including the hopping bits
+  uint32_t riv_nbits = (uint32_t)ceilf(log2f((float)cell.nof_prb * ((float)cell.nof_prb + 1) / 2));
+  uint32_t n_ul_hop  = 0;
+  if (dci->freq_hop_fl != srslte_dci_ul_t::SRSLTE_RA_PUSCH_HOP_DISABLED) {
+    n_ul_hop = cell.nof_prb < 50 ? 1 : 2; // Table 8.4-1 of 36.213
+    if ((uint32_t)dci->freq_hop_fl != (1u << n_ul_hop) - 1) {
+      return false;
+    }
+  }
+  return dci->rnti == ue_dl_cfg.cfg.sps_rnti && !dci->tb.ndi && dci->tpc_pusch == 0 && dci->n_dmrs == 0 &&
+         dci->tb.mcs_idx == 31 && dci->type2_alloc.riv == (1u << (riv_nbits - n_ul_hop)) - 1;
+}
+
 int cc_worker::decode_pmch(mac_interface_phy_lte::tb_action_dl_t* action, srslte_mbsfn_cfg_t* mbsfn_cfg)
 {
   srslte_pdsch_res_t pmch_dec = {};
@@ -632,6 +736,31 @@ bool cc_worker::work_ul(srslte_uci_data_t* uci_data)
     pid = phy->ul_pidof(CURRENT_TTI_TX, &sf_cfg_ul.tdd_config);
   }
 
+  // The SPS release has no PUSCH, it only clears the configured grant in the MAC
+  if (ul_grant_available && is_sps_release(&dci_ul)) {
+    ul_mac_grant.rnti           = dci_ul.rnti;
+    ul_mac_grant.pid            = pid;
+    ul_mac_grant.tti_tx         = CURRENT_TTI_TX;
+    ul_mac_grant.is_sps_release = true;
+    phy->stack->new_grant_ul(cc_idx, ul_mac_grant, &ul_action);
+
+    ul_mac_grant       = {};
+    ul_action          = {};
+    ul_grant_available = false;
+  }
+
+  // Without PDCCH, the configured SPS grant of this TTI is a new transmission with the allocation of the DCI that
+  // activated it, which takes precedence over the PHICH
+  mac_interface_phy_lte::mac_grant_ul_t sps_grant       = {};
+  bool                                  is_sps_occasion = false;
+  if (!ul_grant_available && cc_idx == 0 && phy->stack->get_ul_sps_grant(CURRENT_TTI_TX, &sps_grant)) {
+    phy->get_sps_ul_dci(&dci_ul);
+    dci_ul.cqi_request           = false;
+    ul_mac_grant.phich_available = false;
+    ul_grant_available           = true;
+    is_sps_occasion              = true;
+  }
+
   /* Generate CQI reports if required, note that in case both aperiodic
    * and periodic ones present, only aperiodic is sent (36.213 section 7.2) */
   if (ul_grant_available && dci_ul.cqi_request) {
@@ -661,6 +790,7 @@ bool cc_worker::work_ul(srslte_uci_data_t* uci_data)
 
     // Fill MAC dci
     ul_phy_to_mac_grant(&ue_ul_cfg.ul_cfg.pusch.grant, &dci_ul, pid, ul_grant_available, &ul_mac_grant);
+    ul_mac_grant.tb.ndi_present = ul_grant_available && !is_sps_occasion;
 
     phy->stack->new_grant_ul(cc_idx, ul_mac_grant, &ul_action);
 
@@ -749,6 +879,17 @@ int cc_worker::decode_pdcch_ul()
       // If the DCI does not have Carrier Indicator Field then indicate in which carrier the dci was found
       uint32_t cc_idx_grant = dci[k].cif_present ? dci[k].cif : cc_idx;
 
+      // Discard the PDCCH on the SPS C-RNTI that fail the validation and keep the activation for the configured grants
+      if (dci[k].rnti == ue_dl_cfg.cfg.sps_rnti) {
+        if (!is_sps_dci_valid(&dci[k], cc_idx_grant)) {
+          Info("PDCCH: Discarding UL DCI on SPS C-RNTI that fails the validation\n");
+          continue;
+        }
+        if (!dci[k].tb.ndi && !is_sps_release(&dci[k])) {
+          phy->set_sps_ul_dci(&dci[k]);
+        }
+      }
+
       // Save DCI
       phy->set_ul_pending_grant(&sf_cfg_dl, cc_idx_grant, &dci[k]);
 
@@ -127,6 +127,16 @@ int phy::init(const phy_args_t& args_)
 
   args = args_;
 
+  if (srslte_set_fdd_harq_delay(args.harq_delay_ms)) {
+    return false;
+  }
+
+  // A subframe received in n is transmitted in n+k, with a reduced processing time a worker still busy after k-1 ms
+  // has already missed its deadline
+  if (srslte_fdd_harq_delay() < FDD_HARQ_DELAY_MS) {
+    args.nof_phy_threads = SRSLTE_MIN(args.nof_phy_threads, (int)srslte_fdd_harq_delay() - 1);
+  }
+
   set_earfcn(args.earfcn_list);
 
   // Force frequency if given as argument
@@ -161,6 +171,17 @@ int phy::init(const phy_args_t& args_)
   // set default logger
   log_h = log_vec.at(0).get();
 
+  if (args.nof_phy_threads < args_.nof_phy_threads) {
+    log_h->warning("Reducing the PHY threads from %d to %d for a processing time of %d ms\n",
+                   args_.nof_phy_threads,
+                   args.nof_phy_threads,
+                   srslte_fdd_harq_delay());
+    log_h->console("Warning: Reducing the PHY threads from %d to %d for a processing time of %d ms\n",
+                   args_.nof_phy_threads,
+                   args.nof_phy_threads,
+                   srslte_fdd_harq_delay());
+  }
+
   if (!check_args(args)) {
     return false;
   }
@@ -265,6 +286,7 @@ void phy::get_metrics(phy_metrics_t* m)
   common.get_dl_metrics(m->dl);
   common.get_ul_metrics(m->ul);
   common.get_sync_metrics(m->sync);
+  common.get_timing_metrics(&m->timing);
   m->nof_active_cc = args.nof_carriers;
 }
 
@@ -161,11 +161,12 @@ void phy_common::set_rar_grant(uint8_t             grant_payload[SRSLTE_RAR_GRAN
   }
   dci_ul.rnti = rnti;
 
+  // Msg3 keeps the legacy n+6 timing regardless of the processing time (Section 6.1.1 of 36.213)
   uint32_t msg3_tx_tti;
   if (rar_grant.ul_delay) {
-    msg3_tx_tti = (TTI_TX(rar_grant_tti) + MSG3_DELAY_MS + 1) % 10240;
+    msg3_tx_tti = (TTI_ADD(rar_grant_tti, TX_DELAY) + MSG3_DELAY_MS + 1) % 10240;
   } else {
-    msg3_tx_tti = (TTI_TX(rar_grant_tti) + MSG3_DELAY_MS) % 10240;
+    msg3_tx_tti = (TTI_ADD(rar_grant_tti, TX_DELAY) + MSG3_DELAY_MS) % 10240;
   }
 
   if (cell.frame_type == SRSLTE_TDD) {
@@ -252,14 +253,15 @@ uint32_t phy_common::ul_pidof(uint32_t tti, srslte_tdd_config_t* tdd_config)
         Error("Invalid SF configuration %d\n", tdd_config->sf_config);
     }
   } else {
-    return tti % SRSLTE_FDD_NOF_HARQ;
+    return tti % srslte_fdd_nof_harq();
   }
   return 0;
 }
 
 // Computes SF->TTI at which PHICH will be received according to 9.1.2 of 36.213
 #define tti_phich(sf)                                                                                                  \
-  (sf->tti + (cell.frame_type == SRSLTE_FDD ? FDD_HARQ_DELAY_MS : k_phich[sf->tdd_config.sf_config][sf->tti % 10]))
+  (sf->tti +                                                                                                           \
+   (cell.frame_type == SRSLTE_FDD ? srslte_fdd_harq_delay() : k_phich[sf->tdd_config.sf_config][sf->tti % 10]))
 
 // Here SF->TTI is when PUSCH is transmitted
 void phy_common::set_ul_pending_ack(srslte_ul_sf_cfg_t*  sf,
@@ -319,12 +321,12 @@ bool phy_common::is_any_ul_pending_ack()
 // Computes SF->TTI at which PUSCH will be transmitted according to Section 8 of 36.213
 #define tti_pusch_hi(sf)                                                                                               \
   (sf->tti +                                                                                                           \
-   (cell.frame_type == SRSLTE_FDD ? FDD_HARQ_DELAY_MS                                                                  \
+   (cell.frame_type == SRSLTE_FDD ? srslte_fdd_harq_delay()                                                            \
                                   : I_phich ? 7 : k_pusch[sf->tdd_config.sf_config][sf->tti % 10]) +                   \
    (TX_DELAY - FDD_HARQ_DELAY_MS))
 #define tti_pusch_gr(sf)                                                                                               \
   (sf->tti +                                                                                                           \
-   (cell.frame_type == SRSLTE_FDD ? FDD_HARQ_DELAY_MS                                                                  \
+   (cell.frame_type == SRSLTE_FDD ? srslte_fdd_harq_delay()                                                            \
                                   : dci->ul_idx == 1 ? 7 : k_pusch[sf->tdd_config.sf_config][sf->tti % 10]) +          \
    (TX_DELAY - FDD_HARQ_DELAY_MS))
 
@@ -453,6 +455,30 @@ bool phy_common::get_dl_pending_grant(uint32_t tti, uint32_t cc_idx, uint32_t* g
   }
 }
 
+void phy_common::set_sps_dl_dci(const srslte_dci_dl_t* dci)
+{
+  std::lock_guard<std::mutex> lock(sps_dci_mutex);
+  sps_dl_dci = *dci;
+}
+
+void phy_common::get_sps_dl_dci(srslte_dci_dl_t* dci)
+{
+  std::lock_guard<std::mutex> lock(sps_dci_mutex);
+  *dci = sps_dl_dci;
+}
+
+void phy_common::set_sps_ul_dci(const srslte_dci_ul_t* dci)
+{
+  std::lock_guard<std::mutex> lock(sps_dci_mutex);
+  sps_ul_dci = *dci;
+}
+
+void phy_common::get_sps_ul_dci(srslte_dci_ul_t* dci)
+{
+  std::lock_guard<std::mutex> lock(sps_dci_mutex);
+  *dci = sps_ul_dci;
+}
+
 typedef struct {
   uint32_t M;
   uint32_t K[9];
@@ -490,8 +516,8 @@ bool phy_common::get_dl_pending_ack(srslte_ul_sf_cfg_t* sf, uint32_t cc_idx, srs
   }
   for (uint32_t i = 0; i < M; i++) {
 
-    uint32_t k =
-        (cell.frame_type == SRSLTE_FDD) ? FDD_HARQ_DELAY_MS : das_table[sf->tdd_config.sf_config][sf->tti % 10].K[i];
+    uint32_t k = (cell.frame_type == SRSLTE_FDD) ? srslte_fdd_harq_delay()
+                                                 : das_table[sf->tdd_config.sf_config][sf->tti % 10].K[i];
     uint32_t pdsch_tti = TTI_SUB(sf->tti, k + (TX_DELAY - FDD_HARQ_DELAY_MS));
     if (pending_dl_ack[TTIMOD(pdsch_tti)][cc_idx].enable) {
       ack->m[i].present  = true;
@@ -647,6 +673,29 @@ void phy_common::get_sync_metrics(sync_metrics_t m[SRSLTE_MAX_CARRIERS])
   sync_metrics_read = true;
 }
 
+/* Accounts the time a worker took since its subframe was received until the signal was handed to the radio. The
+ * subframe received in n is transmitted in n+k, which leaves k-1 ms. Returns true if the deadline was missed.
+ */
+bool phy_common::set_processing_time(float proc_ms)
+{
+  std::lock_guard<std::mutex> lock(timing_metrics_mutex);
+  bool                        late = proc_ms > (float)(srslte_fdd_harq_delay() - 1);
+
+  timing_metrics.nof_sf++;
+  if (late) {
+    timing_metrics.nof_late_sf++;
+  }
+  timing_metrics.max_proc_ms = SRSLTE_MAX(timing_metrics.max_proc_ms, proc_ms);
+  return late;
+}
+
+void phy_common::get_timing_metrics(timing_metrics_t* m)
+{
+  std::lock_guard<std::mutex> lock(timing_metrics_mutex);
+  *m             = timing_metrics;
+  timing_metrics = {};
+}
+
 void phy_common::reset_radio()
 {
   // End Tx streams even if they are continuous
@@ -678,6 +727,10 @@ void phy_common::reset()
   ZERO_OBJECT(pending_dl_dai);
   ZERO_OBJECT(pending_ul_ack);
   ZERO_OBJECT(pending_ul_grant);
+
+  std::lock_guard<std::mutex> lock(sps_dci_mutex);
+  ZERO_OBJECT(sps_dl_dci);
+  ZERO_OBJECT(sps_ul_dci);
 }
 
 /*  Convert 6-bit maps to 10-element subframe tables
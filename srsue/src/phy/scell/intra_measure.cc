@@ -43,6 +43,9 @@ intra_measure::~intra_measure()
   srslte_ringbuffer_free(&ring_buffer);
   scell.deinit();
   free(search_buffer);
+  if (cfo_buffer) {
+    free(cfo_buffer);
+  }
 }
 
 void intra_measure::init(phy_common* common, rrc_interface_phy_lte* rrc, srslte::log* log_h)
@@ -61,6 +64,8 @@ void intra_measure::init(phy_common* common, rrc_interface_phy_lte* rrc, srslte:
   search_buffer =
       (cf_t*)srslte_vec_malloc(common->args->intra_freq_meas_len_ms * SRSLTE_SF_LEN_PRB(SRSLTE_MAX_PRB) * sizeof(cf_t));
 
+  cfo_buffer = (cf_t*)srslte_vec_malloc(SRSLTE_SF_LEN_PRB(SRSLTE_MAX_PRB) * sizeof(cf_t));
+
   if (srslte_ringbuffer_init(
           &ring_buffer, sizeof(cf_t) * common->args->intra_freq_meas_len_ms * 2 * SRSLTE_SF_LEN_PRB(SRSLTE_MAX_PRB))) {
     return;
@@ -131,7 +136,7 @@ void intra_measure::rem_cell(int pci)
   }
 }
 
-void intra_measure::write(uint32_t tti, cf_t* data, uint32_t nsamples)
+void intra_measure::write(uint32_t tti, cf_t* data, uint32_t nsamples, float cfo)
 {
   if (receive_enabled) {
     if ((tti % common->args->intra_freq_meas_period_ms) == 0) {
@@ -141,6 +146,11 @@ void intra_measure::write(uint32_t tti, cf_t* data, uint32_t nsamples)
       srslte_ringbuffer_reset(&ring_buffer);
     }
     if (receiving) {
+      // Apply the CFO correction deferred to the OFDM demodulator
+      if (cfo != 0.0f && cfo_buffer) {
+        srslte_vec_apply_cfo(data, cfo, cfo_buffer, nsamples);
+        data = cfo_buffer;
+      }
       if (srslte_ringbuffer_write(&ring_buffer, data, nsamples * sizeof(cf_t)) < (int)(nsamples * sizeof(cf_t))) {
         Warning("Error writting to ringbuffer\n");
         receiving = false;
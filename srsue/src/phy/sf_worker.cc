@@ -119,6 +119,9 @@ void sf_worker::set_tti(uint32_t tti_)
 {
   tti = tti_;
 
+  // The subframe has just been received, the processing deadline counts from here
+  gettimeofday(&rx_done_time, nullptr);
+
   for (auto& cc_worker : cc_workers) {
     cc_worker->set_tti(tti);
   }
@@ -147,6 +150,11 @@ void sf_worker::set_cfo(const uint32_t& cc_idx, float cfo)
   cc_workers[cc_idx]->set_cfo(cfo);
 }
 
+void sf_worker::set_rx_cfo(const uint32_t& cc_idx, float cfo)
+{
+  cc_workers[cc_idx]->set_rx_cfo(cfo);
+}
+
 void sf_worker::set_crnti(uint16_t rnti)
 {
   for (auto& cc_worker : cc_workers) {
@@ -256,6 +264,16 @@ void sf_worker::work_imp()
     }
   }
 
+  // Check the processing deadline
+  struct timeval t[3];
+  t[1] = rx_done_time;
+  gettimeofday(&t[2], nullptr);
+  get_time_interval(t);
+  float proc_ms = t[0].tv_sec * 1e3f + t[0].tv_usec * 1e-3f;
+  if (phy->set_processing_time(proc_ms)) {
+    Warning("TTI %d: processing took %.2f ms, deadline is %d ms\n", tti, proc_ms, srslte_fdd_harq_delay() - 1);
+  }
+
   // Call worker_end to transmit the signal
   phy->worker_end(this, tx_signal_ready, tx_signal_ptr, nof_samples, tx_time);
 
@@ -482,7 +482,7 @@ void sync::run_thread()
                 // Request TTI aligment
                 if (scell_sync->at(i)->tti_align(tti)) {
                   scell_sync->at(i)->read_sf(buffer[i + 1], &tx_time, &next_radio_offset[i + 1]);
-                  srslte_timestamp_add(&tx_time, 0, TX_DELAY * 1e-3 - time_adv_sec);
+                  srslte_timestamp_add(&tx_time, 0, srslte_fdd_harq_delay() * 1e-3 - time_adv_sec);
                 } else {
                   // Failed, keep default Timestamp
                   // Error("SCell asynchronous failed to synchronise (%d)\n", i);
@@ -512,7 +512,7 @@ void sync::run_thread()
               srslte_timestamp_t rx_time, tx_time;
               srslte_ue_sync_get_last_timestamp(&ue_sync, &rx_time);
               srslte_timestamp_copy(&tx_time, &rx_time);
-              srslte_timestamp_add(&tx_time, 0, TX_DELAY * 1e-3 - time_adv_sec);
+              srslte_timestamp_add(&tx_time, 0, srslte_fdd_harq_delay() * 1e-3 - time_adv_sec);
 
               worker->set_prach(prach_ptr ? &prach_ptr[prach_sf_cnt * SRSLTE_SF_LEN_PRB(cell.nof_prb)] : NULL,
                                 prach_power);
@@ -533,6 +533,11 @@ void sync::run_thread()
                 }
 
                 worker->set_cfo(cc, cfo);
+
+                // Carriers received by the PCell radio are CFO corrected by the OFDM demodulator if deferred
+                if (radio_idx == 0) {
+                  worker->set_rx_cfo(cc, srslte_ue_sync_get_cfo_deferred(&ue_sync));
+                }
               }
 
               worker->set_tti(tti);
@@ -566,7 +571,8 @@ void sync::run_thread()
                                &buffer[0][0][SRSLTE_SF_LEN_PRB(cell.nof_prb) / 2 - ue_sync.strack.fft_size]);
               }
               if (srslte_cell_isvalid(&cell)) {
-                intra_freq_meas.write(tti, buffer[0][0], SRSLTE_SF_LEN_PRB(cell.nof_prb));
+                intra_freq_meas.write(
+                    tti, buffer[0][0], SRSLTE_SF_LEN_PRB(cell.nof_prb), srslte_ue_sync_get_cfo_deferred(&ue_sync));
               }
               break;
             case 0:
@@ -819,6 +825,7 @@ bool sync::set_cell()
 
   // Set options defined in expert section
   set_ue_sync_opts(&ue_sync, search_p.get_last_cfo());
+  srslte_ue_sync_set_cfo_defer(&ue_sync, worker_com->args->cfo_fused_ofdm);
 
   // Reset ue_sync and set CFO/gain from search procedure
   srslte_ue_sync_reset(&ue_sync);
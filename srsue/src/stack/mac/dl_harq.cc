@@ -87,12 +87,57 @@ void dl_harq_entity::new_grant_dl(mac_interface_phy_lte::mac_grant_dl_t  grant,
       proc_ptr->reset_ndi();
       Info("Considering NDI in pid=%d to be toggled for first Temporal C-RNTI\n", grant.pid);
     }
+    // NDI is considered toggled if the previous transmission in this process was a configured assignment
+    if (grant.rnti == rntis->crnti && proc_ptr->is_sps()) {
+      for (uint32_t i = 0; i < SRSLTE_MAX_TB; i++) {
+        grant.tb[i].ndi = !proc_ptr->get_ndi(i);
+      }
+    }
+    proc_ptr->set_sps(false);
     proc_ptr->new_grant_dl(grant, action);
   } else {
-    Error("SPS not supported\n");
+    if (grant.is_sps_release) {
+      Info("SPS: Received DL assignment release\n");
+      dl_sps_assig.clear();
+      return;
+    }
+    if (grant.pid >= SRSLTE_MAX_HARQ_PROC) {
+      Error("Invalid PID: %d\n", grant.pid);
+      return;
+    }
+    // NDI=1 on the SPS C-RNTI is a retransmission, NDI=0 (re)activates the configured assignment. The configured
+    // assignments received without PDCCH carry no NDI and are always new transmissions (Section 5.3.1)
+    dl_harq_process* proc_ptr      = &proc[grant.pid];
+    bool             is_retx       = grant.tb[0].ndi_present && grant.tb[0].ndi;
+    bool             is_activation = grant.tb[0].ndi_present && !grant.tb[0].ndi;
+    for (uint32_t i = 0; i < SRSLTE_MAX_TB; i++) {
+      grant.tb[i].ndi         = is_retx ? proc_ptr->get_ndi(i) : !proc_ptr->get_ndi(i);
+      grant.tb[i].ndi_present = true;
+    }
+    if (is_activation) {
+      Info("SPS: Activated DL assignment tti=%d, pid=%d, tbs=%d\n", grant.tti, grant.pid, grant.tb[0].tbs);
+      dl_sps_assig.activate(grant);
+    }
+    proc_ptr->set_sps(true);
+    proc_ptr->new_grant_dl(grant, action);
   }
 }
 
+void dl_harq_entity::set_sps_config(const srslte::sps_cfg_t& sps_cfg)
+{
+  dl_sps_assig.set_config(sps_cfg);
+}
+
+bool dl_harq_entity::get_sps_grant(uint32_t tti, mac_interface_phy_lte::mac_grant_dl_t* grant)
+{
+  return dl_sps_assig.get_pending_grant(tti, grant);
+}
+
+uint32_t dl_harq_entity::get_harq_sps_pid(uint32_t tti)
+{
+  return dl_sps_assig.get_pid(tti);
+}
+
 void dl_harq_entity::tb_decoded(mac_interface_phy_lte::mac_grant_dl_t grant, bool ack[SRSLTE_MAX_CODEWORDS])
 {
   if (grant.rnti == SRSLTE_SIRNTI) {
@@ -144,6 +189,7 @@ bool dl_harq_entity::dl_harq_process::init(int pid, dl_harq_entity* parent)
 
 void dl_harq_entity::dl_harq_process::reset(void)
 {
+  sps_grant = false;
   for (uint32_t tb = 0; tb < SRSLTE_MAX_TB; tb++) {
     subproc[tb].reset();
   }
@@ -179,7 +225,17 @@ void dl_harq_entity::dl_harq_process::tb_decoded(mac_interface_phy_lte::mac_gran
 
 bool dl_harq_entity::dl_harq_process::is_sps()
 {
-  return false;
+  return sps_grant;
+}
+
+void dl_harq_entity::dl_harq_process::set_sps(bool enable)
+{
+  sps_grant = enable;
+}
+
+bool dl_harq_entity::dl_harq_process::get_ndi(uint32_t tb_idx)
+{
+  return subproc[tb_idx].get_ndi();
 }
 
 dl_harq_entity::dl_harq_process::dl_tb_process::dl_tb_process()
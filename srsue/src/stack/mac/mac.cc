@@ -431,6 +431,17 @@ void mac::tb_decoded(uint32_t cc_idx, mac_grant_dl_t grant, bool ack[SRSLTE_MAX_
   }
 }
 
+bool mac::get_dl_sps_grant(uint32_t tti, mac_grant_dl_t* grant)
+{
+  // Semi-persistent scheduling is only supported in the PCell
+  return dl_harq.at(0)->get_sps_grant(tti, grant);
+}
+
+bool mac::get_ul_sps_grant(uint32_t tti_tx, mac_grant_ul_t* grant)
+{
+  return ul_harq.at(0)->get_sps_grant(tti_tx, grant);
+}
+
 void mac::new_grant_dl(uint32_t                               cc_idx,
                        mac_interface_phy_lte::mac_grant_dl_t  grant,
                        mac_interface_phy_lte::tb_action_dl_t* action)
@@ -590,6 +601,10 @@ void mac::set_config(mac_cfg_t& mac_cfg)
       i->set_config(ul_harq_cfg);
     }
   }
+  // Semi-persistent scheduling is only supported in the PCell
+  uernti.sps_rnti = mac_cfg.sps_cfg.sps_rnti;
+  dl_harq.at(0)->set_sps_config(mac_cfg.sps_cfg);
+  ul_harq.at(0)->set_sps_config(mac_cfg.sps_cfg);
   setup_timers(mac_cfg.time_alignment_timer);
 }
 
@@ -82,6 +82,17 @@ void ul_harq_entity::set_config(srslte::ul_harq_cfg_t& harq_cfg)
   this->harq_cfg = harq_cfg;
 }
 
+void ul_harq_entity::set_sps_config(const srslte::sps_cfg_t& sps_cfg_)
+{
+  sps_cfg = sps_cfg_;
+  ul_sps_assig.set_config(sps_cfg);
+}
+
+bool ul_harq_entity::get_sps_grant(uint32_t tti_tx, mac_interface_phy_lte::mac_grant_ul_t* grant)
+{
+  return ul_sps_assig.get_pending_grant(tti_tx, grant);
+}
+
 void ul_harq_entity::start_pcap(srslte::mac_pcap* pcap_)
 {
   pcap = pcap_;
@@ -98,17 +109,36 @@ void ul_harq_entity::new_grant_ul(mac_interface_phy_lte::mac_grant_ul_t  grant,
     return;
   }
   if (grant.rnti == rntis->crnti || grant.rnti == rntis->temp_rnti || SRSLTE_RNTI_ISRAR(grant.rnti)) {
+    // NDI is considered toggled if the previous grant for this process was a configured grant
     if (grant.rnti == rntis->crnti && proc[grant.pid].is_sps()) {
-      grant.tb.ndi = true;
+      grant.tb.ndi = !proc[grant.pid].get_ndi();
     }
+    proc[grant.pid].set_sps(false);
     proc[grant.pid].new_grant_ul(grant, action);
   } else if (grant.rnti == rntis->sps_rnti) {
-    if (grant.tb.ndi) {
+    if (grant.is_sps_release) {
+      Info("SPS: Received UL grant release\n");
+      ul_sps_assig.clear();
+      return;
+    }
+    if (grant.tb.ndi_present && grant.tb.ndi) {
+      // NDI=1 on the SPS C-RNTI is a retransmission
       grant.tb.ndi = proc[grant.pid].get_ndi();
-      proc[grant.pid].new_grant_ul(grant, action);
-    } else {
-      Info("Not implemented\n");
+    } else if (grant.tb.ndi_present || !grant.phich_available) {
+      // NDI=0 activates or re-activates the configured grant. Both the activation and the configured grants received
+      // without PDCCH are new transmissions (Section 5.10.2)
+      if (grant.tb.ndi_present) {
+        Info("SPS: Activated UL grant tti_tx=%d, pid=%d, tbs=%d\n", grant.tti_tx, grant.pid, grant.tb.tbs);
+        ul_sps_assig.activate(grant);
+      }
+      grant.tb.ndi         = !proc[grant.pid].get_ndi();
+      grant.tb.ndi_present = true;
+      if (ul_sps_assig.new_tx_occasion(mux_unit->is_pending_any_sdu())) {
+        Info("SPS: UL grant implicitly released after %d empty transmissions\n", sps_cfg.ul_implicit_release);
+      }
     }
+    proc[grant.pid].set_sps(true);
+    proc[grant.pid].new_grant_ul(grant, action);
   } else {
     Warning("Received grant for unknown rnti=0x%x\n", grant.rnti);
   }
@@ -178,6 +208,7 @@ void ul_harq_entity::ul_harq_process::reset()
   current_tx_nb       = 0;
   current_irv         = 0;
   is_grant_configured = false;
+  sps_grant           = false;
   bzero(&cur_grant, sizeof(mac_interface_phy_lte::mac_grant_ul_t));
   payload_buffer->clear();
 }
@@ -233,7 +264,8 @@ void ul_harq_entity::ul_harq_process::new_grant_ul(mac_interface_phy_lte::mac_gr
     if (grant.tb.tbs == 0) {
       action->tb.enabled = true;
 
-    } else if ((grant.rnti == harq_entity->rntis->crnti &&        // If C-RNTI
+    } else if (((grant.rnti == harq_entity->rntis->crnti ||       // If C-RNTI
+                 grant.rnti == harq_entity->rntis->sps_rnti) &&   // or SPS C-RNTI
                 ((grant.tb.ndi != get_ndi()) || !has_grant())) || // if NDI toggled or is first dci is a new tx
                grant_is_rar())                                    // If T-CRNTI received in RAR has no RV information
     {
@@ -312,7 +344,12 @@ bool ul_harq_entity::ul_harq_process::get_ndi()
 
 bool ul_harq_entity::ul_harq_process::is_sps()
 {
-  return false;
+  return sps_grant;
+}
+
+void ul_harq_entity::ul_harq_process::set_sps(bool enable)
+{
+  sps_grant = enable;
 }
 
 uint32_t ul_harq_entity::ul_harq_process::get_nof_retx()
@@ -2401,7 +2401,14 @@ bool rrc::apply_rr_config_dedicated(rr_cfg_ded_s* cnfg)
   }
 
   if (cnfg->sps_cfg_present) {
-    // TODO
+    current_mac_cfg.sps_cfg = make_sps_cfg_t(cnfg->sps_cfg);
+    rrc_log->info("Set SPS config: sps-rnti=0x%x, dl_interval=%d, ul_interval=%d\n",
+                  current_mac_cfg.sps_cfg.sps_rnti,
+                  current_mac_cfg.sps_cfg.dl_enabled ? current_mac_cfg.sps_cfg.dl_interval : 0,
+                  current_mac_cfg.sps_cfg.ul_enabled ? current_mac_cfg.sps_cfg.ul_interval : 0);
+    mac->set_config(current_mac_cfg);
+    set_phy_cfg_t_sps_cfg(&current_phy_cfg, cnfg->sps_cfg);
+    phy->set_config(current_phy_cfg);
   }
   if (cnfg->rlf_timers_and_consts_r9.is_present() and cnfg->rlf_timers_and_consts_r9->type() == setup_e::setup) {
     auto timer_expire_func = [this](uint32_t tid) { timer_expired(tid); };
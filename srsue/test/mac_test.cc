@@ -1561,6 +1561,144 @@ int mac_random_access_test()
   return SRSLTE_SUCCESS;
 }
 
+// Activation, retransmission and release of SPS grants, and NDI handling when switching back to C-RNTI grants
+int mac_sps_test()
+{
+  srslte::log_filter mac_log("MAC");
+  mac_log.set_level(srslte::LOG_LEVEL_DEBUG);
+  mac_log.set_hex_limit(100000);
+
+  srslte::log_filter rlc_log("RLC");
+  rlc_log.set_level(srslte::LOG_LEVEL_DEBUG);
+  rlc_log.set_hex_limit(100000);
+
+  srslte::timer_handler timers(64);
+
+  // dummy layers
+  phy_dummy   phy;
+  rlc_dummy   rlc(&rlc_log);
+  rrc_dummy   rrc;
+  stack_dummy stack;
+
+  // the actual MAC
+  mac mac(&mac_log);
+  stack.init(&mac, &phy);
+  mac.init(&phy, &rlc, &rrc, &timers, &stack);
+  const uint16_t crnti    = 0x1001;
+  const uint16_t sps_rnti = 0x1002;
+  mac.set_ho_rnti(crnti, 0);
+
+  mac_cfg_t mac_cfg;
+  mac_cfg.sps_cfg.sps_rnti            = sps_rnti;
+  mac_cfg.sps_cfg.dl_enabled          = true;
+  mac_cfg.sps_cfg.dl_interval         = 10;
+  mac_cfg.sps_cfg.dl_nof_harq         = 2;
+  mac_cfg.sps_cfg.ul_enabled          = true;
+  mac_cfg.sps_cfg.ul_interval         = 10;
+  mac_cfg.sps_cfg.ul_implicit_release = 2;
+  mac.set_config(mac_cfg);
+
+  // Padding only MAC PDU
+  const uint8_t dl_sch_pdu[] = {0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+  bool          dl_ack[SRSLTE_MAX_CODEWORDS] = {true, false};
+  int           cc_idx                       = 0;
+
+  {
+    mac_interface_phy_lte::tb_action_dl_t dl_action = {};
+    mac_interface_phy_lte::mac_grant_dl_t mac_grant = {};
+
+    // Activation of the DL assignment is a new transmission
+    mac_grant.rnti              = sps_rnti;
+    mac_grant.tb[0].ndi_present = true;
+    mac_grant.tb[0].ndi         = false;
+    mac_grant.tb[0].tbs         = sizeof(dl_sch_pdu);
+    mac.new_grant_dl(cc_idx, mac_grant, &dl_action);
+    TESTASSERT(dl_action.tb[0].enabled);
+    memcpy(dl_action.tb[0].payload, dl_sch_pdu, sizeof(dl_sch_pdu));
+    mac.tb_decoded(cc_idx, mac_grant, dl_ack);
+
+    // NDI=1 on the SPS C-RNTI is a retransmission of the decoded TB
+    mac_grant.tb[0].ndi = true;
+    mac.new_grant_dl(cc_idx, mac_grant, &dl_action);
+    TESTASSERT(not dl_action.tb[0].enabled);
+    mac.tb_decoded(cc_idx, mac_grant, dl_ack);
+
+    // The configured assignments occur every interval without NDI and are new transmissions
+    mac_interface_phy_lte::mac_grant_dl_t sps_grant = {};
+    TESTASSERT(not mac.get_dl_sps_grant(5, &sps_grant));
+    TESTASSERT(mac.get_dl_sps_grant(10, &sps_grant));
+    TESTASSERT(sps_grant.rnti == sps_rnti and sps_grant.pid == 1 and not sps_grant.tb[0].ndi_present);
+    mac.new_grant_dl(cc_idx, sps_grant, &dl_action);
+    TESTASSERT(dl_action.tb[0].enabled);
+    memcpy(dl_action.tb[0].payload, dl_sch_pdu, sizeof(dl_sch_pdu));
+    mac.tb_decoded(cc_idx, sps_grant, dl_ack);
+
+    // NDI of a C-RNTI assignment is considered toggled after a SPS transmission in the same process
+    mac_grant.rnti      = crnti;
+    mac_grant.tb[0].ndi = false;
+    mac.new_grant_dl(cc_idx, mac_grant, &dl_action);
+    TESTASSERT(dl_action.tb[0].enabled);
+    memcpy(dl_action.tb[0].payload, dl_sch_pdu, sizeof(dl_sch_pdu));
+    mac.tb_decoded(cc_idx, mac_grant, dl_ack);
+
+    // The release does not carry a TB
+    mac_grant.rnti           = sps_rnti;
+    mac_grant.is_sps_release = true;
+    mac.new_grant_dl(cc_idx, mac_grant, &dl_action);
+    TESTASSERT(not dl_action.tb[0].enabled);
+  }
+
+  {
+    mac_interface_phy_lte::tb_action_ul_t ul_action = {};
+    mac_interface_phy_lte::mac_grant_ul_t mac_grant = {};
+
+    // Activation of the UL grant is a new transmission
+    mac_grant.rnti           = sps_rnti;
+    mac_grant.tb.ndi_present = true;
+    mac_grant.tb.ndi         = false;
+    mac_grant.tb.tbs         = 12;
+    mac.new_grant_ul(cc_idx, mac_grant, &ul_action);
+    TESTASSERT(ul_action.tb.enabled);
+    TESTASSERT(ul_action.current_tx_nb == 1);
+
+    // NDI=1 on the SPS C-RNTI is an adaptive retransmission
+    mac_grant.tb.ndi = true;
+    mac.new_grant_ul(cc_idx, mac_grant, &ul_action);
+    TESTASSERT(ul_action.tb.enabled);
+    TESTASSERT(ul_action.current_tx_nb == 2);
+
+    // The configured grants occur every interval without NDI and are new transmissions
+    mac_interface_phy_lte::mac_grant_ul_t sps_grant = {};
+    TESTASSERT(not mac.get_ul_sps_grant(5, &sps_grant));
+    TESTASSERT(mac.get_ul_sps_grant(10, &sps_grant));
+    TESTASSERT(sps_grant.rnti == sps_rnti and sps_grant.pid == 2 and not sps_grant.tb.ndi_present);
+    mac.new_grant_ul(cc_idx, sps_grant, &ul_action);
+    TESTASSERT(ul_action.tb.enabled);
+    TESTASSERT(ul_action.current_tx_nb == 1);
+
+    // A PHICH NACK of a configured grant is a non-adaptive retransmission
+    sps_grant.phich_available = true;
+    sps_grant.hi_value        = false;
+    mac.new_grant_ul(cc_idx, sps_grant, &ul_action);
+    TESTASSERT(ul_action.tb.enabled);
+    TESTASSERT(ul_action.current_tx_nb == 2);
+
+    // NDI of a C-RNTI grant is considered toggled after a SPS transmission in the same process
+    mac_grant.rnti   = crnti;
+    mac_grant.tb.ndi = true;
+    mac.new_grant_ul(cc_idx, mac_grant, &ul_action);
+    TESTASSERT(ul_action.tb.enabled);
+    TESTASSERT(ul_action.current_tx_nb == 1);
+  }
+
+  // make sure MAC PDU thread picks up before stopping
+  sleep(1);
+  mac.run_tti(0);
+  mac.stop();
+
+  return SRSLTE_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
 #if HAVE_PCAP
@@ -1623,5 +1761,10 @@ int main(int argc, char** argv)
     return -1;
   }
 
+  if (mac_sps_test()) {
+    printf("mac_sps_test() test failed.\n");
+    return -1;
+  }
+
   return 0;
 }
@@ -101,6 +101,8 @@ private:
       }
     }
     void tb_decoded(uint32_t cc_idx, mac_grant_dl_t grant, bool* ack) override {}
+    bool get_dl_sps_grant(uint32_t tti, mac_grant_dl_t* grant) override { return false; }
+    bool get_ul_sps_grant(uint32_t tti_tx, mac_grant_ul_t* grant) override { return false; }
     void bch_decoded_ok(uint8_t* payload, uint32_t len) override {}
     void mch_decoded(uint32_t len, bool crc) override {}
     void new_mch_dl(srslte_pdsch_grant_t phy_grant, tb_action_dl_t* action) override {}
@@ -451,7 +451,7 @@ public:
     return is_bsr;
   }
 
-  uint32_t get_pid(const uint32_t tti_) { return tti_ % (2 * FDD_HARQ_DELAY_MS); }
+  uint32_t get_pid(const uint32_t tti_) { return tti_ % srslte_fdd_nof_harq(); }
 
   bool get_ndi_for_new_ul_tx(const uint32_t tti_)
   {